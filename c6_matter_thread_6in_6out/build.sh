@@ -54,8 +54,10 @@ show_menu() {
     echo "7) Menuconfig"
     echo "8) Erase flash (Factory Reset)"
     echo "9) Exit"
+    echo "10) Build Sleepy End Device variant (inputs only)"
+    echo "11) Flash/RAM budget report (diff against size_baseline.json)"
     echo ""
-    read -p "Enter choice [1-9]: " choice
+    read -p "Enter choice [1-11]: " choice
 }
 
 # Main loop
@@ -112,6 +114,18 @@ while true; do
             echo -e "${GREEN}Exiting...${NC}"
             exit 0
             ;;
+        10)
+            echo -e "${GREEN}Building Sleepy End Device variant in build_sed...${NC}"
+            idf.py -B build_sed -D SDKCONFIG=build_sed/sdkconfig \
+                -D SDKCONFIG_DEFAULTS="sdkconfig.defaults;sdkconfig.defaults.sed" build
+            echo -e "${GREEN}Build complete! Flash with: idf.py -B build_sed -p $SERIAL_PORT flash${NC}"
+            ;;
+        11)
+            echo -e "${GREEN}Building and analysing flash/RAM usage...${NC}"
+            idf.py build
+            cmake --build build --target size-budget
+            echo -e "${YELLOW}Run 'cmake --build build --target size-budget-save' to accept as new baseline${NC}"
+            ;;
         *)
             echo -e "${RED}Invalid option${NC}"
             ;;
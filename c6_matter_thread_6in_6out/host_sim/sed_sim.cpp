@@ -0,0 +1,276 @@
+/*
+ * Host simulation of the Sleepy End Device input path
+ *
+ * Replays randomly generated contact events (with bounce and short glitches)
+ * through the same debouncer used by the firmware (main/app_sed_debounce.h)
+ * and models the Thread SED radio:
+ * - slow ICD poll while idle
+ * - report TX + fast polls for the ICD active mode after every report
+ *
+ * Prints radio-on time per reported event and compares the GPIO wakeup design
+ * with the 50 ms polling task used by the always-on build.
+ *
+ * Usage: sed_sim [hours] [events_per_hour_per_input] [seed]
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "app_sed_debounce.h"
+
+// Timing model (microseconds), defaults match sdkconfig.defaults.sed
+struct sim_config_t {
+    int64_t slow_poll_us = 5000 * 1000LL;       // CONFIG_ICD_SLOW_POLL_INTERVAL_MS
+    int64_t fast_poll_us = 200 * 1000LL;        // CONFIG_ICD_FAST_POLL_INTERVAL_MS
+    int64_t active_threshold_us = 1000 * 1000LL; // CONFIG_ICD_ACTIVE_MODE_THRESHOLD_MS
+    int64_t debounce_us = 30 * 1000LL;          // CONFIG_APP_SED_DEBOUNCE_MS
+    int64_t wake_window_us = 120 * 1000LL;      // CONFIG_APP_SED_WAKE_WINDOW_MS
+    int64_t wake_latency_us = 1000;             // Light sleep exit
+    int64_t poll_radio_us = 2500;               // Data request + ack + RX window
+    int64_t report_radio_us = 4000;             // CSMA + ReportData TX + ack
+    int64_t legacy_poll_us = 50 * 1000LL;       // gpio_input_task period
+};
+
+static const int NUM_INPUTS = 4;
+
+struct input_trace_t {
+    std::vector<int64_t> t;   // Transition times, level alternates starting from 'initial'
+    int initial = 1;          // Pull-up: HIGH at rest
+    int real_changes = 0;
+    int glitches = 0;
+
+    int level_at(int64_t time) const
+    {
+        size_t n = std::upper_bound(t.begin(), t.end(), time) - t.begin();
+        return (n & 1) ? !initial : initial;
+    }
+
+    // First time >= 'time' at which the input sits on 'level'
+    int64_t next_time_at_level(int64_t time, int level) const
+    {
+        if (level_at(time) == level) {
+            return time;
+        }
+        auto it = std::upper_bound(t.begin(), t.end(), time);
+        return it == t.end() ? INT64_MAX : *it;
+    }
+};
+
+static void generate_trace(input_trace_t &in, int64_t duration_us, double events_per_hour, std::mt19937 &rng)
+{
+    std::exponential_distribution<double> gap(events_per_hour / 3600e6);
+    std::uniform_int_distribution<int> bounces(0, 6);
+    std::uniform_int_distribution<int64_t> bounce_gap(200, 3000);
+    std::uniform_int_distribution<int64_t> glitch_len(500, 8000);
+    std::uniform_real_distribution<double> coin(0.0, 1.0);
+
+    int64_t now = 0;
+    while (true) {
+        now += (int64_t)gap(rng) + 100000;
+        if (now >= duration_us) {
+            break;
+        }
+        if (coin(rng) < 0.05) {
+            // Short glitch: the input returns to its level before the debounce ends
+            in.t.push_back(now);
+            in.t.push_back(now + glitch_len(rng));
+            in.glitches++;
+            now = in.t.back();
+            continue;
+        }
+        // Real edge followed by an even number of bounce transitions
+        in.t.push_back(now);
+        int n = bounces(rng);
+        for (int i = 0; i < n; i++) {
+            now += bounce_gap(rng);
+            in.t.push_back(now);
+            now += bounce_gap(rng);
+            in.t.push_back(now);
+        }
+        in.real_changes++;
+    }
+}
+
+struct radio_model_t {
+    const sim_config_t &cfg;
+    std::vector<int64_t> reports;   // Time of each report message
+
+    int64_t radio_on_us(int64_t duration_us) const
+    {
+        int64_t on = 0;
+        int64_t active_until = -1;
+        int64_t next_slow = cfg.slow_poll_us;
+        for (int64_t r : reports) {
+            // Slow polls until this report, skipping the ones inside active mode
+            for (; next_slow < r; next_slow += cfg.slow_poll_us) {
+                if (next_slow > active_until) {
+                    on += cfg.poll_radio_us;
+                }
+            }
+            on += cfg.report_radio_us;
+            // Fast polls for the active mode, extended by back-to-back reports
+            int64_t start = std::max(r, active_until);
+            int64_t end = r + cfg.active_threshold_us;
+            if (end > start) {
+                on += ((end - start) / cfg.fast_poll_us) * cfg.poll_radio_us;
+            }
+            active_until = std::max(active_until, end);
+        }
+        for (; next_slow < duration_us; next_slow += cfg.slow_poll_us) {
+            if (next_slow > active_until) {
+                on += cfg.poll_radio_us;
+            }
+        }
+        return on;
+    }
+};
+
+struct result_t {
+    int64_t reported_changes = 0;
+    int64_t report_messages = 0;
+    int64_t wake_windows = 0;
+    int64_t cpu_wakeups = 0;
+    int64_t radio_on_us = 0;
+    bool final_state_ok = true;
+};
+
+// GPIO wakeup design: one wake window per edge, see app_sed.cpp
+static result_t run_wakeup(const sim_config_t &cfg, const std::vector<input_trace_t> &inputs, int64_t duration_us)
+{
+    result_t res;
+    radio_model_t radio{cfg, {}};
+    app_sed_debounce_t db;
+    uint32_t levels = 0;
+    for (int i = 0; i < NUM_INPUTS; i++) {
+        levels |= (uint32_t)inputs[i].level_at(0) << i;
+    }
+    app_sed_debounce_init(&db, NUM_INPUTS, levels);
+
+    int64_t armed_at = 0;
+    while (true) {
+        int64_t wake = INT64_MAX;
+        for (int i = 0; i < NUM_INPUTS; i++) {
+            wake = std::min(wake, inputs[i].next_time_at_level(armed_at, app_sed_debounce_wake_level(&db, i)));
+        }
+        if (wake >= duration_us) {
+            break;
+        }
+        res.wake_windows++;
+        int64_t start = wake + cfg.wake_latency_us;
+        int64_t sample_at = start + cfg.debounce_us;
+        uint32_t sampled = 0;
+        for (int i = 0; i < NUM_INPUTS; i++) {
+            sampled |= (uint32_t)inputs[i].level_at(sample_at) << i;
+        }
+        uint32_t changed = app_sed_debounce_commit(&db, sampled);
+        int64_t end = sample_at;
+        if (changed) {
+            res.reported_changes += __builtin_popcount(changed);
+            res.report_messages++;
+            radio.reports.push_back(sample_at);
+            end = std::max(end, start + cfg.wake_window_us);
+        }
+        armed_at = end;
+    }
+    for (int i = 0; i < NUM_INPUTS; i++) {
+        if ((uint32_t)inputs[i].level_at(duration_us) != ((db.stable >> i) & 1)) {
+            res.final_state_ok = false;
+        }
+    }
+    // Every wake window costs one CPU wakeup, plus one per slow poll
+    res.cpu_wakeups = res.wake_windows + duration_us / cfg.slow_poll_us;
+    res.radio_on_us = radio.radio_on_us(duration_us);
+    return res;
+}
+
+// Always-on build: gpio_input_task samples every 50 ms without debounce
+static result_t run_polled(const sim_config_t &cfg, const std::vector<input_trace_t> &inputs, int64_t duration_us)
+{
+    result_t res;
+    radio_model_t radio{cfg, {}};
+    int last[NUM_INPUTS];
+    for (int i = 0; i < NUM_INPUTS; i++) {
+        last[i] = inputs[i].level_at(0);
+    }
+    for (int64_t t = cfg.legacy_poll_us; t < duration_us; t += cfg.legacy_poll_us) {
+        bool any = false;
+        for (int i = 0; i < NUM_INPUTS; i++) {
+            int level = inputs[i].level_at(t);
+            if (level != last[i]) {
+                last[i] = level;
+                res.reported_changes++;
+                any = true;
+            }
+        }
+        if (any) {
+            res.report_messages++;
+            radio.reports.push_back(t);
+        }
+        res.cpu_wakeups++;
+    }
+    for (int i = 0; i < NUM_INPUTS; i++) {
+        if (inputs[i].level_at(duration_us) != last[i]) {
+            res.final_state_ok = false;
+        }
+    }
+    res.cpu_wakeups += duration_us / cfg.slow_poll_us;
+    res.radio_on_us = radio.radio_on_us(duration_us);
+    return res;
+}
+
+static void print_result(const char *name, const result_t &res, const sim_config_t &cfg, int64_t duration_us)
+{
+    double hours = duration_us / 3600e6;
+    int64_t idle_radio_us = (duration_us / cfg.slow_poll_us) * cfg.poll_radio_us;
+    double per_event_ms = res.report_messages ?
+                          (res.radio_on_us - idle_radio_us) / 1000.0 / res.report_messages : 0.0;
+    printf("%-22s reports=%-6lld changes=%-6lld windows=%-6lld cpu_wakeups/h=%-8.0f "
+           "radio_on=%.3f%% radio_on/event=%.2f ms state=%s\n",
+           name, (long long)res.report_messages, (long long)res.reported_changes,
+           (long long)res.wake_windows, res.cpu_wakeups / hours,
+           100.0 * res.radio_on_us / duration_us, per_event_ms,
+           res.final_state_ok ? "ok" : "MISMATCH");
+}
+
+int main(int argc, char **argv)
+{
+    double hours = argc > 1 ? atof(argv[1]) : 24.0;
+    double events_per_hour = argc > 2 ? atof(argv[2]) : 6.0;
+    unsigned seed = argc > 3 ? (unsigned)atoi(argv[3]) : 1;
+    int64_t duration_us = (int64_t)(hours * 3600e6);
+    sim_config_t cfg;
+
+    std::mt19937 rng(seed);
+    std::vector<input_trace_t> inputs(NUM_INPUTS);
+    int real = 0;
+    int glitches = 0;
+    for (auto &in : inputs) {
+        generate_trace(in, duration_us, events_per_hour, rng);
+        real += in.real_changes;
+        glitches += in.glitches;
+    }
+
+    printf("Simulated %.1f h, %d inputs, %d real edges, %d glitches\n", hours, NUM_INPUTS, real, glitches);
+    printf("Always-on FTD          radio_on=100.000%%\n");
+    result_t polled = run_polled(cfg, inputs, duration_us);
+    result_t wakeup = run_wakeup(cfg, inputs, duration_us);
+    print_result("SED + 50ms polling", polled, cfg, duration_us);
+    print_result("SED + GPIO wakeup", wakeup, cfg, duration_us);
+
+    printf("GPIO wakeup: %lld wake windows = %lld with report + %lld filtered glitches, "
+           "polling: %lld duplicate reports from bounce\n",
+           (long long)wakeup.wake_windows, (long long)wakeup.report_messages,
+           (long long)(wakeup.wake_windows - wakeup.report_messages),
+           (long long)(polled.reported_changes - real));
+
+    // Every real edge must be reported exactly once, glitches never
+    if (!wakeup.final_state_ok || wakeup.reported_changes != real) {
+        printf("FAIL: reported %lld changes for %d real edges\n", (long long)wakeup.reported_changes, real);
+        return 1;
+    }
+    return 0;
+}
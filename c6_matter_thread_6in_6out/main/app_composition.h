@@ -0,0 +1,52 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Composizione del data model Matter descritta a compile-time.
+// La tabella (k_app_composition in app_main.cpp) elenca gli endpoint nell'ordine
+// di creazione, quindi anche gli endpoint ID assegnati: non riordinare le voci
+// su dispositivi gia' commissionati.
+
+enum class app_endpoint_kind_t : uint8_t {
+    input,      // Contact Sensor (BooleanState)
+    output,     // On/Off Light
+    antenna,    // On/Off Light virtuale per la selezione antenna
+};
+
+struct app_endpoint_desc_t {
+    app_endpoint_kind_t kind;
+    uint8_t channel;        // Indice in input_pins / output_pins
+    bool initial_state;     // StateValue (input) o OnOff (output, antenna)
+};
+
+template <size_t N>
+constexpr size_t app_composition_count(const app_endpoint_desc_t (&composition)[N], app_endpoint_kind_t kind)
+{
+    size_t count = 0;
+    for (size_t i = 0; i < N; i++) {
+        if (composition[i].kind == kind) {
+            count++;
+        }
+    }
+    return count;
+}
+
+// Every channel of a kind must appear exactly once, numbered 0..count-1
+template <size_t N>
+constexpr bool app_composition_channels_valid(const app_endpoint_desc_t (&composition)[N], app_endpoint_kind_t kind)
+{
+    size_t count = app_composition_count(composition, kind);
+    for (size_t i = 0; i < N; i++) {
+        if (composition[i].kind == kind && composition[i].channel >= count) {
+            return false;
+        }
+        for (size_t j = i + 1; j < N; j++) {
+            if (composition[i].kind == kind && composition[j].kind == kind &&
+                composition[i].channel == composition[j].channel) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
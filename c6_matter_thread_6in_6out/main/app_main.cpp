@@ -15,6 +15,11 @@
  * - GPIO 3: RF switch enable (LOW to activate)
  * - GPIO 14: Antenna selection (LOW=internal, HIGH=external)
  * - Matter Control: Virtual On/Off endpoint (ON=External, OFF=Internal)
+ *
+ * Sleepy End Device variant (CONFIG_APP_SLEEPY_END_DEVICE):
+ * - Inputs only: no output endpoints, no status LED
+ * - Thread SED with ICD polling, automatic light sleep between events
+ * - Inputs wake the chip through GPIO wakeup (see app_sed.cpp)
  */
 
 #include <esp_err.h>
@@ -29,8 +34,13 @@
 
 #include <app_priv.h>
 #include <app_reset.h>
+#include <app_composition.h>
 #include <driver/gpio.h>
 
+#if CONFIG_APP_SLEEPY_END_DEVICE
+#include <app_sed.h>
+#endif
+
 #if CHIP_DEVICE_CONFIG_ENABLE_THREAD
 #include <platform/ESP32/OpenthreadLauncher.h>
 #include <common/Esp32ThreadInit.h>
@@ -75,18 +85,53 @@ using namespace esp_matter::attribute;
 using namespace esp_matter::endpoint;
 using namespace chip::app::Clusters;
 
+// Device composition: one entry per Matter endpoint, in creation (= endpoint ID) order
+static constexpr app_endpoint_desc_t k_app_composition[] = {
+    // 4 Inputs (Contact Sensors) - initial state closed (HIGH with pull-up, inverted)
+    {app_endpoint_kind_t::input, 0, false},
+    {app_endpoint_kind_t::input, 1, false},
+    {app_endpoint_kind_t::input, 2, false},
+    {app_endpoint_kind_t::input, 3, false},
+#if !CONFIG_APP_SLEEPY_END_DEVICE
+    // 4 Outputs (On/Off Lights) - initial state OFF, not exposed by the sleepy end device
+    {app_endpoint_kind_t::output, 0, false},
+    {app_endpoint_kind_t::output, 1, false},
+    {app_endpoint_kind_t::output, 2, false},
+    {app_endpoint_kind_t::output, 3, false},
+#endif
+    // Antenna control (virtual switch) - ON=External, OFF=Internal
+    {app_endpoint_kind_t::antenna, 0, USE_EXTERNAL_ANTENNA},
+};
+
+static constexpr size_t k_num_inputs = app_composition_count(k_app_composition, app_endpoint_kind_t::input);
+static constexpr size_t k_num_outputs = app_composition_count(k_app_composition, app_endpoint_kind_t::output);
+#if CONFIG_APP_SLEEPY_END_DEVICE
+static_assert(k_num_inputs == 4 && k_num_outputs == 0, "Sleepy end device: 4 inputs and no outputs");
+#else
+static_assert(k_num_inputs == 4 && k_num_outputs == 4, "GPIO tables below expect 4 inputs and 4 outputs");
+#endif
+static_assert(app_composition_count(k_app_composition, app_endpoint_kind_t::antenna) == 1,
+              "Exactly one antenna control endpoint");
+static_assert(app_composition_channels_valid(k_app_composition, app_endpoint_kind_t::input) &&
+              app_composition_channels_valid(k_app_composition, app_endpoint_kind_t::output),
+              "Each input/output channel must appear exactly once");
+
+#if !CONFIG_APP_SLEEPY_END_DEVICE
 // Endpoint IDs for 4 outputs
-static uint16_t output_endpoint_ids[4] = {0, 0, 0, 0};
+static uint16_t output_endpoint_ids[k_num_outputs] = {0, 0, 0, 0};
+#endif
 
 // Endpoint IDs for 4 inputs
-static uint16_t input_endpoint_ids[4] = {0, 0, 0, 0};
+static uint16_t input_endpoint_ids[k_num_inputs] = {0, 0, 0, 0};
 
 // Endpoint ID for antenna control (virtual switch)
 static uint16_t antenna_endpoint_id = 0;
 
 // GPIO pins arrays
-static const gpio_num_t input_pins[4] = {GPIO_INPUT_0, GPIO_INPUT_1, GPIO_INPUT_2, GPIO_INPUT_3};
-static const gpio_num_t output_pins[4] = {GPIO_OUTPUT_0, GPIO_OUTPUT_1, GPIO_OUTPUT_2, GPIO_OUTPUT_3};
+static const gpio_num_t input_pins[k_num_inputs] = {GPIO_INPUT_0, GPIO_INPUT_1, GPIO_INPUT_2, GPIO_INPUT_3};
+#if !CONFIG_APP_SLEEPY_END_DEVICE
+static const gpio_num_t output_pins[k_num_outputs] = {GPIO_OUTPUT_0, GPIO_OUTPUT_1, GPIO_OUTPUT_2, GPIO_OUTPUT_3};
+#endif
 
 // Configure antenna selection for XIAO ESP32C6
 static void configure_antenna(void)
@@ -177,15 +222,17 @@ static esp_err_t app_attribute_update_cb(attribute::callback_type_t type,
     if (type == POST_UPDATE) {
         // Check if it's an OnOff cluster update
         if (cluster_id == OnOff::Id && attribute_id == OnOff::Attributes::OnOff::Id) {
+#if !CONFIG_APP_SLEEPY_END_DEVICE
             // Check which output endpoint it is
-            for (int i = 0; i < 4; i++) {
+            for (size_t i = 0; i < k_num_outputs; i++) {
                 if (endpoint_id == output_endpoint_ids[i]) {
                     gpio_set_level(output_pins[i], val->val.b ? 1 : 0);
-                    ESP_LOGI(TAG, "Output %d (GPIO%d) set to %s", i + 1, output_pins[i],
+                    ESP_LOGI(TAG, "Output %d (GPIO%d) set to %s", (int)i + 1, output_pins[i],
                              val->val.b ? "ON" : "OFF");
                     break;
                 }
             }
+#endif
 
             // Check if it's the antenna control endpoint
             if (endpoint_id == antenna_endpoint_id) {
@@ -205,13 +252,42 @@ static esp_err_t app_identification_cb(identification::callback_type_t type,
     return ESP_OK;
 }
 
+// Report an input level change via Matter
+// Shared by the polling task and the sleepy end-device wake handler
+static void report_input_state(int i, bool current_state)
+{
+    // Invert logic: HIGH (pull-up open) = false (closed), LOW (contact) = true (open)
+    bool inverted_state = !current_state;
+
+    ESP_LOGI(TAG, "Input %d (GPIO%d) changed to %s", i + 1, input_pins[i],
+             inverted_state ? "OPEN" : "CLOSED");
+
+    // Update Matter Boolean State attribute
+    node_t *node = node::get();
+    endpoint_t *endpoint = endpoint::get(node, input_endpoint_ids[i]);
+
+    // Use BooleanState cluster to report contact sensor state
+    // StateValue inverted: HIGH (open physically) = false (closed in Matter)
+    cluster_t *cluster = cluster::get(endpoint, BooleanState::Id);
+    if (cluster) {
+        attribute_t *attribute = attribute::get(cluster, BooleanState::Attributes::StateValue::Id);
+        if (attribute) {
+            esp_matter_attr_val_t val;
+            val.type = ESP_MATTER_VAL_TYPE_BOOLEAN;
+            val.val.b = inverted_state;  // Inverted: LOW = true (open), HIGH = false (closed)
+            attribute::update(input_endpoint_ids[i], BooleanState::Id,
+                             BooleanState::Attributes::StateValue::Id, &val);
+        }
+    }
+}
+
+#if !CONFIG_APP_SLEEPY_END_DEVICE
 // GPIO input monitoring task
 // Monitors 4 independent inputs and reports state changes via Matter
 static void gpio_input_task(void *arg)
 {
     bool last_states[4] = {true, true, true, true};  // Assume pull-up, initial HIGH
     bool current_state;
-    bool inverted_state;
 
     while (1) {
         // Monitor all 4 inputs
@@ -220,30 +296,7 @@ static void gpio_input_task(void *arg)
 
             // Detect state change
             if (current_state != last_states[i]) {
-                // Invert logic: HIGH (pull-up open) = false (closed), LOW (contact) = true (open)
-                inverted_state = !current_state;
-
-                ESP_LOGI(TAG, "Input %d (GPIO%d) changed to %s", i + 1, input_pins[i],
-                         inverted_state ? "OPEN" : "CLOSED");
-
-                // Update Matter Boolean State attribute
-                node_t *node = node::get();
-                endpoint_t *endpoint = endpoint::get(node, input_endpoint_ids[i]);
-
-                // Use BooleanState cluster to report contact sensor state
-                // StateValue inverted: HIGH (open physically) = false (closed in Matter)
-                cluster_t *cluster = cluster::get(endpoint, BooleanState::Id);
-                if (cluster) {
-                    attribute_t *attribute = attribute::get(cluster, BooleanState::Attributes::StateValue::Id);
-                    if (attribute) {
-                        esp_matter_attr_val_t val;
-                        val.type = ESP_MATTER_VAL_TYPE_BOOLEAN;
-                        val.val.b = inverted_state;  // Inverted: LOW = true (open), HIGH = false (closed)
-                        attribute::update(input_endpoint_ids[i], BooleanState::Id,
-                                         BooleanState::Attributes::StateValue::Id, &val);
-                    }
-                }
-
+                report_input_state(i, current_state);
                 last_states[i] = current_state;
             }
         }
@@ -251,8 +304,9 @@ static void gpio_input_task(void *arg)
         vTaskDelay(pdMS_TO_TICKS(50));  // 50ms polling interval with debounce
     }
 }
+#endif // !CONFIG_APP_SLEEPY_END_DEVICE
 
-#if CHIP_DEVICE_CONFIG_ENABLE_THREAD
+#if CHIP_DEVICE_CONFIG_ENABLE_THREAD && !CONFIG_APP_SLEEPY_END_DEVICE
 // Thread role monitoring task - Controls status LED
 // LED patterns indicate Thread device role in mesh network
 static void thread_status_led_task(void *arg)
@@ -333,7 +387,65 @@ static void thread_status_led_task(void *arg)
         }
     }
 }
-#endif // CHIP_DEVICE_CONFIG_ENABLE_THREAD
+#endif // CHIP_DEVICE_CONFIG_ENABLE_THREAD && !CONFIG_APP_SLEEPY_END_DEVICE
+
+// Create the endpoints of k_app_composition in a single pass, endpoint IDs follow the table order
+static esp_err_t create_endpoints(node_t *node)
+{
+    for (const app_endpoint_desc_t &desc : k_app_composition) {
+        endpoint_t *ep = nullptr;
+
+        switch (desc.kind) {
+            case app_endpoint_kind_t::input: {
+                contact_sensor::config_t sensor_config;
+                // With pull-up: HIGH=open, we report as false (contact/closed)
+                sensor_config.boolean_state.state_value = desc.initial_state;
+                ep = contact_sensor::create(node, &sensor_config, ENDPOINT_FLAG_NONE, NULL);
+                if (!ep) {
+                    ESP_LOGE(TAG, "Failed to create input endpoint %d", desc.channel + 1);
+                    return ESP_FAIL;
+                }
+                input_endpoint_ids[desc.channel] = endpoint::get_id(ep);
+                ESP_LOGI(TAG, "Input %d (GPIO%d) endpoint created with id %u",
+                         desc.channel + 1, input_pins[desc.channel], input_endpoint_ids[desc.channel]);
+                break;
+            }
+
+            case app_endpoint_kind_t::output: {
+#if !CONFIG_APP_SLEEPY_END_DEVICE   // the sleepy end device table has no outputs
+                on_off_light::config_t light_config;
+                light_config.on_off.on_off = desc.initial_state;
+                light_config.on_off_lighting.start_up_on_off = nullptr;
+                ep = on_off_light::create(node, &light_config, ENDPOINT_FLAG_NONE, NULL);
+                if (!ep) {
+                    ESP_LOGE(TAG, "Failed to create output endpoint %d", desc.channel + 1);
+                    return ESP_FAIL;
+                }
+                output_endpoint_ids[desc.channel] = endpoint::get_id(ep);
+                ESP_LOGI(TAG, "Output %d (GPIO%d) endpoint created with id %u",
+                         desc.channel + 1, output_pins[desc.channel], output_endpoint_ids[desc.channel]);
+#endif
+                break;
+            }
+
+            case app_endpoint_kind_t::antenna: {
+                on_off_light::config_t antenna_config;
+                antenna_config.on_off.on_off = desc.initial_state;
+                antenna_config.on_off_lighting.start_up_on_off = nullptr;
+                ep = on_off_light::create(node, &antenna_config, ENDPOINT_FLAG_NONE, NULL);
+                if (!ep) {
+                    ESP_LOGE(TAG, "Failed to create antenna control endpoint");
+                    return ESP_FAIL;
+                }
+                antenna_endpoint_id = endpoint::get_id(ep);
+                ESP_LOGI(TAG, "Antenna Control endpoint created with id %u (ON=External, OFF=Internal)",
+                         antenna_endpoint_id);
+                break;
+            }
+        }
+    }
+    return ESP_OK;
+}
 
 extern "C" void app_main()
 {
@@ -347,6 +459,23 @@ extern "C" void app_main()
     }
     ESP_ERROR_CHECK(err);
 
+    // Build the data model first, in one pass from k_app_composition
+    node::config_t node_config;
+    node_t *node = node::create(&node_config, app_attribute_update_cb, app_identification_cb);
+    if (!node) {
+        ESP_LOGE(TAG, "Failed to create Matter node");
+        return;
+    }
+
+    ESP_LOGI(TAG, "Creating Matter endpoints...");
+
+    err = create_endpoints(node);
+    if (err != ESP_OK) {
+        return;
+    }
+
+    ESP_LOGI(TAG, "All Matter endpoints created successfully");
+
     // Set custom Vendor Name and Product Name in NVS BEFORE Matter starts
     const char *vendor_name = "VicinoDiCasaDigitale";
     const char *product_name = "Matter Thread 6in/6out";
@@ -364,6 +493,7 @@ extern "C" void app_main()
     // Configure GPIOs
     gpio_config_t io_conf = {};
 
+#if !CONFIG_APP_SLEEPY_END_DEVICE
     // Configure 4 outputs (D4-D7)
     io_conf.intr_type = GPIO_INTR_DISABLE;
     io_conf.mode = GPIO_MODE_OUTPUT;
@@ -374,9 +504,10 @@ extern "C" void app_main()
     gpio_config(&io_conf);
 
     // Initialize all outputs to LOW
-    for (int i = 0; i < 4; i++) {
+    for (size_t i = 0; i < k_num_outputs; i++) {
         gpio_set_level(output_pins[i], 0);
     }
+#endif
 
     // Configure 4 inputs (D0-D3)
     io_conf.intr_type = GPIO_INTR_DISABLE;
@@ -387,6 +518,7 @@ extern "C" void app_main()
     io_conf.pull_down_en = GPIO_PULLDOWN_DISABLE;
     gpio_config(&io_conf);
 
+#if !CONFIG_APP_SLEEPY_END_DEVICE
     // Configure Status LED (USER LED on GPIO15)
     io_conf.intr_type = GPIO_INTR_DISABLE;
     io_conf.mode = GPIO_MODE_OUTPUT;
@@ -402,66 +534,11 @@ extern "C" void app_main()
     ESP_LOGI(TAG, "  Outputs: GPIO%d, %d, %d, %d",
              GPIO_OUTPUT_0, GPIO_OUTPUT_1, GPIO_OUTPUT_2, GPIO_OUTPUT_3);
     ESP_LOGI(TAG, "  Status LED: GPIO%d (Thread role indicator)", GPIO_STATUS_LED);
-
-    // Create Matter node
-    node::config_t node_config;
-    node_t *node = node::create(&node_config, app_attribute_update_cb, app_identification_cb);
-    if (!node) {
-        ESP_LOGE(TAG, "Failed to create Matter node");
-        return;
-    }
-
-    ESP_LOGI(TAG, "Creating Matter endpoints...");
-
-    // Create 4 Input Endpoints (Contact Sensors)
-    for (int i = 0; i < 4; i++) {
-        contact_sensor::config_t sensor_config;
-        // With pull-up: HIGH=open, we report as false (contact/closed)
-        sensor_config.boolean_state.state_value = false;  // Initial state: closed (HIGH with pull-up inverted)
-
-        endpoint_t *input_endpoint = contact_sensor::create(node, &sensor_config, ENDPOINT_FLAG_NONE, NULL);
-        if (!input_endpoint) {
-            ESP_LOGE(TAG, "Failed to create input endpoint %d", i + 1);
-            return;
-        }
-
-        input_endpoint_ids[i] = endpoint::get_id(input_endpoint);
-        ESP_LOGI(TAG, "Input %d (GPIO%d) endpoint created with id %u",
-                 i + 1, input_pins[i], input_endpoint_ids[i]);
-    }
-
-    // Create 4 Output Endpoints (On/Off Lights)
-    for (int i = 0; i < 4; i++) {
-        on_off_light::config_t light_config;
-        light_config.on_off.on_off = false;  // Initial state: OFF
-        light_config.on_off_lighting.start_up_on_off = nullptr;
-
-        endpoint_t *output_endpoint = on_off_light::create(node, &light_config, ENDPOINT_FLAG_NONE, NULL);
-        if (!output_endpoint) {
-            ESP_LOGE(TAG, "Failed to create output endpoint %d", i + 1);
-            return;
-        }
-
-        output_endpoint_ids[i] = endpoint::get_id(output_endpoint);
-        ESP_LOGI(TAG, "Output %d (GPIO%d) endpoint created with id %u",
-                 i + 1, output_pins[i], output_endpoint_ids[i]);
-    }
-
-    // Create Antenna Control Endpoint (Virtual Switch)
-    on_off_light::config_t antenna_config;
-    antenna_config.on_off.on_off = USE_EXTERNAL_ANTENNA;  // Initial state based on define
-    antenna_config.on_off_lighting.start_up_on_off = nullptr;
-
-    endpoint_t *antenna_endpoint = on_off_light::create(node, &antenna_config, ENDPOINT_FLAG_NONE, NULL);
-    if (!antenna_endpoint) {
-        ESP_LOGE(TAG, "Failed to create antenna control endpoint");
-        return;
-    }
-
-    antenna_endpoint_id = endpoint::get_id(antenna_endpoint);
-    ESP_LOGI(TAG, "Antenna Control endpoint created with id %u (ON=External, OFF=Internal)", antenna_endpoint_id);
-
-    ESP_LOGI(TAG, "All Matter endpoints created successfully");
+#else
+    ESP_LOGI(TAG, "GPIOs configured (sleepy end device, inputs only):");
+    ESP_LOGI(TAG, "  Inputs: GPIO%d, %d, %d, %d",
+             GPIO_INPUT_0, GPIO_INPUT_1, GPIO_INPUT_2, GPIO_INPUT_3);
+#endif
 
     // Setup reset button handler
     app_reset_button_register(app_reset_to_factory);
@@ -476,6 +553,11 @@ extern "C" void app_main()
     set_openthread_platform_config(&config);
 #endif
 
+#if CONFIG_APP_SLEEPY_END_DEVICE
+    // Light sleep between events, the radio follows the ICD poll period
+    app_sed_power_init();
+#endif
+
     // Start Matter
     err = esp_matter::start(app_event_cb);
     if (err != ESP_OK) {
@@ -513,12 +595,20 @@ extern "C" void app_main()
     ESP_LOGI(TAG, "====================================");
     ESP_LOGI(TAG, "");
 
+#if CONFIG_APP_SLEEPY_END_DEVICE
+    // Inputs wake the chip through GPIO wakeup, no polling task
+    err = app_sed_inputs_start(input_pins, k_num_inputs, report_input_state);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to start sleepy input handling: %s", esp_err_to_name(err));
+    }
+#else
     // Start GPIO input monitoring task
     xTaskCreate(gpio_input_task, "gpio_input", 4096, NULL, 5, NULL);
 
 #if CHIP_DEVICE_CONFIG_ENABLE_THREAD
     // Start Thread status LED monitoring task
     xTaskCreate(thread_status_led_task, "thread_led", 4096, NULL, 5, NULL);
+#endif
 #endif
 
     ESP_LOGI(TAG, "");
@@ -527,10 +617,15 @@ extern "C" void app_main()
     ESP_LOGI(TAG, "====================================");
     ESP_LOGI(TAG, "Configuration:");
     ESP_LOGI(TAG, "  - 4 Input Sensors: GPIO 0,1,2,21");
+#if CONFIG_APP_SLEEPY_END_DEVICE
+    ESP_LOGI(TAG, "  - 1 Antenna Control: Virtual (ON=Ext, OFF=Int)");
+    ESP_LOGI(TAG, "  - Protocol: Matter over Thread (Sleepy End Device)");
+#else
     ESP_LOGI(TAG, "  - 4 Output Controls: GPIO 22,23,19,20");
     ESP_LOGI(TAG, "  - 1 Antenna Control: Virtual (ON=Ext, OFF=Int)");
     ESP_LOGI(TAG, "  - Status LED: GPIO 15 (Thread role indicator)");
     ESP_LOGI(TAG, "  - Protocol: Matter over Thread");
+#endif
     ESP_LOGI(TAG, "====================================");
     ESP_LOGI(TAG, "");
 }
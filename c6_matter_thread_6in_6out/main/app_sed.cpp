@@ -0,0 +1,169 @@
+#include "app_sed.h"
+#include "app_sed_debounce.h"
+#include <sdkconfig.h>
+
+#if CONFIG_APP_SLEEPY_END_DEVICE
+
+#include <esp_log.h>
+#include <esp_attr.h>
+#include <esp_timer.h>
+#include <inttypes.h>
+#include <esp_pm.h>
+#include <esp_sleep.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+static const char *TAG = "app_sed";
+
+static gpio_num_t s_pins[APP_SED_MAX_INPUTS];
+static uint8_t s_num_pins = 0;
+static app_sed_report_cb_t s_report_cb = NULL;
+static app_sed_debounce_t s_debounce;
+static TaskHandle_t s_input_task = NULL;
+static esp_pm_lock_handle_t s_wake_lock = NULL;
+
+esp_err_t app_sed_power_init(void)
+{
+#if CONFIG_PM_ENABLE
+    esp_pm_config_t pm_config = {};
+    pm_config.max_freq_mhz = CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ;
+    pm_config.min_freq_mhz = CONFIG_XTAL_FREQ;
+#if CONFIG_FREERTOS_USE_TICKLESS_IDLE
+    pm_config.light_sleep_enable = true;
+#endif
+    esp_err_t err = esp_pm_configure(&pm_config);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Power management configuration failed: %s", esp_err_to_name(err));
+        return err;
+    }
+    ESP_LOGI(TAG, "Automatic light sleep enabled (%d-%d MHz)", pm_config.min_freq_mhz, pm_config.max_freq_mhz);
+    return ESP_OK;
+#else
+    ESP_LOGW(TAG, "CONFIG_PM_ENABLE not set, light sleep disabled");
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+static uint32_t read_inputs(void)
+{
+    uint32_t levels = 0;
+    for (int i = 0; i < s_num_pins; i++) {
+        if (gpio_get_level(s_pins[i])) {
+            levels |= (1UL << i);
+        }
+    }
+    return levels;
+}
+
+// Arm every input on the level opposite to its debounced state, so the next
+// real edge both wakes the chip from light sleep and raises the ISR
+static void arm_inputs(void)
+{
+    for (int i = 0; i < s_num_pins; i++) {
+        int level = app_sed_debounce_wake_level(&s_debounce, i);
+        gpio_wakeup_enable(s_pins[i], level ? GPIO_INTR_HIGH_LEVEL : GPIO_INTR_LOW_LEVEL);
+        gpio_intr_enable(s_pins[i]);
+    }
+}
+
+static void IRAM_ATTR input_isr_handler(void *arg)
+{
+    uint32_t index = (uint32_t)(uintptr_t)arg;
+    BaseType_t higher_prio_woken = pdFALSE;
+
+    // Level interrupt: mask the pin until the wake window re-arms it,
+    // contact bounce must not open further windows
+    gpio_intr_disable(s_pins[index]);
+    xTaskNotifyFromISR(s_input_task, (1UL << index), eSetBits, &higher_prio_woken);
+    portYIELD_FROM_ISR(higher_prio_woken);
+}
+
+// Input task for the sleepy variant
+// Every wakeup opens a single wake window: debounce, sample, report, re-arm
+static void sed_input_task(void *arg)
+{
+    uint32_t pending;
+
+    while (1) {
+        xTaskNotifyWait(0, UINT32_MAX, &pending, portMAX_DELAY);
+
+        // Keep the chip out of light sleep for the whole window
+        esp_pm_lock_acquire(s_wake_lock);
+        int64_t window_start = esp_timer_get_time();
+
+        vTaskDelay(pdMS_TO_TICKS(CONFIG_APP_SED_DEBOUNCE_MS));
+
+        uint32_t changed = app_sed_debounce_commit(&s_debounce, read_inputs());
+        for (int i = 0; i < s_num_pins; i++) {
+            if (changed & (1UL << i)) {
+                s_report_cb(i, (s_debounce.stable >> i) & 1);
+            }
+        }
+        if (!changed) {
+            ESP_LOGD(TAG, "Glitch on inputs 0x%02" PRIx32 " filtered", pending);
+        }
+
+        // Give the reporting engine the rest of the window to push the report
+        // out on the radio before the chip may sleep again
+        if (changed) {
+            int64_t elapsed_ms = (esp_timer_get_time() - window_start) / 1000;
+            if (elapsed_ms < CONFIG_APP_SED_WAKE_WINDOW_MS) {
+                vTaskDelay(pdMS_TO_TICKS(CONFIG_APP_SED_WAKE_WINDOW_MS - elapsed_ms));
+            }
+        }
+
+        // Bits raised by masked pins during the window are stale: the level
+        // interrupts re-fire on arm if an input is still on its wake level
+        xTaskNotifyStateClear(NULL);
+        ulTaskNotifyValueClear(NULL, UINT32_MAX);
+        arm_inputs();
+        esp_pm_lock_release(s_wake_lock);
+    }
+}
+
+esp_err_t app_sed_inputs_start(const gpio_num_t *pins, uint8_t num_pins, app_sed_report_cb_t callback)
+{
+    if (!pins || !callback || num_pins == 0 || num_pins > APP_SED_MAX_INPUTS) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    for (int i = 0; i < num_pins; i++) {
+        s_pins[i] = pins[i];
+    }
+    s_num_pins = num_pins;
+    s_report_cb = callback;
+    app_sed_debounce_init(&s_debounce, num_pins, read_inputs());
+
+    esp_err_t err = esp_pm_lock_create(ESP_PM_NO_LIGHT_SLEEP, 0, "sed_input", &s_wake_lock);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to create PM lock: %s", esp_err_to_name(err));
+        return err;
+    }
+
+    if (xTaskCreate(sed_input_task, "sed_input", 4096, NULL, 5, &s_input_task) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create input task");
+        return ESP_ERR_NO_MEM;
+    }
+
+    err = gpio_install_isr_service(0);
+    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+        ESP_LOGE(TAG, "Failed to install GPIO ISR service: %s", esp_err_to_name(err));
+        return err;
+    }
+    for (int i = 0; i < num_pins; i++) {
+        gpio_isr_handler_add(s_pins[i], input_isr_handler, (void *)(uintptr_t)i);
+    }
+    arm_inputs();
+
+    err = esp_sleep_enable_gpio_wakeup();
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to enable GPIO wakeup: %s", esp_err_to_name(err));
+        return err;
+    }
+
+    ESP_LOGI(TAG, "GPIO wakeup armed on %d inputs (debounce %d ms, wake window %d ms)",
+             num_pins, CONFIG_APP_SED_DEBOUNCE_MS, CONFIG_APP_SED_WAKE_WINDOW_MS);
+    return ESP_OK;
+}
+
+#endif // CONFIG_APP_SLEEPY_END_DEVICE
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <esp_err.h>
+#include <driver/gpio.h>
+
+// Callback invocato per ogni ingresso il cui livello debounced e' cambiato
+typedef void (*app_sed_report_cb_t)(int index, bool level);
+
+// Abilita il light-sleep automatico (power management + tickless idle)
+esp_err_t app_sed_power_init(void);
+
+// Configura gli ingressi come sorgenti di GPIO wakeup e avvia il task che
+// esegue debounce e report in un'unica finestra di veglia per ogni fronte
+esp_err_t app_sed_inputs_start(const gpio_num_t *pins, uint8_t num_pins, app_sed_report_cb_t callback);
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <stdint.h>
+
+// Debounce degli ingressi per la variante Sleepy End Device.
+// Nessuna dipendenza da ESP-IDF: lo stesso codice gira nel firmware
+// (app_sed.cpp) e nella simulazione host (host_sim/sed_sim.cpp).
+//
+// Una sola finestra di veglia per fronte:
+//   1. Il pin raggiunge il livello di wakeup armato -> GPIO wakeup + ISR;
+//      la ISR maschera il pin, cosi' i rimbalzi non aprono altre finestre.
+//   2. Dopo il tempo di debounce tutti gli ingressi vengono campionati una
+//      volta e confrontati con l'ultimo livello riportato (stabile).
+//   3. Ogni pin viene riarmato sul livello opposto al nuovo livello stabile.
+
+#define APP_SED_MAX_INPUTS 8
+
+typedef struct {
+    uint32_t stable;     // Ultimo livello riportato (bit i = ingresso i)
+    uint8_t  num_inputs;
+} app_sed_debounce_t;
+
+static inline void app_sed_debounce_init(app_sed_debounce_t *db, uint8_t num_inputs, uint32_t initial_levels)
+{
+    db->num_inputs = num_inputs;
+    db->stable = initial_levels & ((1UL << num_inputs) - 1);
+}
+
+// Registra i livelli campionati alla fine del debounce.
+// Ritorna la maschera degli ingressi cambiati da riportare via Matter.
+static inline uint32_t app_sed_debounce_commit(app_sed_debounce_t *db, uint32_t sampled_levels)
+{
+    uint32_t mask = (1UL << db->num_inputs) - 1;
+    uint32_t changed = (sampled_levels ^ db->stable) & mask;
+    db->stable = sampled_levels & mask;
+    return changed;
+}
+
+// Livello che deve risvegliare il chip per l'ingresso i (opposto allo stabile)
+static inline int app_sed_debounce_wake_level(const app_sed_debounce_t *db, uint8_t i)
+{
+    return (db->stable & (1UL << i)) ? 0 : 1;
+}
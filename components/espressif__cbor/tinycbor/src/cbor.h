@@ -595,6 +595,28 @@ CBOR_INLINE_API CborError cbor_value_get_map_length(const CborValue *value, size
 
 CBOR_API CborError cbor_value_map_find_value(const CborValue *map, const char *string, CborValue *element);
 
+struct CborMapIndexEntry
+{
+    uint32_t hash;              /* 0 for an empty slot */
+    uint32_t key;               /* offsets from the map */
+    uint32_t value;
+    uint32_t remaining;
+};
+typedef struct CborMapIndexEntry CborMapIndexEntry;
+
+struct CborMapIndex
+{
+    CborValue map;
+    CborMapIndexEntry *entries;
+    size_t size;
+    size_t count;
+    uint8_t valueFlags;
+};
+typedef struct CborMapIndex CborMapIndex;
+
+CBOR_API CborError cbor_value_map_index(const CborValue *map, CborMapIndex *index, CborMapIndexEntry *entries, size_t size);
+CBOR_API CborError cbor_map_index_find_value(const CborMapIndex *index, const char *string, CborValue *element);
+
 /* Floating point */
 CBOR_INLINE_API bool cbor_value_is_half_float(const CborValue *value)
 { return value->type == CborHalfFloatType; }
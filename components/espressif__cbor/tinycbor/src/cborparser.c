@@ -1456,6 +1456,188 @@ error:
     return err;
 }
 
+static uint32_t map_index_hash(uint32_t hash, const uint8_t *data, size_t len)
+{
+    /* FNV-1a */
+    while (len--)
+        hash = (hash ^ *data++) * 16777619U;
+    return hash;
+}
+
+static CborError map_index_hash_string(CborValue *it, uint32_t *hash)
+{
+    CborError err;
+    const void *ptr;
+    size_t len;
+    uint32_t h = 2166136261U;
+
+    err = _cbor_value_begin_string_iteration(it);
+    if (err)
+        return err;
+    while ((err = get_string_chunk(it, &ptr, &len)) == CborNoError)
+        h = map_index_hash(h, (const uint8_t *)ptr, len);
+    if (err != CborErrorNoMoreStringChunks)
+        return err;
+
+    *hash = h ? h : 1;      /* 0 marks the empty slots */
+    return _cbor_value_finish_string_iteration(it);
+}
+
+static CborError map_index_element(const CborMapIndex *index, uint32_t offset, uint32_t remaining,
+                                   uint8_t flags, CborValue *element)
+{
+    element->parser = index->map.parser;
+    element->source.ptr = index->map.source.ptr + offset;
+    element->remaining = remaining;
+    element->extra = 0;
+    element->flags = flags;
+    return preparse_value(element);
+}
+
+/**
+ * \struct CborMapIndex
+ *
+ * This type holds the text string keys of a CBOR map, so that
+ * cbor_map_index_find_value() finds their values without walking the map
+ * again. It is filled by cbor_value_map_index() into an array of
+ * CborMapIndexEntry provided by the caller.
+ *
+ * \sa cbor_value_map_index(), cbor_map_index_find_value()
+ */
+
+/**
+ * Walks the map \a map once and records the hash of each text string key,
+ * with the position of its value, in the \a size entries of \a entries. If the
+ * iterator \a map does not point to a CBOR map, the behaviour is undefined,
+ * so checking with \ref cbor_value_get_type or \ref cbor_value_is_map is
+ * recommended.
+ *
+ * The entries form a hash table: \a size must be a power of 2 larger than the
+ * number of text string keys in the map, twice that number keeps the lookups
+ * short. If the map has more keys, this function returns \ref
+ * CborErrorOutOfMemory. Keys of other types are skipped, as
+ * cbor_value_map_find_value() does. The \a index refers to the buffer of the
+ * parser and to \a entries, which have to stay valid while it is used. Parsers
+ * reading through a CborParserOperations reader are not supported and return
+ * \ref CborErrorUnsupportedType.
+ *
+ * This function has a time complexity of O(n) where n is the number of
+ * elements in the map, and the memory requirements of
+ * cbor_value_map_find_value().
+ *
+ * \sa cbor_map_index_find_value(), cbor_value_map_find_value()
+ */
+CborError cbor_value_map_index(const CborValue *map, CborMapIndex *index, CborMapIndexEntry *entries, size_t size)
+{
+    CborError err;
+    CborValue element;
+    cbor_assert(cbor_value_is_map(map));
+    cbor_assert(size && (size & (size - 1)) == 0);
+
+    index->map = *map;
+    index->entries = entries;
+    index->size = size;
+    index->count = 0;
+    index->valueFlags = 0;
+    memset(entries, 0, size * sizeof(*entries));
+    if (CBOR_PARSER_READER_CONTROL >= 0 &&
+            (map->parser->flags & CborParserFlag_ExternalSource || CBOR_PARSER_READER_CONTROL != 0))
+        return CborErrorUnsupportedType;
+
+    err = cbor_value_enter_container(map, &element);
+    if (err)
+        return err;
+
+    while (!cbor_value_at_end(&element)) {
+        err = cbor_value_skip_tag(&element);
+        if (err)
+            return err;
+        if (cbor_value_is_text_string(&element)) {
+            uint32_t hash;
+            uint32_t key = (uint32_t)(element.source.ptr - map->source.ptr);
+            size_t slot;
+            err = map_index_hash_string(&element, &hash);
+            if (err)
+                return err;
+            if (index->count + 1 >= size)
+                return CborErrorOutOfMemory;
+
+            /* linear probing keeps the first of duplicate keys first */
+            slot = hash & (size - 1);
+            while (entries[slot].hash)
+                slot = (slot + 1) & (size - 1);
+            entries[slot].hash = hash;
+            entries[slot].key = key;
+            entries[slot].value = (uint32_t)(element.source.ptr - map->source.ptr);
+            entries[slot].remaining = element.remaining;
+            index->valueFlags = element.flags;
+            ++index->count;
+        } else {
+            /* skip this key */
+            err = cbor_value_advance(&element);
+            if (err)
+                return err;
+        }
+
+        /* skip this value */
+        err = cbor_value_skip_tag(&element);
+        if (err)
+            return err;
+        err = cbor_value_advance(&element);
+        if (err)
+            return err;
+    }
+    return CborNoError;
+}
+
+/**
+ * Finds the value that corresponds to the text string key \a string in the
+ * map indexed by cbor_value_map_index() in \a index. The result is the one of
+ * cbor_value_map_find_value() on the same map: if the item is found, it is
+ * stored in \a element, otherwise \a element is of type \ref CborInvalidType.
+ *
+ * This function hashes \a string and compares it with the keys of the same
+ * hash only, so it runs in O(1) time on the number of elements in the map.
+ *
+ * \sa cbor_value_map_index(), cbor_value_map_find_value()
+ */
+CborError cbor_map_index_find_value(const CborMapIndex *index, const char *string, CborValue *element)
+{
+    CborError err;
+    size_t len = strlen(string);
+    uint32_t hash = map_index_hash(2166136261U, (const uint8_t *)string, len);
+    size_t mask = index->size - 1;
+    size_t slot;
+    hash = hash ? hash : 1;
+
+    for (slot = hash & mask; index->entries[slot].hash; slot = (slot + 1) & mask) {
+        const CborMapIndexEntry *entry = &index->entries[slot];
+        CborValue key;
+        bool equals;
+        size_t dummyLen = len;
+        if (entry->hash != hash)
+            continue;
+
+        /* the key is the last item its iterator reads */
+        err = map_index_element(index, entry->key, 1, CborIteratorFlag_ContainerIsMap, &key);
+        if (err)
+            goto error;
+        err = iterate_string_chunks(&key, CONST_CAST(char *, string), &dummyLen, &equals, NULL, iterate_memcmp);
+        if (err)
+            goto error;
+        if (equals)
+            return map_index_element(index, entry->value, entry->remaining, index->valueFlags, element);
+    }
+
+    /* not found */
+    element->type = CborInvalidType;
+    return CborNoError;
+
+error:
+    element->type = CborInvalidType;
+    return err;
+}
+
 /**
  * \fn bool cbor_value_is_float(const CborValue *value)
  *
@@ -271,12 +271,8 @@ static CborError validate_value(CborValue *it, uint32_t flags, int recursionLeft
 static inline CborError validate_utf8_string(const void *ptr, size_t n)
 {
     const uint8_t *buffer = (const uint8_t *)ptr;
-    const uint8_t * const end = buffer + n;
-    while (buffer < end) {
-        uint32_t uc = get_utf8(&buffer, end);
-        if (uc == ~0U)
-            return CborErrorInvalidUtf8TextString;
-    }
+    if (!validate_utf8(buffer, buffer + n))
+        return CborErrorInvalidUtf8TextString;
     return CborNoError;
 }
 
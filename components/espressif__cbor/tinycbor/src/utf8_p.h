@@ -0,0 +1,317 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 Intel Corporation
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+** THE SOFTWARE.
+**
+****************************************************************************/
+
+#ifndef CBOR_UTF8_H
+#define CBOR_UTF8_H
+
+#include "compilersupport_p.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__SSSE3__) && !defined(CBOR_NO_SIMD)
+#  include <tmmintrin.h>
+#  define CBOR_UTF8_SSSE3
+#endif
+
+static inline uint32_t get_utf8(const uint8_t **buffer, const uint8_t *end)
+{
+    int charsNeeded;
+    uint32_t uc, min_uc;
+    uint8_t b;
+    ptrdiff_t n = end - *buffer;
+    if (n == 0)
+        return ~0U;
+
+    uc = *(*buffer)++;
+    if (uc < 0x80) {
+        /* single-byte UTF-8 */
+        return uc;
+    }
+
+    /* multi-byte UTF-8, decode it */
+    if (unlikely(uc <= 0xC1))
+        return ~0U;
+    if (uc < 0xE0) {
+        /* two-byte UTF-8 */
+        charsNeeded = 2;
+        min_uc = 0x80;
+        uc &= 0x1f;
+    } else if (uc < 0xF0) {
+        /* three-byte UTF-8 */
+        charsNeeded = 3;
+        min_uc = 0x800;
+        uc &= 0x0f;
+    } else if (uc < 0xF5) {
+        /* four-byte UTF-8 */
+        charsNeeded = 4;
+        min_uc = 0x10000;
+        uc &= 0x07;
+    } else {
+        return ~0U;
+    }
+
+    if (n < charsNeeded)
+        return ~0U;
+
+    /* first continuation character */
+    b = *(*buffer)++;
+    if ((b & 0xc0) != 0x80)
+        return ~0U;
+    uc <<= 6;
+    uc |= b & 0x3f;
+
+    if (charsNeeded > 2) {
+        /* second continuation character */
+        b = *(*buffer)++;
+        if ((b & 0xc0) != 0x80)
+            return ~0U;
+        uc <<= 6;
+        uc |= b & 0x3f;
+
+        if (charsNeeded > 3) {
+            /* third continuation character */
+            b = *(*buffer)++;
+            if ((b & 0xc0) != 0x80)
+                return ~0U;
+            uc <<= 6;
+            uc |= b & 0x3f;
+        }
+    }
+
+    /* overlong sequence? surrogate pair? out or range? */
+    if (uc < min_uc || uc - 0xd800U < 2048U || uc > 0x10ffff)
+        return ~0U;
+
+    return uc;
+}
+
+static inline bool validate_utf8_scalar(const uint8_t *buffer, const uint8_t *end)
+{
+    while (buffer < end) {
+        if (get_utf8(&buffer, end) == ~0U)
+            return false;
+    }
+    return true;
+}
+
+static inline uint64_t load_aligned_word(const uint8_t *ptr)
+{
+    uint64_t word;
+#ifdef __GNUC__
+    ptr = (const uint8_t *)__builtin_assume_aligned(ptr, sizeof(word));
+#endif
+    memcpy(&word, ptr, sizeof(word));
+    return word;
+}
+
+/* returns the first byte of \a buffer that is not US-ASCII, or \a end */
+static inline const uint8_t *skip_ascii(const uint8_t *buffer, const uint8_t *end)
+{
+    const uint64_t highBits = UINT64_C(0x8080808080808080);
+
+    /* words are loaded aligned, which the targets without unaligned loads need */
+    while (buffer < end && ((uintptr_t)buffer & (sizeof(uint64_t) - 1))) {
+        if (*buffer & 0x80)
+            return buffer;
+        ++buffer;
+    }
+    while (end - buffer >= 16) {
+        if ((load_aligned_word(buffer) | load_aligned_word(buffer + 8)) & highBits)
+            break;
+        buffer += 16;
+    }
+    if (end - buffer >= 8 && (load_aligned_word(buffer) & highBits) == 0)
+        buffer += 8;
+    while (buffer < end && *buffer < 0x80)
+        ++buffer;
+    return buffer;
+}
+
+/* checks 8 and 16 bytes at a time while the text is US-ASCII */
+static inline bool validate_utf8_swar(const uint8_t *buffer, const uint8_t *end)
+{
+    while (buffer < end) {
+        buffer = skip_ascii(buffer, end);
+        while (buffer < end && *buffer >= 0x80) {
+            if (get_utf8(&buffer, end) == ~0U)
+                return false;
+        }
+    }
+    return true;
+}
+
+#ifdef CBOR_UTF8_SSSE3
+/*
+ * Validation of 16 bytes at a time by lookup tables, after John Keiser and
+ * Daniel Lemire, "Validating UTF-8 In Less Than One Instruction Per Byte"
+ * (2021). The high and low nibbles of each byte and the high nibble of the
+ * next one index three tables of the errors they can take part in; a byte
+ * pair is invalid if the three lookups share a bit. The 3rd and 4th bytes of
+ * the longer sequences are checked against the leading byte 2 and 3 bytes
+ * before.
+ */
+enum {
+    Utf8TooShort = 1 << 0,       /* lead byte not followed by a continuation */
+    Utf8TooLong = 1 << 1,        /* ASCII followed by a continuation */
+    Utf8Overlong3 = 1 << 2,
+    Utf8TooLarge = 1 << 3,
+    Utf8Surrogate = 1 << 4,
+    Utf8Overlong2 = 1 << 5,
+    Utf8TooLarge1000 = 1 << 6,
+    Utf8Overlong4 = 1 << 6,
+    Utf8TwoConts = 1 << 7,       /* continuation after continuation */
+    Utf8Carry = Utf8TooShort | Utf8TooLong | Utf8TwoConts
+};
+
+static inline __m128i utf8_high_nibbles(__m128i v)
+{
+    return _mm_and_si128(_mm_srli_epi16(v, 4), _mm_set1_epi8(0x0f));
+}
+
+static inline __m128i utf8_check_block(__m128i input, __m128i prev)
+{
+    const __m128i byte1High = _mm_setr_epi8(
+        /* 0_______ ASCII */
+        Utf8TooLong, Utf8TooLong, Utf8TooLong, Utf8TooLong,
+        Utf8TooLong, Utf8TooLong, Utf8TooLong, Utf8TooLong,
+        /* 10______ continuation */
+        Utf8TwoConts, Utf8TwoConts, Utf8TwoConts, Utf8TwoConts,
+        /* 1100____ 1101____ two-byte lead */
+        Utf8TooShort | Utf8Overlong2,
+        Utf8TooShort,
+        /* 1110____ three-byte lead */
+        Utf8TooShort | Utf8Overlong3 | Utf8Surrogate,
+        /* 1111____ four-byte lead */
+        (char)(Utf8TooShort | Utf8TooLarge | Utf8TooLarge1000 | Utf8Overlong4));
+    const __m128i byte1Low = _mm_setr_epi8(
+        /* ____0000 ____0001 */
+        Utf8Carry | Utf8Overlong3 | Utf8Overlong2 | Utf8Overlong4,
+        Utf8Carry | Utf8Overlong2,
+        /* ____001_ */
+        Utf8Carry,
+        Utf8Carry,
+        /* ____0100 */
+        Utf8Carry | Utf8TooLarge,
+        /* ____0101 ... ____1100 */
+        (char)(Utf8Carry | Utf8TooLarge | Utf8TooLarge1000),
+        (char)(Utf8Carry | Utf8TooLarge | Utf8TooLarge1000),
+        (char)(Utf8Carry | Utf8TooLarge | Utf8TooLarge1000),
+        (char)(Utf8Carry | Utf8TooLarge | Utf8TooLarge1000),
+        (char)(Utf8Carry | Utf8TooLarge | Utf8TooLarge1000),
+        (char)(Utf8Carry | Utf8TooLarge | Utf8TooLarge1000),
+        (char)(Utf8Carry | Utf8TooLarge | Utf8TooLarge1000),
+        (char)(Utf8Carry | Utf8TooLarge | Utf8TooLarge1000),
+        /* ____1101 */
+        (char)(Utf8Carry | Utf8TooLarge | Utf8TooLarge1000 | Utf8Surrogate),
+        /* ____1110 ____1111 */
+        (char)(Utf8Carry | Utf8TooLarge | Utf8TooLarge1000),
+        (char)(Utf8Carry | Utf8TooLarge | Utf8TooLarge1000));
+    const __m128i byte2High = _mm_setr_epi8(
+        /* 0_______ ASCII */
+        Utf8TooShort, Utf8TooShort, Utf8TooShort, Utf8TooShort,
+        Utf8TooShort, Utf8TooShort, Utf8TooShort, Utf8TooShort,
+        /* 1000____ */
+        (char)(Utf8TooLong | Utf8Overlong2 | Utf8TwoConts | Utf8Overlong3 | Utf8TooLarge1000 | Utf8Overlong4),
+        /* 1001____ */
+        (char)(Utf8TooLong | Utf8Overlong2 | Utf8TwoConts | Utf8Overlong3 | Utf8TooLarge),
+        /* 101_____ */
+        (char)(Utf8TooLong | Utf8Overlong2 | Utf8TwoConts | Utf8Surrogate | Utf8TooLarge),
+        (char)(Utf8TooLong | Utf8Overlong2 | Utf8TwoConts | Utf8Surrogate | Utf8TooLarge),
+        /* 11______ lead */
+        Utf8TooShort, Utf8TooShort, Utf8TooShort, Utf8TooShort);
+
+    __m128i prev1 = _mm_alignr_epi8(input, prev, 15);
+    __m128i special = _mm_and_si128(
+        _mm_and_si128(_mm_shuffle_epi8(byte1High, utf8_high_nibbles(prev1)),
+                      _mm_shuffle_epi8(byte1Low, _mm_and_si128(prev1, _mm_set1_epi8(0x0f)))),
+        _mm_shuffle_epi8(byte2High, utf8_high_nibbles(input)));
+
+    /* only 111_____ 2 bytes before and 1111____ 3 bytes before keep their high bit */
+    __m128i third = _mm_subs_epu8(_mm_alignr_epi8(input, prev, 14), _mm_set1_epi8(0xe0 - 0x80));
+    __m128i fourth = _mm_subs_epu8(_mm_alignr_epi8(input, prev, 13), _mm_set1_epi8(0xf0 - 0x80));
+    __m128i mustBeContinuation = _mm_and_si128(_mm_or_si128(third, fourth), _mm_set1_epi8((char)0x80));
+    return _mm_xor_si128(mustBeContinuation, special);
+}
+
+static inline bool validate_utf8_ssse3(const uint8_t *buffer, const uint8_t *end)
+{
+    /* a lead byte in the last 3 bytes of a block needs more than the block has */
+    const __m128i maxValue = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                           (char)(0xf0 - 1), (char)(0xe0 - 1), (char)(0xc0 - 1));
+    __m128i prev = _mm_setzero_si128();
+    __m128i error = _mm_setzero_si128();
+    __m128i incomplete = _mm_setzero_si128();
+    uint8_t tail[16];
+    size_t n;
+
+    if (end - buffer < 16)
+        return validate_utf8_swar(buffer, end);
+
+    for ( ; ; buffer += 16) {
+        __m128i input;
+        if (end - buffer >= 16) {
+            input = _mm_loadu_si128((const __m128i *)buffer);
+        } else {
+            /* the zeroes after the end are ASCII and end any sequence left open */
+            n = (size_t)(end - buffer);
+            memset(tail, 0, sizeof(tail));
+            if (n)
+                memcpy(tail, buffer, n);
+            input = _mm_loadu_si128((const __m128i *)tail);
+        }
+
+        if (_mm_movemask_epi8(input) == 0) {
+            error = _mm_or_si128(error, incomplete);
+            incomplete = _mm_setzero_si128();
+
+            /* the US-ASCII run that follows carries no state, skip it 64 bytes at a time */
+            while (end - buffer >= 16 + 64) {
+                const __m128i *next = (const __m128i *)(buffer + 16);
+                __m128i last = _mm_loadu_si128(next + 3);
+                __m128i any = _mm_or_si128(_mm_or_si128(_mm_loadu_si128(next), _mm_loadu_si128(next + 1)),
+                                           _mm_or_si128(_mm_loadu_si128(next + 2), last));
+                if (_mm_movemask_epi8(any))
+                    break;
+                buffer += 64;
+                input = last;
+            }
+        } else {
+            error = _mm_or_si128(error, utf8_check_block(input, prev));
+            incomplete = _mm_subs_epu8(input, maxValue);
+        }
+        prev = input;
+        if (end - buffer < 16)
+            break;
+    }
+    error = _mm_or_si128(error, incomplete);
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) == 0xffff;
+}
+
+#  define validate_utf8 validate_utf8_ssse3
+#else
+#  define validate_utf8 validate_utf8_swar
+#endif
+
+#endif /* CBOR_UTF8_H */
@@ -0,0 +1,144 @@
+/****************************************************************************
+**
+** SPDX-License-Identifier: MIT
+**
+****************************************************************************/
+
+/*
+ * Lookups of text string keys in maps of 8, 32 and 128 entries
+ *
+ * Each map holds keys "key-000" ... with unsigned values and is searched for
+ * every key plus one that is absent. It reports:
+ * - find[ns]:   cbor_value_map_find_value() per lookup
+ * - index[ns]:  cbor_value_map_index() once per map
+ * - lookup[ns]: cbor_map_index_find_value() per lookup
+ * - break-even: lookups from which indexing the map is cheaper
+ *
+ * The bench fails if a lookup through the index does not return the element
+ * of cbor_value_map_find_value().
+ *
+ * Usage: bench_map_index
+ */
+#include "cbor.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define MAX_KEYS    128
+#define ROUNDS      20000
+
+static uint8_t buffer[MAX_KEYS * 16 + 16];
+static char keys[MAX_KEYS + 1][16];
+static volatile uint32_t sink;
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static size_t encode_map(int count)
+{
+    CborEncoder encoder, map;
+    cbor_encoder_init(&encoder, buffer, sizeof(buffer), 0);
+    if (cbor_encoder_create_map(&encoder, &map, count))
+        abort();
+    for (int i = 0; i < count; i++) {
+        if (cbor_encode_text_stringz(&map, keys[i]) || cbor_encode_uint(&map, 1000 + i))
+            abort();
+    }
+    if (cbor_encoder_close_container(&encoder, &map))
+        abort();
+    return cbor_encoder_get_buffer_size(&encoder, buffer);
+}
+
+static uint32_t value_of(const CborValue *element)
+{
+    uint64_t value = 0;
+    if (cbor_value_is_unsigned_integer(element))
+        cbor_value_get_uint64(element, &value);
+    return (uint32_t)value;
+}
+
+static int check(const CborValue *map, const CborMapIndex *index, int count)
+{
+    for (int i = 0; i <= count; i++) {
+        CborValue found, reference;
+        const char *key = i < count ? keys[i] : keys[MAX_KEYS];
+        if (cbor_map_index_find_value(index, key, &found) || cbor_value_map_find_value(map, key, &reference))
+            return 1;
+        if (found.type != reference.type)
+            return 1;
+        if (reference.type == CborInvalidType)
+            continue;
+        if (found.source.ptr != reference.source.ptr || found.remaining != reference.remaining ||
+                found.flags != reference.flags || value_of(&found) != 1000u + i)
+            return 1;
+    }
+    return 0;
+}
+
+int main(void)
+{
+    static const int counts[] = { 8, 32, 128 };
+    CborMapIndexEntry entries[2 * MAX_KEYS];
+    int ret = 0;
+
+    for (int i = 0; i < MAX_KEYS; i++)
+        snprintf(keys[i], sizeof(keys[i]), "key-%03d", i);
+    strcpy(keys[MAX_KEYS], "absent");
+
+    printf("%-6s %-6s %-9s %-10s %-11s %s\n", "keys", "bytes", "find[ns]", "index[ns]", "lookup[ns]", "break-even");
+    for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+        int count = counts[c];
+        size_t size = 2 * count;
+        size_t len = encode_map(count);
+        CborParser parser;
+        CborValue map, element;
+        CborMapIndex index;
+
+        if (cbor_parser_init(buffer, len, 0, &parser, &map) ||
+                cbor_value_map_index(&map, &index, entries, size) || index.count != (size_t)count) {
+            printf("FAIL: %d keys not indexed\n", count);
+            ret = 1;
+            continue;
+        }
+        if (check(&map, &index, count)) {
+            printf("FAIL: %d keys, lookup differs from cbor_value_map_find_value()\n", count);
+            ret = 1;
+        }
+
+        int rounds = ROUNDS * 8 / count;
+        double start = now_ns();
+        for (int r = 0; r < rounds; r++) {
+            for (int i = 0; i <= count; i++) {
+                cbor_value_map_find_value(&map, i < count ? keys[i] : keys[MAX_KEYS], &element);
+                sink += element.type;
+            }
+        }
+        double find = (now_ns() - start) / rounds / (count + 1);
+
+        start = now_ns();
+        for (int r = 0; r < rounds; r++) {
+            cbor_value_map_index(&map, &index, entries, size);
+            sink += index.count;
+        }
+        double build = (now_ns() - start) / rounds;
+
+        start = now_ns();
+        for (int r = 0; r < rounds; r++) {
+            for (int i = 0; i <= count; i++) {
+                cbor_map_index_find_value(&index, i < count ? keys[i] : keys[MAX_KEYS], &element);
+                sink += element.type;
+            }
+        }
+        double lookup = (now_ns() - start) / rounds / (count + 1);
+
+        printf("%-6d %-6zu %-9.1f %-10.1f %-11.1f %.1f\n", count, len, find, build, lookup,
+               find > lookup ? build / (find - lookup) : 0.0);
+    }
+    return ret;
+}
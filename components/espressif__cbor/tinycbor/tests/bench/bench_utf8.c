@@ -0,0 +1,179 @@
+/****************************************************************************
+**
+** SPDX-License-Identifier: MIT
+**
+****************************************************************************/
+
+/*
+ * Throughput of the UTF-8 validators of utf8_p.h
+ *
+ * Each text is 64 KiB validated at once, except "short", which is validated
+ * as separate 12-byte strings like task names:
+ * - ascii: log lines
+ * - short: task names
+ * - latin: French and German text, about 5% of 2-byte sequences
+ * - cjk:   Japanese text, 3-byte sequences with ASCII punctuation
+ * - emoji: ASCII words and 4-byte sequences
+ *
+ * It reports MB/s for validate_utf8_scalar(), the former code point by code
+ * point loop, validate_utf8_swar() and validate_utf8_ssse3() when built with
+ * SSSE3, and for cbor_value_validate() with CborValidateUtf8 on the same text
+ * split into an array of 256-byte strings, which runs the validator selected
+ * at build time (validate_utf8). It fails if a validator rejects a text.
+ *
+ * Usage: bench_utf8
+ */
+#include "cbor.h"
+#include "utf8_p.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define TEXT_SIZE   65536
+#define SHORT_SIZE  12
+#define CHUNK_SIZE  256
+#define MIN_NS      50e6
+
+typedef bool (*validator)(const uint8_t *buffer, const uint8_t *end);
+
+static uint8_t text[TEXT_SIZE + 64] __attribute__((aligned(16)));
+static uint8_t encoded[TEXT_SIZE * 2];
+static size_t textLen;
+static size_t encodedLen;
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/* repeats the sample as many times as it fits in TEXT_SIZE bytes */
+static void fill(const char *sample)
+{
+    size_t len = strlen(sample);
+    textLen = 0;
+    while (textLen + len <= TEXT_SIZE) {
+        memcpy(text + textLen, sample, len);
+        textLen += len;
+    }
+}
+
+static int short_strings(validator v)
+{
+    int ok = 1;
+    for (size_t i = 0; i + SHORT_SIZE <= textLen; i += SHORT_SIZE)
+        ok &= v(text + i, text + i + SHORT_SIZE);
+    return ok;
+}
+
+static double run(validator v, bool splitShort, int *ok)
+{
+    double best = 0;
+    for (int round = 0; round < 3; round++) {
+        long count = 0;
+        double start = now_ns(), elapsed;
+        do {
+            *ok &= splitShort ? short_strings(v) : v(text, text + textLen);
+            ++count;
+        } while ((elapsed = now_ns() - start) < MIN_NS);
+        double mbs = count * (double)textLen / elapsed * 1e3;
+        if (mbs > best)
+            best = mbs;
+    }
+    return best;
+}
+
+static int encode_chunks(size_t chunk)
+{
+    CborEncoder encoder, array;
+    cbor_encoder_init(&encoder, encoded, sizeof(encoded), 0);
+    if (cbor_encoder_create_array(&encoder, &array, CborIndefiniteLength))
+        return 1;
+    for (size_t i = 0, n; i < textLen; i += n) {
+        n = textLen - i < chunk ? textLen - i : chunk;
+        while (i + n < textLen && (text[i + n] & 0xc0) == 0x80)
+            --n;        /* strings end at a character boundary */
+        if (cbor_encode_text_string(&array, (const char *)text + i, n))
+            return 1;
+    }
+    if (cbor_encoder_close_container(&encoder, &array))
+        return 1;
+    encodedLen = cbor_encoder_get_buffer_size(&encoder, encoded);
+    return 0;
+}
+
+static double run_cbor(int *ok)
+{
+    double best = 0;
+    for (int round = 0; round < 3; round++) {
+        long count = 0;
+        double start = now_ns(), elapsed;
+        do {
+            CborParser parser;
+            CborValue value;
+            *ok &= cbor_parser_init(encoded, encodedLen, 0, &parser, &value) == CborNoError &&
+                   cbor_value_validate(&value, CborValidateUtf8) == CborNoError;
+            ++count;
+        } while ((elapsed = now_ns() - start) < MIN_NS);
+        double mbs = count * (double)textLen / elapsed * 1e3;
+        if (mbs > best)
+            best = mbs;
+    }
+    return best;
+}
+
+int main(void)
+{
+    static const struct {
+        const char *name;
+        const char *sample;
+        bool splitShort;
+    } texts[] = {
+        { "ascii", "I (12345) esp_insights: Metrics data: 3 entries, heap 123456 free, min 98765, largest 65536\n", false },
+        { "short", "sys_evt\0\0\0\0\0" "main\0\0\0\0\0\0\0\0" "ipc0\0\0\0\0\0\0\0\0" "tiT\0\0\0\0\0\0\0\0\0", true },
+        { "latin", "Le thermostat du séjour est réglé à 21 °C; die Tür zur Küche ist geöffnet. ", false },
+        { "cjk", "リビングの照明をオンにしました。温度は二十一度です。", false },
+        { "emoji", "lamp \xf0\x9f\x92\xa1 on, door \xf0\x9f\x9a\xaa open, heat \xf0\x9f\x94\xa5 \xf0\x9f\x8c\xa1 ok ", false },
+    };
+    int ret = 0;
+
+    printf("%-6s %-7s %-12s %-10s %-11s %s\n", "text", "bytes", "scalar[MB/s]", "swar[MB/s]", "simd[MB/s]",
+           "cbor[MB/s]");
+    for (size_t t = 0; t < sizeof(texts) / sizeof(texts[0]); t++) {
+        int ok = 1;
+        if (texts[t].splitShort) {
+            /* the sample holds 4 NUL-padded names of SHORT_SIZE bytes */
+            textLen = 0;
+            while (textLen + 4 * SHORT_SIZE <= TEXT_SIZE) {
+                memcpy(text + textLen, texts[t].sample, 4 * SHORT_SIZE);
+                textLen += 4 * SHORT_SIZE;
+            }
+        } else {
+            fill(texts[t].sample);
+        }
+
+        double scalar = run(validate_utf8_scalar, texts[t].splitShort, &ok);
+        double swar = run(validate_utf8_swar, texts[t].splitShort, &ok);
+#ifdef CBOR_UTF8_SSSE3
+        double simd = run(validate_utf8_ssse3, texts[t].splitShort, &ok);
+#endif
+        if (encode_chunks(texts[t].splitShort ? SHORT_SIZE : CHUNK_SIZE))
+            ok = 0;
+        double cbor = run_cbor(&ok);
+
+        printf("%-6s %-7zu %-12.0f %-10.0f ", texts[t].name, textLen, scalar, swar);
+#ifdef CBOR_UTF8_SSSE3
+        printf("%-11.0f ", simd);
+#else
+        printf("%-11s ", "-");
+#endif
+        printf("%.0f\n", cbor);
+        if (!ok) {
+            printf("FAIL: %s rejected\n", texts[t].name);
+            ret = 1;
+        }
+    }
+    return ret;
+}
@@ -0,0 +1,214 @@
+/****************************************************************************
+**
+** SPDX-License-Identifier: MIT
+**
+****************************************************************************/
+
+/*
+ * Differential fuzzing of the UTF-8 validators of utf8_p.h
+ *
+ * validate_utf8_swar() and, when built with SSSE3, validate_utf8_ssse3() are
+ * compared with validate_utf8_scalar(), the code point by code point decoder:
+ * - on every sequence of 1 to 3 bytes, and on the 4-byte sequences with a
+ *   lead byte from 0xF0 to 0xF7 followed by bytes from 0x7F to 0xC0, alone
+ *   and behind 13 bytes of ASCII,
+ * - then on random strings built from ASCII runs, valid code points of 1 to 4
+ *   bytes, boundary bytes (C0, C1, ED A0, F4 90, F5, lone continuations),
+ *   truncated sequences and random bytes, placed at every alignment behind
+ *   up to 40 bytes of ASCII and mutated.
+ *
+ * It fails at the first string on which the validators disagree and prints it.
+ *
+ * Usage: fuzz_utf8 [iterations] [seed]
+ */
+#include "cbor.h"
+#include "utf8_p.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define MAX_STRING  512
+
+static uint8_t storage[MAX_STRING + 64] __attribute__((aligned(16)));
+static uint64_t state;
+static unsigned long long checked;
+
+static uint32_t next_random(void)
+{
+    /* xorshift64* */
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return (uint32_t)((state * UINT64_C(2685821657736338717)) >> 32);
+}
+
+static unsigned long long valid;
+
+static int compare(const uint8_t *string, size_t len)
+{
+    bool expected = validate_utf8_scalar(string, string + len);
+    valid += expected;
+    bool swar = validate_utf8_swar(string, string + len);
+#ifdef CBOR_UTF8_SSSE3
+    bool simd = validate_utf8_ssse3(string, string + len);
+#else
+    bool simd = expected;
+#endif
+    ++checked;
+    if (swar == expected && simd == expected)
+        return 0;
+
+    printf("FAIL: scalar %d, swar %d, simd %d on %zu bytes at offset %u:", expected, swar, simd, len,
+           (unsigned)((uintptr_t)string & 15));
+    for (size_t i = 0; i < len; i++)
+        printf(" %02x", string[i]);
+    printf("\n");
+    return 1;
+}
+
+static int exhaustive(void)
+{
+    /* behind 13 bytes of ASCII, so that the 4-byte sequences straddle the first 16-byte block and the
+     * SIMD validator, which leaves strings shorter than a block to the SWAR one, sees all of them */
+    uint8_t *s = storage + 13;
+    memset(storage, 'a', 13);
+    for (uint32_t v = 0; v < 0x100; v++) {
+        s[0] = (uint8_t)v;
+        if (compare(s, 1) || compare(storage, 13 + 1))
+            return 1;
+    }
+    for (uint32_t v = 0; v < 0x10000; v++) {
+        s[0] = (uint8_t)(v >> 8);
+        s[1] = (uint8_t)v;
+        if (compare(s, 2) || compare(storage, 13 + 2))
+            return 1;
+    }
+    for (uint32_t v = 0; v < 0x1000000; v++) {
+        s[0] = (uint8_t)(v >> 16);
+        s[1] = (uint8_t)(v >> 8);
+        s[2] = (uint8_t)v;
+        if (compare(s, 3) || compare(storage, 13 + 3))
+            return 1;
+    }
+    for (uint32_t lead = 0xf0; lead < 0xf8; lead++) {
+        for (uint32_t v = 0; v < 66 * 66 * 66; v++) {
+            s[0] = (uint8_t)lead;
+            s[1] = (uint8_t)(0x7f + v / (66 * 66));
+            s[2] = (uint8_t)(0x7f + v / 66 % 66);
+            s[3] = (uint8_t)(0x7f + v % 66);
+            if (compare(s, 4) || compare(storage, 13 + 4))
+                return 1;
+        }
+    }
+    return 0;
+}
+
+static size_t put_code_point(uint8_t *s, uint32_t uc)
+{
+    if (uc < 0x80) {
+        s[0] = (uint8_t)uc;
+        return 1;
+    }
+    if (uc < 0x800) {
+        s[0] = (uint8_t)(0xc0 | uc >> 6);
+        s[1] = (uint8_t)(0x80 | (uc & 0x3f));
+        return 2;
+    }
+    if (uc < 0x10000) {
+        s[0] = (uint8_t)(0xe0 | uc >> 12);
+        s[1] = (uint8_t)(0x80 | (uc >> 6 & 0x3f));
+        s[2] = (uint8_t)(0x80 | (uc & 0x3f));
+        return 3;
+    }
+    s[0] = (uint8_t)(0xf0 | uc >> 18);
+    s[1] = (uint8_t)(0x80 | (uc >> 12 & 0x3f));
+    s[2] = (uint8_t)(0x80 | (uc >> 6 & 0x3f));
+    s[3] = (uint8_t)(0x80 | (uc & 0x3f));
+    return 4;
+}
+
+static size_t random_string(uint8_t *s, size_t max)
+{
+    static const uint8_t boundaries[][4] = {
+        { 0xc0, 0x80 }, { 0xc1, 0xbf }, { 0xe0, 0x80, 0x80 }, { 0xe0, 0x9f, 0xbf }, { 0xed, 0xa0, 0x80 },
+        { 0xed, 0xbf, 0xbf }, { 0xf0, 0x8f, 0xbf, 0xbf }, { 0xf4, 0x90, 0x80, 0x80 }, { 0xf5, 0x80, 0x80, 0x80 },
+        { 0xff }, { 0x80 }, { 0xbf }, { 0xee, 0x80, 0x80 }, { 0xf4, 0x8f, 0xbf, 0xbf }, { 0xdf, 0xbf },
+    };
+    size_t len = 0;
+    size_t target = next_random() % max;
+    uint32_t invalid = next_random() % 2 ? 3 : 0;      /* half of the strings are valid before mutation */
+
+    while (len + 4 <= target) {
+        uint32_t r = next_random();
+        uint32_t kind = r % (29 + invalid);
+        if (kind < 12) {
+            size_t run = r >> 8 & 31;
+            for (size_t i = 0; i < run && len < target; i++)
+                s[len++] = (uint8_t)(0x20 + (next_random() % 0x5f));
+        } else if (kind < 18) {
+            len += put_code_point(s + len, 0x80 + (r >> 8) % (0x800 - 0x80));
+        } else if (kind < 24) {
+            uint32_t uc = 0x800 + (r >> 8) % (0x10000 - 0x800);
+            if (uc - 0xd800U >= 2048U)
+                len += put_code_point(s + len, uc);
+        } else if (kind < 29) {
+            len += put_code_point(s + len, 0x10000 + (r >> 8) % (0x110000 - 0x10000));
+        } else if (kind == 29) {
+            const uint8_t *b = boundaries[(r >> 8) % (sizeof(boundaries) / sizeof(boundaries[0]))];
+            size_t blen = 1;
+            while (blen < 4 && b[blen])
+                ++blen;
+            if (r & 0x80000000)
+                blen = 1 + (r >> 16) % blen;        /* truncated */
+            memcpy(s + len, b, blen);
+            len += blen;
+        } else if (kind == 30) {
+            s[len++] = (uint8_t)(r >> 8);
+        } else {
+            s[len++] = (uint8_t)(0x80 + (r >> 16) % 0x40);
+        }
+    }
+    return len;
+}
+
+int main(int argc, char **argv)
+{
+    unsigned long iterations = argc > 1 ? strtoul(argv[1], NULL, 0) : 200000;
+    state = argc > 2 ? strtoull(argv[2], NULL, 0) : UINT64_C(0x9e3779b97f4a7c15);
+    if (!state)
+        state = 1;
+
+    if (exhaustive())
+        return 1;
+
+    uint8_t string[MAX_STRING];
+    for (unsigned long i = 0; i < iterations; i++) {
+        size_t len = random_string(string, MAX_STRING - 40);
+        size_t prefix = next_random() % 41;
+        uint8_t *s = storage + (next_random() % 16);
+
+        memset(s, 'a', prefix);
+        memcpy(s + prefix, string, len);
+        if (compare(s, prefix + len))
+            return 1;
+
+        /* and once more with a random byte flipped */
+        if (prefix + len) {
+            size_t at = next_random() % (prefix + len);
+            uint8_t saved = s[at];
+            s[at] ^= (uint8_t)(1 << (next_random() % 8));
+            if (compare(s, prefix + len))
+                return 1;
+            s[at] = saved;
+        }
+    }
+
+    printf("%llu strings, %llu valid, validators agree (%s)\n", checked, valid,
+#ifdef CBOR_UTF8_SSSE3
+           "scalar, swar, ssse3"
+#else
+           "scalar, swar"
+#endif
+          );
+    return 0;
+}
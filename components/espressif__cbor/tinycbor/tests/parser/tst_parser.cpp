@@ -102,6 +102,8 @@ private slots:
     void stringCompare();
     void mapFind_data();
     void mapFind();
+    void mapIndexFind_data() { mapFind_data(); }
+    void mapIndexFind();
 
     // validation & errors
     void checkedIntegers_data();
@@ -1267,6 +1269,49 @@ void tst_Parser::mapFind()
     }
 }
 
+void tst_Parser::mapIndexFind()
+{
+    QFETCH(QByteArray, data);
+    QFETCH(bool, expected);
+
+    ParserWrapper w;
+    CborError err = w.init(data);
+    QVERIFY2(!err, QByteArray("Got error \"") + cbor_error_string(err) + "\"");
+
+    CborMapIndex index;
+    CborMapIndexEntry entries[8];
+    err = cbor_value_map_index(&w.first, &index, entries, 8);
+    QVERIFY2(!err, QByteArray("Got error \"") + cbor_error_string(err) + "\"");
+
+    CborValue element, reference;
+    err = cbor_map_index_find_value(&index, "needle", &element);
+    QVERIFY2(!err, QByteArray("Got error \"") + cbor_error_string(err) + "\"");
+    err = cbor_value_map_find_value(&w.first, "needle", &reference);
+    QVERIFY2(!err, QByteArray("Got error \"") + cbor_error_string(err) + "\"");
+    QCOMPARE(int(element.type), int(reference.type));
+
+    if (expected) {
+        QCOMPARE(cbor_value_get_next_byte(&element), cbor_value_get_next_byte(&reference));
+        QCOMPARE(element.remaining, reference.remaining);
+        QCOMPARE(int(element.flags), int(reference.flags));
+
+        bool equals;
+        err = cbor_value_skip_tag(&element);
+        QVERIFY2(!err, QByteArray("Got error \"") + cbor_error_string(err) + "\"");
+        err = cbor_value_text_string_equals(&element, "haystack", &equals);
+        QVERIFY2(!err, QByteArray("Got error \"") + cbor_error_string(err) + "\"");
+        QVERIFY(equals);
+    } else {
+        QCOMPARE(int(element.type), int(CborInvalidType));
+    }
+
+    // a table without room for the keys
+    size_t keys = index.count;
+    CborMapIndexEntry small[1];
+    err = cbor_value_map_index(&w.first, &index, small, 1);
+    QCOMPARE(int(err), int(keys ? CborErrorOutOfMemory : CborNoError));
+}
+
 void tst_Parser::checkedIntegers_data()
 {
     QTest::addColumn<QByteArray>("data");
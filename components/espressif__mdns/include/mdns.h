@@ -34,6 +34,11 @@ extern "C" {
  */
 typedef struct mdns_search_once_s mdns_search_once_t;
 
+/**
+ * @brief   Service registration batch handle
+ */
+typedef struct mdns_service_batch_s mdns_service_batch_t;
+
 /**
  * @brief   Daemon query handle
  */
@@ -120,6 +125,94 @@ typedef struct mdns_result_s {
 typedef void (*mdns_query_notify_t)(mdns_search_once_t *search);
 typedef void (*mdns_browse_notify_t)(mdns_result_t *result);
 
+/**
+ * @brief   Change of a browsed record, see mdns_browse_delta_new()
+ */
+typedef enum {
+    MDNS_BROWSE_RECORD_ADD,                 /*!< the record is new */
+    MDNS_BROWSE_RECORD_UPDATE,              /*!< the data of the SRV or TXT record of the instance changed */
+    MDNS_BROWSE_RECORD_REMOVE,              /*!< goodbye received, TTL ran out or record flushed by a newer one */
+} mdns_browse_delta_op_t;
+
+/**
+ * @brief   Browsed record added, updated or removed
+ *
+ * The strings and the TXT data are only valid during the call of the notifier.
+ */
+typedef struct {
+    mdns_browse_delta_op_t op;
+    uint16_t type;                          /*!< MDNS_TYPE_PTR, MDNS_TYPE_SRV, MDNS_TYPE_TXT, MDNS_TYPE_A or MDNS_TYPE_AAAA */
+    esp_netif_t *esp_netif;                 /*!< ptr to corresponding esp-netif */
+    mdns_ip_protocol_t ip_protocol;         /*!< ip_protocol type of the interface (v4/v6) */
+    uint32_t ttl;                           /*!< TTL of the record (s), 0 when removed */
+    const char *instance;                   /*!< instance name of PTR, SRV and TXT records */
+    const char *hostname;                   /*!< target of SRV records, owner of A and AAAA records */
+    uint16_t port;                          /*!< port of SRV records */
+    const uint8_t *txt;                     /*!< data of TXT records (length-prefixed "key=value" strings), NULL when removed */
+    uint16_t txt_len;                       /*!< length of txt */
+    esp_ip_addr_t addr;                     /*!< address of A and AAAA records */
+} mdns_browse_delta_t;
+
+typedef void (*mdns_browse_delta_notify_t)(const mdns_browse_delta_t *deltas, size_t count, void *arg);
+
+#define MDNS_STATS_LATENCY_BUCKETS  8       /*!< buckets of mdns_stats_latency_t */
+
+/**
+ * @brief   Durations of a stage of the mDNS engine
+ *
+ * Bucket i counts the durations under 16 << i microseconds, the last bucket the durations of 1 ms and more.
+ */
+typedef struct {
+    uint32_t buckets[MDNS_STATS_LATENCY_BUCKETS];   /*!< durations per range */
+    uint32_t max_us;                        /*!< longest duration */
+    uint64_t total_us;                      /*!< sum of the durations */
+} mdns_stats_latency_t;
+
+/**
+ * @brief   Traffic of an interface on one IP protocol
+ */
+typedef struct {
+    uint32_t rx_packets;                    /*!< packets received and parsed */
+    uint32_t rx_bytes;                      /*!< bytes of these packets */
+    uint32_t tx_packets;                    /*!< packets sent */
+    uint32_t tx_bytes;                      /*!< bytes of these packets */
+} mdns_stats_netif_t;
+
+/**
+ * @brief   Statistics of the mDNS engine, counted since mdns_init()
+ *
+ * The members marked (stats) are only counted with CONFIG_MDNS_ENABLE_STATS, they are 0 otherwise.
+ */
+typedef struct {
+    mdns_stats_netif_t netif[CONFIG_MDNS_MAX_INTERFACES][MDNS_IP_PROTOCOL_MAX]; /*!< (stats) traffic per interface */
+    mdns_stats_latency_t parse;             /*!< (stats) parsing of a received packet, with the answer it triggers */
+    mdns_stats_latency_t tx;                /*!< (stats) serializing and sending a packet, split packets included */
+    uint32_t answers;                       /*!< (stats) answers generated to received queries */
+    uint32_t known_answer_suppressed;       /*!< records left out of our answers, the querier listed them */
+    uint32_t duplicate_answer_suppressed;   /*!< records dropped from our answers, another responder sent them */
+    uint32_t aggregated_answers;            /*!< answers merged into an answer already scheduled */
+    uint32_t action_queue_depth;            /*!< (stats) actions waiting for the mDNS task */
+    uint32_t action_queue_peak;             /*!< (stats) most actions waiting at once */
+    uint32_t action_queue_drops;            /*!< (stats) actions not posted, the queue was full */
+    uint32_t action_pool_exhausted;         /*!< actions not posted, all actions of the pool were taken */
+    uint32_t malloc_failures;               /*!< (stats) failed allocations */
+    uint32_t searches_started;              /*!< (stats) searches handed to the mDNS task */
+    uint32_t searches_active;               /*!< searches running */
+    uint32_t browses_started;               /*!< (stats) browses handed to the mDNS task */
+    uint32_t browses_active;                /*!< browses running */
+    uint32_t browse_records_dropped;        /*!< records not tracked by the running delta browses, their storage was full */
+    uint32_t queries_sent;                  /*!< questions of searches and browses sent by the timer */
+    uint32_t query_refreshes;               /*!< of which for a cached answer reaching a refresh point */
+    uint32_t query_packets;                 /*!< packets these questions were packed into */
+    uint32_t cache_records;                 /*!< records in the cache */
+    uint32_t cache_bytes;                   /*!< bytes of these records */
+    uint32_t cache_hits;                    /*!< searches and browses that got results from the cache */
+    uint32_t cache_misses;                  /*!< searches and browses that got none */
+    uint32_t cache_inserts;                 /*!< records added to the cache */
+    uint32_t cache_evictions;               /*!< records dropped to make room before their TTL ran out */
+    uint32_t cache_expirations;             /*!< records dropped at the end of their TTL */
+} mdns_stats_t;
+
 /**
  * @brief  Initialize mDNS on given interface
  *
@@ -284,6 +377,65 @@ esp_err_t mdns_service_add(const char *instance_name, const char *service_type,
 esp_err_t mdns_service_add_for_host(const char *instance_name, const char *service_type, const char *proto,
                                     const char *hostname, uint16_t port, mdns_txt_item_t txt[], size_t num_items);
 
+/**
+ * @brief  Start a batch of service registrations
+ *
+ * Services added to the batch are validated and created at once, but registered only by
+ * mdns_service_batch_commit(), all together: they are probed and announced in a single cycle
+ * instead of one cycle per service.
+ *
+ * @return Batch handle, to be passed to mdns_service_batch_commit() or mdns_service_batch_abort().
+ *         NULL if mDNS is not running or out of memory.
+ */
+mdns_service_batch_t *mdns_service_batch_begin(void);
+
+/**
+ * @brief  Add a service to the batch, with the arguments of mdns_service_add_for_host()
+ *
+ * @note Nothing is registered until the batch is committed.
+ *
+ * @param  batch            batch handle from mdns_service_batch_begin()
+ * @param  instance_name    instance name to set. If NULL, global instance name or hostname will be used.
+ * @param  service_type     service type (_http, _ftp, etc)
+ * @param  proto            service protocol (_tcp, _udp)
+ * @param  hostname         service hostname. If NULL or the local hostname (in any case), the local hostname at
+ *                          commit will be used.
+ * @param  port             service port
+ * @param  txt              string array of TXT data (eg. {{"var","val"},{"other","2"}})
+ * @param  num_items        number of items in TXT data
+ *
+ * @return
+ *     - ESP_OK success
+ *     - ESP_ERR_INVALID_ARG Parameter error, or the service is already registered or in the batch
+ *     - ESP_ERR_NO_MEM memory error, or CONFIG_MDNS_MAX_SERVICES would be exceeded
+ */
+esp_err_t mdns_service_batch_add(mdns_service_batch_t *batch, const char *instance_name, const char *service_type,
+                                 const char *proto, const char *hostname, uint16_t port, mdns_txt_item_t txt[],
+                                 size_t num_items);
+
+/**
+ * @brief  Register all the services of the batch and free the batch
+ *
+ * The batch is registered entirely or not at all. It is checked again against the services
+ * registered since it was built, and its services of the local host get the current hostname.
+ *
+ * @param  batch            batch handle from mdns_service_batch_begin()
+ *
+ * @return
+ *     - ESP_OK success
+ *     - ESP_ERR_INVALID_ARG batch is NULL, or one of its services has been registered meanwhile
+ *     - ESP_ERR_INVALID_STATE mDNS is not running or has no hostname
+ *     - ESP_ERR_NO_MEM memory error, or CONFIG_MDNS_MAX_SERVICES would be exceeded
+ */
+esp_err_t mdns_service_batch_commit(mdns_service_batch_t *batch);
+
+/**
+ * @brief  Free the batch without registering its services
+ *
+ * @param  batch            batch handle from mdns_service_batch_begin(), may be NULL
+ */
+void mdns_service_batch_abort(mdns_service_batch_t *batch);
+
 /**
  * @brief  Check whether a service has been added.
  *
@@ -930,6 +1082,43 @@ mdns_browse_t *mdns_browse_new(const char *service, const char *proto, mdns_brow
  */
 esp_err_t mdns_browse_delete(const char *service, const char *proto);
 
+/**
+ * @brief   Browse mDNS for a service `_service._proto`, notifying each record change
+ *
+ * The PTR records of the service type, the SRV and TXT records of its instances and the A and AAAA records
+ * of their hosts are tracked one by one. The notifier gets the changes of every received packet at once, from
+ * the mDNS task: it must not block nor call mdns functions. A record already tracked and received again with the
+ * same data is not notified.
+ *
+ * The records are kept in storage allocated with the browse, about 170 bytes per record, records beyond
+ * max_records are ignored. The browse is stopped with mdns_browse_delete().
+ *
+ * @param service      Pointer to the `_service` which will be browsed.
+ * @param proto        Pointer to the `_proto` which will be browsed.
+ * @param max_records  Most records tracked at once (1-65535).
+ * @param notifier     The callback which will be called with the changes.
+ * @param arg          Argument of the notifier.
+ * @return mdns_browse_t pointer to new browse object if initiated successfully.
+ *         NULL otherwise, also if `_service._proto` is browsed already, with mdns_browse_new() or
+ *         mdns_browse_delta_new(), or about to be.
+ */
+mdns_browse_t *mdns_browse_delta_new(const char *service, const char *proto, size_t max_records,
+                                     mdns_browse_delta_notify_t notifier, void *arg);
+
+/**
+ * @brief   Get the statistics of the mDNS engine
+ *
+ * The counters run from mdns_init(), the per-interface traffic, latencies and other members marked (stats) in
+ * mdns_stats_t need CONFIG_MDNS_ENABLE_STATS.
+ *
+ * @param stats        Receives the statistics.
+ * @return
+ *     - ESP_OK                 success.
+ *     - ESP_ERR_INVALID_ARG    stats is NULL.
+ *     - ESP_ERR_INVALID_STATE  mDNS is not running.
+ */
+esp_err_t mdns_get_stats(mdns_stats_t *stats);
+
 #ifdef __cplusplus
 }
 #endif
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <ctype.h>
 #include <string.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
@@ -25,6 +26,10 @@ static void _mdns_browse_sync(mdns_browse_sync_t *browse_sync);
 static void _mdns_browse_finish(mdns_browse_t *browse);
 static void _mdns_browse_add(mdns_browse_t *browse);
 static void _mdns_browse_send(mdns_browse_t *browse, mdns_if_t interface);
+static void _mdns_browse_delta_record(const mdns_cache_record_t *record, bool flush, uint32_t ttl);
+static void _mdns_browse_delta_flush_all(void);
+static void _mdns_browse_delta_expire(mdns_browse_t *browse);
+static void _mdns_browse_delta_feed(mdns_browse_t *browse);
 
 #if CONFIG_ETH_ENABLED && CONFIG_MDNS_PREDEF_NETIF_ETH
 #include "esp_eth.h"
@@ -66,6 +71,13 @@ static SemaphoreHandle_t _mdns_service_semaphore = NULL;
 static StackType_t *_mdns_stack_buffer;
 
 static void _mdns_search_finish_done(void);
+static bool _mdns_record_read(mdns_parse_ctx_t *ctx, const uint8_t *data, size_t len, mdns_name_t *name, uint16_t type,
+                              const uint8_t *data_ptr, uint16_t data_len, mdns_if_t tcpip_if, mdns_ip_protocol_t ip_protocol,
+                              mdns_cache_record_t *record);
+static void _mdns_cache_add(const mdns_cache_record_t *record, bool flush, uint32_t ttl);
+static void _mdns_cache_remove_pcb(mdns_if_t tcpip_if, mdns_ip_protocol_t ip_protocol);
+static void _mdns_cache_clear(void);
+static bool _mdns_cache_feed_search(mdns_search_once_t *search);
 static mdns_search_once_t *_mdns_search_find_from(mdns_search_once_t *search, mdns_name_t *name, uint16_t type, mdns_if_t tcpip_if, mdns_ip_protocol_t ip_protocol);
 static mdns_browse_t *_mdns_browse_find_from(mdns_browse_t *b, mdns_name_t *name, uint16_t type, mdns_if_t tcpip_if, mdns_ip_protocol_t ip_protocol);
 static void _mdns_browse_result_add_srv(mdns_browse_t *browse, const char *hostname, const char *instance, const char *service, const char *proto,
@@ -89,6 +101,9 @@ static void _mdns_search_result_add_txt(mdns_search_once_t *search, mdns_txt_ite
 static mdns_result_t *_mdns_search_result_add_ptr(mdns_search_once_t *search, const char *instance,
                                                   const char *service_type, const char *proto, mdns_if_t tcpip_if,
                                                   mdns_ip_protocol_t ip_protocol, uint32_t ttl);
+static mdns_result_t *_mdns_search_result_get_instance(mdns_search_once_t *search, const char *instance,
+                                                       const char *service_type, const char *proto, mdns_if_t tcpip_if,
+                                                       mdns_ip_protocol_t ip_protocol, uint32_t ttl);
 static bool _mdns_append_host_list_in_services(mdns_out_answer_t **destination, mdns_srv_item_t *services[], size_t services_len, bool flush, bool bye);
 static bool _mdns_append_host_list(mdns_out_answer_t **destination, bool flush, bool bye);
 static void _mdns_remap_self_service_hostname(const char *old_hostname, const char *new_hostname);
@@ -226,6 +241,11 @@ static inline bool _str_null_or_empty(const char *str)
     return (str == NULL || *str == 0);
 }
 
+static inline bool _str_null_or_equal(const char *a, const char *b)
+{
+    return a == b || (a && b && !strcasecmp(a, b));
+}
+
 /*
  * @brief  Appends/increments a number to name/instance in case of collision
  * */
@@ -279,6 +299,226 @@ static bool _mdns_service_match(const mdns_service_t *srv, const char *service,
            (_str_null_or_empty(hostname) || !strcasecmp(srv->hostname, hostname));
 }
 
+#define MDNS_HASH_INIT  2166136261U
+#define MDNS_HASH_PRIME 16777619U
+
+/**
+ * @brief  continues a case insensitive FNV-1a hash over a string
+ */
+static uint32_t _mdns_hash_nocase(uint32_t hash, const char *str)
+{
+    while (*str) {
+        hash = (hash ^ (uint8_t)tolower((unsigned char)*str++)) * MDNS_HASH_PRIME;
+    }
+    return hash;
+}
+
+/**
+ * @brief  hashes a key (instance, hostname or subtype, NULL hashes as empty) with service and proto
+ */
+static uint32_t _mdns_service_hash(const char *key, const char *service, const char *proto)
+{
+    uint32_t hash = _mdns_hash_nocase(MDNS_HASH_INIT, key ? key : "");
+    hash = _mdns_hash_nocase((hash ^ '.') * MDNS_HASH_PRIME, service);
+    return _mdns_hash_nocase((hash ^ '.') * MDNS_HASH_PRIME, proto);
+}
+
+/**
+ * @brief  returns the service index bucket of the given service type
+ *
+ * PTR answers walk these buckets for every service of a type; lookups by instance, hostname
+ * or subtype use the indexes below. Items of the same type keep their relative order from the
+ * services list.
+ */
+static mdns_srv_item_t **_mdns_service_index_bucket(const char *service, const char *proto)
+{
+    uint32_t hash = _mdns_hash_nocase(MDNS_HASH_INIT, service);
+    hash = _mdns_hash_nocase((hash ^ '.') * MDNS_HASH_PRIME, proto);
+    return &_mdns_server->service_index[hash % MDNS_SERVICE_INDEX_SIZE];
+}
+
+/**
+ * @brief  returns the instance index bucket of (instance, service, proto)
+ */
+static mdns_srv_item_t **_mdns_instance_index_bucket(const char *instance, const char *service, const char *proto)
+{
+    return &_mdns_server->instance_index[_mdns_service_hash(instance, service, proto) % MDNS_SERVICE_INDEX_SIZE];
+}
+
+/**
+ * @brief  returns the host index bucket of (hostname, service, proto)
+ */
+static mdns_srv_item_t **_mdns_host_service_index_bucket(const char *hostname, const char *service, const char *proto)
+{
+    return &_mdns_server->host_service_index[_mdns_service_hash(hostname, service, proto) % MDNS_SERVICE_INDEX_SIZE];
+}
+
+/**
+ * @brief  returns the subtype index bucket of (subtype, service, proto)
+ */
+static mdns_subtype_t **_mdns_subtype_index_bucket(const char *subtype, const char *service, const char *proto)
+{
+    return &_mdns_server->subtype_index[_mdns_service_hash(subtype, service, proto) % MDNS_SERVICE_INDEX_SIZE];
+}
+
+static const char *_mdns_get_default_instance_name(void);
+
+/**
+ * @brief  instance name the service is indexed under, NULL stands for the default instance
+ *         as in _mdns_instance_name_match()
+ */
+static const char *_mdns_service_index_instance(const mdns_service_t *service)
+{
+    return service->instance ? service->instance : _mdns_get_default_instance_name();
+}
+
+/**
+ * @brief  adds subtype of a registered service to the subtype index
+ */
+static void _mdns_subtype_index_add(mdns_srv_item_t *item, mdns_subtype_t *subtype)
+{
+    mdns_subtype_t **bucket = _mdns_subtype_index_bucket(subtype->subtype, item->service->service, item->service->proto);
+    subtype->item = item;
+    subtype->index_next = *bucket;
+    *bucket = subtype;
+}
+
+/**
+ * @brief  removes subtype of a registered service from the subtype index, must be called before freeing it
+ */
+static void _mdns_subtype_index_remove(mdns_subtype_t *subtype)
+{
+    mdns_service_t *service = subtype->item->service;
+    mdns_subtype_t **s = _mdns_subtype_index_bucket(subtype->subtype, service->service, service->proto);
+    while (*s) {
+        if (*s == subtype) {
+            *s = subtype->index_next;
+            return;
+        }
+        s = &(*s)->index_next;
+    }
+}
+
+/**
+ * @brief  adds service item to the instance and host indexes
+ */
+static void _mdns_service_index_add_names(mdns_srv_item_t *item)
+{
+    mdns_service_t *service = item->service;
+    mdns_srv_item_t **bucket = _mdns_instance_index_bucket(_mdns_service_index_instance(service), service->service, service->proto);
+    item->instance_next = *bucket;
+    *bucket = item;
+    bucket = _mdns_host_service_index_bucket(service->hostname, service->service, service->proto);
+    item->host_next = *bucket;
+    *bucket = item;
+}
+
+/**
+ * @brief  removes service item from the instance index, before its instance name changes
+ */
+static void _mdns_service_index_remove_instance(mdns_srv_item_t *item)
+{
+    mdns_service_t *service = item->service;
+    mdns_srv_item_t **s = _mdns_instance_index_bucket(_mdns_service_index_instance(service), service->service, service->proto);
+    while (*s) {
+        if (*s == item) {
+            *s = item->instance_next;
+            return;
+        }
+        s = &(*s)->instance_next;
+    }
+}
+
+/**
+ * @brief  adds service item to the instance index, after its instance name changed
+ */
+static void _mdns_service_index_add_instance(mdns_srv_item_t *item)
+{
+    mdns_service_t *service = item->service;
+    mdns_srv_item_t **bucket = _mdns_instance_index_bucket(_mdns_service_index_instance(service), service->service, service->proto);
+    item->instance_next = *bucket;
+    *bucket = item;
+}
+
+/**
+ * @brief  adds service item to the indexes, must be called after prepending it to the services list
+ */
+static void _mdns_service_index_add(mdns_srv_item_t *item)
+{
+    mdns_srv_item_t **bucket = _mdns_service_index_bucket(item->service->service, item->service->proto);
+    item->index_next = *bucket;
+    *bucket = item;
+    _mdns_service_index_add_names(item);
+    for (mdns_subtype_t *subtype = item->service->subtype; subtype; subtype = subtype->next) {
+        _mdns_subtype_index_add(item, subtype);
+    }
+}
+
+/**
+ * @brief  removes service item and its subtypes from the indexes
+ */
+static void _mdns_service_index_remove(mdns_srv_item_t *item)
+{
+    mdns_service_t *service = item->service;
+    mdns_srv_item_t **s = _mdns_service_index_bucket(service->service, service->proto);
+    while (*s) {
+        if (*s == item) {
+            *s = item->index_next;
+            break;
+        }
+        s = &(*s)->index_next;
+    }
+    _mdns_service_index_remove_instance(item);
+    s = _mdns_host_service_index_bucket(service->hostname, service->service, service->proto);
+    while (*s) {
+        if (*s == item) {
+            *s = item->host_next;
+            break;
+        }
+        s = &(*s)->host_next;
+    }
+    for (mdns_subtype_t *subtype = service->subtype; subtype; subtype = subtype->next) {
+        _mdns_subtype_index_remove(subtype);
+    }
+}
+
+/**
+ * @brief  appends service item to the tails of its instance and host buckets
+ */
+static void _mdns_service_index_append_names(mdns_srv_item_t *item)
+{
+    mdns_service_t *service = item->service;
+    mdns_srv_item_t **s = _mdns_instance_index_bucket(_mdns_service_index_instance(service), service->service, service->proto);
+    while (*s) {
+        s = &(*s)->instance_next;
+    }
+    item->instance_next = NULL;
+    *s = item;
+    s = _mdns_host_service_index_bucket(service->hostname, service->service, service->proto);
+    while (*s) {
+        s = &(*s)->host_next;
+    }
+    item->host_next = NULL;
+    *s = item;
+}
+
+/**
+ * @brief  rebuilds the instance and host indexes, after the hostname or the default instance changed
+ *
+ * Self services follow the hostname and services without an instance name follow the default
+ * instance, so their buckets change with them. Items are appended in list order, so the buckets
+ * keep the order of the services list without a copy of it on the stack: this runs from the
+ * packet parser on collisions.
+ */
+static void _mdns_service_index_rebuild(void)
+{
+    memset(_mdns_server->instance_index, 0, sizeof(_mdns_server->instance_index));
+    memset(_mdns_server->host_service_index, 0, sizeof(_mdns_server->host_service_index));
+    for (mdns_srv_item_t *item = _mdns_server->services; item; item = item->next) {
+        _mdns_service_index_append_names(item);
+    }
+}
+
 /**
  * @brief  finds service from given service type
  * @param  server       the server
@@ -290,49 +530,80 @@ static bool _mdns_service_match(const mdns_service_t *srv, const char *service,
  */
 static mdns_srv_item_t *_mdns_get_service_item(const char *service, const char *proto, const char *hostname)
 {
-    mdns_srv_item_t *s = _mdns_server->services;
+    if (!service || !proto) {
+        return NULL;
+    }
+    if (!_str_null_or_empty(hostname)) {
+        mdns_srv_item_t *s = *_mdns_host_service_index_bucket(hostname, service, proto);
+        while (s) {
+            if (_mdns_service_match(s->service, service, proto, hostname)) {
+                return s;
+            }
+            s = s->host_next;
+        }
+        return NULL;
+    }
+    mdns_srv_item_t *s = *_mdns_service_index_bucket(service, proto);
     while (s) {
         if (_mdns_service_match(s->service, service, proto, hostname)) {
             return s;
         }
-        s = s->next;
+        s = s->index_next;
     }
     return NULL;
 }
 
 static mdns_srv_item_t *_mdns_get_service_item_subtype(const char *subtype, const char *service, const char *proto)
 {
-    mdns_srv_item_t *s = _mdns_server->services;
+    if (!service || !proto || !subtype) {
+        return NULL;
+    }
+    mdns_subtype_t *s = *_mdns_subtype_index_bucket(subtype, service, proto);
     while (s) {
-        if (_mdns_service_match(s->service, service, proto, NULL)) {
-            mdns_subtype_t *subtype_item = s->service->subtype;
-            while (subtype_item) {
-                if (!strcasecmp(subtype_item->subtype, subtype)) {
-                    return s;
-                }
-                subtype_item = subtype_item->next;
-            }
+        if (!strcasecmp(s->subtype, subtype) && _mdns_service_match(s->item->service, service, proto, NULL)) {
+            return s->item;
         }
-        s = s->next;
+        s = s->index_next;
     }
     return NULL;
 }
 
-static mdns_host_item_t *mdns_get_host_item(const char *hostname)
+/**
+ * @brief  delegated hostname index, kept in sync with _mdns_host_list
+ */
+static mdns_host_item_t *_mdns_host_index[MDNS_HOST_INDEX_SIZE];
+
+static mdns_host_item_t **_mdns_host_index_bucket(const char *hostname)
 {
-    if (hostname == NULL || strcasecmp(hostname, _mdns_server->hostname) == 0) {
-        return &_mdns_self_host;
+    return &_mdns_host_index[_mdns_hash_nocase(MDNS_HASH_INIT, hostname) % MDNS_HOST_INDEX_SIZE];
+}
+
+/**
+ * @brief  finds delegated host by its hostname
+ */
+static mdns_host_item_t *_mdns_get_delegated_host(const char *hostname)
+{
+    if (hostname == NULL) {
+        return NULL;
     }
-    mdns_host_item_t *host = _mdns_host_list;
+    mdns_host_item_t *host = *_mdns_host_index_bucket(hostname);
     while (host != NULL) {
         if (strcasecmp(host->hostname, hostname) == 0) {
             return host;
         }
-        host = host->next;
+        host = host->index_next;
     }
     return NULL;
 }
 
+static mdns_host_item_t *mdns_get_host_item(const char *hostname)
+{
+    if (hostname == NULL || strcasecmp(hostname, _mdns_server->hostname) == 0) {
+        return &_mdns_self_host;
+    }
+    return _mdns_get_delegated_host(hostname);
+}
+
 static bool _mdns_can_add_more_services(void)
 {
 #if MDNS_MAX_SERVICES == 0
@@ -351,20 +622,179 @@ static bool _mdns_can_add_more_services(void)
 #endif
 }
 
+/**
+ * @brief  links all the actions of the pool into its freelist
+ */
+static void _mdns_action_pool_init(void)
+{
+    for (uint8_t i = 0; i < MDNS_ACTION_POOL_LEN; i++) {
+        _mdns_server->action_pool.next[i] = i + 1 < MDNS_ACTION_POOL_LEN ? i + 2 : 0;
+    }
+    _mdns_server->action_pool.free = 1;
+}
+
+/**
+ * @brief  takes an action from the pool, NULL and counted as exhausted if it is empty
+ *
+ * Actions are posted from any task and the timer, so the freelist is a lock-free stack.
+ * The tag in the upper half of the head changes on every pop and push, so that a pop racing
+ * with a pop and push of the same action fails its compare and exchange instead of linking
+ * a stale next.
+ */
+static mdns_action_t *_mdns_action_alloc(void)
+{
+    uint32_t head = __atomic_load_n(&_mdns_server->action_pool.free, __ATOMIC_ACQUIRE);
+    uint32_t index;
+    uint32_t next;
+    do {
+        index = head & 0xFFFF;
+        if (!index) {
+            __atomic_add_fetch(&_mdns_server->action_pool.exhausted, 1, __ATOMIC_RELAXED);
+            return NULL;
+        }
+        next = ((head & 0xFFFF0000) + 0x10000) | __atomic_load_n(&_mdns_server->action_pool.next[index - 1], __ATOMIC_RELAXED);
+    } while (!__atomic_compare_exchange_n(&_mdns_server->action_pool.free, &head, next, true, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE));
+
+    uint32_t in_use = __atomic_add_fetch(&_mdns_server->action_pool.in_use, 1, __ATOMIC_RELAXED);
+    uint32_t peak = __atomic_load_n(&_mdns_server->action_pool.peak, __ATOMIC_RELAXED);
+    while (in_use > peak && !__atomic_compare_exchange_n(&_mdns_server->action_pool.peak, &peak, in_use, true,
+                                                         __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+    return &_mdns_server->action_pool.actions[index - 1];
+}
+
+/**
+ * @brief  returns an action to the pool
+ */
+static void _mdns_action_free(mdns_action_t *action)
+{
+    uint8_t index = action - _mdns_server->action_pool.actions + 1;
+    uint32_t head = __atomic_load_n(&_mdns_server->action_pool.free, __ATOMIC_RELAXED);
+    uint32_t next;
+    do {
+        __atomic_store_n(&_mdns_server->action_pool.next[index - 1], head & 0xFFFF, __ATOMIC_RELAXED);
+        next = ((head & 0xFFFF0000) + 0x10000) | index;
+    } while (!__atomic_compare_exchange_n(&_mdns_server->action_pool.free, &head, next, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+    __atomic_sub_fetch(&_mdns_server->action_pool.in_use, 1, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief  posts an action to the mDNS task
+ *
+ * @return true if posted, false if the queue was full
+ */
+static bool _mdns_action_post(mdns_action_t *action)
+{
+#if CONFIG_MDNS_ENABLE_STATS
+    // counted before the send, the mDNS task may take the action before this task runs again
+    uint32_t depth = __atomic_add_fetch(&_mdns_server->stats.action_depth, 1, __ATOMIC_RELAXED);
+#endif
+    if (xQueueSend(_mdns_server->action_queue, &action, (TickType_t)0) != pdPASS) {
+        MDNS_STATS_DEC(action_depth);
+        MDNS_STATS_INC(action_drops);
+        return false;
+    }
+#if CONFIG_MDNS_ENABLE_STATS
+    uint32_t peak = __atomic_load_n(&_mdns_server->stats.action_peak, __ATOMIC_RELAXED);
+    while (depth > peak && !__atomic_compare_exchange_n(&_mdns_server->stats.action_peak, &peak, depth, true,
+                                                         __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+#endif
+    return true;
+}
+
+#if CONFIG_MDNS_ENABLE_STATS
+static inline int64_t _mdns_stats_now(void)
+{
+    return esp_timer_get_time();
+}
+
+/**
+ * @brief  adds the duration from start to now to a latency histogram
+ */
+static void _mdns_stats_latency_add(mdns_stats_latency_t *latency, int64_t start)
+{
+    uint32_t us = esp_timer_get_time() - start;
+    uint8_t bucket = 0;
+    while (bucket < MDNS_STATS_LATENCY_BUCKETS - 1 && us >= (16U << bucket)) {
+        bucket++;
+    }
+    latency->buckets[bucket]++;
+    latency->total_us += us;
+    if (us > latency->max_us) {
+        latency->max_us = us;
+    }
+}
+
+static inline void _mdns_stats_rx(const mdns_rx_packet_t *packet)
+{
+    if (packet->tcpip_if < MDNS_MAX_INTERFACES && packet->ip_protocol < MDNS_IP_PROTOCOL_MAX) {
+        mdns_stats_netif_t *netif = &_mdns_server->stats.netif[packet->tcpip_if][packet->ip_protocol];
+        netif->rx_packets++;
+        netif->rx_bytes += packet->pb->tot_len;
+    }
+}
+
+static inline void _mdns_stats_parse_time(int64_t start)
+{
+    _mdns_stats_latency_add(&_mdns_server->stats.parse, start);
+}
+
+static inline void _mdns_stats_tx(mdns_if_t tcpip_if, mdns_ip_protocol_t ip_protocol, size_t len)
+{
+    if (tcpip_if < MDNS_MAX_INTERFACES && ip_protocol < MDNS_IP_PROTOCOL_MAX) {
+        mdns_stats_netif_t *netif = &_mdns_server->stats.netif[tcpip_if][ip_protocol];
+        netif->tx_packets++;
+        netif->tx_bytes += len;
+    }
+}
+
+static inline void _mdns_stats_tx_time(int64_t start)
+{
+    _mdns_stats_latency_add(&_mdns_server->stats.tx, start);
+}
+
+void _mdns_stats_malloc_failed(void)
+{
+    if (_mdns_server) {
+        MDNS_STATS_INC(malloc_failures);
+    }
+}
+#else
+static inline int64_t _mdns_stats_now(void)
+{
+    return 0;
+}
+
+static inline void _mdns_stats_rx(const mdns_rx_packet_t *packet) {}
+static inline void _mdns_stats_parse_time(int64_t start) {}
+static inline void _mdns_stats_tx(mdns_if_t tcpip_if, mdns_ip_protocol_t ip_protocol, size_t len) {}
+static inline void _mdns_stats_tx_time(int64_t start) {}
+#endif
+
 esp_err_t _mdns_send_rx_action(mdns_rx_packet_t *packet)
 {
     mdns_action_t *action = NULL;
 
-    action = (mdns_action_t *)mdns_mem_malloc(sizeof(mdns_action_t));
+    action = _mdns_action_alloc();
     if (!action) {
-        HOOK_MALLOC_FAILED;
         return ESP_ERR_NO_MEM;
     }
 
     action->type = ACTION_RX_HANDLE;
     action->data.rx_handle.packet = packet;
-    if (xQueueSend(_mdns_server->action_queue, &action, (TickType_t)0) != pdPASS) {
-        mdns_mem_free(action);
+    if (!_mdns_action_post(action)) {
+        _mdns_action_free(action);
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+
+esp_err_t _mdns_send_pooled_rx_action(mdns_action_t *action, mdns_rx_packet_t *packet)
+{
+    action->type = ACTION_RX_HANDLE_POOLED;
+    action->data.rx_handle.packet = packet;
+    if (!_mdns_action_post(action)) {
         return ESP_ERR_NO_MEM;
     }
     return ESP_OK;
@@ -422,22 +852,50 @@ static bool _mdns_service_match_instance(const mdns_service_t *srv, const char *
 static mdns_srv_item_t *_mdns_get_service_item_instance(const char *instance, const char *service, const char *proto,
                                                         const char *hostname)
 {
-    mdns_srv_item_t *s = _mdns_server->services;
+    if (!service || !proto) {
+        return NULL;
+    }
+    if (!instance) {
+        return _mdns_get_service_item(service, proto, hostname);
+    }
+    mdns_srv_item_t *s = *_mdns_instance_index_bucket(instance, service, proto);
     while (s) {
-        if (instance) {
-            if (_mdns_service_match_instance(s->service, instance, service, proto, hostname)) {
-                return s;
-            }
-        } else {
-            if (_mdns_service_match(s->service, service, proto, hostname)) {
-                return s;
-            }
+        if (_mdns_service_match_instance(s->service, instance, service, proto, hostname)) {
+            return s;
         }
-        s = s->next;
+        s = s->instance_next;
     }
     return NULL;
 }
 
+/**
+ * @brief  adds one label to the name being read
+ *
+ * @param  name         mdns_name_t structure to populate
+ * @param  buf          the label, null terminated
+ * @param  len          length of the label
+ */
+static inline void _mdns_read_label(mdns_name_t *name, char *buf, uint8_t len)
+{
+    // the lengths of "local", "arpa", "ip6", "in-addr" and "_sub" skip most comparisons
+    if (name->parts == 1 && buf[0] != '_'
+            && (len != 5 || strcasecmp(buf, MDNS_DEFAULT_DOMAIN) != 0)
+            && (len != 4 || strcasecmp(buf, "arpa") != 0)
+#ifndef CONFIG_MDNS_RESPOND_REVERSE_QUERIES
+            && (len != 3 || strcasecmp(buf, "ip6") != 0)
+            && (len != 7 || strcasecmp(buf, "in-addr") != 0)
+#endif
+       ) {
+        strlcat(name->host, ".", sizeof(name->host));
+        strlcat(name->host, buf, sizeof(name->host));
+    } else if (len == 4 && strcasecmp(buf, MDNS_SUB_STR) == 0) {
+        name->sub = 1;
+    } else if (!name->invalid) {
+        char *mdns_name_ptrs[] = {name->host, name->service, name->proto, name->domain};
+        memcpy(mdns_name_ptrs[name->parts++], buf, len + 1);
+    }
+}
+
 /**
  * @brief  reads MDNS FQDN into mdns_name_t structure
  *         FQDN is in format: [hostname.|[instance.]_service._proto.]local.
@@ -471,22 +929,7 @@ static const uint8_t *_mdns_read_fqdn(const uint8_t *packet, const uint8_t *star
                 buf[i] = start[index++];
             }
             buf[len] = '\0';
-            if (name->parts == 1 && buf[0] != '_'
-                    && (strcasecmp(buf, MDNS_DEFAULT_DOMAIN) != 0)
-                    && (strcasecmp(buf, "arpa") != 0)
-#ifndef CONFIG_MDNS_RESPOND_REVERSE_QUERIES
-                    && (strcasecmp(buf, "ip6") != 0)
-                    && (strcasecmp(buf, "in-addr") != 0)
-#endif
-               ) {
-                strlcat(name->host, ".", sizeof(name->host));
-                strlcat(name->host, buf, sizeof(name->host));
-            } else if (strcasecmp(buf, MDNS_SUB_STR) == 0) {
-                name->sub = 1;
-            } else if (!name->invalid) {
-                char *mdns_name_ptrs[] = {name->host, name->service, name->proto, name->domain};
-                memcpy(mdns_name_ptrs[name->parts++], buf, len + 1);
-            }
+            _mdns_read_label(name, buf, len);
         } else {
             size_t address = (((uint16_t)len & 0x3F) << 8) | start[index++];
             if ((packet + address) >= start) {
@@ -651,39 +1094,8 @@ static inline uint8_t _mdns_append_string(uint8_t *packet, uint16_t *index, cons
     return len + 1;
 }
 
-/**
- * @brief  appends one TXT record ("key=value" or "key")
- *
- * @param  packet       MDNS packet
- * @param  index        offset in the packet
- * @param  txt          one txt record
- *
- * @return length of added data: length of the added txt value + 1 on success
- *         0  if data won't fit the packet
- *         -1 if invalid TXT entry
- */
-static inline int append_one_txt_record_entry(uint8_t *packet, uint16_t *index, mdns_txt_linked_item_t *txt)
-{
-    if (txt == NULL || txt->key == NULL) {
-        return -1;
-    }
-    size_t key_len = strlen(txt->key);
-    size_t len = key_len + txt->value_len + (txt->value ? 1 : 0);
-    if ((*index + len + 1) >= MDNS_MAX_PACKET_SIZE) {
-        return 0;
-    }
-    _mdns_append_u8(packet, index, len);
-    memcpy(packet + *index, txt->key, key_len);
-    if (txt->value) {
-        packet[*index + key_len] = '=';
-        memcpy(packet + *index + key_len + 1, txt->value, txt->value_len);
-    }
-    *index += len;
-    return len + 1;
-}
-
-#ifdef CONFIG_MDNS_RESPOND_REVERSE_QUERIES
-static inline int append_single_str(uint8_t *packet, uint16_t *index, const char *str, int len)
+#ifdef CONFIG_MDNS_RESPOND_REVERSE_QUERIES
+static inline int append_single_str(uint8_t *packet, uint16_t *index, const char *str, int len)
 {
     if ((*index + len + 1) >= MDNS_MAX_PACKET_SIZE) {
         return 0;
@@ -736,92 +1148,216 @@ static uint16_t append_fqdn_dots(uint8_t *packet, uint16_t *index, const char *n
 }
 #endif /* CONFIG_MDNS_RESPOND_REVERSE_QUERIES */
 
+/**
+ * @brief  Build context of the mDNS task, other callers of _mdns_build_tx_packet() bring their own
+ */
+static mdns_tx_ctx_t _mdns_tx_ctx;
+static mdns_action_t _mdns_tx_action = { .type = ACTION_TX_HANDLE };
+static mdns_action_t _mdns_query_action = { .type = ACTION_SEARCH_SEND };
+
+/**
+ * @brief  clears the name compression dictionary, before building a new packet
+ */
+static void _mdns_name_dict_reset(mdns_name_dict_t *dict)
+{
+    memset(dict, 0, sizeof(mdns_name_dict_t));
+}
+
+/**
+ * @brief  continues a case insensitive FNV-1a hash over one label (length byte + characters)
+ */
+static uint32_t _mdns_name_hash_label(uint32_t hash, const char *label)
+{
+    hash = (hash ^ (uint8_t)strlen(label)) * MDNS_HASH_PRIME;
+    return _mdns_hash_nocase(hash, label);
+}
+
+/**
+ * @brief  checks if the name stored at offset (following compression pointers) equals the given labels
+ *
+ * @param  packet       MDNS packet
+ * @param  offset       offset of the first label of the stored name
+ * @param  end          number of valid bytes in the packet
+ * @param  strings      string array containing the parts of the FQDN
+ * @param  count        number of strings in the array
+ *
+ * @return true if the stored name has exactly these labels (compared case insensitive)
+ */
+static bool _mdns_name_matches(const uint8_t *packet, uint16_t offset, uint16_t end, const char *strings[], uint8_t count)
+{
+    uint8_t part = 0;
+    while (offset < end) {
+        uint8_t len = packet[offset];
+        if ((len & 0xC0) == 0xC0) {
+            if (offset + 1 >= end) {
+                return false;
+            }
+            uint16_t target = ((uint16_t)(len & 0x3F) << 8) | packet[offset + 1];
+            if (target >= offset) {
+                //only follow backward references, so we cannot loop
+                return false;
+            }
+            offset = target;
+            continue;
+        }
+        if (len == 0) {
+            return part == count;
+        }
+        if (part == count || len > 63 || offset + 1 + len > end) {
+            return false;
+        }
+        if (strlen(strings[part]) != len || strncasecmp(strings[part], (const char *)packet + offset + 1, len)) {
+            return false;
+        }
+        offset += 1 + len;
+        part++;
+    }
+    return false;
+}
+
+/**
+ * @brief  looks up a previously written occurrence of the name in the dictionary
+ *
+ * @return offset of the name in the packet or 0 if not found
+ */
+static uint16_t _mdns_name_dict_find(const mdns_name_dict_t *dict, const uint8_t *packet, uint16_t end,
+                                     const char *strings[], uint8_t count, uint16_t hash)
+{
+    uint16_t slot = hash & (MDNS_NAME_DICT_SIZE - 1);
+    for (uint16_t probes = 0; probes < MDNS_NAME_DICT_SIZE && dict->offset[slot]; probes++) {
+        if (dict->hash[slot] == hash && _mdns_name_matches(packet, dict->offset[slot], end, strings, count)) {
+            return dict->offset[slot];
+        }
+        slot = (slot + 1) & (MDNS_NAME_DICT_SIZE - 1);
+    }
+    return 0;
+}
+
+/**
+ * @brief  adds a name written at offset to the dictionary (silently ignored once 3/4 full)
+ */
+static void _mdns_name_dict_add(mdns_name_dict_t *dict, uint16_t hash, uint16_t offset)
+{
+    if (dict->used >= (MDNS_NAME_DICT_SIZE * 3) / 4) {
+        return;
+    }
+    uint16_t slot = hash & (MDNS_NAME_DICT_SIZE - 1);
+    while (dict->offset[slot]) {
+        slot = (slot + 1) & (MDNS_NAME_DICT_SIZE - 1);
+    }
+    dict->hash[slot] = hash;
+    dict->offset[slot] = offset;
+    dict->used++;
+}
+
+/**
+ * @brief  drops the names written from offset on, when the records there are taken back
+ *
+ * These are the latest entries, so no remaining entry was probed past their slots.
+ */
+static void _mdns_name_dict_truncate(mdns_name_dict_t *dict, uint16_t offset)
+{
+    for (uint16_t slot = 0; slot < MDNS_NAME_DICT_SIZE && dict->used; slot++) {
+        if (dict->offset[slot] >= offset) {
+            dict->offset[slot] = 0;
+            dict->used--;
+        }
+    }
+}
+
+/**
+ * @brief  flags the record being appended as not fitting the packet
+ *
+ * @return 0, the length of the failed append
+ */
+static inline uint16_t _mdns_tx_overflow(mdns_tx_ctx_t *ctx)
+{
+    ctx->overflow = true;
+    return 0;
+}
+
 /**
  * @brief  appends FQDN to a packet, incrementing the index and
  *         compressing the output if previous occurrence of the string (or part of it) has been found
  *
- * @param  packet       MDNS packet
+ * Compression targets are looked up in the name dictionary of the context, which holds every label suffix
+ * written by this function since the last _mdns_name_dict_reset().
+ *
+ * @param  ctx          packet being built
  * @param  index        offset in the packet
  * @param  strings      string array containing the parts of the FQDN
  * @param  count        number of strings in the array
  *
  * @return length of added data: 0 on error or length on success
  */
-static uint16_t _mdns_append_fqdn(uint8_t *packet, uint16_t *index, const char *strings[], uint8_t count, size_t packet_len)
-{
-    if (!count) {
-        //empty string so terminate
-        return _mdns_append_u8(packet, index, 0);
-    }
-    static char buf[MDNS_NAME_BUF_LEN];
-    uint8_t len = strlen(strings[0]);
-    //try to find first the string length in the packet (if it exists)
-    uint8_t *len_location = (uint8_t *)memchr(packet, (char)len, *index);
-    while (len_location) {
-        mdns_name_t name;
-        //check if the string after len_location is the string that we are looking for
-        if (memcmp(len_location + 1, strings[0], len)) { //not continuing with our string
-search_next:
-            //try and find the length byte further in the packet
-            len_location = (uint8_t *)memchr(len_location + 1, (char)len, *index - (len_location + 1 - packet));
-            continue;
+static uint16_t _mdns_append_fqdn(mdns_tx_ctx_t *ctx, uint16_t *index, const char *strings[], uint8_t count, size_t packet_len)
+{
+    uint8_t *packet = ctx->packet;
+    mdns_name_dict_t *dict = &ctx->names;
+    uint16_t suffix_hash[MDNS_NAME_DICT_MAX_PARTS];
+    uint16_t label_offset[MDNS_NAME_DICT_MAX_PARTS];
+    bool use_dict = count <= MDNS_NAME_DICT_MAX_PARTS;
+    uint16_t written = 0;
+    uint8_t i;
+
+    if (use_dict) {
+        //hash every suffix of the name, starting from the last label
+        uint32_t hash = MDNS_HASH_INIT;
+        for (i = count; i > 0; i--) {
+            hash = _mdns_name_hash_label(hash, strings[i - 1]);
+            suffix_hash[i - 1] = (uint16_t)(hash ^ (hash >> 16));
         }
-        //seems that we might have found the string that we are looking for
-        //read the destination into name and compare
-        name.parts = 0;
-        name.sub = 0;
-        name.invalid = false;
-        name.host[0] = 0;
-        name.service[0] = 0;
-        name.proto[0] = 0;
-        name.domain[0] = 0;
-        const uint8_t *content = _mdns_read_fqdn(packet, len_location, &name, buf, packet_len);
-        if (!content) {
-            //not a readable fqdn?
-            goto search_next; // could be our unfinished fqdn, continue searching
-        }
-        if (name.parts == count) {
-            uint8_t i;
-            for (i = 0; i < count; i++) {
-                if (strcasecmp(strings[i], (const char *)&name + (i * (MDNS_NAME_BUF_LEN)))) {
-                    //not our string! let's search more
-                    goto search_next;
+    }
+
+    for (i = 0; i < count; i++) {
+        if (use_dict) {
+            uint16_t offset = _mdns_name_dict_find(dict, packet, *index, &strings[i], count - i, suffix_hash[i]);
+            if (offset) {
+                //we have found the rest of the name so let's insert a pointer to it instead
+                uint8_t part_length = _mdns_append_u16(packet, index, offset | MDNS_NAME_REF);
+                if (!part_length) {
+                    return _mdns_tx_overflow(ctx);
                 }
+                written += part_length;
+                break;
             }
-            //we actually have found the string
-            break;
-        } else {
-            goto search_next;
+            label_offset[i] = *index;
+        }
+        uint8_t part_length = _mdns_append_string(packet, index, strings[i]);
+        if (!part_length) {
+            return _mdns_tx_overflow(ctx);
         }
+        written += part_length;
     }
-    //string is not yet in the packet, so let's add it
-    if (!len_location) {
-        uint8_t written = _mdns_append_string(packet, index, strings[0]);
-        if (!written) {
-            return 0;
+    if (i == count) {
+        //empty string so terminate
+        if (!_mdns_append_u8(packet, index, 0)) {
+            return _mdns_tx_overflow(ctx);
         }
-        //run the same for the other strings in the name
-        return written + _mdns_append_fqdn(packet, index, &strings[1], count - 1, packet_len);
+        written++;
     }
-
-    //we have found the string so let's insert a pointer to it instead
-    uint16_t offset = len_location - packet;
-    offset |= MDNS_NAME_REF;
-    return _mdns_append_u16(packet, index, offset);
+    if (use_dict) {
+        //the name is complete, so the labels written above can be referenced now
+        for (uint8_t j = 0; j < i; j++) {
+            _mdns_name_dict_add(dict, suffix_hash[j], label_offset[j]);
+        }
+    }
+    return written;
 }
 
 /**
  * @brief  appends PTR record for service to a packet, incrementing the index
  *
- * @param  packet       MDNS packet
+ * @param  ctx          packet being built
  * @param  index        offset in the packet
  * @param  server       the server that is hosting the service
  * @param  service      the service to add record for
  *
  * @return length of added data: 0 on error or length on success
  */
-static uint16_t _mdns_append_ptr_record(uint8_t *packet, uint16_t *index, const char *instance, const char *service, const char *proto, bool flush, bool bye)
+static uint16_t _mdns_append_ptr_record(mdns_tx_ctx_t *ctx, uint16_t *index, const char *instance, const char *service, const char *proto, bool flush, bool bye)
 {
+    uint8_t *packet = ctx->packet;
     const char *str[4];
     uint16_t record_length = 0;
     uint8_t part_length;
@@ -835,7 +1371,7 @@ static uint16_t _mdns_append_ptr_record(uint8_t *packet, uint16_t *index, const
     str[2] = proto;
     str[3] = MDNS_DEFAULT_DOMAIN;
 
-    part_length = _mdns_append_fqdn(packet, index, str + 1, 3, MDNS_MAX_PACKET_SIZE);
+    part_length = _mdns_append_fqdn(ctx, index, str + 1, 3, MDNS_MAX_PACKET_SIZE);
     if (!part_length) {
         return 0;
     }
@@ -843,12 +1379,12 @@ static uint16_t _mdns_append_ptr_record(uint8_t *packet, uint16_t *index, const
 
     part_length = _mdns_append_type(packet, index, MDNS_ANSWER_PTR, false, bye ? 0 : MDNS_ANSWER_PTR_TTL);
     if (!part_length) {
-        return 0;
+        return _mdns_tx_overflow(ctx);
     }
     record_length += part_length;
 
     uint16_t data_len_location = *index - 2;
-    part_length = _mdns_append_fqdn(packet, index, str, 4, MDNS_MAX_PACKET_SIZE);
+    part_length = _mdns_append_fqdn(ctx, index, str, 4, MDNS_MAX_PACKET_SIZE);
     if (!part_length) {
         return 0;
     }
@@ -860,7 +1396,7 @@ static uint16_t _mdns_append_ptr_record(uint8_t *packet, uint16_t *index, const
 /**
  * @brief  appends PTR record for a subtype to a packet, incrementing the index
  *
- * @param  packet       MDNS packet
+ * @param  ctx          packet being built
  * @param  index        offset in the packet
  * @param  instance     the service instance name
  * @param  subtype      the service subtype
@@ -870,10 +1406,11 @@ static uint16_t _mdns_append_ptr_record(uint8_t *packet, uint16_t *index, const
  *
  * @return length of added data: 0 on error or length on success
  */
-static uint16_t _mdns_append_subtype_ptr_record(uint8_t *packet, uint16_t *index, const char *instance,
+static uint16_t _mdns_append_subtype_ptr_record(mdns_tx_ctx_t *ctx, uint16_t *index, const char *instance,
                                                 const char *subtype, const char *service, const char *proto, bool flush,
                                                 bool bye)
 {
+    uint8_t *packet = ctx->packet;
     const char *subtype_str[5] = {subtype, MDNS_SUB_STR, service, proto, MDNS_DEFAULT_DOMAIN};
     const char *instance_str[4] = {instance, service, proto, MDNS_DEFAULT_DOMAIN};
     uint16_t record_length = 0;
@@ -883,7 +1420,7 @@ static uint16_t _mdns_append_subtype_ptr_record(uint8_t *packet, uint16_t *index
         return 0;
     }
 
-    part_length = _mdns_append_fqdn(packet, index, subtype_str, ARRAY_SIZE(subtype_str), MDNS_MAX_PACKET_SIZE);
+    part_length = _mdns_append_fqdn(ctx, index, subtype_str, ARRAY_SIZE(subtype_str), MDNS_MAX_PACKET_SIZE);
     if (!part_length) {
         return 0;
     }
@@ -891,12 +1428,12 @@ static uint16_t _mdns_append_subtype_ptr_record(uint8_t *packet, uint16_t *index
 
     part_length = _mdns_append_type(packet, index, MDNS_ANSWER_PTR, false, bye ? 0 : MDNS_ANSWER_PTR_TTL);
     if (!part_length) {
-        return 0;
+        return _mdns_tx_overflow(ctx);
     }
     record_length += part_length;
 
     uint16_t data_len_location = *index - 2;
-    part_length = _mdns_append_fqdn(packet, index, instance_str, ARRAY_SIZE(instance_str), MDNS_MAX_PACKET_SIZE);
+    part_length = _mdns_append_fqdn(ctx, index, instance_str, ARRAY_SIZE(instance_str), MDNS_MAX_PACKET_SIZE);
     if (!part_length) {
         return 0;
     }
@@ -908,15 +1445,16 @@ static uint16_t _mdns_append_subtype_ptr_record(uint8_t *packet, uint16_t *index
 /**
  * @brief  appends DNS-SD PTR record for service to a packet, incrementing the index
  *
- * @param  packet       MDNS packet
+ * @param  ctx          packet being built
  * @param  index        offset in the packet
  * @param  server       the server that is hosting the service
  * @param  service      the service to add record for
  *
  * @return length of added data: 0 on error or length on success
  */
-static uint16_t _mdns_append_sdptr_record(uint8_t *packet, uint16_t *index, mdns_service_t *service, bool flush, bool bye)
+static uint16_t _mdns_append_sdptr_record(mdns_tx_ctx_t *ctx, uint16_t *index, mdns_service_t *service, bool flush, bool bye)
 {
+    uint8_t *packet = ctx->packet;
     const char *str[3];
     const char *sd_str[4];
     uint16_t record_length = 0;
@@ -935,18 +1473,20 @@ static uint16_t _mdns_append_sdptr_record(uint8_t *packet, uint16_t *index, mdns
     str[1] = service->proto;
     str[2] = MDNS_DEFAULT_DOMAIN;
 
-    part_length = _mdns_append_fqdn(packet, index, sd_str, 4, MDNS_MAX_PACKET_SIZE);
-
+    part_length = _mdns_append_fqdn(ctx, index, sd_str, 4, MDNS_MAX_PACKET_SIZE);
+    if (!part_length) {
+        return 0;
+    }
     record_length += part_length;
 
     part_length = _mdns_append_type(packet, index, MDNS_ANSWER_PTR, flush, MDNS_ANSWER_PTR_TTL);
     if (!part_length) {
-        return 0;
+        return _mdns_tx_overflow(ctx);
     }
     record_length += part_length;
 
     uint16_t data_len_location = *index - 2;
-    part_length = _mdns_append_fqdn(packet, index, str, 3, MDNS_MAX_PACKET_SIZE);
+    part_length = _mdns_append_fqdn(ctx, index, str, 3, MDNS_MAX_PACKET_SIZE);
     if (!part_length) {
         return 0;
     }
@@ -958,15 +1498,16 @@ static uint16_t _mdns_append_sdptr_record(uint8_t *packet, uint16_t *index, mdns
 /**
  * @brief  appends TXT record for service to a packet, incrementing the index
  *
- * @param  packet       MDNS packet
+ * @param  ctx          packet being built
  * @param  index        offset in the packet
  * @param  server       the server that is hosting the service
  * @param  service      the service to add record for
  *
  * @return length of added data: 0 on error or length on success
  */
-static uint16_t _mdns_append_txt_record(uint8_t *packet, uint16_t *index, mdns_service_t *service, bool flush, bool bye)
+static uint16_t _mdns_append_txt_record(mdns_tx_ctx_t *ctx, uint16_t *index, mdns_service_t *service, bool flush, bool bye)
 {
+    uint8_t *packet = ctx->packet;
     const char *str[4];
     uint16_t record_length = 0;
     uint8_t part_length;
@@ -984,7 +1525,7 @@ static uint16_t _mdns_append_txt_record(uint8_t *packet, uint16_t *index, mdns_s
         return 0;
     }
 
-    part_length = _mdns_append_fqdn(packet, index, str, 4, MDNS_MAX_PACKET_SIZE);
+    part_length = _mdns_append_fqdn(ctx, index, str, 4, MDNS_MAX_PACKET_SIZE);
     if (!part_length) {
         return 0;
     }
@@ -992,28 +1533,22 @@ static uint16_t _mdns_append_txt_record(uint8_t *packet, uint16_t *index, mdns_s
 
     part_length = _mdns_append_type(packet, index, MDNS_ANSWER_TXT, flush, bye ? 0 : MDNS_ANSWER_TXT_TTL);
     if (!part_length) {
-        return 0;
+        return _mdns_tx_overflow(ctx);
     }
     record_length += part_length;
 
     uint16_t data_len_location = *index - 2;
-    uint16_t data_len = 0;
-
-    mdns_txt_linked_item_t *txt = service->txt;
-    while (txt) {
-        int l = append_one_txt_record_entry(packet, index, txt);
-        if (l > 0) {
-            data_len += l;
-        } else if (l == 0) { // TXT entry won't fit into the mdns packet
-            return 0;
-        }
-        txt = txt->next;
+    uint16_t data_len = service->txt_len ? service->txt_len : 1;
+
+    if ((*index + data_len) > MDNS_MAX_PACKET_SIZE) {
+        return _mdns_tx_overflow(ctx);
     }
-    if (!data_len) {
-        data_len = 1;
-        packet[*index] = 0;
-        *index = *index + 1;
+    if (service->txt_len) {
+        memcpy(packet + *index, service->txt, data_len);
+    } else {
+        packet[*index] = 0; // no items: one empty string
     }
+    *index += data_len;
     _mdns_set_u16(packet, data_len_location, data_len);
     record_length += data_len;
     return record_length;
@@ -1022,15 +1557,16 @@ static uint16_t _mdns_append_txt_record(uint8_t *packet, uint16_t *index, mdns_s
 /**
  * @brief  appends SRV record for service to a packet, incrementing the index
  *
- * @param  packet       MDNS packet
+ * @param  ctx          packet being built
  * @param  index        offset in the packet
  * @param  server       the server that is hosting the service
  * @param  service      the service to add record for
  *
  * @return length of added data: 0 on error or length on success
  */
-static uint16_t _mdns_append_srv_record(uint8_t *packet, uint16_t *index, mdns_service_t *service, bool flush, bool bye)
+static uint16_t _mdns_append_srv_record(mdns_tx_ctx_t *ctx, uint16_t *index, mdns_service_t *service, bool flush, bool bye)
 {
+    uint8_t *packet = ctx->packet;
     const char *str[4];
     uint16_t record_length = 0;
     uint8_t part_length;
@@ -1044,11 +1580,11 @@ static uint16_t _mdns_append_srv_record(uint8_t *packet, uint16_t *index, mdns_s
     str[2] = service->proto;
     str[3] = MDNS_DEFAULT_DOMAIN;
 
-    if (!str[0]) {
+    if (!str[0] || _str_null_or_empty(service->hostname ? service->hostname : _mdns_server->hostname)) {
         return 0;
     }
 
-    part_length = _mdns_append_fqdn(packet, index, str, 4, MDNS_MAX_PACKET_SIZE);
+    part_length = _mdns_append_fqdn(ctx, index, str, 4, MDNS_MAX_PACKET_SIZE);
     if (!part_length) {
         return 0;
     }
@@ -1056,7 +1592,7 @@ static uint16_t _mdns_append_srv_record(uint8_t *packet, uint16_t *index, mdns_s
 
     part_length = _mdns_append_type(packet, index, MDNS_ANSWER_SRV, flush, bye ? 0 : MDNS_ANSWER_SRV_TTL);
     if (!part_length) {
-        return 0;
+        return _mdns_tx_overflow(ctx);
     }
     record_length += part_length;
 
@@ -1067,7 +1603,7 @@ static uint16_t _mdns_append_srv_record(uint8_t *packet, uint16_t *index, mdns_s
     part_length += _mdns_append_u16(packet, index, service->weight);
     part_length += _mdns_append_u16(packet, index, service->port);
     if (part_length != 6) {
-        return 0;
+        return _mdns_tx_overflow(ctx);
     }
 
     if (service->hostname) {
@@ -1077,11 +1613,7 @@ static uint16_t _mdns_append_srv_record(uint8_t *packet, uint16_t *index, mdns_s
     }
     str[1] = MDNS_DEFAULT_DOMAIN;
 
-    if (_str_null_or_empty(str[0])) {
-        return 0;
-    }
-
-    part_length = _mdns_append_fqdn(packet, index, str, 2, MDNS_MAX_PACKET_SIZE);
+    part_length = _mdns_append_fqdn(ctx, index, str, 2, MDNS_MAX_PACKET_SIZE);
     if (!part_length) {
         return 0;
     }
@@ -1095,15 +1627,16 @@ static uint16_t _mdns_append_srv_record(uint8_t *packet, uint16_t *index, mdns_s
 /**
  * @brief  appends A record to a packet, incrementing the index
  *
- * @param  packet       MDNS packet
+ * @param  ctx          packet being built
  * @param  index        offset in the packet
  * @param  hostname     the hostname address to add
  * @param  ip           the IP address to add
  *
  * @return length of added data: 0 on error or length on success
  */
-static uint16_t _mdns_append_a_record(uint8_t *packet, uint16_t *index, const char *hostname, uint32_t ip, bool flush, bool bye)
+static uint16_t _mdns_append_a_record(mdns_tx_ctx_t *ctx, uint16_t *index, const char *hostname, uint32_t ip, bool flush, bool bye)
 {
+    uint8_t *packet = ctx->packet;
     const char *str[2];
     uint16_t record_length = 0;
     uint8_t part_length;
@@ -1115,7 +1648,7 @@ static uint16_t _mdns_append_a_record(uint8_t *packet, uint16_t *index, const ch
         return 0;
     }
 
-    part_length = _mdns_append_fqdn(packet, index, str, 2, MDNS_MAX_PACKET_SIZE);
+    part_length = _mdns_append_fqdn(ctx, index, str, 2, MDNS_MAX_PACKET_SIZE);
     if (!part_length) {
         return 0;
     }
@@ -1123,14 +1656,14 @@ static uint16_t _mdns_append_a_record(uint8_t *packet, uint16_t *index, const ch
 
     part_length = _mdns_append_type(packet, index, MDNS_ANSWER_A, flush, bye ? 0 : MDNS_ANSWER_A_TTL);
     if (!part_length) {
-        return 0;
+        return _mdns_tx_overflow(ctx);
     }
     record_length += part_length;
 
     uint16_t data_len_location = *index - 2;
 
     if ((*index + 3) >= MDNS_MAX_PACKET_SIZE) {
-        return 0;
+        return _mdns_tx_overflow(ctx);
     }
     _mdns_append_u8(packet, index, ip & 0xFF);
     _mdns_append_u8(packet, index, (ip >> 8) & 0xFF);
@@ -1147,15 +1680,16 @@ static uint16_t _mdns_append_a_record(uint8_t *packet, uint16_t *index, const ch
 /**
  * @brief  appends AAAA record to a packet, incrementing the index
  *
- * @param  packet       MDNS packet
+ * @param  ctx          packet being built
  * @param  index        offset in the packet
  * @param  hostname     the hostname address to add
  * @param  ipv6         the IPv6 address to add
  *
  * @return length of added data: 0 on error or length on success
  */
-static uint16_t _mdns_append_aaaa_record(uint8_t *packet, uint16_t *index, const char *hostname, uint8_t *ipv6, bool flush, bool bye)
+static uint16_t _mdns_append_aaaa_record(mdns_tx_ctx_t *ctx, uint16_t *index, const char *hostname, uint8_t *ipv6, bool flush, bool bye)
 {
+    uint8_t *packet = ctx->packet;
     const char *str[2];
     uint16_t record_length = 0;
     uint8_t part_length;
@@ -1168,7 +1702,7 @@ static uint16_t _mdns_append_aaaa_record(uint8_t *packet, uint16_t *index, const
     }
 
 
-    part_length = _mdns_append_fqdn(packet, index, str, 2, MDNS_MAX_PACKET_SIZE);
+    part_length = _mdns_append_fqdn(ctx, index, str, 2, MDNS_MAX_PACKET_SIZE);
     if (!part_length) {
         return 0;
     }
@@ -1176,14 +1710,14 @@ static uint16_t _mdns_append_aaaa_record(uint8_t *packet, uint16_t *index, const
 
     part_length = _mdns_append_type(packet, index, MDNS_ANSWER_AAAA, flush, bye ? 0 : MDNS_ANSWER_AAAA_TTL);
     if (!part_length) {
-        return 0;
+        return _mdns_tx_overflow(ctx);
     }
     record_length += part_length;
 
     uint16_t data_len_location = *index - 2;
 
     if ((*index + MDNS_ANSWER_AAAA_SIZE) > MDNS_MAX_PACKET_SIZE) {
-        return 0;
+        return _mdns_tx_overflow(ctx);
     }
 
     part_length = MDNS_ANSWER_AAAA_SIZE;
@@ -1198,14 +1732,15 @@ static uint16_t _mdns_append_aaaa_record(uint8_t *packet, uint16_t *index, const
 /**
  * @brief  Append question to packet
  */
-static uint16_t _mdns_append_question(uint8_t *packet, uint16_t *index, mdns_out_question_t *q)
+static uint16_t _mdns_append_question(mdns_tx_ctx_t *ctx, uint16_t *index, mdns_out_question_t *q)
 {
+    uint8_t *packet = ctx->packet;
     uint8_t part_length;
 #ifdef CONFIG_MDNS_RESPOND_REVERSE_QUERIES
     if (q->host && (strstr(q->host, "in-addr") || strstr(q->host, "ip6"))) {
         part_length = append_fqdn_dots(packet, index, q->host, false);
         if (!part_length) {
-            return 0;
+            return _mdns_tx_overflow(ctx);
         }
     } else
 #endif /* CONFIG_MDNS_RESPOND_REVERSE_QUERIES */
@@ -1224,15 +1759,16 @@ static uint16_t _mdns_append_question(uint8_t *packet, uint16_t *index, mdns_out
         if (q->domain) {
             str[str_index++] = q->domain;
         }
-        part_length = _mdns_append_fqdn(packet, index, str, str_index, MDNS_MAX_PACKET_SIZE);
+        part_length = _mdns_append_fqdn(ctx, index, str, str_index, MDNS_MAX_PACKET_SIZE);
         if (!part_length) {
             return 0;
         }
     }
 
-    part_length += _mdns_append_u16(packet, index, q->type);
-    part_length += _mdns_append_u16(packet, index, q->unicast ? 0x8001 : 0x0001);
-    return part_length;
+    if (!_mdns_append_u16(packet, index, q->type) || !_mdns_append_u16(packet, index, q->unicast ? 0x8001 : 0x0001)) {
+        return _mdns_tx_overflow(ctx);
+    }
+    return part_length + 4;
 }
 
 /**
@@ -1283,7 +1819,7 @@ static bool _ipv6_address_is_zero(esp_ip6_addr_t ip6)
 }
 #endif /* CONFIG_LWIP_IPV6 */
 
-static uint8_t _mdns_append_host_answer(uint8_t *packet, uint16_t *index, mdns_host_item_t *host,
+static uint8_t _mdns_append_host_answer(mdns_tx_ctx_t *ctx, uint16_t *index, mdns_host_item_t *host,
                                         uint8_t address_type, bool flush, bool bye)
 {
     mdns_ip_addr_t *addr = host->address_list;
@@ -1293,13 +1829,13 @@ static uint8_t _mdns_append_host_answer(uint8_t *packet, uint16_t *index, mdns_h
         if (addr->addr.type == address_type) {
 #ifdef CONFIG_LWIP_IPV4
             if (address_type == ESP_IPADDR_TYPE_V4 &&
-                    _mdns_append_a_record(packet, index, host->hostname, addr->addr.u_addr.ip4.addr, flush, bye) <= 0) {
+                    _mdns_append_a_record(ctx, index, host->hostname, addr->addr.u_addr.ip4.addr, flush, bye) <= 0) {
                 break;
             }
 #endif /* CONFIG_LWIP_IPV4 */
 #ifdef CONFIG_LWIP_IPV6
             if (address_type == ESP_IPADDR_TYPE_V6 &&
-                    _mdns_append_aaaa_record(packet, index, host->hostname, (uint8_t *)addr->addr.u_addr.ip6.addr, flush,
+                    _mdns_append_aaaa_record(ctx, index, host->hostname, (uint8_t *)addr->addr.u_addr.ip6.addr, flush,
                                              bye) <= 0) {
                 break;
             }
@@ -1315,24 +1851,25 @@ static uint8_t _mdns_append_host_answer(uint8_t *packet, uint16_t *index, mdns_h
 /**
  * @brief Appends reverse lookup PTR record
  */
-static uint8_t _mdns_append_reverse_ptr_record(uint8_t *packet, uint16_t *index, const char *name)
+static uint8_t _mdns_append_reverse_ptr_record(mdns_tx_ctx_t *ctx, uint16_t *index, const char *name)
 {
+    uint8_t *packet = ctx->packet;
     if (strstr(name, "in-addr") == NULL && strstr(name, "ip6") == NULL) {
         return 0;
     }
 
     if (!append_fqdn_dots(packet, index, name, false)) {
-        return 0;
+        return _mdns_tx_overflow(ctx);
     }
 
     if (!_mdns_append_type(packet, index, MDNS_ANSWER_PTR, false, 10 /* TTL set to 10s*/)) {
-        return 0;
+        return _mdns_tx_overflow(ctx);
     }
 
     uint16_t data_len_location = *index - 2; /* store the position of size (2=16bis) of this record */
     const char *str[2] = { _mdns_self_host.hostname, MDNS_DEFAULT_DOMAIN };
 
-    int part_length = _mdns_append_fqdn(packet, index, str, 2, MDNS_MAX_PACKET_SIZE);
+    int part_length = _mdns_append_fqdn(ctx, index, str, 2, MDNS_MAX_PACKET_SIZE);
     if (!part_length) {
         return 0;
     }
@@ -1347,12 +1884,12 @@ static uint8_t _mdns_append_reverse_ptr_record(uint8_t *packet, uint16_t *index,
  *
  *  @return number of answers added to the packet
  */
-static uint8_t _mdns_append_service_ptr_answers(uint8_t *packet, uint16_t *index, mdns_service_t *service, bool flush,
+static uint8_t _mdns_append_service_ptr_answers(mdns_tx_ctx_t *ctx, uint16_t *index, mdns_service_t *service, bool flush,
                                                 bool bye)
 {
     uint8_t appended_answers = 0;
 
-    if (_mdns_append_ptr_record(packet, index, _mdns_get_service_instance_name(service), service->service,
+    if (_mdns_append_ptr_record(ctx, index, _mdns_get_service_instance_name(service), service->service,
                                 service->proto, flush, bye) <= 0) {
         return appended_answers;
     }
@@ -1361,7 +1898,7 @@ static uint8_t _mdns_append_service_ptr_answers(uint8_t *packet, uint16_t *index
     mdns_subtype_t *subtype = service->subtype;
     while (subtype) {
         appended_answers +=
-            (_mdns_append_subtype_ptr_record(packet, index, _mdns_get_service_instance_name(service), subtype->subtype,
+            (_mdns_append_subtype_ptr_record(ctx, index, _mdns_get_service_instance_name(service), subtype->subtype,
                                              service->service, service->proto, flush, bye) > 0);
         subtype = subtype->next;
     }
@@ -1375,7 +1912,7 @@ static uint8_t _mdns_append_service_ptr_answers(uint8_t *packet, uint16_t *index
  *
  *  @return number of answers added to the packet
  */
-static uint8_t _mdns_append_answer(uint8_t *packet, uint16_t *index, mdns_out_answer_t *answer, mdns_if_t tcpip_if)
+static uint8_t _mdns_append_answer(mdns_tx_ctx_t *ctx, uint16_t *index, mdns_out_answer_t *answer, mdns_if_t tcpip_if)
 {
     if (answer->host) {
         bool is_host_valid = (&_mdns_self_host == answer->host);
@@ -1393,23 +1930,23 @@ static uint8_t _mdns_append_answer(uint8_t *packet, uint16_t *index, mdns_out_an
 
     if (answer->type == MDNS_TYPE_PTR) {
         if (answer->service) {
-            return _mdns_append_service_ptr_answers(packet, index, answer->service, answer->flush, answer->bye);
+            return _mdns_append_service_ptr_answers(ctx, index, answer->service, answer->flush, answer->bye);
 #ifdef CONFIG_MDNS_RESPOND_REVERSE_QUERIES
         } else if (answer->host && answer->host->hostname &&
                    (strstr(answer->host->hostname, "in-addr") || strstr(answer->host->hostname, "ip6"))) {
-            return _mdns_append_reverse_ptr_record(packet, index, answer->host->hostname) > 0;
+            return _mdns_append_reverse_ptr_record(ctx, index, answer->host->hostname) > 0;
 #endif /* CONFIG_MDNS_RESPOND_REVERSE_QUERIES */
         } else {
-            return _mdns_append_ptr_record(packet, index,
+            return _mdns_append_ptr_record(ctx, index,
                                            answer->custom_instance, answer->custom_service, answer->custom_proto,
                                            answer->flush, answer->bye) > 0;
         }
     } else if (answer->type == MDNS_TYPE_SRV) {
-        return _mdns_append_srv_record(packet, index, answer->service, answer->flush, answer->bye) > 0;
+        return _mdns_append_srv_record(ctx, index, answer->service, answer->flush, answer->bye) > 0;
     } else if (answer->type == MDNS_TYPE_TXT) {
-        return _mdns_append_txt_record(packet, index, answer->service, answer->flush, answer->bye) > 0;
+        return _mdns_append_txt_record(ctx, index, answer->service, answer->flush, answer->bye) > 0;
     } else if (answer->type == MDNS_TYPE_SDPTR) {
-        return _mdns_append_sdptr_record(packet, index, answer->service, answer->flush, answer->bye) > 0;
+        return _mdns_append_sdptr_record(ctx, index, answer->service, answer->flush, answer->bye) > 0;
     }
 #ifdef CONFIG_LWIP_IPV4
     else if (answer->type == MDNS_TYPE_A) {
@@ -1421,7 +1958,7 @@ static uint8_t _mdns_append_answer(uint8_t *packet, uint16_t *index, mdns_out_an
             if (esp_netif_get_ip_info(_mdns_get_esp_netif(tcpip_if), &if_ip_info)) {
                 return 0;
             }
-            if (_mdns_append_a_record(packet, index, _mdns_server->hostname, if_ip_info.ip.addr, answer->flush, answer->bye) <= 0) {
+            if (_mdns_append_a_record(ctx, index, _mdns_server->hostname, if_ip_info.ip.addr, answer->flush, answer->bye) <= 0) {
                 return 0;
             }
             if (!_mdns_if_is_dup(tcpip_if)) {
@@ -1431,12 +1968,12 @@ static uint8_t _mdns_append_answer(uint8_t *packet, uint16_t *index, mdns_out_an
             if (esp_netif_get_ip_info(_mdns_get_esp_netif(other_if), &if_ip_info)) {
                 return 1;
             }
-            if (_mdns_append_a_record(packet, index, _mdns_server->hostname, if_ip_info.ip.addr, answer->flush, answer->bye) > 0) {
+            if (_mdns_append_a_record(ctx, index, _mdns_server->hostname, if_ip_info.ip.addr, answer->flush, answer->bye) > 0) {
                 return 2;
             }
             return 1;
         } else if (answer->host != NULL) {
-            return _mdns_append_host_answer(packet, index, answer->host, ESP_IPADDR_TYPE_V4, answer->flush, answer->bye);
+            return _mdns_append_host_answer(ctx, index, answer->host, ESP_IPADDR_TYPE_V4, answer->flush, answer->bye);
         }
     }
 #endif /* CONFIG_LWIP_IPV4 */
@@ -1454,7 +1991,7 @@ static uint8_t _mdns_append_answer(uint8_t *packet, uint16_t *index, mdns_out_an
                 if (_ipv6_address_is_zero(if_ip6s[i])) {
                     return 0;
                 }
-                if (_mdns_append_aaaa_record(packet, index, _mdns_server->hostname, (uint8_t *)if_ip6s[i].addr,
+                if (_mdns_append_aaaa_record(ctx, index, _mdns_server->hostname, (uint8_t *)if_ip6s[i].addr,
                                              answer->flush, answer->bye) <= 0) {
                     return 0;
                 }
@@ -1468,13 +2005,13 @@ static uint8_t _mdns_append_answer(uint8_t *packet, uint16_t *index, mdns_out_an
             if (esp_netif_get_ip6_linklocal(_mdns_get_esp_netif(other_if), &other_ip6)) {
                 return count;
             }
-            if (_mdns_append_aaaa_record(packet, index, _mdns_server->hostname, (uint8_t *)other_ip6.addr,
+            if (_mdns_append_aaaa_record(ctx, index, _mdns_server->hostname, (uint8_t *)other_ip6.addr,
                                          answer->flush, answer->bye) > 0) {
                 return 1 + count;
             }
             return count;
         } else if (answer->host != NULL) {
-            return _mdns_append_host_answer(packet, index, answer->host, ESP_IPADDR_TYPE_V6, answer->flush,
+            return _mdns_append_host_answer(ctx, index, answer->host, ESP_IPADDR_TYPE_V6, answer->flush,
                                             answer->bye);
         }
     }
@@ -1483,72 +2020,173 @@ static uint8_t _mdns_append_answer(uint8_t *packet, uint16_t *index, mdns_out_an
 }
 
 /**
- * @brief  sends a packet
+ * @brief  appends the records of the packet from where the context left off, until one does not fit
+ *
+ * Records leave in the order of the packet: answers, then authority and additional records. A record
+ * that does not fit is taken back, and the context points the next packet to it. A record too large
+ * for any packet is left out.
+ *
+ * @param  ctx          build context, holding the header and the questions
+ * @param  p            the packet
+ * @param  index        offset of the first record
+ * @param  split        whether the records can continue in the next packet before one fits this one
+ *
+ * @return length of the serialized packet
+ */
+static uint16_t _mdns_build_tx_records(mdns_tx_ctx_t *ctx, mdns_tx_packet_t *p, uint16_t index, bool split)
+{
+    static const uint16_t count_offset[MDNS_TX_SECTIONS] = {
+        MDNS_HEAD_ANSWERS_OFFSET, MDNS_HEAD_SERVERS_OFFSET, MDNS_HEAD_ADDITIONAL_OFFSET
+    };
+    mdns_out_answer_t *sections[MDNS_TX_SECTIONS] = { p->answers, p->servers, p->additional };
+    mdns_out_answer_t *a = ctx->next_answer;
+    uint8_t section = ctx->next_section;
+
+    ctx->next_section = MDNS_TX_SECTIONS;
+    ctx->next_answer = NULL;
+    for (; section < MDNS_TX_SECTIONS; section++, a = NULL) {
+        uint16_t count = 0;
+        if (!a) {
+            a = sections[section];
+        }
+        while (a) {
+            uint16_t start = index;
+            ctx->overflow = false;
+            uint8_t records = _mdns_append_answer(ctx, &index, a, p->tcpip_if);
+            if (ctx->overflow || !records) {
+                index = start;
+                _mdns_name_dict_truncate(&ctx->names, start);
+            }
+            if (ctx->overflow && split) {
+                ctx->next_section = section;
+                ctx->next_answer = a;
+                _mdns_set_u16(ctx->packet, count_offset[section], count);
+                return index;
+            }
+            if (!ctx->overflow) {
+                count += records;
+                split |= records > 0;
+            }
+            a = a->next;
+        }
+        _mdns_set_u16(ctx->packet, count_offset[section], count);
+    }
+    return index;
+}
+
+/**
+ * @brief  sets the flags of the packet built, with the TC bit on a query whose known answers continue
+ */
+static void _mdns_build_tx_flags(mdns_tx_ctx_t *ctx, mdns_tx_packet_t *p, uint16_t index)
+{
+    uint16_t flags = p->flags;
+    if (!(flags & MDNS_FLAGS_QUERY_REPSONSE) && ctx->next_section < MDNS_TX_SECTIONS) {
+        flags |= MDNS_FLAGS_DISTRIBUTED;
+    }
+    _mdns_set_u16(ctx->packet, MDNS_HEAD_FLAGS_OFFSET, flags);
+
+#ifdef MDNS_ENABLE_DEBUG
+    _mdns_dbg_printf("\nTX[%lu][%lu]: ", (unsigned long)p->tcpip_if, (unsigned long)p->ip_protocol);
+#ifdef CONFIG_LWIP_IPV4
+    if (p->dst.type == ESP_IPADDR_TYPE_V4) {
+        _mdns_dbg_printf("To: " IPSTR ":%u, ", IP2STR(&p->dst.u_addr.ip4), p->port);
+    }
+#endif
+#ifdef CONFIG_LWIP_IPV6
+    if (p->dst.type == ESP_IPADDR_TYPE_V6) {
+        _mdns_dbg_printf("To: " IPV6STR ":%u, ", IPV62STR(p->dst.u_addr.ip6), p->port);
+    }
+#endif
+    mdns_debug_packet(ctx->packet, index);
+#endif
+}
+
+/**
+ * @brief  serializes a packet into the build context
  *
+ * Reentrant: the scratch state is in ctx, the services and hosts are only read.
+ * When the records do not fit, the packet holds the first ones and _mdns_build_tx_next() builds the rest.
+ *
+ * @param  ctx     build context, receives the wire data
  * @param  p       the packet
+ *
+ * @return length of the serialized packet
  */
-static void _mdns_dispatch_tx_packet(mdns_tx_packet_t *p)
+static uint16_t _mdns_build_tx_packet(mdns_tx_ctx_t *ctx, mdns_tx_packet_t *p)
 {
-    static uint8_t packet[MDNS_MAX_PACKET_SIZE];
+    uint8_t *packet = ctx->packet;
     uint16_t index = MDNS_HEAD_LEN;
     memset(packet, 0, MDNS_HEAD_LEN);
+    _mdns_name_dict_reset(&ctx->names);
     mdns_out_question_t *q;
-    mdns_out_answer_t *a;
     uint8_t count;
 
-    _mdns_set_u16(packet, MDNS_HEAD_FLAGS_OFFSET, p->flags);
     _mdns_set_u16(packet, MDNS_HEAD_ID_OFFSET, p->id);
 
     count = 0;
     q = p->questions;
     while (q) {
-        if (_mdns_append_question(packet, &index, q)) {
+        uint16_t start = index;
+        if (_mdns_append_question(ctx, &index, q)) {
             count++;
+        } else {
+            index = start;
+            _mdns_name_dict_truncate(&ctx->names, start);
         }
         q = q->next;
     }
     _mdns_set_u16(packet, MDNS_HEAD_QUESTIONS_OFFSET, count);
 
-    count = 0;
-    a = p->answers;
-    while (a) {
-        count += _mdns_append_answer(packet, &index, a, p->tcpip_if);
-        a = a->next;
-    }
-    _mdns_set_u16(packet, MDNS_HEAD_ANSWERS_OFFSET, count);
+    ctx->next_section = 0;
+    ctx->next_answer = NULL;
+    index = _mdns_build_tx_records(ctx, p, index, count > 0);
+    _mdns_build_tx_flags(ctx, p, index);
+    return index;
+}
 
-    count = 0;
-    a = p->servers;
-    while (a) {
-        count += _mdns_append_answer(packet, &index, a, p->tcpip_if);
-        a = a->next;
+/**
+ * @brief  serializes the next packet of a packet split by _mdns_build_tx_packet()
+ *
+ * The next packets carry the records left out by the previous one, without the questions (RFC 6762 7.2).
+ * All but the last packet of a query have the TC bit set.
+ *
+ * @param  ctx     build context of the previous packet, receives the wire data
+ * @param  p       the packet
+ *
+ * @return length of the serialized packet, 0 if there are no records left
+ */
+static uint16_t _mdns_build_tx_next(mdns_tx_ctx_t *ctx, mdns_tx_packet_t *p)
+{
+    if (ctx->next_section == MDNS_TX_SECTIONS) {
+        return 0;
     }
-    _mdns_set_u16(packet, MDNS_HEAD_SERVERS_OFFSET, count);
+    memset(ctx->packet, 0, MDNS_HEAD_LEN);
+    _mdns_name_dict_reset(&ctx->names);
+    _mdns_set_u16(ctx->packet, MDNS_HEAD_ID_OFFSET, p->id);
 
-    count = 0;
-    a = p->additional;
-    while (a) {
-        count += _mdns_append_answer(packet, &index, a, p->tcpip_if);
-        a = a->next;
+    uint16_t index = _mdns_build_tx_records(ctx, p, MDNS_HEAD_LEN, false);
+    if (index == MDNS_HEAD_LEN) {
+        return 0;
     }
-    _mdns_set_u16(packet, MDNS_HEAD_ADDITIONAL_OFFSET, count);
+    _mdns_build_tx_flags(ctx, p, index);
+    return index;
+}
 
-#ifdef MDNS_ENABLE_DEBUG
-    _mdns_dbg_printf("\nTX[%lu][%lu]: ", (unsigned long)p->tcpip_if, (unsigned long)p->ip_protocol);
-#ifdef CONFIG_LWIP_IPV4
-    if (p->dst.type == ESP_IPADDR_TYPE_V4) {
-        _mdns_dbg_printf("To: " IPSTR ":%u, ", IP2STR(&p->dst.u_addr.ip4), p->port);
-    }
-#endif
-#ifdef CONFIG_LWIP_IPV6
-    if (p->dst.type == ESP_IPADDR_TYPE_V6) {
-        _mdns_dbg_printf("To: " IPV6STR ":%u, ", IPV62STR(p->dst.u_addr.ip6), p->port);
+/**
+ * @brief  sends a packet, in as many packets as its records take
+ *
+ * @param  p       the packet
+ */
+static void _mdns_dispatch_tx_packet(mdns_tx_packet_t *p)
+{
+    int64_t start = _mdns_stats_now();
+    uint16_t len = _mdns_build_tx_packet(&_mdns_tx_ctx, p);
+    while (len) {
+        _mdns_udp_pcb_write(p->tcpip_if, p->ip_protocol, &p->dst, p->port, _mdns_tx_ctx.packet, len);
+        _mdns_stats_tx(p->tcpip_if, p->ip_protocol, len);
+        len = _mdns_build_tx_next(&_mdns_tx_ctx, p);
     }
-#endif
-    mdns_debug_packet(packet, index);
-#endif
-
-    _mdns_udp_pcb_write(p->tcpip_if, p->ip_protocol, &p->dst, p->port, packet, index);
+    _mdns_stats_tx_time(start);
 }
 
 /**
@@ -1580,121 +2218,390 @@ static void _mdns_free_tx_packet(mdns_tx_packet_t *packet)
 }
 
 /**
- * @brief  schedules a packet to be sent after given milliseconds
- *
- * @param  packet       the packet
- * @param  ms_after     number of milliseconds after which the packet should be dispatched
+ * @brief  orders scheduled packets by send time, packets due at the same time keep their scheduling order
  */
-static void _mdns_schedule_tx_packet(mdns_tx_packet_t *packet, uint32_t ms_after)
+static inline bool _mdns_tx_before(const mdns_tx_packet_t *a, const mdns_tx_packet_t *b)
 {
-    if (!packet) {
-        return;
-    }
-    packet->send_at = (xTaskGetTickCount() * portTICK_PERIOD_MS) + ms_after;
-    packet->next = NULL;
-    if (!_mdns_server->tx_queue_head || _mdns_server->tx_queue_head->send_at > packet->send_at) {
-        packet->next = _mdns_server->tx_queue_head;
-        _mdns_server->tx_queue_head = packet;
-        return;
-    }
-    mdns_tx_packet_t *q = _mdns_server->tx_queue_head;
-    while (q->next && q->next->send_at <= packet->send_at) {
-        q = q->next;
-    }
-    packet->next = q->next;
-    q->next = packet;
+    int32_t diff = (int32_t)(a->send_at - b->send_at);
+    return diff < 0 || (diff == 0 && (int32_t)(a->seq - b->seq) < 0);
 }
 
-/**
- * @brief  free all packets scheduled for sending
- */
-static void _mdns_clear_tx_queue_head(void)
+static inline void _mdns_tx_heap_set(size_t index, mdns_tx_packet_t *packet)
 {
-    mdns_tx_packet_t *q;
-    while (_mdns_server->tx_queue_head) {
-        q = _mdns_server->tx_queue_head;
-        _mdns_server->tx_queue_head = _mdns_server->tx_queue_head->next;
-        _mdns_free_tx_packet(q);
-    }
+    _mdns_server->tx_queue.heap[index] = packet;
+    packet->heap_index = index;
 }
 
-/**
- * @brief  clear packets scheduled for sending on a specific interface
- *
- * @param  tcpip_if     the interface
- * @param  ip_protocol     pcb type V4/V6
- */
-static void _mdns_clear_pcb_tx_queue_head(mdns_if_t tcpip_if, mdns_ip_protocol_t ip_protocol)
+static void _mdns_tx_heap_sift_up(size_t index)
 {
-    mdns_tx_packet_t *q, * p;
-    while (_mdns_server->tx_queue_head && _mdns_server->tx_queue_head->tcpip_if == tcpip_if && _mdns_server->tx_queue_head->ip_protocol == ip_protocol) {
-        q = _mdns_server->tx_queue_head;
-        _mdns_server->tx_queue_head = _mdns_server->tx_queue_head->next;
-        _mdns_free_tx_packet(q);
+    mdns_tx_packet_t **heap = _mdns_server->tx_queue.heap;
+    mdns_tx_packet_t *packet = heap[index];
+    while (index > 0) {
+        size_t parent = (index - 1) / 2;
+        if (!_mdns_tx_before(packet, heap[parent])) {
+            break;
+        }
+        _mdns_tx_heap_set(index, heap[parent]);
+        index = parent;
     }
-    if (_mdns_server->tx_queue_head) {
-        q = _mdns_server->tx_queue_head;
-        while (q->next) {
-            if (q->next->tcpip_if == tcpip_if && q->next->ip_protocol == ip_protocol) {
-                p = q->next;
-                q->next = p->next;
-                _mdns_free_tx_packet(p);
-            } else {
-                q = q->next;
-            }
+    _mdns_tx_heap_set(index, packet);
+}
+
+static void _mdns_tx_heap_sift_down(size_t index)
+{
+    mdns_tx_packet_t **heap = _mdns_server->tx_queue.heap;
+    size_t len = _mdns_server->tx_queue.len;
+    mdns_tx_packet_t *packet = heap[index];
+    while (2 * index + 1 < len) {
+        size_t child = 2 * index + 1;
+        if (child + 1 < len && _mdns_tx_before(heap[child + 1], heap[child])) {
+            child++;
         }
+        if (!_mdns_tx_before(heap[child], packet)) {
+            break;
+        }
+        _mdns_tx_heap_set(index, heap[child]);
+        index = child;
     }
+    _mdns_tx_heap_set(index, packet);
 }
 
 /**
- * @brief  get the next packet scheduled for sending on a specific interface
- *
+ * @brief  makes room for one more scheduled packet, the heap only grows here (never on dispatch)
+ */
+static bool _mdns_tx_heap_reserve(void)
+{
+    size_t size = _mdns_server->tx_queue.size;
+    if (_mdns_server->tx_queue.len < size) {
+        return true;
+    }
+    size = size ? size * 2 : MDNS_TX_QUEUE_INIT_LEN;
+    if (size > UINT16_MAX) {
+        return false;
+    }
+    mdns_tx_packet_t **heap = (mdns_tx_packet_t **)mdns_mem_malloc(size * sizeof(mdns_tx_packet_t *));
+    if (!heap) {
+        HOOK_MALLOC_FAILED;
+        return false;
+    }
+    if (_mdns_server->tx_queue.len) {
+        memcpy(heap, _mdns_server->tx_queue.heap, _mdns_server->tx_queue.len * sizeof(mdns_tx_packet_t *));
+    }
+    mdns_mem_free(_mdns_server->tx_queue.heap);
+    _mdns_server->tx_queue.heap = heap;
+    _mdns_server->tx_queue.size = size;
+    return true;
+}
+
+/**
+ * @brief  removes a packet from the schedule (heap and PCB list) without freeing it
+ */
+static void _mdns_unschedule_tx_packet(mdns_tx_packet_t *packet)
+{
+    mdns_tx_packet_t **heap = _mdns_server->tx_queue.heap;
+    size_t index = packet->heap_index;
+    mdns_tx_packet_t *last = heap[--_mdns_server->tx_queue.len];
+    if (last != packet) {
+        _mdns_tx_heap_set(index, last);
+        if (index > 0 && _mdns_tx_before(last, heap[(index - 1) / 2])) {
+            _mdns_tx_heap_sift_up(index);
+        } else {
+            _mdns_tx_heap_sift_down(index);
+        }
+    }
+    if (packet->prev) {
+        packet->prev->next = packet->next;
+    } else {
+        _mdns_server->interfaces[packet->tcpip_if].pcbs[packet->ip_protocol].tx_packets = packet->next;
+    }
+    if (packet->next) {
+        packet->next->prev = packet->prev;
+    }
+}
+
+static void _mdns_timer_arm(void);
+
+/**
+ * @brief  schedules a packet to be sent after given milliseconds
+ *
+ * @param  packet       the packet
+ * @param  ms_after     number of milliseconds after which the packet should be dispatched
+ */
+static void _mdns_schedule_tx_packet(mdns_tx_packet_t *packet, uint32_t ms_after)
+{
+    if (!packet) {
+        return;
+    }
+    if (!_mdns_tx_heap_reserve()) {
+        _mdns_free_tx_packet(packet);
+        return;
+    }
+    packet->send_at = (xTaskGetTickCount() * portTICK_PERIOD_MS) + ms_after;
+    packet->seq = _mdns_server->tx_queue.seq++;
+    // the heap orders the packets, the PCB list only groups them
+    mdns_tx_packet_t **q = &_mdns_server->interfaces[packet->tcpip_if].pcbs[packet->ip_protocol].tx_packets;
+    packet->prev = NULL;
+    packet->next = *q;
+    if (*q) {
+        (*q)->prev = packet;
+    }
+    *q = packet;
+    _mdns_server->tx_queue.heap[_mdns_server->tx_queue.len] = packet;
+    _mdns_tx_heap_sift_up(_mdns_server->tx_queue.len++);
+    if (packet->heap_index == 0) {
+        _mdns_timer_arm();
+    }
+}
+
+/**
+ * @brief  free all packets scheduled for sending
+ */
+static void _mdns_clear_tx_queue(void)
+{
+    for (size_t i = 0; i < _mdns_server->tx_queue.len; i++) {
+        _mdns_free_tx_packet(_mdns_server->tx_queue.heap[i]);
+    }
+    _mdns_server->tx_queue.len = 0;
+    for (int i = 0; i < MDNS_MAX_INTERFACES; i++) {
+        for (int j = 0; j < MDNS_IP_PROTOCOL_MAX; j++) {
+            _mdns_server->interfaces[i].pcbs[j].tx_packets = NULL;
+        }
+    }
+}
+
+/**
+ * @brief  clear packets scheduled for sending on a specific interface
+ *
+ * @param  tcpip_if     the interface
+ * @param  ip_protocol     pcb type V4/V6
+ */
+static void _mdns_clear_pcb_tx_queue(mdns_if_t tcpip_if, mdns_ip_protocol_t ip_protocol)
+{
+    mdns_pcb_t *pcb = &_mdns_server->interfaces[tcpip_if].pcbs[ip_protocol];
+    while (pcb->tx_packets) {
+        mdns_tx_packet_t *q = pcb->tx_packets;
+        _mdns_unschedule_tx_packet(q);
+        _mdns_free_tx_packet(q);
+    }
+}
+
+/**
+ * @brief  get the next packet scheduled for sending on a specific interface
+ *
  * @param  tcpip_if     the interface
  * @param  ip_protocol     pcb type V4/V6
  */
 static mdns_tx_packet_t *_mdns_get_next_pcb_packet(mdns_if_t tcpip_if, mdns_ip_protocol_t ip_protocol)
 {
-    mdns_tx_packet_t *q = _mdns_server->tx_queue_head;
-    while (q) {
-        if (q->tcpip_if == tcpip_if && q->ip_protocol == ip_protocol) {
-            return q;
+    mdns_tx_packet_t *next = _mdns_server->interfaces[tcpip_if].pcbs[ip_protocol].tx_packets;
+    for (mdns_tx_packet_t *p = next; p; p = p->next) {
+        if (_mdns_tx_before(p, next)) {
+            next = p;
         }
-        q = q->next;
     }
-    return NULL;
+    return next;
+}
+
+/**
+ * @brief  TTL of our records of the given type
+ */
+static uint32_t _mdns_answer_ttl(uint16_t type)
+{
+    switch (type) {
+    case MDNS_TYPE_SRV:
+        return MDNS_ANSWER_SRV_TTL;
+    case MDNS_TYPE_TXT:
+        return MDNS_ANSWER_TXT_TTL;
+    case MDNS_TYPE_A:
+        return MDNS_ANSWER_A_TTL;
+    case MDNS_TYPE_AAAA:
+        return MDNS_ANSWER_AAAA_TTL;
+    default:
+        return MDNS_ANSWER_PTR_TTL;
+    }
 }
 
 /**
- * @brief  Find, remove and free answer from the scheduled packets
+ * @brief  Check if the known answers hold the address record of the host
  */
-static void _mdns_remove_scheduled_answer(mdns_if_t tcpip_if, mdns_ip_protocol_t ip_protocol, uint16_t type, mdns_srv_item_t *service)
+static bool _mdns_known_address(mdns_known_answer_t *known, uint16_t type, mdns_host_item_t *host, const esp_ip_addr_t *addr)
 {
-    mdns_srv_item_t s = {NULL, NULL};
-    if (!service) {
-        service = &s;
+    while (known) {
+        if (known->type == type && known->host == host) {
+#ifdef CONFIG_LWIP_IPV4
+            if (type == MDNS_TYPE_A && known->addr.u_addr.ip4.addr == addr->u_addr.ip4.addr) {
+                return true;
+            }
+#endif /* CONFIG_LWIP_IPV4 */
+#ifdef CONFIG_LWIP_IPV6
+            if (type == MDNS_TYPE_AAAA && !memcmp(known->addr.u_addr.ip6.addr, addr->u_addr.ip6.addr, _MDNS_SIZEOF_IP6_ADDR)) {
+                return true;
+            }
+#endif /* CONFIG_LWIP_IPV6 */
+        }
+        known = known->next;
     }
-    mdns_tx_packet_t *q = _mdns_server->tx_queue_head;
-    while (q) {
-        if (q->tcpip_if == tcpip_if && q->ip_protocol == ip_protocol && q->distributed) {
-            mdns_out_answer_t *a = q->answers;
-            if (a) {
-                if (a->type == type && a->service == service->service) {
-                    q->answers = q->answers->next;
-                    mdns_mem_free(a);
-                } else {
-                    while (a->next) {
-                        if (a->next->type == type && a->next->service == service->service) {
-                            mdns_out_answer_t *b = a->next;
-                            a->next = b->next;
-                            mdns_mem_free(b);
-                            break;
-                        }
-                        a = a->next;
-                    }
+    return false;
+}
+
+/**
+ * @brief  Count the address records our A or AAAA answer of the host would carry, if the known answers hold them all
+ *
+ * Follows _mdns_append_answer(): the addresses of the interface (and of its duplicate), or the address
+ * list of a delegated host
+ *
+ * @return number of address records, -1 if one of them is not known
+ */
+static int _mdns_known_host_addresses(mdns_known_answer_t *known, uint16_t type, mdns_host_item_t *host, mdns_if_t tcpip_if)
+{
+    esp_ip_addr_t addr = { 0 };
+    int records = 0;
+
+    if (host != &_mdns_self_host) {
+        uint8_t addr_type = (type == MDNS_TYPE_A) ? ESP_IPADDR_TYPE_V4 : ESP_IPADDR_TYPE_V6;
+        mdns_ip_addr_t *a = host->address_list;
+        while (a) {
+            if (a->addr.type == addr_type) {
+                if (!_mdns_known_address(known, type, host, &a->addr)) {
+                    return -1;
                 }
+                records++;
             }
+            a = a->next;
         }
-        q = q->next;
+        return records;
+    }
+#ifdef CONFIG_LWIP_IPV4
+    if (type == MDNS_TYPE_A) {
+        esp_netif_ip_info_t if_ip_info;
+        if (esp_netif_get_ip_info(_mdns_get_esp_netif(tcpip_if), &if_ip_info)) {
+            return 0;
+        }
+        addr.u_addr.ip4.addr = if_ip_info.ip.addr;
+        if (!_mdns_known_address(known, type, host, &addr)) {
+            return -1;
+        }
+        if (_mdns_if_is_dup(tcpip_if) && !esp_netif_get_ip_info(_mdns_get_esp_netif(_mdns_get_other_if(tcpip_if)), &if_ip_info)) {
+            addr.u_addr.ip4.addr = if_ip_info.ip.addr;
+            return _mdns_known_address(known, type, host, &addr) ? 2 : -1;
+        }
+        return 1;
+    }
+#endif /* CONFIG_LWIP_IPV4 */
+#ifdef CONFIG_LWIP_IPV6
+    if (type == MDNS_TYPE_AAAA) {
+        struct esp_ip6_addr if_ip6s[NETIF_IPV6_MAX_NUMS];
+        int count = esp_netif_get_all_ip6(_mdns_get_esp_netif(tcpip_if), if_ip6s);
+        for (int i = 0; i < count; i++) {
+            memcpy(addr.u_addr.ip6.addr, if_ip6s[i].addr, _MDNS_SIZEOF_IP6_ADDR);
+            if (!_mdns_known_address(known, type, host, &addr)) {
+                return -1;
+            }
+            records++;
+        }
+        if (records && _mdns_if_is_dup(tcpip_if)) {
+            struct esp_ip6_addr other_ip6;
+            if (!esp_netif_get_ip6_linklocal(_mdns_get_esp_netif(_mdns_get_other_if(tcpip_if)), &other_ip6)) {
+                memcpy(addr.u_addr.ip6.addr, other_ip6.addr, _MDNS_SIZEOF_IP6_ADDR);
+                return _mdns_known_address(known, type, host, &addr) ? records + 1 : -1;
+            }
+        }
+        return records;
+    }
+#endif /* CONFIG_LWIP_IPV6 */
+    return 0;
+}
+
+/**
+ * @brief  Count the records of our answer, if the known answers cover them all
+ *
+ * @return number of records, -1 if the answer is not covered
+ */
+static int _mdns_answer_known_records(mdns_out_answer_t *answer, mdns_known_answer_t *known, mdns_if_t tcpip_if)
+{
+    if (answer->bye) {
+        return -1;
+    }
+    if (answer->type == MDNS_TYPE_A || answer->type == MDNS_TYPE_AAAA) {
+        return answer->host ? _mdns_known_host_addresses(known, answer->type, answer->host, tcpip_if) : -1;
+    }
+    if (!answer->service) {
+        return -1;
+    }
+    while (known) {
+        if (known->type == answer->type) {
+            if (known->service == answer->service) {
+                return 1;
+            }
+            // all services of a type share the same service discovery PTR
+            if (answer->type == MDNS_TYPE_SDPTR
+                    && !strcasecmp(known->service->service, answer->service->service)
+                    && !strcasecmp(known->service->proto, answer->service->proto)) {
+                return 1;
+            }
+        }
+        known = known->next;
+    }
+    return -1;
+}
+
+/**
+ * @brief  Remove and free the answers covered by the known answers from answer list
+ *
+ * Address answers without any address to carry are removed as well, they would be sent empty
+ *
+ * @return number of records removed
+ */
+static uint16_t _mdns_remove_known_answers(mdns_out_answer_t **answers, mdns_known_answer_t *known, mdns_if_t tcpip_if)
+{
+    uint16_t removed = 0;
+    while (*answers) {
+        mdns_out_answer_t *a = *answers;
+        int records = _mdns_answer_known_records(a, known, tcpip_if);
+        if (records >= 0) {
+            *answers = a->next;
+            mdns_mem_free(a);
+            removed += records;
+        } else {
+            answers = &a->next;
+        }
+    }
+    return removed;
+}
+
+/**
+ * @brief  Remove the known answers of a packet without our questions from our scheduled answers on its PCB
+ *
+ * A response of another responder drops duplicates of our answers (RFC 6762 7.4), a query
+ * continues the known answer list of a truncated query of the same sender (RFC 6762 7.2).
+ * Packets left without answers are not sent, and a continuation with the TC bit set holds
+ * back the answer for the packets still to come.
+ */
+static void _mdns_remove_scheduled_known_answers(mdns_parsed_packet_t *parsed_packet)
+{
+    uint16_t removed = 0;
+    uint32_t now = xTaskGetTickCount() * portTICK_PERIOD_MS;
+    mdns_tx_packet_t *p = _mdns_server->interfaces[parsed_packet->tcpip_if].pcbs[parsed_packet->ip_protocol].tx_packets;
+    while (p) {
+        mdns_tx_packet_t *next = p->next;
+        bool continued = p->distributed && !memcmp(&p->query_src, &parsed_packet->src, sizeof(esp_ip_addr_t));
+        if (continued || (parsed_packet->authoritative && p->shared_answer)) {
+            removed += _mdns_remove_known_answers(&p->answers, parsed_packet->known_answers, p->tcpip_if);
+            removed += _mdns_remove_known_answers(&p->additional, parsed_packet->known_answers, p->tcpip_if);
+            if (!p->answers) {
+                _mdns_unschedule_tx_packet(p);
+                _mdns_free_tx_packet(p);
+            } else if (continued && parsed_packet->distributed && (int32_t)(p->send_at - now) < MDNS_TRUNCATED_DELAY_MS) {
+                _mdns_unschedule_tx_packet(p);
+                _mdns_schedule_tx_packet(p, MDNS_TRUNCATED_DELAY_MS);
+            }
+        }
+        p = next;
+    }
+    if (parsed_packet->authoritative) {
+        _mdns_server->suppressed.duplicate_answer += removed;
+    } else {
+        _mdns_server->suppressed.known_answer += removed;
     }
 }
 
@@ -1856,6 +2763,104 @@ static bool _mdns_service_match_ptr_question(const mdns_service_t *service, cons
     return true;
 }
 
+/**
+ * @brief  Find the answer with the same records as needle in answer list
+ *
+ * Address answers carry the addresses of their host, whatever service they came with
+ *
+ * @return the link to the answer or NULL if the list has none
+ */
+static mdns_out_answer_t **_mdns_find_same_answer(mdns_out_answer_t **answers, mdns_out_answer_t *needle)
+{
+    bool address = needle->type == MDNS_TYPE_A || needle->type == MDNS_TYPE_AAAA;
+    while (*answers) {
+        mdns_out_answer_t *a = *answers;
+        if (a->type == needle->type && a->host == needle->host && (address || a->service == needle->service)) {
+            return answers;
+        }
+        answers = &a->next;
+    }
+    return NULL;
+}
+
+/**
+ * @brief  Move the answers of list to the answers (or additional records) of target, dropping the records it holds
+ *
+ * An answer of the list held by target as additional record becomes an answer of target
+ *
+ * @return number of answers dropped
+ */
+static uint16_t _mdns_merge_answers(mdns_tx_packet_t *target, mdns_out_answer_t **list, bool additional)
+{
+    uint16_t dropped = 0;
+    while (*list) {
+        mdns_out_answer_t *a = *list;
+        mdns_out_answer_t **held;
+        *list = a->next;
+        a->next = NULL;
+        if (_mdns_find_same_answer(&target->answers, a) || (additional && _mdns_find_same_answer(&target->additional, a))) {
+            mdns_mem_free(a);
+            dropped++;
+            continue;
+        }
+        if (additional) {
+            queueToEnd(mdns_out_answer_t, target->additional, a);
+            continue;
+        }
+        if ((held = _mdns_find_same_answer(&target->additional, a)) != NULL) {
+            mdns_out_answer_t *h = *held;
+            *held = h->next;
+            mdns_mem_free(h);
+            dropped++;
+        }
+        queueToEnd(mdns_out_answer_t, target->answers, a);
+    }
+    return dropped;
+}
+
+/**
+ * @brief  Merge a shared answer into an answer scheduled on its PCB for the same destination
+ *
+ * The scheduled answer must leave within the delay of a shared answer to the new query, and
+ * both must fit in one packet. Answers to several queries received in a row then leave in
+ * one packet, each record once.
+ *
+ * @return true if the packet was merged and freed
+ */
+static bool _mdns_aggregate_answer(mdns_tx_packet_t *packet)
+{
+    uint32_t now = xTaskGetTickCount() * portTICK_PERIOD_MS;
+    mdns_tx_packet_t *target = NULL;
+
+    if (packet->questions || packet->distributed) {
+        return false;
+    }
+    // the first one to leave of the matching answers
+    for (mdns_tx_packet_t *p = _mdns_server->interfaces[packet->tcpip_if].pcbs[packet->ip_protocol].tx_packets; p; p = p->next) {
+        int32_t delay = (int32_t)(p->send_at - now);
+        if (delay >= MDNS_AGGREGATE_MIN_DELAY_MS && delay <= MDNS_AGGREGATE_MAX_DELAY_MS && p->shared_answer
+                && !p->distributed && !p->questions && p->port == packet->port && p->flags == packet->flags
+                && p->id == packet->id && !memcmp(&p->dst, &packet->dst, sizeof(esp_ip_addr_t))
+                && (!target || _mdns_tx_before(p, target))) {
+            target = p;
+        }
+    }
+    if (!target) {
+        return false;
+    }
+    // compression only shortens the merged packet
+    if (_mdns_build_tx_packet(&_mdns_tx_ctx, target) + _mdns_build_tx_packet(&_mdns_tx_ctx, packet) - MDNS_HEAD_LEN
+            > MDNS_MAX_PACKET_SIZE) {
+        return false;
+    }
+    uint16_t dropped = _mdns_merge_answers(target, &packet->answers, false);
+    dropped += _mdns_merge_answers(target, &packet->additional, true);
+    _mdns_free_tx_packet(packet);
+    _mdns_server->aggregated.packets++;
+    _mdns_server->aggregated.records += dropped;
+    return true;
+}
+
 /**
  * @brief  Create answer packet to questions from parsed packet
  */
@@ -1891,36 +2896,32 @@ static void _mdns_create_answer_from_parsed_packet(mdns_parsed_packet_t *parsed_
             } else {
                 out_record_nums++;
             }
+        } else if (q->service && q->proto && q->sub && q->host) {
+            // subtype PTR, only the services in the subtype's bucket can match
+            mdns_subtype_t *subtype = *_mdns_subtype_index_bucket(q->host, q->service, q->proto);
+            while (subtype) {
+                if (!strcasecmp(subtype->subtype, q->host) && _mdns_service_match_ptr_question(subtype->item->service, q)) {
+                    if (!_mdns_create_answer_from_service(packet, subtype->item->service, q, shared, send_flush)) {
+                        _mdns_free_tx_packet(packet);
+                        return;
+                    } else {
+                        out_record_nums++;
+                    }
+                }
+                subtype = subtype->index_next;
+            }
         } else if (q->service && q->proto) {
-            mdns_srv_item_t *service = _mdns_server->services;
+            mdns_srv_item_t *service = *_mdns_service_index_bucket(q->service, q->proto);
             while (service) {
                 if (_mdns_service_match_ptr_question(service->service, q)) {
-                    mdns_parsed_record_t *r = parsed_packet->records;
-                    bool is_record_exist = false;
-                    while (r) {
-                        if (service->service->instance && r->host) {
-                            if (_mdns_service_match_instance(service->service, r->host, r->service, r->proto, NULL) && r->ttl > (MDNS_ANSWER_PTR_TTL / 2)) {
-                                is_record_exist = true;
-                                break;
-                            }
-                        } else if (!service->service->instance && !r->host) {
-                            if (_mdns_service_match(service->service, r->service, r->proto, NULL) && r->ttl > (MDNS_ANSWER_PTR_TTL / 2)) {
-                                is_record_exist = true;
-                                break;
-                            }
-                        }
-                        r = r->next;
-                    }
-                    if (!is_record_exist) {
-                        if (!_mdns_create_answer_from_service(packet, service->service, q, shared, send_flush)) {
-                            _mdns_free_tx_packet(packet);
-                            return;
-                        } else {
-                            out_record_nums++;
-                        }
+                    if (!_mdns_create_answer_from_service(packet, service->service, q, shared, send_flush)) {
+                        _mdns_free_tx_packet(packet);
+                        return;
+                    } else {
+                        out_record_nums++;
                     }
                 }
-                service = service->next;
+                service = service->index_next;
             }
         } else if (q->type == MDNS_TYPE_A || q->type == MDNS_TYPE_AAAA) {
             if (!_mdns_create_answer_from_hostname(packet, q->host, send_flush)) {
@@ -1984,10 +2985,18 @@ static void _mdns_create_answer_from_parsed_packet(mdns_parsed_packet_t *parsed_
         }
         q = q->next;
     }
+    if (parsed_packet->known_answers) {
+        _mdns_server->suppressed.known_answer += _mdns_remove_known_answers(&packet->answers, parsed_packet->known_answers, packet->tcpip_if);
+        _mdns_server->suppressed.known_answer += _mdns_remove_known_answers(&packet->additional, parsed_packet->known_answers, packet->tcpip_if);
+        if (!packet->answers) {
+            out_record_nums = 0;
+        }
+    }
     if (out_record_nums == 0) {
         _mdns_free_tx_packet(packet);
         return;
     }
+    MDNS_STATS_INC(answers);
     if (unicast || !send_flush) {
         memcpy(&packet->dst, &parsed_packet->src, sizeof(esp_ip_addr_t));
         packet->port = parsed_packet->src_port;
@@ -1995,7 +3004,16 @@ static void _mdns_create_answer_from_parsed_packet(mdns_parsed_packet_t *parsed_
 
     static uint8_t share_step = 0;
     if (shared) {
-        _mdns_schedule_tx_packet(packet, 25 + (share_step * 25));
+        packet->shared_answer = true;
+        if (packet->distributed) {
+            // the known answers of the query continue in the next packets of the sender
+            memcpy(&packet->query_src, &parsed_packet->src, sizeof(esp_ip_addr_t));
+            _mdns_schedule_tx_packet(packet, MDNS_TRUNCATED_DELAY_MS + (share_step * 25));
+        } else if (_mdns_aggregate_answer(packet)) {
+            return;
+        } else {
+            _mdns_schedule_tx_packet(packet, 25 + (share_step * 25));
+        }
         share_step = (share_step + 1) & 0x03;
     } else {
         _mdns_dispatch_tx_packet(packet);
@@ -2317,7 +3335,7 @@ static void _mdns_init_pcb_probe(mdns_if_t tcpip_if, mdns_ip_protocol_t ip_proto
 {
     mdns_pcb_t *pcb = &_mdns_server->interfaces[tcpip_if].pcbs[ip_protocol];
 
-    _mdns_clear_pcb_tx_queue_head(tcpip_if, ip_protocol);
+    _mdns_clear_pcb_tx_queue(tcpip_if, ip_protocol);
 
     if (_str_null_or_empty(_mdns_server->hostname)) {
         pcb->state = PCB_RUNNING;
@@ -2386,6 +3404,7 @@ static void _mdns_send_bye(mdns_srv_item_t **services, size_t len, bool include_
         return;
     }
 
+    _mdns_udp_pcb_batch_begin();
     for (i = 0; i < MDNS_MAX_INTERFACES; i++) {
         for (j = 0; j < MDNS_IP_PROTOCOL_MAX; j++) {
             if (mdns_is_netif_ready(i, j) && _mdns_server->interfaces[i].pcbs[j].state == PCB_RUNNING) {
@@ -2393,6 +3412,7 @@ static void _mdns_send_bye(mdns_srv_item_t **services, size_t len, bool include_
             }
         }
     }
+    _mdns_udp_pcb_batch_flush();
 }
 
 /**
@@ -2414,9 +3434,10 @@ static void _mdns_send_bye_subtype(mdns_srv_item_t *service, const char *instanc
                     return;
                 }
 
-                static uint8_t pkt[MDNS_MAX_PACKET_SIZE];
+                uint8_t *pkt = _mdns_tx_ctx.packet;
                 uint16_t index = MDNS_HEAD_LEN;
                 memset(pkt, 0, MDNS_HEAD_LEN);
+                _mdns_name_dict_reset(&_mdns_tx_ctx.names);
                 mdns_out_answer_t *a;
                 uint8_t count;
 
@@ -2429,7 +3450,7 @@ static void _mdns_send_bye_subtype(mdns_srv_item_t *service, const char *instanc
                     if (a->type == MDNS_TYPE_PTR && a->service) {
                         const mdns_subtype_t *current_subtype = remove_subtypes;
                         while (current_subtype) {
-                            count += (_mdns_append_subtype_ptr_record(pkt, &index, instance_name, current_subtype->subtype, a->service->service, a->service->proto, a->flush, a->bye) > 0);
+                            count += (_mdns_append_subtype_ptr_record(&_mdns_tx_ctx, &index, instance_name, current_subtype->subtype, a->service->service, a->service->proto, a->flush, a->bye) > 0);
                             current_subtype = current_subtype->next;
                         }
                     }
@@ -2438,6 +3459,7 @@ static void _mdns_send_bye_subtype(mdns_srv_item_t *service, const char *instanc
                 _mdns_set_u16(pkt, MDNS_HEAD_ANSWERS_OFFSET, count);
 
                 _mdns_udp_pcb_write(packet->tcpip_if, packet->ip_protocol, &packet->dst, packet->port, pkt, index);
+                _mdns_stats_tx(packet->tcpip_if, packet->ip_protocol, index);
 
                 _mdns_free_tx_packet(packet);
             }
@@ -2609,7 +3631,7 @@ static void _mdns_restart_all_pcbs_no_instance(void)
  */
 static void _mdns_restart_all_pcbs(void)
 {
-    _mdns_clear_tx_queue_head();
+    _mdns_clear_tx_queue();
     size_t srv_count = 0;
     mdns_srv_item_t *a = _mdns_server->services;
     while (a) {
@@ -2634,94 +3656,128 @@ static void _mdns_restart_all_pcbs(void)
 
 
 /**
- * @brief  creates/allocates new text item list
- * @param  num_items     service number of txt items or 0
- * @param  txt           service txt items array or NULL
+ * @brief  length of one TXT item in the TXT rdata, length byte included
  *
- * @return pointer to the linked txt item list or NULL
+ * @return the length, 0 if the item is over the 255 bytes of a TXT string (RFC 6763 6.1)
  */
-static mdns_txt_linked_item_t *_mdns_allocate_txt(size_t num_items, mdns_txt_item_t txt[])
+static uint16_t _mdns_txt_item_len(const char *key, const char *value, size_t value_len)
 {
-    mdns_txt_linked_item_t *new_txt = NULL;
-    size_t i = 0;
-    if (num_items) {
-        for (i = 0; i < num_items; i++) {
-            mdns_txt_linked_item_t *new_item = (mdns_txt_linked_item_t *)mdns_mem_malloc(sizeof(mdns_txt_linked_item_t));
-            if (!new_item) {
-                HOOK_MALLOC_FAILED;
-                break;
-            }
-            new_item->key = mdns_mem_strdup(txt[i].key);
-            if (!new_item->key) {
-                mdns_mem_free(new_item);
-                break;
-            }
-            if (txt[i].value) {
-                new_item->value = mdns_mem_strdup(txt[i].value);
-                if (!new_item->value) {
-                    mdns_mem_free((char *)new_item->key);
-                    mdns_mem_free(new_item);
-                    break;
-                }
-                new_item->value_len = strlen(new_item->value);
-            } else {
-                new_item->value = NULL;
-                new_item->value_len = 0;
-            }
-            new_item->next = new_txt;
-            new_txt = new_item;
-        }
-    }
-    return new_txt;
+    // in size_t, a value over 255 bytes is caught here rather than truncated by the caller
+    size_t len = strlen(key) + (value ? 1 + value_len : 0);
+    return len > UINT8_MAX ? 0 : len + 1;
 }
 
 /**
- * @brief Deallocate the txt linked list
- * @param txt pointer to the txt pointer to free, noop if txt==NULL
+ * @brief  writes one TXT item ("key=value", or "key" without value) to the TXT rdata
+ *
+ * @return the position after the item
  */
-static void _mdns_free_linked_txt(mdns_txt_linked_item_t *txt)
+static uint8_t *_mdns_txt_item_write(uint8_t *out, const char *key, const char *value, size_t value_len)
 {
-    mdns_txt_linked_item_t *t;
-    while (txt) {
-        t = txt;
-        txt = txt->next;
-        mdns_mem_free((char *)t->value);
-        mdns_mem_free((char *)t->key);
-        mdns_mem_free(t);
+    size_t key_len = strlen(key);
+    *out++ = _mdns_txt_item_len(key, value, value_len) - 1;
+    memcpy(out, key, key_len);
+    out += key_len;
+    if (value) {
+        *out++ = '=';
+        memcpy(out, value, value_len);
+        out += value_len;
     }
+    return out;
 }
 
 /**
- * @brief  creates/allocates new service
- * @param  service       service type
- * @param  proto         service proto
- * @param  hostname      service hostname
- * @param  port          service port
- * @param  instance      service instance
- * @param  num_items     service number of txt items or 0
- * @param  txt           service txt items array or NULL
+ * @brief  replaces the TXT rdata of the service, encoding the items
  *
- * @return pointer to the service or NULL on error
+ * Items go in reverse order, as they always went on the wire. Items longer than a TXT string are left out.
+ *
+ * @param  service       the service
+ * @param  num_items     number of txt items or 0
+ * @param  txt           txt items array or NULL
+ *
+ * @return true on success, false if out of memory or over a packet (the service keeps its TXT rdata)
  */
-static mdns_service_t *_mdns_create_service(const char *service, const char *proto, const char *hostname,
-                                            uint16_t port, const char *instance, size_t num_items,
-                                            mdns_txt_item_t txt[])
+static bool _mdns_txt_set_items(mdns_service_t *service, size_t num_items, mdns_txt_item_t txt[])
 {
-    mdns_service_t *s = (mdns_service_t *)mdns_mem_calloc(1, sizeof(mdns_service_t));
+    size_t len = 0;
+    for (size_t i = 0; i < num_items; i++) {
+        len += _mdns_txt_item_len(txt[i].key, txt[i].value, txt[i].value ? strlen(txt[i].value) : 0);
+    }
+    uint8_t *data = NULL;
+    if (len) {
+        if (len > MDNS_MAX_PACKET_SIZE) {
+            return false;
+        }
+        data = (uint8_t *)mdns_mem_malloc(len);
+        if (!data) {
+            HOOK_MALLOC_FAILED;
+            return false;
+        }
+        uint8_t *out = data;
+        for (size_t i = num_items; i > 0; i--) {
+            mdns_txt_item_t *t = &txt[i - 1];
+            size_t value_len = t->value ? strlen(t->value) : 0;
+            if (_mdns_txt_item_len(t->key, t->value, value_len)) {
+                out = _mdns_txt_item_write(out, t->key, t->value, value_len);
+            }
+        }
+    }
+    mdns_mem_free(service->txt);
+    service->txt = data;
+    service->txt_len = len;
+    return true;
+}
+
+/**
+ * @brief  finds the item of the key in the TXT rdata of the service
+ *
+ * @return offset of the item, -1 if not found
+ */
+static int _mdns_txt_find(const mdns_service_t *service, const char *key, uint16_t *item_len)
+{
+    size_t key_len = strlen(key);
+    uint16_t i = 0;
+    while (i < service->txt_len) {
+        uint8_t len = service->txt[i];
+        const char *item = (const char *)service->txt + i + 1;
+        if (len >= key_len && !memcmp(item, key, key_len) && (len == key_len || item[key_len] == '=')) {
+            *item_len = len + 1;
+            return i;
+        }
+        i += len + 1;
+    }
+    return -1;
+}
+
+/**
+ * @brief  creates/allocates new service
+ * @param  service       service type
+ * @param  proto         service proto
+ * @param  hostname      service hostname
+ * @param  port          service port
+ * @param  instance      service instance
+ * @param  num_items     service number of txt items or 0
+ * @param  txt           service txt items array or NULL
+ *
+ * @return pointer to the service or NULL on error
+ */
+static mdns_service_t *_mdns_create_service(const char *service, const char *proto, const char *hostname,
+                                            uint16_t port, const char *instance, size_t num_items,
+                                            mdns_txt_item_t txt[])
+{
+    mdns_service_t *s = (mdns_service_t *)mdns_mem_calloc(1, sizeof(mdns_service_t));
     if (!s) {
         HOOK_MALLOC_FAILED;
         return NULL;
     }
 
-    mdns_txt_linked_item_t *new_txt = _mdns_allocate_txt(num_items, txt);
-    if (num_items && new_txt == NULL) {
+    if (!_mdns_txt_set_items(s, num_items, txt)) {
         goto fail;
     }
 
     s->priority = 0;
     s->weight = 0;
     s->instance = instance ? mdns_mem_strndup(instance, MDNS_NAME_BUF_LEN - 1) : NULL;
-    s->txt = new_txt;
     s->port = port;
     s->subtype = NULL;
 
@@ -2746,7 +3802,7 @@ static mdns_service_t *_mdns_create_service(const char *service, const char *pro
     return s;
 
 fail:
-    _mdns_free_linked_txt(s->txt);
+    mdns_mem_free(s->txt);
     mdns_mem_free((char *)s->instance);
     mdns_mem_free((char *)s->service);
     mdns_mem_free((char *)s->proto);
@@ -2782,15 +3838,12 @@ static void _mdns_dealloc_scheduled_service_answers(mdns_out_answer_t **destinat
 }
 
 /**
- * @brief  Find, remove and free answers and scheduled packets for service
+ * @brief  Find, remove and free answers and scheduled packets for service on a specific interface
  */
-static void _mdns_remove_scheduled_service_packets(mdns_service_t *service)
+static void _mdns_remove_scheduled_pcb_service_packets(mdns_if_t tcpip_if, mdns_ip_protocol_t ip_protocol, mdns_service_t *service)
 {
-    if (!service) {
-        return;
-    }
     mdns_tx_packet_t *p = NULL;
-    mdns_tx_packet_t *q = _mdns_server->tx_queue_head;
+    mdns_tx_packet_t *q = _mdns_server->interfaces[tcpip_if].pcbs[ip_protocol].tx_packets;
     while (q) {
         bool had_answers = (q->answers != NULL);
 
@@ -2859,12 +3912,27 @@ static void _mdns_remove_scheduled_service_packets(mdns_service_t *service)
         p = q;
         q = q->next;
         if (!p->questions && !p->answers && !p->additional && !p->servers) {
-            queueDetach(mdns_tx_packet_t, _mdns_server->tx_queue_head, p);
+            _mdns_unschedule_tx_packet(p);
             _mdns_free_tx_packet(p);
         }
     }
 }
 
+/**
+ * @brief  Find, remove and free answers and scheduled packets for service
+ */
+static void _mdns_remove_scheduled_service_packets(mdns_service_t *service)
+{
+    if (!service) {
+        return;
+    }
+    for (int i = 0; i < MDNS_MAX_INTERFACES; i++) {
+        for (int j = 0; j < MDNS_IP_PROTOCOL_MAX; j++) {
+            _mdns_remove_scheduled_pcb_service_packets((mdns_if_t)i, (mdns_ip_protocol_t)j, service);
+        }
+    }
+}
+
 static void _mdns_free_subtype(mdns_subtype_t *subtype)
 {
     while (subtype) {
@@ -2895,13 +3963,7 @@ static void _mdns_free_service(mdns_service_t *service)
     mdns_mem_free((char *)service->service);
     mdns_mem_free((char *)service->proto);
     mdns_mem_free((char *)service->hostname);
-    while (service->txt) {
-        mdns_txt_linked_item_t *s = service->txt;
-        service->txt = service->txt->next;
-        mdns_mem_free((char *)s->key);
-        mdns_mem_free((char *)s->value);
-        mdns_mem_free(s);
-    }
+    mdns_mem_free(service->txt);
     _mdns_free_service_subtype(service);
     mdns_mem_free(service);
 }
@@ -2968,14 +4030,22 @@ static int _mdns_check_srv_collision(mdns_service_t *service, uint16_t priority,
     return 0;//same
 }
 
+/**
+ * @brief  Check if SRV data is the same as ours, also for services of delegated hosts
+ */
+static bool _mdns_srv_data_is_ours(mdns_service_t *service, uint16_t priority, uint16_t weight, uint16_t port, const char *host, const char *domain)
+{
+    const char *our_host = service->hostname ? service->hostname : _mdns_server->hostname;
+    return service->priority == priority && service->weight == weight && service->port == port
+           && !_str_null_or_empty(our_host) && !strcasecmp(our_host, host) && !strcasecmp(MDNS_DEFAULT_DOMAIN, domain);
+}
+
 /**
  * @brief  Detect TXT collision
  */
 static int _mdns_check_txt_collision(mdns_service_t *service, const uint8_t *data, size_t len)
 {
-    size_t data_len = 0;
     if (len <= 1 && service->txt) {     // len==0 means incorrect packet (and handled by the packet parser)
-        // but handled here again to fix clang-tidy warning on VLA "uint8_t our[0];"
         return -1;//we win
     } else if (len > 1 && !service->txt) {
         return 1;//they win
@@ -2983,28 +4053,13 @@ static int _mdns_check_txt_collision(mdns_service_t *service, const uint8_t *dat
         return 0;//same
     }
 
-    mdns_txt_linked_item_t *txt = service->txt;
-    while (txt) {
-        data_len += 1 /* record-len */ + strlen(txt->key) + txt->value_len + (txt->value ? 1 : 0 /* "=" */);
-        txt = txt->next;
-    }
-
-    if (len > data_len) {
+    if (len > service->txt_len) {
         return 1;//they win
-    } else if (len < data_len) {
+    } else if (len < service->txt_len) {
         return -1;//we win
     }
 
-    uint8_t ours[len];
-    uint16_t index = 0;
-
-    txt = service->txt;
-    while (txt) {
-        append_one_txt_record_entry(ours, &index, txt);
-        txt = txt->next;
-    }
-
-    int ret = memcmp(ours, data, len);
+    int ret = memcmp(service->txt, data, len);
     if (ret > 0) {
         return -1;//we win
     } else if (ret < 0) {
@@ -3027,6 +4082,7 @@ static esp_err_t mdns_pcb_deinit_local(mdns_if_t tcpip_if, mdns_ip_protocol_t ip
     _pcb->probe_services_len = 0;
     _pcb->probe_running = false;
     _pcb->failed_probes = 0;
+    _mdns_cache_remove_pcb(tcpip_if, ip_proto);
     return ESP_OK;
 }
 /**
@@ -3043,7 +4099,7 @@ static void _mdns_dup_interface(mdns_if_t tcpip_if)
         if (mdns_is_netif_ready(other_if, i)) {
             //stop this interface and mark as dup
             if (mdns_is_netif_ready(tcpip_if, i)) {
-                _mdns_clear_pcb_tx_queue_head(tcpip_if, i);
+                _mdns_clear_pcb_tx_queue(tcpip_if, i);
                 mdns_pcb_deinit_local(tcpip_if, i);
             }
             _mdns_server->interfaces[tcpip_if].pcbs[i].state = PCB_DUP;
@@ -3130,14 +4186,7 @@ static bool _hostname_is_ours(const char *hostname)
             strcasecmp(hostname, _mdns_server->hostname) == 0) {
         return true;
     }
-    mdns_host_item_t *host = _mdns_host_list;
-    while (host != NULL) {
-        if (strcasecmp(hostname, host->hostname) == 0) {
-            return true;
-        }
-        host = host->next;
-    }
-    return false;
+    return _mdns_get_delegated_host(hostname) != NULL;
 }
 
 /**
@@ -3162,6 +4211,9 @@ static bool _mdns_delegate_hostname_add(const char *hostname, mdns_ip_addr_t *ad
     host->hostname = hostname;
     host->next = _mdns_host_list;
     _mdns_host_list = host;
+    mdns_host_item_t **bucket = _mdns_host_index_bucket(hostname);
+    host->index_next = *bucket;
+    *bucket = host;
     return true;
 }
 
@@ -3181,16 +4233,13 @@ static bool _mdns_delegate_hostname_set_address(const char *hostname, mdns_ip_ad
             strcasecmp(hostname, _mdns_server->hostname) == 0) {
         return false;
     }
-    mdns_host_item_t *host = _mdns_host_list;
-    while (host != NULL) {
-        if (strcasecmp(hostname, host->hostname) == 0) {
-            // free previous address list
-            free_address_list(host->address_list);
-            // set current address list to the host
-            host->address_list = address_list;
-            return true;
-        }
-        host = host->next;
+    mdns_host_item_t *host = _mdns_get_delegated_host(hostname);
+    if (host != NULL) {
+        // free previous address list
+        free_address_list(host->address_list);
+        // set current address list to the host
+        host->address_list = address_list;
+        return true;
     }
     return false;
 }
@@ -3230,6 +4279,7 @@ static void free_delegated_hostnames(void)
         mdns_mem_free(item);
     }
     _mdns_host_list = NULL;
+    memset(_mdns_host_index, 0, sizeof(_mdns_host_index));
 }
 
 static bool _mdns_delegate_hostname_remove(const char *hostname)
@@ -3241,6 +4291,7 @@ static bool _mdns_delegate_hostname_remove(const char *hostname)
             mdns_srv_item_t *to_free = srv;
             _mdns_send_bye(&srv, 1, false);
             _mdns_remove_scheduled_service_packets(srv->service);
+            _mdns_service_index_remove(srv);
             if (prev_srv == NULL) {
                 _mdns_server->services = srv->next;
                 srv = srv->next;
@@ -3264,6 +4315,11 @@ static bool _mdns_delegate_hostname_remove(const char *hostname)
             } else {
                 prev_host->next = host->next;
             }
+            mdns_host_item_t **h = _mdns_host_index_bucket(host->hostname);
+            while (*h != host) {
+                h = &(*h)->index_next;
+            }
+            *h = host->index_next;
             free_address_list(host->address_list);
             mdns_mem_free((char *)host->hostname);
             mdns_mem_free(host);
@@ -3400,15 +4456,9 @@ static inline uint32_t _mdns_read_u32(const uint8_t *packet, uint16_t index)
 }
 
 /**
- * @brief  reads and formats MDNS FQDN into mdns_name_t structure
- *
- * @param  packet       MDNS packet
- * @param  start        Starting point of FQDN
- * @param  name         mdns_name_t structure to populate
- *
- * @return the address after the parsed FQDN in the packet or NULL on error
+ * @brief  empties the name before a FQDN is read into it
  */
-static const uint8_t *_mdns_parse_fqdn(const uint8_t *packet, const uint8_t *start, mdns_name_t *name, size_t packet_len)
+static void _mdns_name_clear(mdns_name_t *name)
 {
     name->parts = 0;
     name->sub = 0;
@@ -3417,10 +4467,18 @@ static const uint8_t *_mdns_parse_fqdn(const uint8_t *packet, const uint8_t *sta
     name->proto[0] = 0;
     name->domain[0] = 0;
     name->invalid = false;
+}
 
-    static char buf[MDNS_NAME_BUF_LEN];
-
-    const uint8_t *next_data = (uint8_t *)_mdns_read_fqdn(packet, start, name, buf, packet_len);
+/**
+ * @brief  moves the parts of a FQDN just read to their fields and checks its domain
+ *
+ * @param  name         the name read
+ * @param  next_data    the address after the FQDN in the packet, NULL if it could not be read
+ *
+ * @return next_data
+ */
+static const uint8_t *_mdns_name_format(mdns_name_t *name, const uint8_t *next_data)
+{
     if (!next_data) {
         return 0;
     }
@@ -3443,70 +4501,203 @@ static const uint8_t *_mdns_parse_fqdn(const uint8_t *packet, const uint8_t *sta
 }
 
 /**
- * @brief  Called from parser to check if question matches particular service
+ * @brief  reads and formats MDNS FQDN into mdns_name_t structure
+ *
+ * @param  packet       MDNS packet
+ * @param  start        Starting point of FQDN
+ * @param  name         mdns_name_t structure to populate
+ *
+ * @return the address after the parsed FQDN in the packet or NULL on error
  */
-static bool _mdns_question_matches(mdns_parsed_question_t *question, uint16_t type, mdns_srv_item_t *service)
+static const uint8_t *_mdns_parse_fqdn(const uint8_t *packet, const uint8_t *start, mdns_name_t *name, size_t packet_len)
 {
-    if (question->type != type) {
-        return false;
+    char buf[MDNS_NAME_BUF_LEN];
+
+    _mdns_name_clear(name);
+    return _mdns_name_format(name, _mdns_read_fqdn(packet, start, name, buf, packet_len));
+}
+
+/**
+ * @brief  empties the name table, before a packet is parsed
+ */
+static void _mdns_name_table_reset(mdns_parse_ctx_t *ctx)
+{
+    ctx->names.count = 0;
+    ctx->names.label_count = 0;
+    ctx->name_labels = 0;
+    ctx->target_labels = 0;
+}
+
+/**
+ * @brief  finds the name starting at offset among the names already read from the packet
+ *
+ * Names are indexed in the order they are first read, which follows the packet, and a name
+ * is mostly read again right after: the search starts from the last one.
+ */
+static const mdns_name_entry_t *_mdns_name_table_find(const mdns_name_table_t *table, uint16_t offset)
+{
+    for (int i = table->count - 1; i >= 0 && table->names[i].offset >= offset; i--) {
+        if (table->names[i].offset == offset) {
+            return &table->names[i];
+        }
     }
-    if (type == MDNS_TYPE_A || type == MDNS_TYPE_AAAA) {
-        return true;
-    } else if (type == MDNS_TYPE_PTR || type == MDNS_TYPE_SDPTR) {
-        if (question->service && question->proto && question->domain
-                && !strcasecmp(service->service->service, question->service)
-                && !strcasecmp(service->service->proto, question->proto)
-                && !strcasecmp(MDNS_DEFAULT_DOMAIN, question->domain)) {
-            if (!service->service->instance) {
-                return true;
-            } else if (service->service->instance && question->host && !strcasecmp(service->service->instance, question->host)) {
-                return true;
+    return NULL;
+}
+
+/**
+ * @brief  reads the FQDN at offset into name and indexes its labels, in one pass
+ *
+ * Validates the name as _mdns_read_fqdn() does: labels of 63 bytes at most and inside the
+ * packet, compression pointers before the labels they follow, which rules out loops.
+ * Names it could not index are left to _mdns_read_fqdn(): malformed names, a pointer to an
+ * empty name, names past the size of the table or read out of the packet order.
+ *
+ * @param  table        the name table of the packet
+ * @param  packet       MDNS packet
+ * @param  packet_len   length of the packet
+ * @param  offset       where the name starts
+ * @param  name         mdns_name_t structure to populate, cleared
+ *
+ * @return the entry of the name or NULL if it was not indexed
+ */
+static const mdns_name_entry_t *_mdns_name_table_read(mdns_name_table_t *table, const uint8_t *packet,
+                                                      size_t packet_len, uint16_t offset, mdns_name_t *name)
+{
+    if (table->count == MDNS_NAME_TABLE_NAMES || (table->count && table->names[table->count - 1].offset >= offset)) {
+        return NULL;
+    }
+    mdns_name_entry_t *entry = &table->names[table->count];
+    uint16_t segment = offset;
+    uint16_t index = offset;
+    char buf[MDNS_NAME_BUF_LEN];
+    entry->offset = offset;
+    entry->end = 0;
+    entry->first = table->label_count;
+    while (index < packet_len) {
+        uint8_t len = packet[index];
+        if (len == 0) {
+            if (!entry->end) {
+                entry->end = index + 1;
             }
+            entry->count = table->label_count - entry->first;
+            table->count++;
+            return entry;
         }
-    } else if (service && (type == MDNS_TYPE_SRV || type == MDNS_TYPE_TXT)) {
-        const char *name = _mdns_get_service_instance_name(service->service);
-        if (name && question->host && question->service && question->proto && question->domain
-                && !strcasecmp(name, question->host)
-                && !strcasecmp(service->service->service, question->service)
-                && !strcasecmp(service->service->proto, question->proto)
-                && !strcasecmp(MDNS_DEFAULT_DOMAIN, question->domain)) {
-            return true;
+        if (len >= 0xC0) {
+            if (index + 1 >= packet_len) {
+                break;
+            }
+            uint16_t address = ((uint16_t)(len & 0x3F) << 8) | packet[index + 1];
+            if (address >= segment || !packet[address]) {
+                // invalid, or an empty target that _mdns_read_fqdn() checks for the 4 parts once more
+                break;
+            }
+            if (!entry->end) {
+                entry->end = index + 2;
+            }
+            segment = index = address;
+            continue;
+        }
+        if (len > 63 || index + 1 + len > packet_len || table->label_count == MDNS_NAME_TABLE_LABELS) {
+            break;
+        }
+        if (name->parts == 4) {
+            name->invalid = true;
         }
+        memcpy(buf, packet + index + 1, len);
+        buf[len] = '\0';
+        _mdns_read_label(name, buf, len);
+        table->labels[table->label_count++] = index;
+        index += 1 + len;
     }
+    table->label_count = entry->first;
+    return NULL;
+}
 
-    return false;
+/**
+ * @brief  reads and formats the FQDN at start, indexing it in the name table of the packet
+ *
+ * The labels of a name read before are taken from the table, without following its pointers
+ * again. Names are equal when their first labels are at the same offset: a name equal to the
+ * one already in the buffer, or a pointer to it, is not read again.
+ *
+ * @param  table        the name table of the packet
+ * @param  packet       MDNS packet
+ * @param  start        Starting point of FQDN
+ * @param  name         mdns_name_t structure to populate
+ * @param  labels       offset of the first label of the name in the buffer (0 if unknown), updated
+ * @param  packet_len   length of the packet
+ *
+ * @return the address after the parsed FQDN in the packet or NULL on error
+ */
+static const uint8_t *_mdns_parse_name(mdns_name_table_t *table, const uint8_t *packet, const uint8_t *start,
+                                       mdns_name_t *name, uint16_t *labels, size_t packet_len)
+{
+    uint16_t offset = start - packet;
+    if (*labels && offset + 1 < packet_len && start[0] >= 0xC0
+            && (((uint16_t)(start[0] & 0x3F) << 8) | start[1]) == *labels && *labels < offset) {
+        // a pointer to the first label of the name in the buffer
+        return start + 2;
+    }
+    const mdns_name_entry_t *entry = _mdns_name_table_find(table, offset);
+    if (entry) {
+        uint16_t first = entry->count ? table->labels[entry->first] : 0;
+        if (first && first == *labels) {
+            return packet + entry->end;
+        }
+        char buf[MDNS_NAME_BUF_LEN];
+        _mdns_name_clear(name);
+        for (uint8_t i = 0; i < entry->count; i++) {
+            const uint8_t *label = packet + table->labels[entry->first + i];
+            if (name->parts == 4) {
+                name->invalid = true;
+            }
+            memcpy(buf, label + 1, label[0]);
+            buf[label[0]] = '\0';
+            _mdns_read_label(name, buf, label[0]);
+        }
+        *labels = first;
+        return _mdns_name_format(name, packet + entry->end);
+    }
+    _mdns_name_clear(name);
+    entry = _mdns_name_table_read(table, packet, packet_len, offset, name);
+    if (!entry) {
+        *labels = 0;
+        return _mdns_parse_fqdn(packet, start, name, packet_len);
+    }
+    *labels = entry->count ? table->labels[entry->first] : 0;
+    return _mdns_name_format(name, packet + entry->end);
 }
 
 /**
- * @brief  Removes saved question from parsed data
+ * @brief  Saves a record of ours sent by another host with the same data as ours
+ *
+ * The record is kept if its TTL is at least half of ours in a query (RFC 6762 7.1)
+ * and not lower than ours in a response (RFC 6762 7.4)
+ *
+ * @return false on allocation failure
  */
-static void _mdns_remove_parsed_question(mdns_parsed_packet_t *parsed_packet, uint16_t type, mdns_srv_item_t *service)
+static bool _mdns_add_known_answer(mdns_parsed_packet_t *parsed_packet, uint16_t type, uint32_t ttl,
+                                   mdns_service_t *service, mdns_host_item_t *host, const esp_ip_addr_t *addr)
 {
-    mdns_parsed_question_t *q = parsed_packet->questions;
-
-    if (_mdns_question_matches(q, type, service)) {
-        parsed_packet->questions = q->next;
-        mdns_mem_free(q->host);
-        mdns_mem_free(q->service);
-        mdns_mem_free(q->proto);
-        mdns_mem_free(q->domain);
-        mdns_mem_free(q);
-        return;
+    uint32_t our_ttl = _mdns_answer_ttl(type);
+    if (ttl < (parsed_packet->authoritative ? our_ttl : our_ttl / 2)) {
+        return true;
     }
-
-    while (q->next) {
-        mdns_parsed_question_t *p = q->next;
-        if (_mdns_question_matches(p, type, service)) {
-            q->next = p->next;
-            mdns_mem_free(p->host);
-            mdns_mem_free(p->service);
-            mdns_mem_free(p->proto);
-            mdns_mem_free(p->domain);
-            mdns_mem_free(p);
-            return;
-        }
-        q = q->next;
+    mdns_known_answer_t *known = (mdns_known_answer_t *)mdns_mem_calloc(1, sizeof(mdns_known_answer_t));
+    if (!known) {
+        HOOK_MALLOC_FAILED;
+        return false;
+    }
+    known->type = type;
+    known->service = service;
+    known->host = host;
+    if (addr) {
+        memcpy(&known->addr, addr, sizeof(esp_ip_addr_t));
     }
+    known->next = parsed_packet->known_answers;
+    parsed_packet->known_answers = known;
+    return true;
 }
 
 /**
@@ -3665,13 +4856,21 @@ static esp_err_t _mdns_strdup_check(char **out, char *in)
 }
 
 /**
- * @brief  main packet parser
+ * @brief  Parse context of the mDNS task, other callers of _mdns_parse_packet() bring their own
+ */
+static mdns_parse_ctx_t _mdns_rx_ctx;
+
+/**
+ * @brief  packet parser working in the given context
+ *
+ * The scratch state is in ctx. Results are applied to the server state, so calls still
+ * have to be serialized with MDNS_SERVICE_LOCK()
  *
+ * @param  ctx          parse context
  * @param  packet       the packet
  */
-void mdns_parse_packet(mdns_rx_packet_t *packet)
+static void _mdns_parse_packet(mdns_parse_ctx_t *ctx, mdns_rx_packet_t *packet)
 {
-    static mdns_name_t n;
     mdns_header_t header;
     const uint8_t *data = _mdns_get_packet_data(packet);
     size_t len = _mdns_get_packet_len(packet);
@@ -3733,7 +4932,7 @@ void mdns_parse_packet(mdns_rx_packet_t *packet)
     }
     memset(parsed_packet, 0, sizeof(mdns_parsed_packet_t));
 
-    mdns_name_t *name = &n;
+    mdns_name_t *name = &ctx->name;
     memset(name, 0, sizeof(mdns_name_t));
 
     header.id = _mdns_read_u16(data, MDNS_HEAD_ID_OFFSET);
@@ -3762,13 +4961,15 @@ void mdns_parse_packet(mdns_rx_packet_t *packet)
     parsed_packet->id = header.id;
     esp_netif_ip_addr_copy(&parsed_packet->src, &packet->src);
     parsed_packet->src_port = packet->src_port;
-    parsed_packet->records = NULL;
+    parsed_packet->known_answers = NULL;
+
+    _mdns_name_table_reset(ctx);
 
     if (header.questions) {
         uint8_t qs = header.questions;
 
         while (qs--) {
-            content = _mdns_parse_fqdn(data, content, name, len);
+            content = _mdns_parse_name(&ctx->names, data, content, name, &ctx->name_labels, len);
             if (!content) {
                 header.answers = 0;
                 header.additional = 0;
@@ -3850,7 +5051,7 @@ void mdns_parse_packet(mdns_rx_packet_t *packet)
 
         while (content < (data + len)) {
 
-            content = _mdns_parse_fqdn(data, content, name, len);
+            content = _mdns_parse_name(&ctx->names, data, content, name, &ctx->name_labels, len);
             if (!content) {
                 goto clear_rx_packet;//error
             }
@@ -3863,6 +5064,7 @@ void mdns_parse_packet(mdns_rx_packet_t *packet)
             uint32_t ttl = _mdns_read_u32(content, MDNS_TTL_OFFSET);
             uint16_t data_len = _mdns_read_u16(content, MDNS_LEN_OFFSET);
             const uint8_t *data_ptr = content + MDNS_DATA_OFFSET;
+            bool cache_flush = mdns_class & 0x8000;
             mdns_class &= 0x7FFF;
 
             content = data_ptr + data_len;
@@ -3892,13 +5094,20 @@ void mdns_parse_packet(mdns_rx_packet_t *packet)
             } else if (!name->sub && _mdns_name_is_ours(name)) {
                 ours = true;
                 if (name->service[0] && name->proto[0]) {
-                    service = _mdns_get_service_item(name->service, name->proto, NULL);
+                    service = _mdns_get_service_item_instance(name->host[0] ? name->host : NULL, name->service, name->proto, NULL);
                 }
             } else {
                 if ((header.flags & MDNS_FLAGS_QUERY_REPSONSE) == 0 || record_type == MDNS_NS) {
                     //skip this record
                     continue;
                 }
+                mdns_cache_record_t record;
+                if (mdns_class == MDNS_CLASS_IN && (MDNS_CACHE_SIZE || _mdns_server->delta_browses)
+                        && _mdns_record_read(ctx, data, len, name, type, data_ptr, data_len, packet->tcpip_if,
+                                             packet->ip_protocol, &record)) {
+                    _mdns_cache_add(&record, cache_flush, ttl);
+                    _mdns_browse_delta_record(&record, cache_flush, ttl);
+                }
                 search_result = _mdns_search_find_from(_mdns_server->search_once, name, type, packet->tcpip_if, packet->ip_protocol);
                 browse_result = _mdns_browse_find_from(_mdns_server->browse, name, type, packet->tcpip_if, packet->ip_protocol);
                 if (browse_result) {
@@ -3919,7 +5128,7 @@ void mdns_parse_packet(mdns_rx_packet_t *packet)
                             goto clear_rx_packet;
                         }
                     }
-                    memcpy(browse_result_service, browse_result->service, MDNS_NAME_BUF_LEN);
+                    memcpy(browse_result_service, browse_result->service, strlen(browse_result->service) + 1);
                     if (!browse_result_proto) {
                         browse_result_proto = (char *)mdns_mem_malloc(MDNS_NAME_BUF_LEN);
                         if (!browse_result_proto) {
@@ -3927,7 +5136,7 @@ void mdns_parse_packet(mdns_rx_packet_t *packet)
                             goto clear_rx_packet;
                         }
                     }
-                    memcpy(browse_result_proto, browse_result->proto, MDNS_NAME_BUF_LEN);
+                    memcpy(browse_result_proto, browse_result->proto, strlen(browse_result->proto) + 1);
                     if (type == MDNS_TYPE_SRV || type == MDNS_TYPE_TXT) {
                         if (!browse_result_instance) {
                             browse_result_instance = (char *)mdns_mem_malloc(MDNS_NAME_BUF_LEN);
@@ -3942,7 +5151,7 @@ void mdns_parse_packet(mdns_rx_packet_t *packet)
             }
 
             if (type == MDNS_TYPE_PTR) {
-                if (!_mdns_parse_fqdn(data, data_ptr, name, len)) {
+                if (!_mdns_parse_name(&ctx->names, data, data_ptr, name, &ctx->name_labels, len)) {
                     continue;//error
                 }
                 if (search_result) {
@@ -3954,78 +5163,23 @@ void mdns_parse_packet(mdns_rx_packet_t *packet)
                     } else {
                         service = _mdns_get_service_item(name->service, name->proto, NULL);
                     }
-                    if (discovery && service) {
-                        _mdns_remove_parsed_question(parsed_packet, MDNS_TYPE_SDPTR, service);
-                    } else if (service && parsed_packet->questions && !parsed_packet->probe) {
-                        _mdns_remove_parsed_question(parsed_packet, type, service);
-                    } else if (service) {
-                        //check if TTL is more than half of the full TTL value (4500)
-                        if (ttl > (MDNS_ANSWER_PTR_TTL / 2)) {
-                            _mdns_remove_scheduled_answer(packet->tcpip_if, packet->ip_protocol, type, service);
-                        }
-                    }
-                    if (service) {
-                        mdns_parsed_record_t *record = mdns_mem_malloc(sizeof(mdns_parsed_record_t));
-                        if (!record) {
-                            HOOK_MALLOC_FAILED;
-                            goto clear_rx_packet;
-                        }
-                        record->next = parsed_packet->records;
-                        parsed_packet->records = record;
-                        record->type = MDNS_TYPE_PTR;
-                        record->record_type = MDNS_ANSWER;
-                        record->ttl = ttl;
-                        record->host = NULL;
-                        record->service = NULL;
-                        record->proto = NULL;
-                        if (name->host[0]) {
-                            record->host = mdns_mem_malloc(MDNS_NAME_BUF_LEN);
-                            if (!record->host) {
-                                HOOK_MALLOC_FAILED;
-                                goto clear_rx_packet;
-                            }
-                            memcpy(record->host, name->host, MDNS_NAME_BUF_LEN);
-                        }
-                        if (name->service[0]) {
-                            record->service = mdns_mem_malloc(MDNS_NAME_BUF_LEN);
-                            if (!record->service) {
-                                HOOK_MALLOC_FAILED;
-                                goto clear_rx_packet;
-                            }
-                            memcpy(record->service, name->service, MDNS_NAME_BUF_LEN);
-                        }
-                        if (name->proto[0]) {
-                            record->proto = mdns_mem_malloc(MDNS_NAME_BUF_LEN);
-                            if (!record->proto) {
-                                HOOK_MALLOC_FAILED;
-                                goto clear_rx_packet;
-                            }
-                            memcpy(record->proto, name->proto, MDNS_NAME_BUF_LEN);
-                        }
+                    if (service && !parsed_packet->probe
+                            && !_mdns_add_known_answer(parsed_packet, discovery ? MDNS_TYPE_SDPTR : MDNS_TYPE_PTR, ttl,
+                                                       service->service, NULL, NULL)) {
+                        goto clear_rx_packet;
                     }
                 }
             } else if (type == MDNS_TYPE_SRV) {
                 mdns_result_t *result = NULL;
                 if (search_result && search_result->type == MDNS_TYPE_PTR) {
-                    result = search_result->result;
-                    while (result) {
-                        if (_mdns_get_esp_netif(packet->tcpip_if) == result->esp_netif
-                                && packet->ip_protocol == result->ip_protocol
-                                && result->instance_name && !strcmp(name->host, result->instance_name)) {
-                            break;
-                        }
-                        result = result->next;
-                    }
+                    result = _mdns_search_result_get_instance(search_result, name->host, name->service, name->proto,
+                                                              packet->tcpip_if, packet->ip_protocol, ttl);
                     if (!result) {
-                        result = _mdns_search_result_add_ptr(search_result, name->host, name->service, name->proto,
-                                                             packet->tcpip_if, packet->ip_protocol, ttl);
-                        if (!result) {
-                            continue;//error
-                        }
+                        continue;//error
                     }
                 }
                 bool is_selfhosted = _mdns_name_is_selfhosted(name);
-                if (!_mdns_parse_fqdn(data, data_ptr + MDNS_SRV_FQDN_OFFSET, name, len)) {
+                if (!_mdns_parse_name(&ctx->names, data, data_ptr + MDNS_SRV_FQDN_OFFSET, name, &ctx->name_labels, len)) {
                     continue;//error
                 }
                 if (data_ptr + MDNS_SRV_PORT_OFFSET + 1 >= data + len) {
@@ -4049,11 +5203,12 @@ void mdns_parse_packet(mdns_rx_packet_t *packet)
                         _mdns_search_result_add_srv(search_result, name->host, port, packet->tcpip_if, packet->ip_protocol, ttl);
                     }
                 } else if (ours) {
-                    if (parsed_packet->questions && !parsed_packet->probe) {
-                        _mdns_remove_parsed_question(parsed_packet, type, service);
-                        continue;
-                    } else if (parsed_packet->distributed) {
-                        _mdns_remove_scheduled_answer(packet->tcpip_if, packet->ip_protocol, type, service);
+                    if (service && !parsed_packet->probe && mdns_class == 1
+                            && _mdns_srv_data_is_ours(service->service, priority, weight, port, name->host, name->domain)
+                            && !_mdns_add_known_answer(parsed_packet, type, ttl, service->service, NULL, NULL)) {
+                        goto clear_rx_packet;
+                    }
+                    if ((parsed_packet->questions && !parsed_packet->probe) || parsed_packet->distributed) {
                         continue;
                     }
                     if (!is_selfhosted) {
@@ -4076,8 +5231,10 @@ void mdns_parse_packet(mdns_rx_packet_t *packet)
                                 if (!_str_null_or_empty(service->service->instance)) {
                                     char *new_instance = _mdns_mangle_name((char *)service->service->instance);
                                     if (new_instance) {
+                                        _mdns_service_index_remove_instance(service);
                                         mdns_mem_free((char *)service->service->instance);
                                         service->service->instance = new_instance;
+                                        _mdns_service_index_add_instance(service);
                                     }
                                     _mdns_probe_all_pcbs(&service, 1, false, false);
                                 } else if (!_str_null_or_empty(_mdns_server->instance)) {
@@ -4085,6 +5242,7 @@ void mdns_parse_packet(mdns_rx_packet_t *packet)
                                     if (new_instance) {
                                         mdns_mem_free((char *)_mdns_server->instance);
                                         _mdns_server->instance = new_instance;
+                                        _mdns_service_index_rebuild();
                                     }
                                     _mdns_restart_all_pcbs_no_instance();
                                 } else {
@@ -4094,6 +5252,7 @@ void mdns_parse_packet(mdns_rx_packet_t *packet)
                                         mdns_mem_free((char *)_mdns_server->hostname);
                                         _mdns_server->hostname = new_host;
                                         _mdns_self_host.hostname = new_host;
+                                        _mdns_service_index_rebuild();
                                     }
                                     _mdns_restart_all_pcbs();
                                 }
@@ -4102,8 +5261,6 @@ void mdns_parse_packet(mdns_rx_packet_t *packet)
                                 _mdns_init_pcb_probe(packet->tcpip_if, packet->ip_protocol, &service, 1, false);
                             }
                         }
-                    } else if (ttl > 60 && !col && !parsed_packet->authoritative && !parsed_packet->probe && !parsed_packet->questions) {
-                        _mdns_remove_scheduled_answer(packet->tcpip_if, packet->ip_protocol, type, service);
                     }
                 }
             } else if (type == MDNS_TYPE_TXT) {
@@ -4119,21 +5276,10 @@ void mdns_parse_packet(mdns_rx_packet_t *packet)
                 }
                 if (search_result) {
                     if (search_result->type == MDNS_TYPE_PTR) {
-                        result = search_result->result;
-                        while (result) {
-                            if (_mdns_get_esp_netif(packet->tcpip_if) == result->esp_netif
-                                    && packet->ip_protocol == result->ip_protocol
-                                    && result->instance_name && !strcmp(name->host, result->instance_name)) {
-                                break;
-                            }
-                            result = result->next;
-                        }
+                        result = _mdns_search_result_get_instance(search_result, name->host, name->service, name->proto,
+                                                                  packet->tcpip_if, packet->ip_protocol, ttl);
                         if (!result) {
-                            result = _mdns_search_result_add_ptr(search_result, name->host, name->service, name->proto,
-                                                                 packet->tcpip_if, packet->ip_protocol, ttl);
-                            if (!result) {
-                                continue;//error
-                            }
+                            continue;//error
                         }
                         if (!result->txt) {
                             _mdns_result_txt_create(data_ptr, data_len, &txt, &txt_value_len, &txt_count);
@@ -4150,8 +5296,12 @@ void mdns_parse_packet(mdns_rx_packet_t *packet)
                         }
                     }
                 } else if (ours) {
+                    if (service && !parsed_packet->probe && mdns_class == 1
+                            && !_mdns_check_txt_collision(service->service, data_ptr, data_len)
+                            && !_mdns_add_known_answer(parsed_packet, type, ttl, service->service, NULL, NULL)) {
+                        goto clear_rx_packet;
+                    }
                     if (parsed_packet->questions && !parsed_packet->probe && service) {
-                        _mdns_remove_parsed_question(parsed_packet, type, service);
                         continue;
                     }
                     if (!_mdns_name_is_selfhosted(name)) {
@@ -4169,8 +5319,6 @@ void mdns_parse_packet(mdns_rx_packet_t *packet)
                     if (col && !_mdns_server->interfaces[packet->tcpip_if].pcbs[packet->ip_protocol].probe_running && service) {
                         do_not_reply = true;
                         _mdns_init_pcb_probe(packet->tcpip_if, packet->ip_protocol, &service, 1, true);
-                    } else if (ttl > (MDNS_ANSWER_TXT_TTL / 2) && !col && !parsed_packet->authoritative && !parsed_packet->probe && !parsed_packet->questions && !_mdns_server->interfaces[packet->tcpip_if].pcbs[packet->ip_protocol].probe_running) {
-                        _mdns_remove_scheduled_answer(packet->tcpip_if, packet->ip_protocol, type, service);
                     }
                 }
 
@@ -4190,8 +5338,12 @@ void mdns_parse_packet(mdns_rx_packet_t *packet)
                         search_result = _mdns_search_find_from(search_result->next, name, type, packet->tcpip_if, packet->ip_protocol);
                     }
                 } else if (ours) {
+                    mdns_host_item_t *host = mdns_get_host_item(name->host);
+                    if (host && !parsed_packet->probe && mdns_class == 1
+                            && !_mdns_add_known_answer(parsed_packet, type, ttl, NULL, host, &ip6)) {
+                        goto clear_rx_packet;
+                    }
                     if (parsed_packet->questions && !parsed_packet->probe) {
-                        _mdns_remove_parsed_question(parsed_packet, type, NULL);
                         continue;
                     }
                     if (!_mdns_name_is_selfhosted(name)) {
@@ -4219,14 +5371,13 @@ void mdns_parse_packet(mdns_rx_packet_t *packet)
                                     mdns_mem_free((char *)_mdns_server->hostname);
                                     _mdns_server->hostname = new_host;
                                     _mdns_self_host.hostname = new_host;
+                                    _mdns_service_index_rebuild();
                                 }
                                 _mdns_restart_all_pcbs();
                             }
                         } else {
                             _mdns_init_pcb_probe(packet->tcpip_if, packet->ip_protocol, NULL, 0, true);
                         }
-                    } else if (ttl > 60 && !col && !parsed_packet->authoritative && !parsed_packet->probe && !parsed_packet->questions && !_mdns_server->interfaces[packet->tcpip_if].pcbs[packet->ip_protocol].probe_running) {
-                        _mdns_remove_scheduled_answer(packet->tcpip_if, packet->ip_protocol, type, NULL);
                     }
                 }
 
@@ -4247,8 +5398,12 @@ void mdns_parse_packet(mdns_rx_packet_t *packet)
                         search_result = _mdns_search_find_from(search_result->next, name, type, packet->tcpip_if, packet->ip_protocol);
                     }
                 } else if (ours) {
+                    mdns_host_item_t *host = mdns_get_host_item(name->host);
+                    if (host && !parsed_packet->probe && mdns_class == 1
+                            && !_mdns_add_known_answer(parsed_packet, type, ttl, NULL, host, &ip)) {
+                        goto clear_rx_packet;
+                    }
                     if (parsed_packet->questions && !parsed_packet->probe) {
-                        _mdns_remove_parsed_question(parsed_packet, type, NULL);
                         continue;
                     }
                     if (!_mdns_name_is_selfhosted(name)) {
@@ -4276,14 +5431,13 @@ void mdns_parse_packet(mdns_rx_packet_t *packet)
                                     mdns_mem_free((char *)_mdns_server->hostname);
                                     _mdns_server->hostname = new_host;
                                     _mdns_self_host.hostname = new_host;
+                                    _mdns_service_index_rebuild();
                                 }
                                 _mdns_restart_all_pcbs();
                             }
                         } else {
                             _mdns_init_pcb_probe(packet->tcpip_if, packet->ip_protocol, NULL, 0, true);
                         }
-                    } else if (ttl > 60 && !col && !parsed_packet->authoritative && !parsed_packet->probe && !parsed_packet->questions && !_mdns_server->interfaces[packet->tcpip_if].pcbs[packet->ip_protocol].probe_running) {
-                        _mdns_remove_scheduled_answer(packet->tcpip_if, packet->ip_protocol, type, NULL);
                     }
                 }
 
@@ -4298,6 +5452,8 @@ void mdns_parse_packet(mdns_rx_packet_t *packet)
 
     if (!do_not_reply && _mdns_server->interfaces[packet->tcpip_if].pcbs[packet->ip_protocol].state > PCB_PROBE_3 && (parsed_packet->questions || parsed_packet->discovery)) {
         _mdns_create_answer_from_parsed_packet(parsed_packet);
+    } else if (parsed_packet->known_answers && !parsed_packet->questions && !parsed_packet->discovery) {
+        _mdns_remove_scheduled_known_answers(parsed_packet);
     }
     if (out_sync_browse) {
 #ifdef MDNS_ENABLE_DEBUG
@@ -4317,6 +5473,7 @@ void mdns_parse_packet(mdns_rx_packet_t *packet)
     }
 
 clear_rx_packet:
+    _mdns_browse_delta_flush_all();
     while (parsed_packet->questions) {
         mdns_parsed_question_t *question = parsed_packet->questions;
         parsed_packet->questions = parsed_packet->questions->next;
@@ -4334,20 +5491,10 @@ clear_rx_packet:
         }
         mdns_mem_free(question);
     }
-    while (parsed_packet->records) {
-        mdns_parsed_record_t *record = parsed_packet->records;
-        parsed_packet->records = parsed_packet->records->next;
-        if (record->host) {
-            mdns_mem_free(record->host);
-        }
-        if (record->service) {
-            mdns_mem_free(record->service);
-        }
-        if (record->proto) {
-            mdns_mem_free(record->proto);
-        }
-        record->next = NULL;
-        mdns_mem_free(record);
+    while (parsed_packet->known_answers) {
+        mdns_known_answer_t *known = parsed_packet->known_answers;
+        parsed_packet->known_answers = known->next;
+        mdns_mem_free(known);
     }
     mdns_mem_free(parsed_packet);
     mdns_mem_free(browse_result_instance);
@@ -4356,6 +5503,19 @@ clear_rx_packet:
     mdns_mem_free(out_sync_browse);
 }
 
+/**
+ * @brief  main packet parser
+ *
+ * @param  packet       the packet
+ */
+void mdns_parse_packet(mdns_rx_packet_t *packet)
+{
+    int64_t start = _mdns_stats_now();
+    _mdns_stats_rx(packet);
+    _mdns_parse_packet(&_mdns_rx_ctx, packet);
+    _mdns_stats_parse_time(start);
+}
+
 /**
  * @brief  Enable mDNS interface
  */
@@ -4378,7 +5538,7 @@ void _mdns_disable_pcb(mdns_if_t tcpip_if, mdns_ip_protocol_t ip_protocol)
     _mdns_clean_netif_ptr(tcpip_if);
 
     if (mdns_is_netif_ready(tcpip_if, ip_protocol)) {
-        _mdns_clear_pcb_tx_queue_head(tcpip_if, ip_protocol);
+        _mdns_clear_pcb_tx_queue(tcpip_if, ip_protocol);
         mdns_pcb_deinit_local(tcpip_if, ip_protocol);
         mdns_if_t other_if = _mdns_get_other_if(tcpip_if);
         if (other_if != MDNS_MAX_INTERFACES && _mdns_server->interfaces[other_if].pcbs[ip_protocol].state == PCB_DUP) {
@@ -4638,7 +5798,7 @@ static mdns_search_once_t *_mdns_search_init(const char *name, const char *servi
     search->max_results = max_results;
     search->result = NULL;
     search->state = SEARCH_INIT;
-    search->sent_at = 0;
+    memset(&search->query, 0, sizeof(search->query));
     search->started_at = xTaskGetTickCount() * portTICK_PERIOD_MS;
     search->notifier = notifier;
     search->next = NULL;
@@ -4664,8 +5824,18 @@ static void _mdns_search_finish(mdns_search_once_t *search)
  */
 static void _mdns_search_add(mdns_search_once_t *search)
 {
+    MDNS_STATS_INC(searches);
     search->next = _mdns_server->search_once;
     _mdns_server->search_once = search;
+    if (MDNS_CACHE_SIZE) {
+        if (_mdns_cache_feed_search(search)) {
+            _mdns_server->cache.hits++;
+            _mdns_search_finish_done();
+        } else {
+            _mdns_server->cache.misses++;
+        }
+    }
+    _mdns_timer_arm();
 }
 
 /**
@@ -4839,20 +6009,38 @@ static mdns_result_t *_mdns_search_result_add_ptr(mdns_search_once_t *search, co
 }
 
 /**
- * @brief  Called from parser to add SRV data to search result
+ * @brief  Result of a PTR search for the instance, added if missing
  */
-static void _mdns_search_result_add_srv(mdns_search_once_t *search, const char *hostname, uint16_t port,
-                                        mdns_if_t tcpip_if, mdns_ip_protocol_t ip_protocol, uint32_t ttl)
+static mdns_result_t *_mdns_search_result_get_instance(mdns_search_once_t *search, const char *instance,
+                                                       const char *service_type, const char *proto, mdns_if_t tcpip_if,
+                                                       mdns_ip_protocol_t ip_protocol, uint32_t ttl)
 {
     mdns_result_t *r = search->result;
     while (r) {
-        if (r->esp_netif == _mdns_get_esp_netif(tcpip_if) && r->ip_protocol == ip_protocol && !_str_null_or_empty(r->hostname) && !strcasecmp(hostname, r->hostname)) {
-            _mdns_result_update_ttl(r, ttl);
-            return;
+        if (_mdns_get_esp_netif(tcpip_if) == r->esp_netif && ip_protocol == r->ip_protocol
+                && r->instance_name && !strcmp(instance, r->instance_name)) {
+            return r;
         }
         r = r->next;
     }
-    if (!search->max_results || search->num_results < search->max_results) {
+    return _mdns_search_result_add_ptr(search, instance, service_type, proto, tcpip_if, ip_protocol, ttl);
+}
+
+/**
+ * @brief  Called from parser to add SRV data to search result
+ */
+static void _mdns_search_result_add_srv(mdns_search_once_t *search, const char *hostname, uint16_t port,
+                                        mdns_if_t tcpip_if, mdns_ip_protocol_t ip_protocol, uint32_t ttl)
+{
+    mdns_result_t *r = search->result;
+    while (r) {
+        if (r->esp_netif == _mdns_get_esp_netif(tcpip_if) && r->ip_protocol == ip_protocol && !_str_null_or_empty(r->hostname) && !strcasecmp(hostname, r->hostname)) {
+            _mdns_result_update_ttl(r, ttl);
+            return;
+        }
+        r = r->next;
+    }
+    if (!search->max_results || search->num_results < search->max_results) {
         r = (mdns_result_t *)mdns_mem_malloc(sizeof(mdns_result_t));
         if (!r) {
             HOOK_MALLOC_FAILED;
@@ -4998,59 +6186,615 @@ static mdns_search_once_t *_mdns_search_find_from(mdns_search_once_t *s, mdns_na
 }
 
 /**
- * @brief  Create search packet for particular interface
+ * @brief  Drop the cached record at *link
  */
-static mdns_tx_packet_t *_mdns_create_search_packet(mdns_search_once_t *search, mdns_if_t tcpip_if, mdns_ip_protocol_t ip_protocol)
+static void _mdns_cache_drop(mdns_cache_record_t **link)
 {
-    mdns_result_t *r = NULL;
-    mdns_tx_packet_t *packet = _mdns_alloc_packet_default(tcpip_if, ip_protocol);
-    if (!packet) {
-        return NULL;
+    mdns_cache_record_t *r = *link;
+    *link = r->next;
+    _mdns_server->cache.bytes -= r->size;
+    _mdns_server->cache.len--;
+    mdns_mem_free(r);
+}
+
+static bool _mdns_cache_expired(const mdns_cache_record_t *r, uint32_t now)
+{
+    return (int32_t)(r->expires_at - now) <= 0;
+}
+
+/**
+ * @brief  TTL left to a cached record (s), rounded up
+ */
+static uint32_t _mdns_cache_ttl_left(const mdns_cache_record_t *r, uint32_t now)
+{
+    return _mdns_cache_expired(r, now) ? 0 : (r->expires_at - now + 999) / 1000;
+}
+
+/**
+ * @brief  Drop the records whose TTL ran out
+ */
+static void _mdns_cache_expire(uint32_t now)
+{
+    mdns_cache_record_t **link = &_mdns_server->cache.records;
+    while (*link) {
+        if (_mdns_cache_expired(*link, now)) {
+            _mdns_cache_drop(link);
+            _mdns_server->cache.expirations++;
+        } else {
+            link = &(*link)->next;
+        }
     }
+}
 
-    mdns_out_question_t *q = (mdns_out_question_t *)mdns_mem_malloc(sizeof(mdns_out_question_t));
-    if (!q) {
+/**
+ * @brief  Make room for a record of size bytes
+ *
+ * Expired records go first, then the ones received longest ago.
+ *
+ * @return false if the record is larger than the cache
+ */
+static bool _mdns_cache_reserve(size_t size, uint32_t now)
+{
+    if (size > MDNS_CACHE_SIZE) {
+        return false;
+    }
+    if (_mdns_server->cache.bytes + size > MDNS_CACHE_SIZE) {
+        _mdns_cache_expire(now);
+    }
+    while (_mdns_server->cache.bytes + size > MDNS_CACHE_SIZE) {
+        mdns_cache_record_t **victim = &_mdns_server->cache.records;
+        for (mdns_cache_record_t **link = &(*victim)->next; *link; link = &(*link)->next) {
+            if ((int32_t)((*link)->received_at - (*victim)->received_at) < 0) {
+                victim = link;
+            }
+        }
+        _mdns_cache_drop(victim);
+        _mdns_server->cache.evictions++;
+    }
+    return true;
+}
+
+static bool _mdns_cache_same_name(const mdns_cache_record_t *a, const mdns_cache_record_t *b)
+{
+    return a->type == b->type && a->tcpip_if == b->tcpip_if && a->ip_protocol == b->ip_protocol
+           && !strcasecmp(a->name, b->name) && !strcasecmp(a->service, b->service) && !strcasecmp(a->proto, b->proto);
+}
+
+static bool _mdns_cache_same_data(const mdns_cache_record_t *a, const mdns_cache_record_t *b)
+{
+    switch (a->type) {
+    case MDNS_TYPE_PTR:
+        return !strcasecmp(a->target, b->target);
+    case MDNS_TYPE_SRV:
+        return a->port == b->port && !strcasecmp(a->target, b->target);
+    case MDNS_TYPE_TXT:
+        return a->txt_len == b->txt_len && !memcmp(a->txt, b->txt, a->txt_len);
+#ifdef CONFIG_LWIP_IPV4
+    case MDNS_TYPE_A:
+        return a->addr.u_addr.ip4.addr == b->addr.u_addr.ip4.addr;
+#endif
+#ifdef CONFIG_LWIP_IPV6
+    case MDNS_TYPE_AAAA:
+        return !memcmp(a->addr.u_addr.ip6.addr, b->addr.u_addr.ip6.addr, MDNS_ANSWER_AAAA_SIZE);
+#endif
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief  Whether a cached record answers a question of a search or browse
+ *
+ * PTR questions are answered by the PTR records of the service type, SRV and TXT questions by the records of
+ * the instance, A and AAAA questions by the records of the host (name).
+ */
+static bool _mdns_cache_answers(const mdns_cache_record_t *r, uint16_t type, const char *name, const char *service,
+                                const char *proto)
+{
+    if (r->type != type) {
+        return false;
+    }
+    switch (type) {
+    case MDNS_TYPE_PTR:
+        return service && proto && !strcasecmp(r->service, service) && !strcasecmp(r->proto, proto);
+    case MDNS_TYPE_SRV:
+    case MDNS_TYPE_TXT:
+        return name && service && proto && !strcasecmp(r->name, name) && !strcasecmp(r->service, service)
+               && !strcasecmp(r->proto, proto);
+    case MDNS_TYPE_A:
+    case MDNS_TYPE_AAAA:
+        return name && !strcasecmp(r->name, name);
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief  Time (ms) of the next refresh query of a cached record: 80, 85, 90 or 95% of its TTL, plus its jitter
+ */
+static uint32_t _mdns_cache_refresh_point(const mdns_cache_record_t *r)
+{
+    return r->received_at + r->ttl * 10 * (80 + 5 * r->refreshed + r->refresh_jitter);
+}
+
+/**
+ * @brief  Update the refresh point of a question to the earliest one of its cached answers
+ */
+static void _mdns_query_refresh_update(mdns_query_sched_t *query, uint16_t type, const char *name, const char *service,
+                                       const char *proto, uint32_t now)
+{
+    query->refresh = false;
+    for (mdns_cache_record_t *r = _mdns_server->cache.records; r; r = r->next) {
+        if (r->refreshed >= MDNS_QUERY_REFRESH_STEPS || _mdns_cache_expired(r, now)
+                || !_mdns_cache_answers(r, type, name, service, proto)) {
+            continue;
+        }
+        uint32_t t = _mdns_cache_refresh_point(r);
+        if (!query->refresh || (int32_t)(t - query->refresh_at) < 0) {
+            query->refresh_at = t;
+            query->refresh = true;
+        }
+    }
+}
+
+/**
+ * @brief  Time (ms) after which the question is queried again
+ */
+static uint32_t _mdns_query_deadline(const mdns_query_sched_t *query)
+{
+    uint32_t t = query->sent_at + query->interval;
+    if (query->refresh && (int32_t)(query->refresh_at - t) < 0) {
+        t = query->refresh_at;
+    }
+    return t;
+}
+
+/**
+ * @brief  Whether the question is due for a query
+ *
+ * The refresh point is checked again first: its answer may have been received again or have expired since.
+ */
+static bool _mdns_query_due(mdns_query_sched_t *query, uint16_t type, const char *name, const char *service,
+                            const char *proto, uint32_t now)
+{
+    if ((int32_t)(now - _mdns_query_deadline(query)) <= 0) {
+        return false;
+    }
+    if (query->refresh) {
+        _mdns_query_refresh_update(query, type, name, service, proto, now);
+    }
+    return (int32_t)(now - _mdns_query_deadline(query)) > 0;
+}
+
+/**
+ * @brief  Account for a query of the question sent at now
+ *
+ * If the backoff interval ran out, it doubles (the first query sets it to MDNS_QUERY_INTERVAL_MIN_MS), otherwise
+ * the query was a refresh. Cached answers past a refresh point move to the next one.
+ */
+static void _mdns_query_sent(mdns_query_sched_t *query, uint16_t type, const char *name, const char *service,
+                             const char *proto, uint32_t now)
+{
+    if (!query->interval) {
+        query->interval = MDNS_QUERY_INTERVAL_MIN_MS;
+    } else if ((int32_t)(now - (query->sent_at + query->interval)) > 0) {
+        query->interval = query->interval < MDNS_QUERY_INTERVAL_MAX_MS / 2 ? query->interval * 2 : MDNS_QUERY_INTERVAL_MAX_MS;
+    } else {
+        _mdns_server->queries.refreshes++;
+    }
+    _mdns_server->queries.sent++;
+    query->sent_at = now;
+    for (mdns_cache_record_t *r = _mdns_server->cache.records; r; r = r->next) {
+        if (_mdns_cache_answers(r, type, name, service, proto)) {
+            while (r->refreshed < MDNS_QUERY_REFRESH_STEPS && (int32_t)(now - _mdns_cache_refresh_point(r)) >= 0) {
+                r->refreshed++;
+            }
+        }
+    }
+    _mdns_query_refresh_update(query, type, name, service, proto, now);
+}
+
+/**
+ * @brief  Bring forward the refresh point of the searches and browses a cached record received now answers
+ */
+static void _mdns_cache_refresh_notify(const mdns_cache_record_t *r)
+{
+    uint32_t t = _mdns_cache_refresh_point(r);
+    bool earlier = false;
+    for (mdns_search_once_t *s = _mdns_server->search_once; s; s = s->next) {
+        if (s->state == SEARCH_RUNNING && _mdns_cache_answers(r, s->type, s->instance, s->service, s->proto)
+                && (!s->query.refresh || (int32_t)(t - s->query.refresh_at) < 0)) {
+            s->query.refresh_at = t;
+            s->query.refresh = earlier = true;
+        }
+    }
+    for (mdns_browse_t *b = _mdns_server->browse; b; b = b->next) {
+        if (b->state == BROWSE_RUNNING && _mdns_cache_answers(r, MDNS_TYPE_PTR, NULL, b->service, b->proto)
+                && (!b->query.refresh || (int32_t)(t - b->query.refresh_at) < 0)) {
+            b->query.refresh_at = t;
+            b->query.refresh = earlier = true;
+        }
+    }
+    if (earlier) {
+        _mdns_timer_arm();
+    }
+}
+
+/**
+ * @brief  Called from parser to read a record of another host received in a response
+ *
+ * Only service type PTR, instance SRV and TXT and host A and AAAA records are read. The strings of the record
+ * point to name and ctx->target, its TXT data to the packet.
+ *
+ * @return false if the record is not one of them
+ */
+static bool _mdns_record_read(mdns_parse_ctx_t *ctx, const uint8_t *data, size_t len, mdns_name_t *name, uint16_t type,
+                              const uint8_t *data_ptr, uint16_t data_len, mdns_if_t tcpip_if, mdns_ip_protocol_t ip_protocol,
+                              mdns_cache_record_t *record)
+{
+    if (name->sub || name->invalid || !name->parts) {
+        return false;
+    }
+    bool instance = name->host[0] && name->service[0] && name->proto[0];
+    *record = (mdns_cache_record_t) {
+        .type = type,
+        .tcpip_if = tcpip_if,
+        .ip_protocol = ip_protocol,
+        .name = name->host,
+        .service = name->service,
+        .proto = name->proto,
+        .target = "",
+    };
+    switch (type) {
+    case MDNS_TYPE_PTR:
+        if (name->host[0] || !name->service[0] || !name->proto[0]
+                || !_mdns_parse_name(&ctx->names, data, data_ptr, &ctx->target, &ctx->target_labels, len)
+                || !ctx->target.host[0]) {
+            return false;
+        }
+        record->target = ctx->target.host;
+        return true;
+    case MDNS_TYPE_SRV:
+        if (!instance || data_len <= MDNS_SRV_FQDN_OFFSET
+                || !_mdns_parse_name(&ctx->names, data, data_ptr + MDNS_SRV_FQDN_OFFSET, &ctx->target,
+                                     &ctx->target_labels, len) || !ctx->target.host[0]) {
+            return false;
+        }
+        record->target = ctx->target.host;
+        record->port = _mdns_read_u16(data_ptr, MDNS_SRV_PORT_OFFSET);
+        return true;
+    case MDNS_TYPE_TXT:
+        if (!instance) {
+            return false;
+        }
+        record->txt = data_ptr;
+        record->txt_len = data_len;
+        return true;
+#ifdef CONFIG_LWIP_IPV4
+    case MDNS_TYPE_A:
+        if (!name->host[0] || name->service[0] || data_len != sizeof(record->addr.u_addr.ip4.addr)) {
+            return false;
+        }
+        record->addr.type = ESP_IPADDR_TYPE_V4;
+        memcpy(&record->addr.u_addr.ip4.addr, data_ptr, data_len);
+        return true;
+#endif
+#ifdef CONFIG_LWIP_IPV6
+    case MDNS_TYPE_AAAA:
+        if (!name->host[0] || name->service[0] || data_len != MDNS_ANSWER_AAAA_SIZE) {
+            return false;
+        }
+        record->addr.type = ESP_IPADDR_TYPE_V6;
+        memcpy(record->addr.u_addr.ip6.addr, data_ptr, MDNS_ANSWER_AAAA_SIZE);
+        return true;
+#endif
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief  Called from parser to cache a record read by _mdns_record_read()
+ *
+ * A goodbye (TTL 0) drops the record. With the cache-flush bit, the other records of the same name and type go,
+ * unless received in the last second (RFC 6762 10.2).
+ */
+static void _mdns_cache_add(const mdns_cache_record_t *record, bool flush, uint32_t ttl)
+{
+    if (!MDNS_CACHE_SIZE) {
+        return;
+    }
+    mdns_cache_record_t key = *record;
+    uint32_t now = xTaskGetTickCount() * portTICK_PERIOD_MS;
+    if (ttl > MDNS_CACHE_MAX_TTL) {
+        ttl = MDNS_CACHE_MAX_TTL;
+    }
+    mdns_cache_record_t *found = NULL;
+    mdns_cache_record_t **link = &_mdns_server->cache.records;
+    while (*link) {
+        mdns_cache_record_t *r = *link;
+        if (_mdns_cache_same_name(r, &key)) {
+            if (_mdns_cache_same_data(r, &key)) {
+                if (!ttl) {
+                    _mdns_cache_drop(link);
+                    continue;
+                }
+                found = r;
+            } else if (flush && now - r->received_at > MDNS_CACHE_FLUSH_GRACE_MS) {
+                _mdns_cache_drop(link);
+                continue;
+            }
+        }
+        link = &r->next;
+    }
+    if (found) {
+        found->received_at = now;
+        found->expires_at = now + ttl * 1000;
+        found->ttl = ttl;
+        found->refreshed = 0;
+        found->refresh_jitter = esp_random() % 3;
+        _mdns_cache_refresh_notify(found);
+        return;
+    }
+    if (!ttl) {
+        return;
+    }
+
+    size_t name_len = strlen(key.name) + 1;
+    size_t service_len = strlen(key.service) + 1;
+    size_t proto_len = strlen(key.proto) + 1;
+    size_t target_len = strlen(key.target) + 1;
+    size_t size = sizeof(mdns_cache_record_t) + name_len + service_len + proto_len + target_len + key.txt_len;
+    if (!_mdns_cache_reserve(size, now)) {
+        return;
+    }
+    mdns_cache_record_t *r = (mdns_cache_record_t *)mdns_mem_malloc(size);
+    if (!r) {
         HOOK_MALLOC_FAILED;
-        _mdns_free_tx_packet(packet);
-        return NULL;
+        return;
     }
-    q->next = NULL;
-    q->unicast = search->unicast;
-    q->type = search->type;
-    q->host = search->instance;
-    q->service = search->service;
-    q->proto = search->proto;
-    q->domain = MDNS_DEFAULT_DOMAIN;
-    q->own_dynamic_memory = false;
-    queueToEnd(mdns_out_question_t, packet->questions, q);
+    *r = key;
+    char *strings = (char *)(r + 1);
+    r->name = memcpy(strings, key.name, name_len);
+    r->service = memcpy(strings += name_len, key.service, service_len);
+    r->proto = memcpy(strings += service_len, key.proto, proto_len);
+    r->target = memcpy(strings += proto_len, key.target, target_len);
+    if (key.txt_len) {
+        r->txt = memcpy(strings + target_len, key.txt, key.txt_len);
+    }
+    r->size = size;
+    r->received_at = now;
+    r->expires_at = now + ttl * 1000;
+    r->ttl = ttl;
+    r->refresh_jitter = esp_random() % 3;
+    r->next = _mdns_server->cache.records;
+    _mdns_server->cache.records = r;
+    _mdns_server->cache.bytes += size;
+    _mdns_server->cache.len++;
+    _mdns_server->cache.inserts++;
+    _mdns_cache_refresh_notify(r);
+}
 
-    if (search->type == MDNS_TYPE_PTR) {
-        r = search->result;
-        while (r) {
-            //full record on the same interface is available
-            if (r->esp_netif != _mdns_get_esp_netif(tcpip_if) || r->ip_protocol != ip_protocol || r->instance_name == NULL || r->hostname == NULL || r->addr == NULL) {
-                r = r->next;
+/**
+ * @brief  Drop the records received on a PCB going down
+ */
+static void _mdns_cache_remove_pcb(mdns_if_t tcpip_if, mdns_ip_protocol_t ip_protocol)
+{
+    mdns_cache_record_t **link = &_mdns_server->cache.records;
+    while (*link) {
+        if ((*link)->tcpip_if == tcpip_if && (*link)->ip_protocol == ip_protocol) {
+            _mdns_cache_drop(link);
+        } else {
+            link = &(*link)->next;
+        }
+    }
+}
+
+static void _mdns_cache_clear(void)
+{
+    while (_mdns_server->cache.records) {
+        _mdns_cache_drop(&_mdns_server->cache.records);
+    }
+}
+
+/**
+ * @brief  Name of a cached record, as the parser would have read it
+ */
+static void _mdns_cache_record_name(const mdns_cache_record_t *r, mdns_name_t *name)
+{
+    // the strings were read by _mdns_parse_fqdn(), they fit the name buffers
+    memset(name, 0, sizeof(mdns_name_t));
+    memcpy(name->host, r->name, strlen(r->name) + 1);
+    memcpy(name->service, r->service, strlen(r->service) + 1);
+    memcpy(name->proto, r->proto, strlen(r->proto) + 1);
+    memcpy(name->domain, MDNS_DEFAULT_DOMAIN, strlen(MDNS_DEFAULT_DOMAIN) + 1);
+    name->parts = (name->host[0] ? 1 : 0) + (name->service[0] ? 2 : 0) + 1;
+}
+
+/**
+ * @brief  Order in which cached records are replayed: PTR records bring instances, SRV records their hosts
+ */
+static const uint16_t _mdns_cache_replay_types[] = {
+    MDNS_TYPE_PTR, MDNS_TYPE_SRV, MDNS_TYPE_TXT, MDNS_TYPE_A, MDNS_TYPE_AAAA
+};
+
+/**
+ * @brief  Give a new search the cached records it would match, as if they had just been received
+ *
+ * @return true if the search got results
+ */
+static bool _mdns_cache_feed_search(mdns_search_once_t *search)
+{
+    if (!_mdns_server->cache.records) {
+        return false;
+    }
+    uint32_t now = xTaskGetTickCount() * portTICK_PERIOD_MS;
+    mdns_name_t name;
+    _mdns_cache_expire(now);
+    for (size_t i = 0; i < sizeof(_mdns_cache_replay_types) / sizeof(_mdns_cache_replay_types[0]); i++) {
+        uint16_t type = _mdns_cache_replay_types[i];
+        for (mdns_cache_record_t *r = _mdns_server->cache.records; r; r = r->next) {
+            if (r->type != type) {
                 continue;
             }
-            mdns_out_answer_t *a = (mdns_out_answer_t *)mdns_mem_malloc(sizeof(mdns_out_answer_t));
-            if (!a) {
-                HOOK_MALLOC_FAILED;
-                _mdns_free_tx_packet(packet);
-                return NULL;
+            _mdns_cache_record_name(r, &name);
+            if (_mdns_search_find_from(search, &name, type, r->tcpip_if, r->ip_protocol) != search) {
+                continue;
             }
-            a->type = MDNS_TYPE_PTR;
-            a->service = NULL;
-            a->custom_instance = r->instance_name;
-            a->custom_service = search->service;
-            a->custom_proto = search->proto;
-            a->bye = false;
-            a->flush = false;
-            a->next = NULL;
-            queueToEnd(mdns_out_answer_t, packet->answers, a);
-            r = r->next;
+            uint32_t ttl = _mdns_cache_ttl_left(r, now);
+            mdns_result_t *result = NULL;
+            if (type == MDNS_TYPE_PTR) {
+                _mdns_search_result_add_ptr(search, r->target, r->service, r->proto, r->tcpip_if, r->ip_protocol, ttl);
+            } else if (type == MDNS_TYPE_SRV) {
+                if (search->type != MDNS_TYPE_PTR) {
+                    _mdns_search_result_add_srv(search, r->target, r->port, r->tcpip_if, r->ip_protocol, ttl);
+                } else if ((result = _mdns_search_result_get_instance(search, r->name, r->service, r->proto,
+                                                                      r->tcpip_if, r->ip_protocol, ttl)) && !result->hostname) {
+                    result->port = r->port;
+                    result->hostname = mdns_mem_strdup(r->target);
+                }
+            } else if (type == MDNS_TYPE_TXT) {
+                mdns_txt_item_t *txt = NULL;
+                uint8_t *txt_value_len = NULL;
+                size_t txt_count = 0;
+                if (search->type == MDNS_TYPE_PTR) {
+                    result = _mdns_search_result_get_instance(search, r->name, r->service, r->proto,
+                                                              r->tcpip_if, r->ip_protocol, ttl);
+                    if (!result || result->txt) {
+                        continue;
+                    }
+                }
+                _mdns_result_txt_create(r->txt, r->txt_len, &txt, &txt_value_len, &txt_count);
+                if (!txt_count) {
+                    continue;
+                }
+                if (result) {
+                    result->txt = txt;
+                    result->txt_count = txt_count;
+                    result->txt_value_len = txt_value_len;
+                } else {
+                    _mdns_search_result_add_txt(search, txt, txt_value_len, txt_count, r->tcpip_if, r->ip_protocol, ttl);
+                }
+            } else {
+                esp_ip_addr_t addr = r->addr;
+                _mdns_search_result_add_ip(search, r->name, &addr, r->tcpip_if, r->ip_protocol, ttl);
+            }
+        }
+    }
+    return search->result != NULL;
+}
+
+/**
+ * @brief  Add a PTR record of the searched service as known answer, unless the packet already lists it
+ *
+ * Questions packed into one packet share their known answers.
+ */
+static bool _mdns_search_add_known_answer(mdns_tx_packet_t *packet, mdns_search_once_t *search, const char *instance)
+{
+    mdns_out_answer_t *a = packet->answers;
+    while (a && (a->type != MDNS_TYPE_PTR || strcasecmp(a->custom_instance, instance)
+                 || strcasecmp(a->custom_service, search->service) || strcasecmp(a->custom_proto, search->proto))) {
+        a = a->next;
+    }
+    if (a) {
+        return true;
+    }
+    a = (mdns_out_answer_t *)mdns_mem_malloc(sizeof(mdns_out_answer_t));
+    if (!a) {
+        HOOK_MALLOC_FAILED;
+        return false;
+    }
+    a->type = MDNS_TYPE_PTR;
+    a->service = NULL;
+    a->host = NULL;
+    a->custom_instance = instance;
+    a->custom_service = search->service;
+    a->custom_proto = search->proto;
+    a->bye = false;
+    a->flush = false;
+    a->next = NULL;
+    queueToEnd(mdns_out_answer_t, packet->answers, a);
+    return true;
+}
+
+/**
+ * @brief  Add the known answers of a PTR search (RFC 6762 7.1)
+ *
+ * Complete results of the search on the interface of the packet are listed, then the cached PTR records of the
+ * service with more than half of their TTL left.
+ */
+static bool _mdns_search_add_known_answers(mdns_tx_packet_t *packet, mdns_search_once_t *search)
+{
+    for (mdns_result_t *r = search->result; r; r = r->next) {
+        //full record on the same interface is available
+        if (r->esp_netif != _mdns_get_esp_netif(packet->tcpip_if) || r->ip_protocol != packet->ip_protocol || r->instance_name == NULL || r->hostname == NULL || r->addr == NULL) {
+            continue;
+        }
+        if (!_mdns_search_add_known_answer(packet, search, r->instance_name)) {
+            return false;
         }
     }
+    uint32_t now = xTaskGetTickCount() * portTICK_PERIOD_MS;
+    for (mdns_cache_record_t *r = _mdns_server->cache.records; r; r = r->next) {
+        if (r->type != MDNS_TYPE_PTR || r->tcpip_if != packet->tcpip_if || r->ip_protocol != packet->ip_protocol
+                || strcasecmp(r->service, search->service) || strcasecmp(r->proto, search->proto)
+                || _mdns_cache_expired(r, now) || (r->expires_at - now) / 500 <= r->ttl) {
+            continue;
+        }
+        if (!_mdns_search_add_known_answer(packet, search, r->target)) {
+            return false;
+        }
+    }
+    return true;
+}
 
+/**
+ * @brief  Add the question of a search and its known answers to a query packet
+ *
+ * A question already in the packet is not repeated, it then asks for a unicast response only if all its
+ * searches do.
+ */
+static bool _mdns_search_pack(mdns_tx_packet_t *packet, mdns_search_once_t *search)
+{
+    mdns_out_question_t *q = packet->questions;
+    while (q && (q->type != search->type || !_str_null_or_equal(q->host, search->instance)
+                 || !_str_null_or_equal(q->service, search->service) || !_str_null_or_equal(q->proto, search->proto))) {
+        q = q->next;
+    }
+    if (q) {
+        q->unicast = q->unicast && search->unicast;
+    } else {
+        q = (mdns_out_question_t *)mdns_mem_malloc(sizeof(mdns_out_question_t));
+        if (!q) {
+            HOOK_MALLOC_FAILED;
+            return false;
+        }
+        q->next = NULL;
+        q->unicast = search->unicast;
+        q->type = search->type;
+        q->host = search->instance;
+        q->service = search->service;
+        q->proto = search->proto;
+        q->domain = MDNS_DEFAULT_DOMAIN;
+        q->own_dynamic_memory = false;
+        queueToEnd(mdns_out_question_t, packet->questions, q);
+    }
+    return search->type != MDNS_TYPE_PTR || _mdns_search_add_known_answers(packet, search);
+}
+
+/**
+ * @brief  Create search packet for particular interface
+ */
+static mdns_tx_packet_t *_mdns_create_search_packet(mdns_search_once_t *search, mdns_if_t tcpip_if, mdns_ip_protocol_t ip_protocol)
+{
+    mdns_tx_packet_t *packet = _mdns_alloc_packet_default(tcpip_if, ip_protocol);
+    if (!packet) {
+        return NULL;
+    }
+    if (!_mdns_search_pack(packet, search)) {
+        _mdns_free_tx_packet(packet);
+        return NULL;
+    }
     return packet;
 }
 
@@ -5071,31 +6815,150 @@ static void _mdns_search_send_pcb(mdns_search_once_t *search, mdns_if_t tcpip_if
 }
 
 /**
- * @brief  Send search packet to all available interfaces
+ * @brief  Length of a name without compression, the most it takes in a packet
+ */
+static uint16_t _mdns_name_len_max(const char *host, const char *service, const char *proto, const char *domain)
+{
+    return (host ? strlen(host) + 1 : 0) + (service ? strlen(service) + 1 : 0) + (proto ? strlen(proto) + 1 : 0)
+           + (domain ? strlen(domain) + 1 : 0) + 1;
+}
+
+/**
+ * @brief  Send a packet of packed queries
+ */
+static void _mdns_queries_flush(mdns_tx_packet_t **packet)
+{
+    _mdns_dispatch_tx_packet(*packet);
+    _mdns_free_tx_packet(*packet);
+    *packet = NULL;
+    _mdns_server->queries.packets++;
+}
+
+/**
+ * @brief  Serialize a packet of packed queries to see if all its questions and known answers fit in one packet
+ *
+ * @param  packet     the packet
+ * @param  questions  questions of the packet
+ * @param  len        receives the length of the serialized packet if they fit
+ */
+static bool _mdns_queries_fit(mdns_tx_packet_t *packet, uint16_t questions, uint16_t *len)
+{
+    uint16_t built = _mdns_build_tx_packet(&_mdns_tx_ctx, packet);
+    if (_mdns_tx_ctx.next_section < MDNS_TX_SECTIONS
+            || _mdns_read_u16(_mdns_tx_ctx.packet, MDNS_HEAD_QUESTIONS_OFFSET) != questions) {
+        return false;
+    }
+    *len = built;
+    return true;
+}
+
+/**
+ * @brief  Pack the question of a due search into the query packet being filled for a PCB
+ *
+ * The length of the packet is bounded by the length of its names without compression. Only once this bound is
+ * over a full packet, the packet is serialized to see if the question really fits. If it does not, the packet
+ * leaves without it and the question starts the next one. A question alone in its packet always stays, its known
+ * answers then continue in packets with the TC bit set.
+ *
+ * @param  packet   packet being filled, allocated by the first question
+ * @param  len      bound of the serialized length of the packet
+ * @param  search   the search
+ */
+static void _mdns_queries_pack(mdns_tx_packet_t **packet, uint16_t *len, mdns_search_once_t *search,
+                               mdns_if_t tcpip_if, mdns_ip_protocol_t ip_protocol)
+{
+    if (!*packet) {
+        *packet = _mdns_alloc_packet_default(tcpip_if, ip_protocol);
+        if (!*packet) {
+            return;
+        }
+        *len = MDNS_HEAD_LEN;
+    }
+    mdns_tx_packet_t *p = *packet;
+    mdns_out_question_t *last_q = p->questions;
+    mdns_out_answer_t *last_a = p->answers;
+    uint16_t questions = 0;
+    while (last_q && last_q->next) {
+        last_q = last_q->next;
+        questions++;
+    }
+    questions += last_q != NULL;
+    while (last_a && last_a->next) {
+        last_a = last_a->next;
+    }
+
+    bool packed = _mdns_search_pack(p, search);
+    mdns_out_question_t *q = last_q ? last_q->next : p->questions;
+    mdns_out_answer_t *a = last_a ? last_a->next : p->answers;
+    if (q) {
+        *len += _mdns_name_len_max(q->host, q->service, q->proto, q->domain) + 4;
+        questions++;
+    }
+    for (; a; a = a->next) {
+        // PTR record, with its owner name in the data again
+        *len += 2 * _mdns_name_len_max(NULL, a->custom_service, a->custom_proto, MDNS_DEFAULT_DOMAIN)
+                + strlen(a->custom_instance) + 1 + 10;
+    }
+    if (packed && (!last_q || *len <= MDNS_MAX_PACKET_SIZE || _mdns_queries_fit(p, questions, len))) {
+        return;
+    }
+
+    // take the question back
+    if (last_q) {
+        queueFree(mdns_out_question_t, last_q->next);
+    } else {
+        queueFree(mdns_out_question_t, p->questions);
+    }
+    if (last_a) {
+        queueFree(mdns_out_answer_t, last_a->next);
+    } else {
+        queueFree(mdns_out_answer_t, p->answers);
+    }
+    if (packed) {
+        _mdns_queries_flush(packet);
+        _mdns_queries_pack(packet, len, search, tcpip_if, ip_protocol);
+    }
+}
+
+/**
+ * @brief  Send the questions of the searches and browses due for a query, packed per PCB
+ *
+ * The questions share as few packets as they fit in, along with their known answers.
  */
-static void _mdns_search_send(mdns_search_once_t *search)
+static void _mdns_queries_send(void)
 {
-    mdns_search_once_t *queue = _mdns_server->search_once;
-    bool found = false;
-    // looking for this search in active searches
-    while (queue) {
-        if (queue == search) {
-            found = true;
-            break;
+    mdns_search_once_t browse_search = { .type = MDNS_TYPE_PTR };
+    _mdns_server->queries.send_pending = false;
+    for (uint8_t i = 0; i < MDNS_MAX_INTERFACES; i++) {
+        for (uint8_t j = 0; j < MDNS_IP_PROTOCOL_MAX; j++) {
+            if (!mdns_is_netif_ready(i, j) || _mdns_server->interfaces[i].pcbs[j].state <= PCB_INIT) {
+                continue;
+            }
+            mdns_tx_packet_t *packet = NULL;
+            uint16_t len = 0;
+            for (mdns_search_once_t *s = _mdns_server->search_once; s; s = s->next) {
+                if (s->send_pending && s->state != SEARCH_OFF) {
+                    _mdns_queries_pack(&packet, &len, s, (mdns_if_t)i, (mdns_ip_protocol_t)j);
+                }
+            }
+            for (mdns_browse_t *b = _mdns_server->browse; b; b = b->next) {
+                if (b->send_pending) {
+                    // Using search once for packing the PTR query
+                    browse_search.service = b->service;
+                    browse_search.proto = b->proto;
+                    _mdns_queries_pack(&packet, &len, &browse_search, (mdns_if_t)i, (mdns_ip_protocol_t)j);
+                }
+            }
+            if (packet) {
+                _mdns_queries_flush(&packet);
+            }
         }
-        queue = queue->next;
     }
-
-    if (!found) {
-        // no longer active -> skip sending this search
-        return;
+    for (mdns_search_once_t *s = _mdns_server->search_once; s; s = s->next) {
+        s->send_pending = false;
     }
-
-    uint8_t i, j;
-    for (i = 0; i < MDNS_MAX_INTERFACES; i++) {
-        for (j = 0; j < MDNS_IP_PROTOCOL_MAX; j++) {
-            _mdns_search_send_pcb(search, (mdns_if_t)i, (mdns_ip_protocol_t)j);
-        }
+    for (mdns_browse_t *b = _mdns_server->browse; b; b = b->next) {
+        b->send_pending = false;
     }
 }
 
@@ -5156,6 +7019,26 @@ static void _mdns_tx_handle_packet(mdns_tx_packet_t *p)
     }
 }
 
+/**
+ * @brief  transmits all scheduled packets that are due, packets rescheduled meanwhile wait for the next tick
+ */
+static void _mdns_tx_handle_due_packets(void)
+{
+    uint32_t now = xTaskGetTickCount() * portTICK_PERIOD_MS;
+    _mdns_udp_pcb_batch_begin();
+    while (_mdns_server->tx_queue.len) {
+        mdns_tx_packet_t *p = _mdns_server->tx_queue.heap[0];
+        if ((int32_t)(p->send_at - now) >= 0) {
+            break;
+        }
+        _mdns_unschedule_tx_packet(p);
+        _mdns_tx_handle_packet(p);
+    }
+    _mdns_udp_pcb_batch_flush();
+    _mdns_server->tx_queue.handle_pending = false;
+    _mdns_timer_arm();
+}
+
 static void _mdns_remap_self_service_hostname(const char *old_hostname, const char *new_hostname)
 {
     mdns_srv_item_t *service = _mdns_server->services;
@@ -5196,8 +7079,6 @@ static void _mdns_free_action(mdns_action_t *action)
         break;
     case ACTION_SEARCH_ADD:
     //fallthrough
-    case ACTION_SEARCH_SEND:
-    //fallthrough
     case ACTION_SEARCH_END:
         _mdns_search_free(action->data.search_add.search);
         break;
@@ -5209,12 +7090,22 @@ static void _mdns_free_action(mdns_action_t *action)
     case ACTION_BROWSE_SYNC:
         _mdns_sync_browse_result_link_free(action->data.browse_sync.browse_sync);
         break;
-    case ACTION_TX_HANDLE:
-        _mdns_free_tx_packet(action->data.tx_handle.packet);
+    case ACTION_BROWSE_EXPIRE:
+        // the browse stays in the browse chain
         break;
+    case ACTION_SEARCH_SEND:
+        // static action, searches and browses stay in their chains
+        return;
+    case ACTION_TX_HANDLE:
+        // static action, packets stay scheduled
+        return;
     case ACTION_RX_HANDLE:
         _mdns_packet_free(action->data.rx_handle.packet);
         break;
+    case ACTION_RX_HANDLE_POOLED:
+        // the action is part of the pooled packet, released with it
+        _mdns_packet_free(action->data.rx_handle.packet);
+        return;
     case ACTION_DELEGATE_HOSTNAME_SET_ADDR:
     case ACTION_DELEGATE_HOSTNAME_ADD:
         mdns_mem_free((char *)action->data.delegate_hostname.hostname);
@@ -5226,7 +7117,7 @@ static void _mdns_free_action(mdns_action_t *action)
     default:
         break;
     }
-    mdns_mem_free(action);
+    _mdns_action_free(action);
 }
 
 /**
@@ -5234,6 +7125,7 @@ static void _mdns_free_action(mdns_action_t *action)
  */
 static void _mdns_execute_action(mdns_action_t *action)
 {
+    MDNS_STATS_DEC(action_depth);
     switch (action->type) {
     case ACTION_SYSTEM_EVENT:
         perform_event_action(action->data.sys_event.interface, action->data.sys_event.event_action);
@@ -5244,6 +7136,7 @@ static void _mdns_execute_action(mdns_action_t *action)
         mdns_mem_free((char *)_mdns_server->hostname);
         _mdns_server->hostname = action->data.hostname_set.hostname;
         _mdns_self_host.hostname = action->data.hostname_set.hostname;
+        _mdns_service_index_rebuild();
         _mdns_restart_all_pcbs();
         xSemaphoreGive(_mdns_server->action_sema);
         break;
@@ -5251,6 +7144,7 @@ static void _mdns_execute_action(mdns_action_t *action)
         _mdns_send_bye_all_pcbs_no_instance(false);
         mdns_mem_free((char *)_mdns_server->instance);
         _mdns_server->instance = action->data.instance;
+        _mdns_service_index_rebuild();
         _mdns_restart_all_pcbs_no_instance();
 
         break;
@@ -5258,8 +7152,9 @@ static void _mdns_execute_action(mdns_action_t *action)
         _mdns_search_add(action->data.search_add.search);
         break;
     case ACTION_SEARCH_SEND:
-        _mdns_search_send(action->data.search_add.search);
-        break;
+        _mdns_queries_send();
+        // static action, see _mdns_queries_post()
+        return;
     case ACTION_SEARCH_END:
         _mdns_search_finish(action->data.search_add.search);
         break;
@@ -5274,23 +7169,25 @@ static void _mdns_execute_action(mdns_action_t *action)
     case ACTION_BROWSE_END:
         _mdns_browse_finish(action->data.browse_add.browse);
         break;
+    case ACTION_BROWSE_EXPIRE:
+        _mdns_browse_delta_expire(action->data.browse_add.browse);
+        break;
 
-    case ACTION_TX_HANDLE: {
-        mdns_tx_packet_t *p = _mdns_server->tx_queue_head;
-        // packet to be handled should be at tx head, but must be consistent with the one pushed to action queue
-        if (p && p == action->data.tx_handle.packet && p->queued) {
-            p->queued = false; // clearing, as the packet might be reused (pushed and transmitted again)
-            _mdns_server->tx_queue_head = p->next;
-            _mdns_tx_handle_packet(p);
-        } else {
-            ESP_LOGD(TAG, "Skipping transmit of an unexpected packet!");
-        }
-    }
-    break;
+    case ACTION_TX_HANDLE:
+        _mdns_tx_handle_due_packets();
+        // static action, see _mdns_scheduler_run()
+        return;
     case ACTION_RX_HANDLE:
         mdns_parse_packet(action->data.rx_handle.packet);
         _mdns_packet_free(action->data.rx_handle.packet);
         break;
+    case ACTION_RX_HANDLE_POOLED: {
+        // the action is part of the pooled packet, it must not be touched once the packet is released
+        mdns_rx_packet_t *packet = action->data.rx_handle.packet;
+        mdns_parse_packet(packet);
+        _mdns_packet_free(packet);
+    }
+    return;
     case ACTION_DELEGATE_HOSTNAME_ADD:
         if (!_mdns_delegate_hostname_add(action->data.delegate_hostname.hostname,
                                          action->data.delegate_hostname.address_list)) {
@@ -5313,7 +7210,7 @@ static void _mdns_execute_action(mdns_action_t *action)
     default:
         break;
     }
-    mdns_mem_free(action);
+    _mdns_action_free(action);
 }
 
 /**
@@ -5323,16 +7220,15 @@ static esp_err_t _mdns_send_search_action(mdns_action_type_t type, mdns_search_o
 {
     mdns_action_t *action = NULL;
 
-    action = (mdns_action_t *)mdns_mem_malloc(sizeof(mdns_action_t));
+    action = _mdns_action_alloc();
     if (!action) {
-        HOOK_MALLOC_FAILED;
         return ESP_ERR_NO_MEM;
     }
 
     action->type = type;
     action->data.search_add.search = search;
-    if (xQueueSend(_mdns_server->action_queue, &action, (TickType_t)0) != pdPASS) {
-        mdns_mem_free(action);
+    if (!_mdns_action_post(action)) {
+        _mdns_action_free(action);
         return ESP_ERR_NO_MEM;
     }
     return ESP_OK;
@@ -5341,44 +7237,39 @@ static esp_err_t _mdns_send_search_action(mdns_action_type_t type, mdns_search_o
 /**
  * @brief  Called from timer task to run mDNS responder
  *
- * periodically checks first unqueued packet (from tx head).
- * if it is scheduled to be transmitted, then pushes the packet to action queue to be handled.
+ * periodically checks the earliest scheduled packet (heap top).
+ * if it is due, then pushes the static TX action to the action queue, which transmits all due packets.
+ * only one TX action is in flight at a time, so nothing is allocated per transmission.
  *
  */
 static void _mdns_scheduler_run(void)
 {
     MDNS_SERVICE_LOCK();
-    mdns_tx_packet_t *p = _mdns_server->tx_queue_head;
-    mdns_action_t *action = NULL;
-
-    // find first unqueued packet
-    while (p && p->queued) {
-        p = p->next;
-    }
-    if (!p) {
-        MDNS_SERVICE_UNLOCK();
-        return;
-    }
-    while (p && (int32_t)(p->send_at - (xTaskGetTickCount() * portTICK_PERIOD_MS)) < 0) {
-        action = (mdns_action_t *)mdns_mem_malloc(sizeof(mdns_action_t));
-        if (action) {
-            action->type = ACTION_TX_HANDLE;
-            action->data.tx_handle.packet = p;
-            p->queued = true;
-            if (xQueueSend(_mdns_server->action_queue, &action, (TickType_t)0) != pdPASS) {
-                mdns_mem_free(action);
-                p->queued = false;
-            }
-        } else {
-            HOOK_MALLOC_FAILED;
-            break;
+    if (!_mdns_server->tx_queue.handle_pending && _mdns_server->tx_queue.len
+            && (int32_t)(_mdns_server->tx_queue.heap[0]->send_at - (xTaskGetTickCount() * portTICK_PERIOD_MS)) < 0) {
+        mdns_action_t *action = &_mdns_tx_action;
+        if (_mdns_action_post(action)) {
+            _mdns_server->tx_queue.handle_pending = true;
         }
-        //Find the next unqued packet
-        p = p->next;
     }
     MDNS_SERVICE_UNLOCK();
 }
 
+/**
+ * @brief  Called from timer task to have the questions marked as due sent, in one action for all of them
+ */
+static bool _mdns_queries_post(void)
+{
+    if (!_mdns_server->queries.send_pending) {
+        mdns_action_t *action = &_mdns_query_action;
+        if (!_mdns_action_post(action)) {
+            return false;
+        }
+        _mdns_server->queries.send_pending = true;
+    }
+    return true;
+}
+
 /**
  * @brief  Called from timer task to run active searches
  */
@@ -5398,12 +7289,12 @@ static void _mdns_search_run(void)
                 if (_mdns_send_search_action(ACTION_SEARCH_END, s) != ESP_OK) {
                     s->state = SEARCH_RUNNING;
                 }
-            } else if (s->state == SEARCH_INIT || (now - s->sent_at) > 1000) {
+            } else if ((s->state == SEARCH_INIT
+                        || _mdns_query_due(&s->query, s->type, s->instance, s->service, s->proto, now))
+                       && _mdns_queries_post()) {
                 s->state = SEARCH_RUNNING;
-                s->sent_at = now;
-                if (_mdns_send_search_action(ACTION_SEARCH_SEND, s) != ESP_OK) {
-                    s->sent_at -= 1000;
-                }
+                s->send_pending = true;
+                _mdns_query_sent(&s->query, s->type, s->instance, s->service, s->proto, now);
             }
         }
         s = s->next;
@@ -5411,6 +7302,31 @@ static void _mdns_search_run(void)
     MDNS_SERVICE_UNLOCK();
 }
 
+/**
+ * @brief  Called from timer task to query again the running browses
+ */
+static void _mdns_browse_run(void)
+{
+    MDNS_SERVICE_LOCK();
+    uint32_t now = xTaskGetTickCount() * portTICK_PERIOD_MS;
+    for (mdns_browse_t *b = _mdns_server->browse; b; b = b->next) {
+        if (b->state != BROWSE_RUNNING) {
+            continue;
+        }
+        if (_mdns_query_due(&b->query, MDNS_TYPE_PTR, NULL, b->service, b->proto, now)
+                && _mdns_queries_post()) {
+            b->send_pending = true;
+            _mdns_query_sent(&b->query, MDNS_TYPE_PTR, NULL, b->service, b->proto, now);
+        }
+        mdns_browse_records_t *records = b->records;
+        if (records && records->len && !records->expire_pending && (int32_t)(now - records->next_expiry) > 0
+                && _mdns_send_browse_action(ACTION_BROWSE_EXPIRE, b) == ESP_OK) {
+            records->expire_pending = true;
+        }
+    }
+    MDNS_SERVICE_UNLOCK();
+}
+
 /**
  * @brief  the main MDNS service task. Packets are received and parsed here
  */
@@ -5436,10 +7352,96 @@ static void _mdns_service_task(void *pvParameters)
     vTaskDelay(portMAX_DELAY);
 }
 
+/**
+ * @brief  Earliest time (ms) at which the timer callback has work to do
+ *
+ * The callback acts once the current time is past the deadline: next packet in the TX queue (unless the TX action
+ * is already pending), next query or timeout of every active search, next query of every running browse and next
+ * expiry of the records of delta browses.
+ */
+static bool _mdns_timer_next_deadline(uint32_t now, uint32_t *deadline)
+{
+    bool found = false;
+    if (_mdns_server->tx_queue.len && !_mdns_server->tx_queue.handle_pending) {
+        *deadline = _mdns_server->tx_queue.heap[0]->send_at;
+        found = true;
+    }
+    for (mdns_search_once_t *s = _mdns_server->search_once; s; s = s->next) {
+        uint32_t t;
+        if (s->state == SEARCH_OFF) {
+            continue;
+        } else if (s->state == SEARCH_INIT) {
+            t = now;
+        } else {
+            t = s->started_at + s->timeout;
+            uint32_t query = _mdns_query_deadline(&s->query);
+            if ((int32_t)(query - t) < 0) {
+                t = query;
+            }
+        }
+        if (!found || (int32_t)(t - *deadline) < 0) {
+            *deadline = t;
+            found = true;
+        }
+    }
+    for (mdns_browse_t *b = _mdns_server->browse; b; b = b->next) {
+        if (b->state != BROWSE_RUNNING) {
+            continue;
+        }
+        uint32_t t = _mdns_query_deadline(&b->query);
+        mdns_browse_records_t *records = b->records;
+        if (records && records->len && !records->expire_pending && (int32_t)(records->next_expiry - t) < 0) {
+            t = records->next_expiry;
+        }
+        if (!found || (int32_t)(t - *deadline) < 0) {
+            *deadline = t;
+            found = true;
+        }
+    }
+    return found;
+}
+
+/**
+ * @brief  Arms the one-shot timer for the next deadline, called with the service lock held
+ *
+ * An already armed timer is kept if it fires early enough: the callback re-arms it anyway.
+ * Deadlines already missed (action queue was full) are retried after MDNS_TIMER_RETRY_MS.
+ */
+static void _mdns_timer_arm(void)
+{
+    uint32_t now = xTaskGetTickCount() * portTICK_PERIOD_MS;
+    uint32_t deadline;
+
+    if (!_mdns_server->timer_handle) {
+        return;
+    }
+    if (!_mdns_timer_next_deadline(now, &deadline)) {
+        if (_mdns_server->timer_armed) {
+            esp_timer_stop(_mdns_server->timer_handle);
+            _mdns_server->timer_armed = false;
+        }
+        return;
+    }
+    int32_t wait = (int32_t)(deadline - now);
+    // the tick count must move past the deadline, so wake up one tick after it
+    uint32_t delay_ms = wait < 0 ? MDNS_TIMER_RETRY_MS : (uint32_t)wait + portTICK_PERIOD_MS;
+    if (_mdns_server->timer_armed && (int32_t)(_mdns_server->timer_fires_at - (now + delay_ms)) <= 0) {
+        return;
+    }
+    esp_timer_stop(_mdns_server->timer_handle);
+    _mdns_server->timer_armed = esp_timer_start_once(_mdns_server->timer_handle, delay_ms * 1000ULL) == ESP_OK;
+    _mdns_server->timer_fires_at = now + delay_ms;
+}
+
 static void _mdns_timer_cb(void *arg)
 {
     _mdns_scheduler_run();
     _mdns_search_run();
+    _mdns_browse_run();
+    MDNS_SERVICE_LOCK();
+    _mdns_server->timer_armed = false;
+    _mdns_timer_arm();
+    MDNS_SERVICE_UNLOCK();
 }
 
 static esp_err_t _mdns_start_timer(void)
@@ -5450,22 +7452,29 @@ static esp_err_t _mdns_start_timer(void)
         .dispatch_method = ESP_TIMER_TASK,
         .name = "mdns_timer"
     };
-    esp_err_t err = esp_timer_create(&timer_conf, &(_mdns_server->timer_handle));
-    if (err) {
-        return err;
-    }
-    return esp_timer_start_periodic(_mdns_server->timer_handle, MDNS_TIMER_PERIOD_US);
+    // one-shot, armed by _mdns_timer_arm() when there is something to send
+    return esp_timer_create(&timer_conf, &(_mdns_server->timer_handle));
 }
 
+/**
+ * @brief  Stops and deletes the timer, called with the service lock held
+ *
+ * The handle is cleared once deleted: actions still queued and a callback already waiting for the lock
+ * call _mdns_timer_arm(), which leaves a NULL handle alone.
+ */
 static esp_err_t _mdns_stop_timer(void)
 {
     esp_err_t err = ESP_OK;
     if (_mdns_server->timer_handle) {
         err = esp_timer_stop(_mdns_server->timer_handle);
-        if (err) {
+        if (err && err != ESP_ERR_INVALID_STATE) {  // not running
             return err;
         }
         err = esp_timer_delete(_mdns_server->timer_handle);
+        if (err == ESP_OK) {
+            _mdns_server->timer_handle = NULL;
+        }
+        _mdns_server->timer_armed = false;
     }
     return err;
 }
@@ -5536,7 +7545,9 @@ err:
  */
 static esp_err_t _mdns_service_task_stop(void)
 {
+    MDNS_SERVICE_LOCK();
     _mdns_stop_timer();
+    MDNS_SERVICE_UNLOCK();
     if (_mdns_service_task_handle) {
         TaskHandle_t task_handle = _mdns_service_task_handle;
         mdns_action_t action;
@@ -5561,17 +7572,16 @@ static esp_err_t mdns_post_custom_action_tcpip_if(mdns_if_t mdns_if, mdns_event_
         return ESP_ERR_INVALID_STATE;
     }
 
-    mdns_action_t *action = (mdns_action_t *)mdns_mem_calloc(1, sizeof(mdns_action_t));
+    mdns_action_t *action = _mdns_action_alloc();
     if (!action) {
-        HOOK_MALLOC_FAILED;
         return ESP_ERR_NO_MEM;
     }
     action->type = ACTION_SYSTEM_EVENT;
     action->data.sys_event.event_action = event_action;
     action->data.sys_event.interface = mdns_if;
 
-    if (xQueueSend(_mdns_server->action_queue, &action, (TickType_t)0) != pdPASS) {
-        mdns_mem_free(action);
+    if (!_mdns_action_post(action)) {
+        _mdns_action_free(action);
     }
     return ESP_OK;
 }
@@ -5676,6 +7686,7 @@ esp_err_t mdns_init(void)
         return ESP_ERR_NO_MEM;
     }
     memset((uint8_t *)_mdns_server, 0, sizeof(mdns_server_t));
+    _mdns_action_pool_init();
     // zero-out local copy of netifs to initiate a fresh search by interface key whenever a netif ptr is needed
     for (mdns_if_t i = 0; i < MDNS_MAX_INTERFACES; ++i) {
         s_esp_netifs[i].netif = NULL;
@@ -5738,6 +7749,11 @@ esp_err_t mdns_init(void)
         err = ESP_FAIL;
         goto free_all_and_disable_pcbs;
     }
+#if CONFIG_MDNS_STATS_DIAG_METRICS
+    if (_mdns_stats_diag_init() != ESP_OK) {
+        ESP_LOGW(TAG, "mDNS metrics not reported");
+    }
+#endif
 
     return ESP_OK;
 
@@ -5769,6 +7785,9 @@ void mdns_free(void)
 
     // Unregister handlers before destroying the mdns internals to avoid receiving async events while deinit
     unregister_predefined_handlers();
+#if CONFIG_MDNS_STATS_DIAG_METRICS
+    _mdns_stats_diag_deinit();
+#endif
 
     mdns_service_remove_all();
     free_delegated_hostnames();
@@ -5789,7 +7808,8 @@ void mdns_free(void)
         }
         vQueueDelete(_mdns_server->action_queue);
     }
-    _mdns_clear_tx_queue_head();
+    _mdns_clear_tx_queue();
+    mdns_mem_free(_mdns_server->tx_queue.heap);
     while (_mdns_server->search_once) {
         mdns_search_once_t *h = _mdns_server->search_once;
         _mdns_server->search_once = h->next;
@@ -5808,6 +7828,7 @@ void mdns_free(void)
         _mdns_browse_item_free(b);
 
     }
+    _mdns_cache_clear();
     vSemaphoreDelete(_mdns_server->action_sema);
     mdns_mem_free(_mdns_server);
     _mdns_server = NULL;
@@ -5826,17 +7847,16 @@ esp_err_t mdns_hostname_set(const char *hostname)
         return ESP_ERR_NO_MEM;
     }
 
-    mdns_action_t *action = (mdns_action_t *)mdns_mem_malloc(sizeof(mdns_action_t));
+    mdns_action_t *action = _mdns_action_alloc();
     if (!action) {
-        HOOK_MALLOC_FAILED;
         mdns_mem_free(new_hostname);
         return ESP_ERR_NO_MEM;
     }
     action->type = ACTION_HOSTNAME_SET;
     action->data.hostname_set.hostname = new_hostname;
-    if (xQueueSend(_mdns_server->action_queue, &action, (TickType_t)0) != pdPASS) {
+    if (!_mdns_action_post(action)) {
         mdns_mem_free(new_hostname);
-        mdns_mem_free(action);
+        _mdns_action_free(action);
         return ESP_ERR_NO_MEM;
     }
     xSemaphoreTake(_mdns_server->action_sema, portMAX_DELAY);
@@ -5874,18 +7894,17 @@ esp_err_t mdns_delegate_hostname_add(const char *hostname, const mdns_ip_addr_t
         return ESP_ERR_NO_MEM;
     }
 
-    mdns_action_t *action = (mdns_action_t *)mdns_mem_malloc(sizeof(mdns_action_t));
+    mdns_action_t *action = _mdns_action_alloc();
     if (!action) {
-        HOOK_MALLOC_FAILED;
         mdns_mem_free(new_hostname);
         return ESP_ERR_NO_MEM;
     }
     action->type = ACTION_DELEGATE_HOSTNAME_ADD;
     action->data.delegate_hostname.hostname = new_hostname;
     action->data.delegate_hostname.address_list = copy_address_list(address_list);
-    if (xQueueSend(_mdns_server->action_queue, &action, (TickType_t)0) != pdPASS) {
+    if (!_mdns_action_post(action)) {
         mdns_mem_free(new_hostname);
-        mdns_mem_free(action);
+        _mdns_action_free(action);
         return ESP_ERR_NO_MEM;
     }
     xSemaphoreTake(_mdns_server->action_sema, portMAX_DELAY);
@@ -5905,17 +7924,16 @@ esp_err_t mdns_delegate_hostname_remove(const char *hostname)
         return ESP_ERR_NO_MEM;
     }
 
-    mdns_action_t *action = (mdns_action_t *)mdns_mem_malloc(sizeof(mdns_action_t));
+    mdns_action_t *action = _mdns_action_alloc();
     if (!action) {
-        HOOK_MALLOC_FAILED;
         mdns_mem_free(new_hostname);
         return ESP_ERR_NO_MEM;
     }
     action->type = ACTION_DELEGATE_HOSTNAME_REMOVE;
     action->data.delegate_hostname.hostname = new_hostname;
-    if (xQueueSend(_mdns_server->action_queue, &action, (TickType_t)0) != pdPASS) {
+    if (!_mdns_action_post(action)) {
         mdns_mem_free(new_hostname);
-        mdns_mem_free(action);
+        _mdns_action_free(action);
         return ESP_ERR_NO_MEM;
     }
     return ESP_OK;
@@ -5934,18 +7952,17 @@ esp_err_t mdns_delegate_hostname_set_address(const char *hostname, const mdns_ip
         return ESP_ERR_NO_MEM;
     }
 
-    mdns_action_t *action = (mdns_action_t *)mdns_mem_malloc(sizeof(mdns_action_t));
+    mdns_action_t *action = _mdns_action_alloc();
     if (!action) {
-        HOOK_MALLOC_FAILED;
         mdns_mem_free(new_hostname);
         return ESP_ERR_NO_MEM;
     }
     action->type = ACTION_DELEGATE_HOSTNAME_SET_ADDR;
     action->data.delegate_hostname.hostname = new_hostname;
     action->data.delegate_hostname.address_list = copy_address_list(address_list);
-    if (xQueueSend(_mdns_server->action_queue, &action, (TickType_t)0) != pdPASS) {
+    if (!_mdns_action_post(action)) {
         mdns_mem_free(new_hostname);
-        mdns_mem_free(action);
+        _mdns_action_free(action);
         return ESP_ERR_NO_MEM;
     }
     return ESP_OK;
@@ -5973,17 +7990,16 @@ esp_err_t mdns_instance_name_set(const char *instance)
         return ESP_ERR_NO_MEM;
     }
 
-    mdns_action_t *action = (mdns_action_t *)mdns_mem_malloc(sizeof(mdns_action_t));
+    mdns_action_t *action = _mdns_action_alloc();
     if (!action) {
-        HOOK_MALLOC_FAILED;
         mdns_mem_free(new_instance);
         return ESP_ERR_NO_MEM;
     }
     action->type = ACTION_INSTANCE_SET;
     action->data.instance = new_instance;
-    if (xQueueSend(_mdns_server->action_queue, &action, (TickType_t)0) != pdPASS) {
+    if (!_mdns_action_post(action)) {
         mdns_mem_free(new_instance);
-        mdns_mem_free(action);
+        _mdns_action_free(action);
         return ESP_ERR_NO_MEM;
     }
     return ESP_OK;
@@ -6020,30 +8036,209 @@ esp_err_t mdns_service_add_for_host(const char *instance, const char *service, c
     item->service = s;
     item->next = NULL;
 
-    item->next = _mdns_server->services;
-    _mdns_server->services = item;
-    _mdns_probe_all_pcbs(&item, 1, false, false);
+    item->next = _mdns_server->services;
+    _mdns_server->services = item;
+    _mdns_service_index_add(item);
+    _mdns_probe_all_pcbs(&item, 1, false, false);
+    MDNS_SERVICE_UNLOCK();
+    return ESP_OK;
+
+err:
+    MDNS_SERVICE_UNLOCK();
+    _mdns_free_service(s);
+    if (ret == ESP_ERR_NO_MEM) {
+        HOOK_MALLOC_FAILED;
+    }
+    return ret;
+}
+
+esp_err_t mdns_service_add(const char *instance, const char *service, const char *proto, uint16_t port,
+                           mdns_txt_item_t txt[], size_t num_items)
+{
+    if (!_mdns_server) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    return mdns_service_add_for_host(instance, service, proto, NULL, port, txt, num_items);
+}
+
+/**
+ * @brief  hostname of a service of the batch, services of our host get the hostname at commit
+ */
+static const char *_mdns_batch_service_hostname(const mdns_service_t *service)
+{
+    return service->hostname ? service->hostname : _mdns_server->hostname;
+}
+
+/**
+ * @brief  finds a service in a list of batch services, with the matching rules of _mdns_get_service_item_instance()
+ */
+static mdns_srv_item_t *_mdns_batch_get_service_item(mdns_srv_item_t *services, const char *instance, const char *service,
+                                                     const char *proto, const char *hostname)
+{
+    for (mdns_srv_item_t *s = services; s; s = s->next) {
+        mdns_service_t *srv = s->service;
+        if (strcasecmp(srv->service, service) || strcasecmp(srv->proto, proto) ||
+                (!_str_null_or_empty(hostname) && strcasecmp(_mdns_batch_service_hostname(srv), hostname))) {
+            continue;
+        }
+        if (!instance || _mdns_instance_name_match(srv->instance, instance)) {
+            return s;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief  checks that the services of the batch fit in the registry next to the registered ones
+ */
+static bool _mdns_batch_fits(size_t len)
+{
+    size_t service_num = len;
+    for (mdns_srv_item_t *s = _mdns_server->services; s && service_num <= MDNS_MAX_SERVICES; s = s->next) {
+        service_num++;
+    }
+    return service_num <= MDNS_MAX_SERVICES;
+}
+
+/**
+ * @brief  registers the services of the batch and probes them all at once
+ *
+ * @param  services  array of batch->len entries for the probe, filled here
+ */
+static void _mdns_batch_register(mdns_service_batch_t *batch, mdns_srv_item_t **services)
+{
+    mdns_srv_item_t *last = NULL;
+    size_t len = 0;
+    for (mdns_srv_item_t *item = batch->services; item; item = item->next) {
+        services[len++] = item;
+        last = item;
+    }
+    // same order as if they were added one by one
+    last->next = _mdns_server->services;
+    _mdns_server->services = batch->services;
+    for (size_t i = len; i > 0; i--) {
+        _mdns_service_index_add(services[i - 1]);
+    }
+    _mdns_probe_all_pcbs(services, len, false, false);
+}
+
+mdns_service_batch_t *mdns_service_batch_begin(void)
+{
+    if (!_mdns_server) {
+        return NULL;
+    }
+    mdns_service_batch_t *batch = (mdns_service_batch_t *)mdns_mem_calloc(1, sizeof(mdns_service_batch_t));
+    if (!batch) {
+        HOOK_MALLOC_FAILED;
+    }
+    return batch;
+}
+
+esp_err_t mdns_service_batch_add(mdns_service_batch_t *batch, const char *instance, const char *service, const char *proto,
+                                 const char *host, uint16_t port, mdns_txt_item_t txt[], size_t num_items)
+{
+    if (!_mdns_server || !batch || _str_null_or_empty(service) || _str_null_or_empty(proto) || !_mdns_server->hostname) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    MDNS_SERVICE_LOCK();
+    esp_err_t ret = ESP_OK;
+    const char *hostname = host ? host : _mdns_server->hostname;
+    mdns_service_t *s = NULL;
+
+    ESP_GOTO_ON_FALSE(_mdns_batch_fits(batch->len + 1), ESP_ERR_NO_MEM, err, TAG,
+                      "Cannot add more services, please increase CONFIG_MDNS_MAX_SERVICES (%d)", CONFIG_MDNS_MAX_SERVICES);
+    ESP_GOTO_ON_FALSE(!_mdns_get_service_item_instance(instance, service, proto, hostname), ESP_ERR_INVALID_ARG, err, TAG,
+                      "Service already exists");
+    ESP_GOTO_ON_FALSE(!_mdns_batch_get_service_item(batch->services, instance, service, proto, hostname), ESP_ERR_INVALID_ARG,
+                      err, TAG, "Service already in the batch");
+
+    // services of our host take the hostname it has at commit, as registered ones follow it
+    s = _mdns_create_service(service, proto, host && strcasecmp(host, _mdns_server->hostname) ? host : NULL, port, instance,
+                             num_items, txt);
+    ESP_GOTO_ON_FALSE(s, ESP_ERR_NO_MEM, err, TAG, "Cannot create service: Out of memory");
+
+    mdns_srv_item_t *item = (mdns_srv_item_t *)mdns_mem_calloc(1, sizeof(mdns_srv_item_t));
+    ESP_GOTO_ON_FALSE(item, ESP_ERR_NO_MEM, err, TAG, "Cannot create service: Out of memory");
+
+    item->service = s;
+    item->next = batch->services;
+    batch->services = item;
+    batch->len++;
+    MDNS_SERVICE_UNLOCK();
+    return ESP_OK;
+
+err:
+    MDNS_SERVICE_UNLOCK();
+    _mdns_free_service(s);
+    if (ret == ESP_ERR_NO_MEM) {
+        HOOK_MALLOC_FAILED;
+    }
+    return ret;
+}
+
+void mdns_service_batch_abort(mdns_service_batch_t *batch)
+{
+    if (!batch) {
+        return;
+    }
+    while (batch->services) {
+        mdns_srv_item_t *item = batch->services;
+        batch->services = item->next;
+        _mdns_free_service(item->service);
+        mdns_mem_free(item);
+    }
+    mdns_mem_free(batch);
+}
+
+esp_err_t mdns_service_batch_commit(mdns_service_batch_t *batch)
+{
+    if (!batch) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!batch->len) {
+        mdns_service_batch_abort(batch);
+        return ESP_OK;
+    }
+
+    MDNS_SERVICE_LOCK();
+    esp_err_t ret = ESP_OK;
+    mdns_srv_item_t **services = NULL;
+    ESP_GOTO_ON_FALSE(_mdns_server && _mdns_server->hostname, ESP_ERR_INVALID_STATE, err, TAG, "Invalid state");
+    ESP_GOTO_ON_FALSE(_mdns_batch_fits(batch->len), ESP_ERR_NO_MEM, err, TAG,
+                      "Cannot add more services, please increase CONFIG_MDNS_MAX_SERVICES (%d)", CONFIG_MDNS_MAX_SERVICES);
+
+    // services registered since they were added to the batch, or that the hostname changed into duplicates
+    for (mdns_srv_item_t *item = batch->services; item; item = item->next) {
+        mdns_service_t *s = item->service;
+        const char *hostname = _mdns_batch_service_hostname(s);
+        ESP_GOTO_ON_FALSE(!_mdns_get_service_item_instance(s->instance, s->service, s->proto, hostname), ESP_ERR_INVALID_ARG,
+                          err, TAG, "Service already exists");
+        ESP_GOTO_ON_FALSE(!_mdns_batch_get_service_item(item->next, s->instance, s->service, s->proto, hostname),
+                          ESP_ERR_INVALID_ARG, err, TAG, "Service twice in the batch");
+    }
+    // allocated before any service is registered, the batch is then committed whole
+    services = (mdns_srv_item_t **)mdns_mem_malloc(batch->len * sizeof(mdns_srv_item_t *));
+    ESP_GOTO_ON_FALSE(services, ESP_ERR_NO_MEM, err, TAG, "Out of memory");
+    for (mdns_srv_item_t *item = batch->services; item; item = item->next) {
+        if (!item->service->hostname) {
+            item->service->hostname = mdns_mem_strndup(_mdns_server->hostname, MDNS_NAME_BUF_LEN - 1);
+            ESP_GOTO_ON_FALSE(item->service->hostname, ESP_ERR_NO_MEM, err, TAG, "Out of memory");
+        }
+    }
+    _mdns_batch_register(batch, services);
     MDNS_SERVICE_UNLOCK();
+    mdns_mem_free(services);
+    mdns_mem_free(batch);
     return ESP_OK;
 
 err:
     MDNS_SERVICE_UNLOCK();
-    _mdns_free_service(s);
-    if (ret == ESP_ERR_NO_MEM) {
-        HOOK_MALLOC_FAILED;
-    }
+    mdns_mem_free(services);
+    mdns_service_batch_abort(batch);
     return ret;
 }
 
-esp_err_t mdns_service_add(const char *instance, const char *service, const char *proto, uint16_t port,
-                           mdns_txt_item_t txt[], size_t num_items)
-{
-    if (!_mdns_server) {
-        return ESP_ERR_INVALID_STATE;
-    }
-    return mdns_service_add_for_host(instance, service, proto, NULL, port, txt, num_items);
-}
-
 bool mdns_service_exists(const char *service_type, const char *proto, const char *hostname)
 {
     bool ret = false;
@@ -6063,11 +8258,11 @@ bool mdns_service_exists_with_instance(const char *instance, const char *service
     return ret;
 }
 
-static mdns_txt_item_t *_copy_mdns_txt_items(mdns_txt_linked_item_t *items, uint8_t **txt_value_len, size_t *txt_count)
+static mdns_txt_item_t *_copy_mdns_txt_items(const uint8_t *txt, uint16_t txt_len, uint8_t **txt_value_len, size_t *txt_count)
 {
     mdns_txt_item_t *ret = NULL;
     size_t ret_index = 0;
-    for (mdns_txt_linked_item_t *tmp = items; tmp != NULL; tmp = tmp->next) {
+    for (uint16_t i = 0; i < txt_len; i += txt[i] + 1) {
         ret_index++;
     }
     *txt_count = ret_index;
@@ -6082,25 +8277,28 @@ static mdns_txt_item_t *_copy_mdns_txt_items(mdns_txt_linked_item_t *items, uint
         goto handle_error;
     }
     ret_index = 0;
-    for (mdns_txt_linked_item_t *tmp = items; tmp != NULL; tmp = tmp->next) {
-        size_t key_len = strlen(tmp->key);
+    for (uint16_t i = 0; i < txt_len; i += txt[i] + 1) {
+        const char *item = (const char *)txt + i + 1;
+        const char *equal = memchr(item, '=', txt[i]);
+        size_t key_len = equal ? equal - item : txt[i];
+        size_t value_len = equal ? txt[i] - key_len - 1 : 0;
         char *key = (char *)mdns_mem_malloc(key_len + 1);
         if (!key) {
             HOOK_MALLOC_FAILED;
             goto handle_error;
         }
-        memcpy(key, tmp->key, key_len);
+        memcpy(key, item, key_len);
         key[key_len] = 0;
         ret[ret_index].key = key;
-        char *value = (char *)mdns_mem_malloc(tmp->value_len + 1);
+        char *value = (char *)mdns_mem_malloc(value_len + 1);
         if (!value) {
             HOOK_MALLOC_FAILED;
             goto handle_error;
         }
-        memcpy(value, tmp->value, tmp->value_len);
-        value[tmp->value_len] = 0;
+        memcpy(value, item + key_len + 1, value_len);
+        value[value_len] = 0;
         ret[ret_index].value = value;
-        (*txt_value_len)[ret_index] = tmp->value_len;
+        (*txt_value_len)[ret_index] = value_len;
         ret_index++;
     }
     return ret;
@@ -6118,12 +8316,9 @@ handle_error:
 
 static mdns_ip_addr_t *_copy_delegated_host_address_list(char *hostname)
 {
-    mdns_host_item_t *host = _mdns_host_list;
-    while (host) {
-        if (strcasecmp(host->hostname, hostname) == 0) {
-            return copy_address_list(host->address_list);
-        }
-        host = host->next;
+    mdns_host_item_t *host = _mdns_get_delegated_host(hostname);
+    if (host) {
+        return copy_address_list(host->address_list);
     }
     return NULL;
 }
@@ -6182,7 +8377,7 @@ static mdns_result_t *_mdns_lookup_service(const char *instance, const char *ser
                     goto handle_error;
                 }
                 item->port = srv->port;
-                item->txt = _copy_mdns_txt_items(srv->txt, &(item->txt_value_len), &(item->txt_count));
+                item->txt = _copy_mdns_txt_items(srv->txt, srv->txt_len, &(item->txt_value_len), &(item->txt_count));
                 // We should not append addresses for selfhost lookup result as we don't know which interface's address to append.
                 if (selfhost) {
                     item->addr = NULL;
@@ -6245,18 +8440,7 @@ esp_err_t mdns_service_txt_set_for_host(const char *instance, const char *servic
     mdns_srv_item_t *s = _mdns_get_service_item_instance(instance, service, proto, hostname);
     ESP_GOTO_ON_FALSE(s, ESP_ERR_NOT_FOUND, err, TAG, "Service doesn't exist");
 
-    mdns_txt_linked_item_t *new_txt = NULL;
-    if (num_items) {
-        new_txt = _mdns_allocate_txt(num_items, txt_items);
-        if (!new_txt) {
-            return ESP_ERR_NO_MEM;
-        }
-    }
-    mdns_service_t *srv = s->service;
-    mdns_txt_linked_item_t *txt = srv->txt;
-    srv->txt = NULL;
-    _mdns_free_linked_txt(txt);
-    srv->txt = new_txt;
+    ESP_GOTO_ON_FALSE(_mdns_txt_set_items(s->service, num_items, txt_items), ESP_ERR_NO_MEM, err, TAG, "Out of memory");
     _mdns_announce_all_pcbs(&s, 1, false);
 
 err:
@@ -6277,8 +8461,7 @@ esp_err_t mdns_service_txt_item_set_for_host_with_explicit_value_len(const char
 {
     MDNS_SERVICE_LOCK();
     esp_err_t ret = ESP_OK;
-    char *value = NULL;
-    mdns_txt_linked_item_t *new_txt = NULL;
+    uint8_t *txt = NULL;
     const char *hostname = host ? host : _mdns_server->hostname;
     ESP_GOTO_ON_FALSE(_mdns_server && _mdns_server->services && !_str_null_or_empty(service) && !_str_null_or_empty(proto) && !_str_null_or_empty(key) &&
                       !((!value_arg && value_len)), ESP_ERR_INVALID_ARG, err, TAG, "Invalid state or arguments");
@@ -6287,33 +8470,30 @@ esp_err_t mdns_service_txt_item_set_for_host_with_explicit_value_len(const char
     ESP_GOTO_ON_FALSE(s, ESP_ERR_NOT_FOUND, err, TAG, "Service doesn't exist");
 
     mdns_service_t *srv = s->service;
-    if (value_len > 0) {
-        value = (char *) mdns_mem_malloc(value_len);
-        ESP_GOTO_ON_FALSE(value, ESP_ERR_NO_MEM, out_of_mem, TAG, "Out of memory");
-        memcpy(value, value_arg, value_len);
-    } else {
-        value_len = 0;
-    }
-    mdns_txt_linked_item_t *txt = srv->txt;
-    while (txt) {
-        if (strcmp(txt->key, key) == 0) {
-            mdns_mem_free((char *)txt->value);
-            txt->value = value;
-            txt->value_len = value_len;
-            break;
-        }
-        txt = txt->next;
-    }
-    if (!txt) {
-        new_txt = (mdns_txt_linked_item_t *)mdns_mem_malloc(sizeof(mdns_txt_linked_item_t));
-        ESP_GOTO_ON_FALSE(new_txt, ESP_ERR_NO_MEM, out_of_mem, TAG, "Out of memory");
-        new_txt->key = mdns_mem_strdup(key);
-        ESP_GOTO_ON_FALSE(new_txt->key, ESP_ERR_NO_MEM, out_of_mem, TAG, "Out of memory");
-        new_txt->value = value;
-        new_txt->value_len = value_len;
-        new_txt->next = srv->txt;
-        srv->txt = new_txt;
-    }
+    const char *value = value_len > 0 ? value_arg : NULL;
+    uint16_t item_len = _mdns_txt_item_len(key, value, value_len);
+    ESP_GOTO_ON_FALSE(item_len, ESP_ERR_INVALID_ARG, err, TAG, "TXT item over 255 bytes");
+
+    // the item replaces the one of the key, or goes first
+    uint16_t old_len = 0;
+    int at = _mdns_txt_find(srv, key, &old_len);
+    if (at < 0) {
+        at = 0;
+    }
+    size_t txt_len = srv->txt_len - old_len + item_len;
+    ESP_GOTO_ON_FALSE(txt_len <= MDNS_MAX_PACKET_SIZE, ESP_ERR_INVALID_ARG, err, TAG, "TXT record over a packet");
+    txt = (uint8_t *)mdns_mem_malloc(txt_len);
+    ESP_GOTO_ON_FALSE(txt, ESP_ERR_NO_MEM, out_of_mem, TAG, "Out of memory");
+    if (at) {
+        memcpy(txt, srv->txt, at);
+    }
+    uint8_t *rest = _mdns_txt_item_write(txt + at, key, value, value_len);
+    if (srv->txt_len > at + old_len) {
+        memcpy(rest, srv->txt + at + old_len, srv->txt_len - at - old_len);
+    }
+    mdns_mem_free(srv->txt);
+    srv->txt = txt;
+    srv->txt_len = txt_len;
 
     _mdns_announce_all_pcbs(&s, 1, false);
 
@@ -6323,16 +8503,19 @@ err:
 out_of_mem:
     MDNS_SERVICE_UNLOCK();
     HOOK_MALLOC_FAILED;
-    mdns_mem_free(value);
-    mdns_mem_free(new_txt);
     return ret;
 }
 
 esp_err_t mdns_service_txt_item_set_for_host(const char *instance, const char *service, const char *proto, const char *hostname,
                                              const char *key, const char *value)
 {
+    size_t value_len = strlen(value);
+    // the explicit length is a uint8_t, a longer value would be truncated rather than refused
+    if (value_len > UINT8_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
     return mdns_service_txt_item_set_for_host_with_explicit_value_len(instance, service, proto, hostname, key, value,
-                                                                      strlen(value));
+                                                                      value_len);
 }
 
 
@@ -6341,8 +8524,7 @@ esp_err_t mdns_service_txt_item_set(const char *service, const char *proto, cons
     if (!_mdns_server) {
         return ESP_ERR_INVALID_STATE;
     }
-    return mdns_service_txt_item_set_for_host_with_explicit_value_len(NULL, service, proto, NULL, key,
-                                                                      value, strlen(value));
+    return mdns_service_txt_item_set_for_host(NULL, service, proto, NULL, key, value);
 }
 
 esp_err_t mdns_service_txt_item_set_with_explicit_value_len(const char *service, const char *proto, const char *key,
@@ -6367,27 +8549,17 @@ esp_err_t mdns_service_txt_item_remove_for_host(const char *instance, const char
     ESP_GOTO_ON_FALSE(s, ESP_ERR_NOT_FOUND, err, TAG, "Service doesn't exist");
 
     mdns_service_t *srv = s->service;
-    mdns_txt_linked_item_t *txt = srv->txt;
-    if (!txt) {
+    if (!srv->txt) {
         goto err;
     }
-    if (strcmp(txt->key, key) == 0) {
-        srv->txt = txt->next;
-        mdns_mem_free((char *)txt->key);
-        mdns_mem_free((char *)txt->value);
-        mdns_mem_free(txt);
-    } else {
-        while (txt->next) {
-            if (strcmp(txt->next->key, key) == 0) {
-                mdns_txt_linked_item_t *t = txt->next;
-                txt->next = t->next;
-                mdns_mem_free((char *)t->key);
-                mdns_mem_free((char *)t->value);
-                mdns_mem_free(t);
-                break;
-            } else {
-                txt = txt->next;
-            }
+    uint16_t item_len;
+    int at = _mdns_txt_find(srv, key, &item_len);
+    if (at >= 0) {
+        srv->txt_len -= item_len;
+        memmove(srv->txt + at, srv->txt + at + item_len, srv->txt_len - at);
+        if (!srv->txt_len) {
+            mdns_mem_free(srv->txt);
+            srv->txt = NULL;
         }
     }
 
@@ -6423,6 +8595,7 @@ static esp_err_t _mdns_service_subtype_remove_for_host(mdns_srv_item_t *service,
             } else {
                 pre->next = srv_subtype->next;
             }
+            _mdns_subtype_index_remove(srv_subtype);
             mdns_mem_free((char *)srv_subtype->subtype);
             mdns_mem_free(srv_subtype);
             ret = ESP_OK;
@@ -6486,6 +8659,7 @@ static esp_err_t _mdns_service_subtype_add_for_host(mdns_srv_item_t *service, co
     ESP_GOTO_ON_FALSE(subtype_item->subtype, ESP_ERR_NO_MEM, out_of_mem, TAG, "Out of memory");
     subtype_item->next = service->service->subtype;
     service->service->subtype = subtype_item;
+    _mdns_subtype_index_add(service, subtype_item);
 
 err:
     return ret;
@@ -6602,6 +8776,9 @@ esp_err_t mdns_service_subtype_update_multiple_items_for_host(const char *instan
     mdns_srv_item_t *s = _mdns_get_service_item_instance(instance_name, service_type, proto, hostname);
     ESP_GOTO_ON_FALSE(s, ESP_ERR_NOT_FOUND, err, TAG, "Service doesn't exist");
 
+    for (mdns_subtype_t *indexed = s->service->subtype; indexed; indexed = indexed->next) {
+        _mdns_subtype_index_remove(indexed);
+    }
     mdns_subtype_t *goodbye_subtype = _mdns_service_find_subtype_needed_sendbye(s->service, subtype, num_items);
 
     if (goodbye_subtype) {
@@ -6650,11 +8827,13 @@ esp_err_t mdns_service_instance_name_set_for_host(const char *instance_old, cons
     mdns_srv_item_t *s = _mdns_get_service_item_instance(instance_old, service, proto, hostname);
     ESP_GOTO_ON_FALSE(s, ESP_ERR_NOT_FOUND, err, TAG, "Service doesn't exist");
 
+    _mdns_service_index_remove_instance(s);
     if (s->service->instance) {
         _mdns_send_bye(&s, 1, false);
         mdns_mem_free((char *)s->service->instance);
     }
     s->service->instance = mdns_mem_strndup(instance, MDNS_NAME_BUF_LEN - 1);
+    _mdns_service_index_add_instance(s);
     ESP_GOTO_ON_FALSE(s->service->instance, ESP_ERR_NO_MEM, err, TAG, "Out of memory");
     _mdns_probe_all_pcbs(&s, 1, false, false);
 
@@ -6691,6 +8870,7 @@ esp_err_t mdns_service_remove_for_host(const char *instance, const char *service
                 } else {
                     _mdns_server->services = a->next;
                 }
+                _mdns_service_index_remove(a);
                 _mdns_send_bye(&a, 1, false);
                 _mdns_remove_scheduled_service_packets(a->service);
                 _mdns_free_service(a->service);
@@ -6708,6 +8888,7 @@ esp_err_t mdns_service_remove_for_host(const char *instance, const char *service
                 } else {
                     _mdns_server->services = a->next;
                 }
+                _mdns_service_index_remove(a);
                 _mdns_send_bye(&a, 1, false);
                 _mdns_remove_scheduled_service_packets(a->service);
                 _mdns_free_service(a->service);
@@ -6744,6 +8925,10 @@ esp_err_t mdns_service_remove_all(void)
     _mdns_send_final_bye(false);
     mdns_srv_item_t *services = _mdns_server->services;
     _mdns_server->services = NULL;
+    memset(_mdns_server->service_index, 0, sizeof(_mdns_server->service_index));
+    memset(_mdns_server->instance_index, 0, sizeof(_mdns_server->instance_index));
+    memset(_mdns_server->host_service_index, 0, sizeof(_mdns_server->host_service_index));
+    memset(_mdns_server->subtype_index, 0, sizeof(_mdns_server->subtype_index));
     while (services) {
         mdns_srv_item_t *s = services;
         services = services->next;
@@ -7025,7 +9210,7 @@ esp_err_t mdns_query_aaaa(const char *name, uint32_t timeout, esp_ip6_addr_t *ad
 
 void mdns_debug_packet(const uint8_t *data, size_t len)
 {
-    static mdns_name_t n;
+    mdns_name_t n;
     mdns_header_t header;
     const uint8_t *content = data + MDNS_HEAD_LEN;
     uint32_t t = xTaskGetTickCount() * portTICK_PERIOD_MS;
@@ -7257,16 +9442,15 @@ static esp_err_t _mdns_sync_browse_action(mdns_action_type_t type, mdns_browse_s
 {
     mdns_action_t *action = NULL;
 
-    action = (mdns_action_t *)mdns_mem_malloc(sizeof(mdns_action_t));
+    action = _mdns_action_alloc();
     if (!action) {
-        HOOK_MALLOC_FAILED;
         return ESP_ERR_NO_MEM;
     }
 
     action->type = type;
     action->data.browse_sync.browse_sync = browse_sync;
-    if (xQueueSend(_mdns_server->action_queue, &action, (TickType_t)0) != pdPASS) {
-        mdns_mem_free(action);
+    if (!_mdns_action_post(action)) {
+        _mdns_action_free(action);
         return ESP_ERR_NO_MEM;
     }
     return ESP_OK;
@@ -7279,22 +9463,58 @@ static esp_err_t _mdns_send_browse_action(mdns_action_type_t type, mdns_browse_t
 {
     mdns_action_t *action = NULL;
 
-    action = (mdns_action_t *)mdns_mem_malloc(sizeof(mdns_action_t));
-
+    action = _mdns_action_alloc();
     if (!action) {
-        HOOK_MALLOC_FAILED;
         return ESP_ERR_NO_MEM;
     }
 
     action->type = type;
     action->data.browse_add.browse = browse;
-    if (xQueueSend(_mdns_server->action_queue, &action, (TickType_t)0) != pdPASS) {
-        mdns_mem_free(action);
+    if (!_mdns_action_post(action)) {
+        _mdns_action_free(action);
         return ESP_ERR_NO_MEM;
     }
     return ESP_OK;
 }
 
+/**
+ * @brief  Whether the service type of the browse is browsed already, or posted to be
+ *
+ * @note   Called with the service lock held
+ */
+static bool _mdns_browse_exists(mdns_browse_t *browse)
+{
+    mdns_browse_t *chains[] = {_mdns_server->browse, _mdns_server->browse_pending};
+    for (size_t i = 0; i < sizeof(chains) / sizeof(chains[0]); i++) {
+        for (mdns_browse_t *b = chains[i]; b; b = b->next) {
+            if (!strcmp(b->service, browse->service) && !strcmp(b->proto, browse->proto)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief  Post the start of a browse, it stays in the pending list until the mDNS task adds it
+ *
+ * @param  unique  Fail with ESP_ERR_INVALID_STATE if the service type is browsed already or posted to be
+ */
+static esp_err_t _mdns_browse_post(mdns_browse_t *browse, bool unique)
+{
+    esp_err_t err = ESP_ERR_INVALID_STATE;
+    MDNS_SERVICE_LOCK();
+    if (!unique || !_mdns_browse_exists(browse)) {
+        err = _mdns_send_browse_action(ACTION_BROWSE_ADD, browse);
+        if (err == ESP_OK) {
+            browse->next = _mdns_server->browse_pending;
+            _mdns_server->browse_pending = browse;
+        }
+    }
+    MDNS_SERVICE_UNLOCK();
+    return err;
+}
+
 /**
  * @brief  Free a browse item (Not free the list).
  */
@@ -7305,6 +9525,7 @@ static void _mdns_browse_item_free(mdns_browse_t *browse)
     if (browse->result) {
         _mdns_query_results_free(browse->result);
     }
+    mdns_mem_free(browse->records);
     mdns_mem_free(browse);
 }
 
@@ -7355,7 +9576,7 @@ mdns_browse_t *mdns_browse_new(const char *service, const char *proto, mdns_brow
         return NULL;
     }
 
-    if (_mdns_send_browse_action(ACTION_BROWSE_ADD, browse)) {
+    if (_mdns_browse_post(browse, false)) {
         _mdns_browse_item_free(browse);
         return NULL;
     }
@@ -7383,6 +9604,100 @@ esp_err_t mdns_browse_delete(const char *service, const char *proto)
     return ESP_OK;
 }
 
+mdns_browse_t *mdns_browse_delta_new(const char *service, const char *proto, size_t max_records,
+                                     mdns_browse_delta_notify_t notifier, void *arg)
+{
+    if (!_mdns_server || _str_null_or_empty(service) || _str_null_or_empty(proto) || !notifier
+            || !max_records || max_records > UINT16_MAX) {
+        return NULL;
+    }
+    mdns_browse_t *browse = _mdns_browse_init(service, proto, NULL);
+    if (!browse) {
+        return NULL;
+    }
+    size_t buckets = 8;
+    while (buckets < max_records) {
+        buckets <<= 1;
+    }
+    // one block: the records state, the slots, then the buckets
+    mdns_browse_records_t *records = (mdns_browse_records_t *)mdns_mem_calloc(1, sizeof(mdns_browse_records_t)
+                                                                                 + max_records * sizeof(mdns_browse_record_t) + buckets * sizeof(uint16_t));
+    if (!records) {
+        HOOK_MALLOC_FAILED;
+        _mdns_browse_item_free(browse);
+        return NULL;
+    }
+    records->notifier = notifier;
+    records->arg = arg;
+    records->slots = (mdns_browse_record_t *)(records + 1);
+    records->buckets = (uint16_t *)(records->slots + max_records);
+    records->size = max_records;
+    records->mask = buckets - 1;
+    for (uint16_t i = 0; i + 1 < max_records; i++) {
+        records->slots[i].next = i + 2;
+    }
+    records->free = 1;
+    browse->records = records;
+
+    // a duplicate would be freed by the mDNS task, the records go to the browse of the caller only
+    if (_mdns_browse_post(browse, true)) {
+        _mdns_browse_item_free(browse);
+        return NULL;
+    }
+    return browse;
+}
+
+esp_err_t mdns_get_stats(mdns_stats_t *stats)
+{
+    if (!stats) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!_mdns_server) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    memset(stats, 0, sizeof(mdns_stats_t));
+    MDNS_SERVICE_LOCK();
+#if CONFIG_MDNS_ENABLE_STATS
+    for (mdns_if_t i = 0; i < MDNS_MAX_INTERFACES && i < CONFIG_MDNS_MAX_INTERFACES; i++) {
+        memcpy(stats->netif[i], _mdns_server->stats.netif[i], sizeof(stats->netif[i]));
+    }
+    stats->parse = _mdns_server->stats.parse;
+    stats->tx = _mdns_server->stats.tx;
+    stats->answers = _mdns_server->stats.answers;
+    stats->action_queue_depth = __atomic_load_n(&_mdns_server->stats.action_depth, __ATOMIC_RELAXED);
+    stats->action_queue_peak = __atomic_load_n(&_mdns_server->stats.action_peak, __ATOMIC_RELAXED);
+    stats->action_queue_drops = __atomic_load_n(&_mdns_server->stats.action_drops, __ATOMIC_RELAXED);
+    stats->malloc_failures = __atomic_load_n(&_mdns_server->stats.malloc_failures, __ATOMIC_RELAXED);
+    stats->searches_started = _mdns_server->stats.searches;
+    stats->browses_started = _mdns_server->stats.browses;
+#endif
+    stats->known_answer_suppressed = _mdns_server->suppressed.known_answer;
+    stats->duplicate_answer_suppressed = _mdns_server->suppressed.duplicate_answer;
+    stats->aggregated_answers = _mdns_server->aggregated.packets;
+    stats->action_pool_exhausted = __atomic_load_n(&_mdns_server->action_pool.exhausted, __ATOMIC_RELAXED);
+    for (mdns_search_once_t *search = _mdns_server->search_once; search; search = search->next) {
+        stats->searches_active += search->state != SEARCH_OFF;
+    }
+    for (mdns_browse_t *browse = _mdns_server->browse; browse; browse = browse->next) {
+        stats->browses_active++;
+        if (browse->records) {
+            stats->browse_records_dropped += browse->records->dropped;
+        }
+    }
+    stats->queries_sent = _mdns_server->queries.sent;
+    stats->query_refreshes = _mdns_server->queries.refreshes;
+    stats->query_packets = _mdns_server->queries.packets;
+    stats->cache_records = _mdns_server->cache.len;
+    stats->cache_bytes = _mdns_server->cache.bytes;
+    stats->cache_hits = _mdns_server->cache.hits;
+    stats->cache_misses = _mdns_server->cache.misses;
+    stats->cache_inserts = _mdns_server->cache.inserts;
+    stats->cache_evictions = _mdns_server->cache.evictions;
+    stats->cache_expirations = _mdns_server->cache.expirations;
+    MDNS_SERVICE_UNLOCK();
+    return ESP_OK;
+}
+
 /**
  * @brief  Mark browse as finished, remove and free it from browse chain
  */
@@ -7397,6 +9712,9 @@ static void _mdns_browse_finish(mdns_browse_t *browse)
             target_free = b;
             b = b->next;
             queueDetach(mdns_browse_t, _mdns_server->browse, target_free);
+            if (target_free->records) {
+                _mdns_server->delta_browses--;
+            }
             _mdns_browse_item_free(target_free);
         } else {
             b = b->next;
@@ -7405,11 +9723,71 @@ static void _mdns_browse_finish(mdns_browse_t *browse)
     _mdns_browse_item_free(browse);
 }
 
+/**
+ * @brief  Notify a new browse of the cached records it would match, as if they had just been received
+ */
+static void _mdns_cache_feed_browse(mdns_browse_t *browse)
+{
+    uint32_t now = xTaskGetTickCount() * portTICK_PERIOD_MS;
+    mdns_name_t name;
+    mdns_browse_sync_t *browse_sync = (mdns_browse_sync_t *)mdns_mem_malloc(sizeof(mdns_browse_sync_t));
+    if (!browse_sync) {
+        HOOK_MALLOC_FAILED;
+        return;
+    }
+    browse_sync->browse = browse;
+    browse_sync->sync_result = NULL;
+    _mdns_cache_expire(now);
+    for (size_t i = 0; i < sizeof(_mdns_cache_replay_types) / sizeof(_mdns_cache_replay_types[0]); i++) {
+        uint16_t type = _mdns_cache_replay_types[i];
+        for (mdns_cache_record_t *r = _mdns_server->cache.records; r; r = r->next) {
+            if (r->type != type) {
+                continue;
+            }
+            _mdns_cache_record_name(r, &name);
+            if (_mdns_browse_find_from(browse, &name, type, r->tcpip_if, r->ip_protocol) != browse) {
+                continue;
+            }
+            uint32_t ttl = _mdns_cache_ttl_left(r, now);
+            if (type == MDNS_TYPE_SRV) {
+                _mdns_browse_result_add_srv(browse, r->target, r->name, r->service, r->proto, r->port,
+                                            r->tcpip_if, r->ip_protocol, ttl, browse_sync);
+            } else if (type == MDNS_TYPE_TXT) {
+                mdns_txt_item_t *txt = NULL;
+                uint8_t *txt_value_len = NULL;
+                size_t txt_count = 0;
+                _mdns_result_txt_create(r->txt, r->txt_len, &txt, &txt_value_len, &txt_count);
+                _mdns_browse_result_add_txt(browse, r->name, r->service, r->proto, txt, txt_value_len, txt_count,
+                                            r->tcpip_if, r->ip_protocol, ttl, browse_sync);
+            } else {
+                esp_ip_addr_t addr = r->addr;
+                _mdns_browse_result_add_ip(browse, r->name, &addr, r->tcpip_if, r->ip_protocol, ttl, browse_sync);
+            }
+        }
+    }
+    if (browse_sync->sync_result) {
+        _mdns_server->cache.hits++;
+        _mdns_browse_sync(browse_sync);
+    } else {
+        _mdns_server->cache.misses++;
+    }
+    _mdns_sync_browse_result_link_free(browse_sync);
+}
+
 /**
  * @brief  Add new browse to the browse chain
  */
 static void _mdns_browse_add(mdns_browse_t *browse)
 {
+    mdns_browse_t **pending = &_mdns_server->browse_pending;
+    while (*pending && *pending != browse) {
+        pending = &(*pending)->next;
+    }
+    if (*pending) {
+        *pending = browse->next;
+        browse->next = NULL;
+    }
+    MDNS_STATS_INC(browses);
     browse->state = BROWSE_RUNNING;
     mdns_browse_t *queue = _mdns_server->browse;
     bool found = false;
@@ -7425,13 +9803,347 @@ static void _mdns_browse_add(mdns_browse_t *browse)
     if (!found) {
         browse->next = _mdns_server->browse;
         _mdns_server->browse = browse;
+        if (browse->records) {
+            _mdns_server->delta_browses++;
+            if (MDNS_CACHE_SIZE) {
+                _mdns_browse_delta_feed(browse);
+            }
+        } else if (MDNS_CACHE_SIZE) {
+            _mdns_cache_feed_browse(browse);
+        }
     }
     for (uint8_t interface_idx = 0; interface_idx < MDNS_MAX_INTERFACES; interface_idx++) {
         _mdns_browse_send(browse, (mdns_if_t)interface_idx);
     }
     if (found) {
         _mdns_browse_item_free(browse);
+    } else {
+        _mdns_query_sent(&browse->query, MDNS_TYPE_PTR, NULL, browse->service, browse->proto,
+                         xTaskGetTickCount() * portTICK_PERIOD_MS);
+        _mdns_timer_arm();
+    }
+}
+
+/**
+ * @brief  Whether the browse is still in the browse chain, it may have ended since an action was posted for it
+ */
+static bool _mdns_browse_is_running(mdns_browse_t *browse)
+{
+    mdns_browse_t *b = _mdns_server->browse;
+    while (b && b != browse) {
+        b = b->next;
+    }
+    return b != NULL;
+}
+
+/**
+ * @brief  Pass the queued changes of a delta browse to its notifier, then release the slots of removed records
+ */
+static void _mdns_browse_delta_flush(mdns_browse_t *browse)
+{
+    mdns_browse_records_t *records = browse->records;
+    if (!records->pending) {
+        return;
+    }
+    records->notifier(records->deltas, records->pending, records->arg);
+    for (uint16_t i = 0; i < records->pending; i++) {
+        if (records->deltas[i].op == MDNS_BROWSE_RECORD_REMOVE) {
+            mdns_browse_record_t *slot = &records->slots[records->pending_slot[i]];
+            slot->type = 0;
+            slot->removed = false;
+            slot->next = records->free;
+            records->free = records->pending_slot[i] + 1;
+        }
+    }
+    records->pending = 0;
+}
+
+static void _mdns_browse_delta_flush_all(void)
+{
+    for (mdns_browse_t *b = _mdns_server->browse; b && _mdns_server->delta_browses; b = b->next) {
+        if (b->records) {
+            _mdns_browse_delta_flush(b);
+        }
+    }
+}
+
+/**
+ * @brief  Queue a change of the record in slot index, the notifier gets it with the next flush
+ */
+static void _mdns_browse_delta_queue(mdns_browse_t *browse, mdns_browse_delta_op_t op, uint16_t index, const uint8_t *txt)
+{
+    mdns_browse_records_t *records = browse->records;
+    if (records->pending == MDNS_BROWSE_DELTA_BATCH) {
+        _mdns_browse_delta_flush(browse);
+    }
+    mdns_browse_record_t *slot = &records->slots[index];
+    mdns_browse_delta_t *delta = &records->deltas[records->pending];
+    memset(delta, 0, sizeof(mdns_browse_delta_t));
+    delta->op = op;
+    delta->type = slot->type;
+    delta->esp_netif = _mdns_get_esp_netif(slot->tcpip_if);
+    delta->ip_protocol = slot->ip_protocol;
+    delta->ttl = op == MDNS_BROWSE_RECORD_REMOVE ? 0 : slot->ttl;
+    switch (slot->type) {
+    case MDNS_TYPE_SRV:
+        delta->hostname = slot->target;
+        delta->port = slot->port;
+        delta->instance = slot->name;
+        break;
+    case MDNS_TYPE_TXT:
+        if (op != MDNS_BROWSE_RECORD_REMOVE) {
+            delta->txt = txt;
+            delta->txt_len = slot->txt_len;
+        }
+        delta->instance = slot->name;
+        break;
+    case MDNS_TYPE_A:
+    case MDNS_TYPE_AAAA:
+        delta->hostname = slot->name;
+        delta->addr = slot->addr;
+        break;
+    default:
+        delta->instance = slot->name;
+        break;
+    }
+    records->pending_slot[records->pending++] = index;
+}
+
+/**
+ * @brief  Unlink the record at *link from its bucket and queue its removal
+ */
+static void _mdns_browse_delta_remove(mdns_browse_t *browse, uint16_t *link)
+{
+    mdns_browse_records_t *records = browse->records;
+    uint16_t index = *link - 1;
+    mdns_browse_record_t *slot = &records->slots[index];
+    *link = slot->next;
+    slot->removed = true;
+    records->len--;
+    _mdns_browse_delta_queue(browse, MDNS_BROWSE_RECORD_REMOVE, index, NULL);
+}
+
+static uint32_t _mdns_browse_delta_expiry(const mdns_browse_record_t *slot)
+{
+    return slot->received_at + slot->ttl * 1000;
+}
+
+/**
+ * @brief  Bring forward the next expiry of the browse to the one of slot
+ */
+static void _mdns_browse_delta_track_expiry(mdns_browse_records_t *records, const mdns_browse_record_t *slot)
+{
+    uint32_t t = _mdns_browse_delta_expiry(slot);
+    if (records->len == 1 || (int32_t)(t - records->next_expiry) < 0) {
+        records->next_expiry = t;
+        _mdns_timer_arm();
+    }
+}
+
+/**
+ * @brief  Whether the host is the target of an SRV record of the browse
+ */
+static bool _mdns_browse_delta_is_target(mdns_browse_records_t *records, const char *host, uint32_t hash,
+                                         mdns_if_t tcpip_if, mdns_ip_protocol_t ip_protocol)
+{
+    for (uint16_t i = 0; i < records->size; i++) {
+        mdns_browse_record_t *slot = &records->slots[i];
+        if (slot->type == MDNS_TYPE_SRV && !slot->removed && slot->data_hash == hash && slot->tcpip_if == tcpip_if
+                && slot->ip_protocol == ip_protocol && !strcasecmp(slot->target, host)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static uint32_t _mdns_browse_delta_txt_hash(const uint8_t *txt, uint16_t len)
+{
+    uint32_t hash = MDNS_HASH_INIT;
+    for (uint16_t i = 0; i < len; i++) {
+        hash = (hash ^ txt[i]) * MDNS_HASH_PRIME;
+    }
+    return hash;
+}
+
+/**
+ * @brief  Track a record received for a delta browse, queueing the change it makes
+ *
+ * PTR, SRV and TXT records must be of the browsed service type, A and AAAA records of the target of one of its
+ * SRV records. A record received again with the same data only renews its TTL. A goodbye removes it, the
+ * cache-flush bit of an address removes the other addresses of the host received more than a second ago.
+ */
+static void _mdns_browse_delta_add(mdns_browse_t *browse, const mdns_cache_record_t *record, bool flush, uint32_t ttl)
+{
+    mdns_browse_records_t *records = browse->records;
+    uint16_t type = record->type;
+    bool address = type == MDNS_TYPE_A || type == MDNS_TYPE_AAAA;
+    const char *name = record->name;
+    if (!address) {
+        if (strcasecmp(record->service, browse->service) || strcasecmp(record->proto, browse->proto)) {
+            return;
+        }
+        if (type == MDNS_TYPE_PTR) {
+            name = record->target;
+        }
+    }
+    if (ttl > MDNS_CACHE_MAX_TTL) {
+        ttl = MDNS_CACHE_MAX_TTL;
+    }
+    uint32_t now = xTaskGetTickCount() * portTICK_PERIOD_MS;
+    uint32_t hash = _mdns_hash_nocase(MDNS_HASH_INIT, name);
+    uint16_t *found = NULL;
+    bool known_host = false;
+    uint16_t *link = &records->buckets[hash & records->mask];
+    while (*link) {
+        mdns_browse_record_t *slot = &records->slots[*link - 1];
+        if (slot->hash != hash || slot->tcpip_if != record->tcpip_if || slot->ip_protocol != record->ip_protocol
+                || strcasecmp(slot->name, name)) {
+            link = &slot->next;
+            continue;
+        }
+        known_host |= slot->type == MDNS_TYPE_A || slot->type == MDNS_TYPE_AAAA;
+        if (slot->type != type) {
+            link = &slot->next;
+            continue;
+        }
+        if (!address || !memcmp(&slot->addr, &record->addr, sizeof(esp_ip_addr_t))) {
+            found = link;
+        } else if (flush && ttl && now - slot->received_at > MDNS_CACHE_FLUSH_GRACE_MS) {
+            _mdns_browse_delta_remove(browse, link);
+            continue;
+        }
+        link = &slot->next;
+    }
+
+    if (!ttl) {
+        if (found) {
+            _mdns_browse_delta_remove(browse, found);
+        }
+        return;
+    }
+    uint32_t txt_hash = type == MDNS_TYPE_TXT ? _mdns_browse_delta_txt_hash(record->txt, record->txt_len) : 0;
+    if (found) {
+        uint16_t index = *found - 1;
+        mdns_browse_record_t *slot = &records->slots[index];
+        slot->received_at = now;
+        slot->ttl = ttl;
+        _mdns_browse_delta_track_expiry(records, slot);
+        if (type == MDNS_TYPE_SRV && (slot->port != record->port || strcasecmp(slot->target, record->target))) {
+            slot->port = record->port;
+            memcpy(slot->target, record->target, strlen(record->target) + 1);
+            slot->data_hash = _mdns_hash_nocase(MDNS_HASH_INIT, slot->target);
+        } else if (type == MDNS_TYPE_TXT && (slot->txt_len != record->txt_len || slot->data_hash != txt_hash)) {
+            slot->txt_len = record->txt_len;
+            slot->data_hash = txt_hash;
+        } else {
+            return;
+        }
+        _mdns_browse_delta_queue(browse, MDNS_BROWSE_RECORD_UPDATE, index, record->txt);
+        return;
+    }
+    if (address && !known_host
+            && !_mdns_browse_delta_is_target(records, name, hash, record->tcpip_if, record->ip_protocol)) {
+        return;
+    }
+    if (!records->free) {
+        records->dropped++;
+        return;
+    }
+    uint16_t index = records->free - 1;
+    mdns_browse_record_t *slot = &records->slots[index];
+    records->free = slot->next;
+    memset(slot, 0, sizeof(mdns_browse_record_t));
+    slot->type = type;
+    slot->tcpip_if = record->tcpip_if;
+    slot->ip_protocol = record->ip_protocol;
+    slot->received_at = now;
+    slot->ttl = ttl;
+    slot->hash = hash;
+    // the names were read by _mdns_parse_fqdn(), they fit the slot
+    memcpy(slot->name, name, strlen(name) + 1);
+    if (type == MDNS_TYPE_SRV) {
+        slot->port = record->port;
+        memcpy(slot->target, record->target, strlen(record->target) + 1);
+        slot->data_hash = _mdns_hash_nocase(MDNS_HASH_INIT, slot->target);
+    } else if (type == MDNS_TYPE_TXT) {
+        slot->txt_len = record->txt_len;
+        slot->data_hash = txt_hash;
+    } else if (address) {
+        slot->addr = record->addr;
+    }
+    uint16_t *bucket = &records->buckets[hash & records->mask];
+    slot->next = *bucket;
+    *bucket = index + 1;
+    records->len++;
+    _mdns_browse_delta_track_expiry(records, slot);
+    _mdns_browse_delta_queue(browse, MDNS_BROWSE_RECORD_ADD, index, record->txt);
+}
+
+/**
+ * @brief  Called from parser with every record read from a response
+ */
+static void _mdns_browse_delta_record(const mdns_cache_record_t *record, bool flush, uint32_t ttl)
+{
+    for (mdns_browse_t *b = _mdns_server->browse; b && _mdns_server->delta_browses; b = b->next) {
+        if (b->records && b->state == BROWSE_RUNNING) {
+            _mdns_browse_delta_add(b, record, flush, ttl);
+        }
+    }
+}
+
+/**
+ * @brief  Remove the records of a delta browse whose TTL ran out, posted by the timer
+ */
+static void _mdns_browse_delta_expire(mdns_browse_t *browse)
+{
+    if (!_mdns_browse_is_running(browse)) {
+        return;
+    }
+    mdns_browse_records_t *records = browse->records;
+    uint32_t now = xTaskGetTickCount() * portTICK_PERIOD_MS;
+    bool first = true;
+    records->expire_pending = false;
+    for (uint32_t bucket = 0; bucket <= records->mask; bucket++) {
+        uint16_t *link = &records->buckets[bucket];
+        while (*link) {
+            mdns_browse_record_t *slot = &records->slots[*link - 1];
+            uint32_t expiry = _mdns_browse_delta_expiry(slot);
+            if ((int32_t)(now - expiry) >= 0) {
+                _mdns_browse_delta_remove(browse, link);
+                continue;
+            }
+            if (first || (int32_t)(expiry - records->next_expiry) < 0) {
+                records->next_expiry = expiry;
+                first = false;
+            }
+            link = &slot->next;
+        }
+    }
+    // the timer re-armed while the expiry was pending, without this browse
+    _mdns_timer_arm();
+    _mdns_browse_delta_flush(browse);
+}
+
+/**
+ * @brief  Notify a new delta browse of the cached records it tracks, as if they had just been received
+ */
+static void _mdns_browse_delta_feed(mdns_browse_t *browse)
+{
+    uint32_t now = xTaskGetTickCount() * portTICK_PERIOD_MS;
+    _mdns_cache_expire(now);
+    for (size_t i = 0; i < sizeof(_mdns_cache_replay_types) / sizeof(_mdns_cache_replay_types[0]); i++) {
+        for (mdns_cache_record_t *r = _mdns_server->cache.records; r; r = r->next) {
+            if (r->type == _mdns_cache_replay_types[i]) {
+                _mdns_browse_delta_add(browse, r, false, _mdns_cache_ttl_left(r, now));
+            }
+        }
+    }
+    if (browse->records->len) {
+        _mdns_server->cache.hits++;
+    } else {
+        _mdns_server->cache.misses++;
     }
+    _mdns_browse_delta_flush(browse);
 }
 
 /**
@@ -7558,6 +10270,11 @@ static mdns_browse_t *_mdns_browse_find_from(mdns_browse_t *b, mdns_name_t *name
     }
     mdns_result_t *r = NULL;
     while (b) {
+        if (b->records) {
+            // delta browses are fed by _mdns_browse_delta_record()
+            b = b->next;
+            continue;
+        }
         if (type == MDNS_TYPE_SRV || type == MDNS_TYPE_TXT) {
             if (strcasecmp(name->service, b->service)
                     || strcasecmp(name->proto, b->proto)) {
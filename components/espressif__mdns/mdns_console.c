@@ -1414,6 +1414,80 @@ static void register_mdns_browse_del(void)
     ESP_ERROR_CHECK(esp_console_cmd_register(&cmd_browse_del));
 }
 
+static void mdns_print_latency(const char *stage, const mdns_stats_latency_t *latency)
+{
+    uint32_t count = 0;
+    for (int i = 0; i < MDNS_STATS_LATENCY_BUCKETS; i++) {
+        count += latency->buckets[i];
+    }
+    printf("%-6s count: %" PRIu32 ", avg: %" PRIu32 " us, max: %" PRIu32 " us\n", stage, count,
+           count ? (uint32_t)(latency->total_us / count) : 0, latency->max_us);
+    printf("      ");
+    for (int i = 0; i < MDNS_STATS_LATENCY_BUCKETS - 1; i++) {
+        printf("<%uus: %" PRIu32 "  ", 16U << i, latency->buckets[i]);
+    }
+    printf(">=%uus: %" PRIu32 "\n", 16U << (MDNS_STATS_LATENCY_BUCKETS - 2), latency->buckets[MDNS_STATS_LATENCY_BUCKETS - 1]);
+}
+
+static int cmd_mdns_stats(int argc, char **argv)
+{
+    mdns_stats_t *stats = mdns_mem_malloc(sizeof(mdns_stats_t));
+    if (!stats) {
+        printf("ERROR: No memory!\n");
+        return 1;
+    }
+    esp_err_t err = mdns_get_stats(stats);
+    if (err) {
+        printf("ERROR: mDNS not running!\n");
+        mdns_mem_free(stats);
+        return 1;
+    }
+#if CONFIG_MDNS_ENABLE_STATS
+    for (int i = 0; i < CONFIG_MDNS_MAX_INTERFACES; i++) {
+        esp_netif_t *netif = _mdns_get_esp_netif(i);
+        for (int j = 0; j < MDNS_IP_PROTOCOL_MAX; j++) {
+            const mdns_stats_netif_t *n = &stats->netif[i][j];
+            if (netif && (n->rx_packets || n->tx_packets)) {
+                printf("%s %s: rx %" PRIu32 " packets %" PRIu32 " bytes, tx %" PRIu32 " packets %" PRIu32 " bytes\n",
+                       esp_netif_get_ifkey(netif), ip_protocol_str[j], n->rx_packets, n->rx_bytes, n->tx_packets, n->tx_bytes);
+            }
+        }
+    }
+    mdns_print_latency("parse", &stats->parse);
+    mdns_print_latency("tx", &stats->tx);
+    printf("answers: %" PRIu32 "\n", stats->answers);
+    printf("actions: queued %" PRIu32 ", peak %" PRIu32 ", drops %" PRIu32 "\n", stats->action_queue_depth,
+           stats->action_queue_peak, stats->action_queue_drops);
+    printf("malloc failures: %" PRIu32 "\n", stats->malloc_failures);
+#endif
+    printf("suppressed: known answer %" PRIu32 ", duplicate answer %" PRIu32 ", aggregated answers %" PRIu32 "\n",
+           stats->known_answer_suppressed, stats->duplicate_answer_suppressed, stats->aggregated_answers);
+    printf("action pool exhausted: %" PRIu32 "\n", stats->action_pool_exhausted);
+    printf("searches: started %" PRIu32 ", active %" PRIu32 "\n", stats->searches_started, stats->searches_active);
+    printf("browses: started %" PRIu32 ", active %" PRIu32 ", records dropped %" PRIu32 "\n", stats->browses_started,
+           stats->browses_active, stats->browse_records_dropped);
+    printf("queries: sent %" PRIu32 ", refreshes %" PRIu32 ", packets %" PRIu32 "\n", stats->queries_sent,
+           stats->query_refreshes, stats->query_packets);
+    printf("cache: %" PRIu32 " records %" PRIu32 " bytes, hits %" PRIu32 ", misses %" PRIu32 ", inserts %" PRIu32
+           ", evictions %" PRIu32 ", expirations %" PRIu32 "\n", stats->cache_records, stats->cache_bytes,
+           stats->cache_hits, stats->cache_misses, stats->cache_inserts, stats->cache_evictions, stats->cache_expirations);
+    mdns_mem_free(stats);
+    return 0;
+}
+
+static void register_mdns_stats(void)
+{
+    const esp_console_cmd_t cmd_stats = {
+        .command = "mdns_stats",
+        .help = "Print the statistics of the mDNS engine",
+        .hint = NULL,
+        .func = &cmd_mdns_stats,
+        .argtable = NULL
+    };
+
+    ESP_ERROR_CHECK(esp_console_cmd_register(&cmd_stats));
+}
+
 void mdns_console_register(void)
 {
     register_mdns_init();
@@ -1436,6 +1510,7 @@ void mdns_console_register(void)
 
     register_mdns_browse();
     register_mdns_browse_del();
+    register_mdns_stats();
 
 #ifdef CONFIG_LWIP_IPV4
     register_mdns_query_a();
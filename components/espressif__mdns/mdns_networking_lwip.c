@@ -381,6 +381,14 @@ size_t _mdns_udp_pcb_write(mdns_if_t tcpip_if, mdns_ip_protocol_t ip_protocol, c
     return len;
 }
 
+void _mdns_udp_pcb_batch_begin(void)
+{
+}
+
+void _mdns_udp_pcb_batch_flush(void)
+{
+}
+
 void *_mdns_get_packet_data(mdns_rx_packet_t *packet)
 {
     return packet->pb->payload;
@@ -8,6 +8,8 @@
  * @brief MDNS Server Networking module implemented using BSD sockets
  */
 
+#include <inttypes.h>
+#include <stddef.h>
 #include <string.h>
 #include "esp_event.h"
 #include "mdns_networking.h"
@@ -25,6 +27,8 @@
 
 #if defined(CONFIG_IDF_TARGET_LINUX)
 #include <sys/ioctl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <net/if.h>
 #endif
 
@@ -58,6 +62,49 @@ struct pbuf  {
 #define s6_addr32 un.u32_addr
 #endif // CONFIG_IDF_TARGET_LINUX
 
+#ifndef CONFIG_MDNS_SOCKET_RX_POOL_LEN
+#define CONFIG_MDNS_SOCKET_RX_POOL_LEN 4
+#endif
+
+/**
+ * @brief  Preallocated RX packet: the socket receives straight into data, the action queued to the engine
+ * lives here too, so a received packet costs no allocation. Taken by the receive task, released by the
+ * mDNS task in _mdns_packet_free()
+ */
+typedef struct {
+    mdns_rx_packet_t packet;
+    mdns_action_t action;
+    struct pbuf pb;
+    bool in_use;
+    uint8_t data[MDNS_MAX_PACKET_SIZE];
+} rx_slot_t;
+
+static rx_slot_t s_rx_pool[CONFIG_MDNS_SOCKET_RX_POOL_LEN];
+static uint32_t s_rx_dropped;
+static bool s_sock_recv_task_running = false;
+
+#if defined(CONFIG_IDF_TARGET_LINUX)
+// Datagrams per recvmmsg()/sendmmsg() call
+#define MDNS_SOCKET_BATCH_LEN 16
+
+// The receive task waits on the sockets and on an eventfd signalled to stop it, all in one epoll set
+static int s_epoll_fd = -1;
+static int s_event_fd = -1;
+
+/**
+ * @brief  Packets kept between _mdns_udp_pcb_batch_begin() and _mdns_udp_pcb_batch_flush()
+ */
+static struct {
+    bool active;
+    int len;
+    int sock[MDNS_SOCKET_BATCH_LEN];
+    struct mmsghdr msgs[MDNS_SOCKET_BATCH_LEN];
+    struct iovec iov[MDNS_SOCKET_BATCH_LEN];
+    struct sockaddr_storage addr[MDNS_SOCKET_BATCH_LEN];
+    uint8_t data[MDNS_SOCKET_BATCH_LEN][MDNS_MAX_PACKET_SIZE];
+} s_tx_batch;
+#endif // CONFIG_IDF_TARGET_LINUX
+
 static void __attribute__((constructor)) ctor_networking_socket(void)
 {
     for (int i = 0; i < sizeof(s_interfaces) / sizeof(s_interfaces[0]); ++i) {
@@ -68,6 +115,9 @@ static void __attribute__((constructor)) ctor_networking_socket(void)
 
 static void delete_socket(int sock)
 {
+#if defined(CONFIG_IDF_TARGET_LINUX)
+    epoll_ctl(s_epoll_fd, EPOLL_CTL_DEL, sock, NULL);
+#endif
     close(sock);
 }
 
@@ -88,9 +138,22 @@ size_t _mdns_get_packet_len(mdns_rx_packet_t *packet)
 
 void _mdns_packet_free(mdns_rx_packet_t *packet)
 {
-    mdns_mem_free(packet->pb->payload);
-    mdns_mem_free(packet->pb);
-    mdns_mem_free(packet);
+    rx_slot_t *slot = (rx_slot_t *)((uint8_t *)packet - offsetof(rx_slot_t, packet));
+    __atomic_store_n(&slot->in_use, false, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief  Up to max free pool slots, only the receive task takes slots so no compare-and-swap is needed
+ */
+static int rx_slots_get(rx_slot_t **slots, int max)
+{
+    int count = 0;
+    for (int i = 0; i < CONFIG_MDNS_SOCKET_RX_POOL_LEN && count < max; i++) {
+        if (!__atomic_load_n(&s_rx_pool[i].in_use, __ATOMIC_ACQUIRE)) {
+            slots[count++] = &s_rx_pool[i];
+        }
+    }
+    return count;
 }
 
 esp_err_t _mdns_pcb_deinit(mdns_if_t tcpip_if, mdns_ip_protocol_t ip_protocol)
@@ -100,6 +163,7 @@ esp_err_t _mdns_pcb_deinit(mdns_if_t tcpip_if, mdns_ip_protocol_t ip_protocol)
         // if the interface for both protocols uninitialized, close the interface socket
         if (s_interfaces[tcpip_if].sock >= 0) {
             delete_socket(s_interfaces[tcpip_if].sock);
+            s_interfaces[tcpip_if].sock = -1;
         }
     }
 
@@ -111,8 +175,17 @@ esp_err_t _mdns_pcb_deinit(mdns_if_t tcpip_if, mdns_ip_protocol_t ip_protocol)
     }
 
     // no interface alive, stop the rx task
-    s_run_sock_recv_task = false;
-    vTaskDelay(pdMS_TO_TICKS(500));
+    __atomic_store_n(&s_run_sock_recv_task, false, __ATOMIC_RELEASE);
+#if defined(CONFIG_IDF_TARGET_LINUX)
+    uint64_t wake = 1;
+    if (write(s_event_fd, &wake, sizeof(wake)) < 0) {
+        ESP_LOGE(TAG, "Failed to wake the receive task. errno=%d: %s", errno, strerror(errno));
+    }
+#endif
+    // lwIP: the task notices at the next select() timeout, within a second
+    while (__atomic_load_n(&s_sock_recv_task_running, __ATOMIC_ACQUIRE)) {
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
     return ESP_OK;
 }
 
@@ -192,6 +265,50 @@ static inline size_t espaddr_to_inet(const esp_ip_addr_t *addr, const uint16_t p
     return ss_addr_len;
 }
 
+#if defined(CONFIG_IDF_TARGET_LINUX)
+/**
+ * @brief  Sends the kept packets, one sendmmsg() per run of packets on the same socket
+ */
+static void tx_batch_send(void)
+{
+    int i = 0;
+    while (i < s_tx_batch.len) {
+        int sock = s_tx_batch.sock[i];
+        int run = 1;
+        while (i + run < s_tx_batch.len && s_tx_batch.sock[i + run] == sock) {
+            run++;
+        }
+        int sent = sendmmsg(sock, &s_tx_batch.msgs[i], run, 0);
+        if (sent < 1) {
+            // Skip the packet that failed, the next call sends the rest
+            ESP_LOGE(TAG, "[sock=%d]: sendmmsg() has failed\n errno=%d: %s", sock, errno, strerror(errno));
+            sent = 1;
+        }
+        i += sent;
+    }
+    s_tx_batch.len = 0;
+}
+
+static size_t tx_batch_add(int sock, const struct sockaddr_storage *in_addr, size_t ss_size, const uint8_t *data, size_t len)
+{
+    if (s_tx_batch.len == MDNS_SOCKET_BATCH_LEN) {
+        tx_batch_send();
+    }
+    int i = s_tx_batch.len++;
+    memcpy(s_tx_batch.data[i], data, len);
+    memcpy(&s_tx_batch.addr[i], in_addr, ss_size);
+    s_tx_batch.sock[i] = sock;
+    s_tx_batch.iov[i].iov_base = s_tx_batch.data[i];
+    s_tx_batch.iov[i].iov_len = len;
+    memset(&s_tx_batch.msgs[i], 0, sizeof(struct mmsghdr));
+    s_tx_batch.msgs[i].msg_hdr.msg_name = &s_tx_batch.addr[i];
+    s_tx_batch.msgs[i].msg_hdr.msg_namelen = ss_size;
+    s_tx_batch.msgs[i].msg_hdr.msg_iov = &s_tx_batch.iov[i];
+    s_tx_batch.msgs[i].msg_hdr.msg_iovlen = 1;
+    return len;
+}
+#endif // CONFIG_IDF_TARGET_LINUX
+
 size_t _mdns_udp_pcb_write(mdns_if_t tcpip_if, mdns_ip_protocol_t ip_protocol, const esp_ip_addr_t *ip, uint16_t port, uint8_t *data, size_t len)
 {
     if (!(s_interfaces[tcpip_if].proto & (ip_protocol == MDNS_IP_PROTOCOL_V4 ? PROTO_IPV4 : PROTO_IPV6))) {
@@ -208,6 +325,11 @@ size_t _mdns_udp_pcb_write(mdns_if_t tcpip_if, mdns_ip_protocol_t ip_protocol, c
         return 0;
     }
     ESP_LOGD(TAG, "[sock=%d]: Sending to IP %s port %d", sock, get_string_address(&in_addr), port);
+#if defined(CONFIG_IDF_TARGET_LINUX)
+    if (s_tx_batch.active && len <= MDNS_MAX_PACKET_SIZE) {
+        return tx_batch_add(sock, &in_addr, ss_size, data, len);
+    }
+#endif
     ssize_t actual_len = sendto(sock, data, len, 0, (struct sockaddr *)&in_addr, ss_size);
     if (actual_len < 0) {
         ESP_LOGE(TAG, "[sock=%d]: _mdns_udp_pcb_write sendto() has failed\n errno=%d: %s", sock, errno, strerror(errno));
@@ -215,6 +337,21 @@ size_t _mdns_udp_pcb_write(mdns_if_t tcpip_if, mdns_ip_protocol_t ip_protocol, c
     return actual_len;
 }
 
+void _mdns_udp_pcb_batch_begin(void)
+{
+#if defined(CONFIG_IDF_TARGET_LINUX)
+    s_tx_batch.active = true;
+#endif
+}
+
+void _mdns_udp_pcb_batch_flush(void)
+{
+#if defined(CONFIG_IDF_TARGET_LINUX)
+    tx_batch_send();
+    s_tx_batch.active = false;
+#endif
+}
+
 static inline void inet_to_espaddr(const struct sockaddr_storage *in_addr, esp_ip_addr_t *addr, uint16_t *port)
 {
 #ifdef CONFIG_LWIP_IPV4
@@ -247,9 +384,162 @@ static inline void inet_to_espaddr(const struct sockaddr_storage *in_addr, esp_i
 #endif // CONFIG_LWIP_IPV6
 }
 
+/**
+ * @brief  Drops datagrams when all buffers are with the mDNS task, or the socket keeps being reported readable
+ */
+static void rx_drop(int sock)
+{
+    uint8_t discard;
+#if defined(CONFIG_IDF_TARGET_LINUX)
+    // Everything queued on the socket, in one call
+    struct iovec iov = { .iov_base = &discard, .iov_len = sizeof(discard) };
+    struct mmsghdr msgs[MDNS_SOCKET_BATCH_LEN];
+    memset(msgs, 0, sizeof(msgs));
+    for (int i = 0; i < MDNS_SOCKET_BATCH_LEN; i++) {
+        msgs[i].msg_hdr.msg_iov = &iov;
+        msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+    int dropped = recvmmsg(sock, msgs, MDNS_SOCKET_BATCH_LEN, MSG_DONTWAIT, NULL);
+#else
+    int dropped = recv(sock, &discard, sizeof(discard), 0) >= 0;
+#endif
+    if (dropped <= 0) {
+        return;
+    }
+    if ((s_rx_dropped & ~0x3F) != ((s_rx_dropped + dropped) & ~0x3F) || s_rx_dropped == 0) {
+        ESP_LOGW(TAG, "RX pool exhausted, %" PRIu32 " packets dropped", s_rx_dropped + dropped);
+    }
+    s_rx_dropped += dropped;
+}
+
+/**
+ * @brief  Passes a received slot to the mdns main engine, it comes back in _mdns_packet_free()
+ */
+static void rx_deliver(rx_slot_t *slot, mdns_if_t tcpip_if, const struct sockaddr_storage *raddr, size_t len)
+{
+    uint16_t port = 0;
+    ESP_LOGD(TAG, "[if=%d]: Received from IP:%s", (int)tcpip_if, get_string_address((struct sockaddr_storage *)raddr));
+    ESP_LOG_BUFFER_HEXDUMP(TAG, slot->data, len, ESP_LOG_VERBOSE);
+
+    mdns_rx_packet_t *packet = &slot->packet;
+    memset(packet, 0, sizeof(mdns_rx_packet_t));
+    inet_to_espaddr(raddr, &packet->src, &port);
+    slot->pb.next = NULL;
+    slot->pb.payload = slot->data;
+    slot->pb.tot_len = len;
+    slot->pb.len = len;
+    packet->tcpip_if = tcpip_if;
+    packet->pb = &slot->pb;
+    packet->src_port = ntohs(port);
+    // TODO(IDF-3651): Add the correct dest addr -- for mdns to decide multicast/unicast
+    // Currently it's enough to assume the packet is multicast and mdns to check the source port of the packet
+    packet->multicast = 1;
+    packet->dest.type = packet->src.type;
+    packet->ip_protocol =
+        packet->src.type == ESP_IPADDR_TYPE_V4 ? MDNS_IP_PROTOCOL_V4 : MDNS_IP_PROTOCOL_V6;
+    slot->in_use = true;
+    if (_mdns_send_pooled_rx_action(&slot->action, packet) != ESP_OK) {
+        ESP_LOGE(TAG, "_mdns_send_pooled_rx_action failed!");
+        _mdns_packet_free(packet);
+    }
+}
+
+#if defined(CONFIG_IDF_TARGET_LINUX)
+/**
+ * @brief  Receives as many datagrams as there are free slots with one recvmmsg()
+ */
+static void sock_recv_batch(mdns_if_t tcpip_if, int sock)
+{
+    rx_slot_t *slots[MDNS_SOCKET_BATCH_LEN];
+    struct mmsghdr msgs[MDNS_SOCKET_BATCH_LEN];
+    struct iovec iov[MDNS_SOCKET_BATCH_LEN];
+    struct sockaddr_storage raddr[MDNS_SOCKET_BATCH_LEN];
+    int count = rx_slots_get(slots, MDNS_SOCKET_BATCH_LEN);
+    if (count == 0) {
+        rx_drop(sock);
+        return;
+    }
+    memset(msgs, 0, count * sizeof(struct mmsghdr));
+    for (int i = 0; i < count; i++) {
+        iov[i].iov_base = slots[i]->data;
+        iov[i].iov_len = sizeof(slots[i]->data);
+        msgs[i].msg_hdr.msg_name = &raddr[i];
+        msgs[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_storage);
+        msgs[i].msg_hdr.msg_iov = &iov[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+    int n = recvmmsg(sock, msgs, count, MSG_DONTWAIT, NULL);
+    if (n < 0) {
+        if (errno != EAGAIN && errno != EWOULDBLOCK) {
+            ESP_LOGE(TAG, "multicast recvmmsg failed. errno=%d: %s", errno, strerror(errno));
+        }
+        return;
+    }
+    for (int i = 0; i < n; i++) {
+        rx_deliver(slots[i], tcpip_if, &raddr[i], msgs[i].msg_len);
+    }
+}
+
 void sock_recv_task(void *arg)
 {
-    while (s_run_sock_recv_task) {
+    struct epoll_event events[MDNS_MAX_INTERFACES + 1];
+    while (__atomic_load_n(&s_run_sock_recv_task, __ATOMIC_ACQUIRE)) {
+        int n = epoll_wait(s_epoll_fd, events, MDNS_MAX_INTERFACES + 1, -1);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            ESP_LOGE(TAG, "epoll_wait failed. errno=%d: %s", errno, strerror(errno));
+            break;
+        }
+        for (int i = 0; i < n; i++) {
+            uint32_t tcpip_if = events[i].data.u32;
+            if (tcpip_if == MDNS_MAX_INTERFACES) {
+                // Woken up to stop, the loop condition tells
+                uint64_t wake;
+                if (read(s_event_fd, &wake, sizeof(wake)) < 0) {
+                    ESP_LOGD(TAG, "eventfd read failed. errno=%d", errno);
+                }
+                continue;
+            }
+            int sock = s_interfaces[tcpip_if].sock;
+            if (sock >= 0) {
+                sock_recv_batch(tcpip_if, sock);
+            }
+        }
+    }
+    __atomic_store_n(&s_sock_recv_task_running, false, __ATOMIC_RELEASE);
+    vTaskDelete(NULL);
+}
+
+/**
+ * @brief  Adds the socket to the epoll set of the receive task, creating the set with its eventfd first
+ */
+static bool event_loop_add(mdns_if_t tcpip_if, int sock)
+{
+    if (s_epoll_fd < 0) {
+        s_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+        s_event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        struct epoll_event ev = { .events = EPOLLIN, .data.u32 = MDNS_MAX_INTERFACES };
+        if (s_epoll_fd < 0 || s_event_fd < 0 || epoll_ctl(s_epoll_fd, EPOLL_CTL_ADD, s_event_fd, &ev) < 0) {
+            ESP_LOGE(TAG, "Failed to create the receive event loop. errno=%d: %s", errno, strerror(errno));
+            close(s_epoll_fd);
+            close(s_event_fd);
+            s_epoll_fd = s_event_fd = -1;
+            return false;
+        }
+    }
+    struct epoll_event ev = { .events = EPOLLIN, .data.u32 = tcpip_if };
+    if (epoll_ctl(s_epoll_fd, EPOLL_CTL_ADD, sock, &ev) < 0) {
+        ESP_LOGE(TAG, "[sock=%d]: Failed to add the socket to epoll. errno=%d: %s", sock, errno, strerror(errno));
+        return false;
+    }
+    return true;
+}
+#else
+void sock_recv_task(void *arg)
+{
+    while (__atomic_load_n(&s_run_sock_recv_task, __ATOMIC_ACQUIRE)) {
         struct timeval tv = {
             .tv_sec = 1,
             .tv_usec = 0,
@@ -281,67 +571,34 @@ void sock_recv_task(void *arg)
                     continue;
                 }
                 if (FD_ISSET(sock, &rfds)) {
-                    static char recvbuf[MDNS_MAX_PACKET_SIZE];
-                    uint16_t port = 0;
-
                     struct sockaddr_storage raddr; // Large enough for both IPv4 or IPv6
                     socklen_t socklen = sizeof(struct sockaddr_storage);
-                    esp_ip_addr_t addr = {0};
-                    int len = recvfrom(sock, recvbuf, sizeof(recvbuf), 0,
+                    rx_slot_t *slot;
+                    if (rx_slots_get(&slot, 1) == 0) {
+                        rx_drop(sock);
+                        continue;
+                    }
+                    int len = recvfrom(sock, slot->data, sizeof(slot->data), 0,
                                        (struct sockaddr *) &raddr, &socklen);
                     if (len < 0) {
                         ESP_LOGE(TAG, "multicast recvfrom failed. errno=%d: %s", errno, strerror(errno));
                         break;
                     }
-                    ESP_LOGD(TAG, "[sock=%d]: Received from IP:%s", sock, get_string_address(&raddr));
-                    ESP_LOG_BUFFER_HEXDUMP(TAG, recvbuf, len, ESP_LOG_VERBOSE);
-                    inet_to_espaddr(&raddr, &addr, &port);
-
-                    // Allocate the packet structure and pass it to the mdns main engine
-                    mdns_rx_packet_t *packet = (mdns_rx_packet_t *) mdns_mem_calloc(1, sizeof(mdns_rx_packet_t));
-                    struct pbuf *packet_pbuf = mdns_mem_calloc(1, sizeof(struct pbuf));
-                    uint8_t *buf = mdns_mem_malloc(len);
-                    if (packet == NULL || packet_pbuf == NULL || buf == NULL) {
-                        mdns_mem_free(buf);
-                        mdns_mem_free(packet_pbuf);
-                        mdns_mem_free(packet);
-                        HOOK_MALLOC_FAILED;
-                        ESP_LOGE(TAG, "Failed to allocate the mdns packet");
-                        continue;
-                    }
-                    memcpy(buf, recvbuf, len);
-                    packet_pbuf->next = NULL;
-                    packet_pbuf->payload = buf;
-                    packet_pbuf->tot_len = len;
-                    packet_pbuf->len = len;
-                    packet->tcpip_if = tcpip_if;
-                    packet->pb = packet_pbuf;
-                    packet->src_port = ntohs(port);
-                    memcpy(&packet->src, &addr, sizeof(esp_ip_addr_t));
-                    // TODO(IDF-3651): Add the correct dest addr -- for mdns to decide multicast/unicast
-                    // Currently it's enough to assume the packet is multicast and mdns to check the source port of the packet
-                    memset(&packet->dest, 0, sizeof(esp_ip_addr_t));
-                    packet->multicast = 1;
-                    packet->dest.type = packet->src.type;
-                    packet->ip_protocol =
-                        packet->src.type == ESP_IPADDR_TYPE_V4 ? MDNS_IP_PROTOCOL_V4 : MDNS_IP_PROTOCOL_V6;
-                    if (_mdns_send_rx_action(packet) != ESP_OK) {
-                        ESP_LOGE(TAG, "_mdns_send_rx_action failed!");
-                        mdns_mem_free(packet->pb->payload);
-                        mdns_mem_free(packet->pb);
-                        mdns_mem_free(packet);
-                    }
+                    rx_deliver(slot, tcpip_if, &raddr, len);
                 }
             }
         }
     }
+    __atomic_store_n(&s_sock_recv_task_running, false, __ATOMIC_RELEASE);
     vTaskDelete(NULL);
 }
+#endif // CONFIG_IDF_TARGET_LINUX
 
 static void mdns_networking_init(void)
 {
     if (s_run_sock_recv_task == false) {
         s_run_sock_recv_task = true;
+        s_sock_recv_task_running = true;
         xTaskCreate(sock_recv_task, "mdns recv task", 3 * 1024, NULL, 5, NULL);
     }
 }
@@ -355,6 +612,12 @@ static bool create_pcb(mdns_if_t tcpip_if, mdns_ip_protocol_t ip_protocol)
     esp_netif_t *netif = _mdns_get_esp_netif(tcpip_if);
     if (sock < 0) {
         sock = create_socket(netif);
+#if defined(CONFIG_IDF_TARGET_LINUX)
+        if (sock >= 0 && !event_loop_add(tcpip_if, sock)) {
+            close(sock);
+            sock = -1;
+        }
+#endif
     }
     if (sock < 0) {
         ESP_LOGE(TAG, "Failed to create the socket!");
@@ -0,0 +1,157 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "sdkconfig.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_diagnostics_metrics.h"
+#include "mdns.h"
+#include "mdns_private.h"
+#include "mdns_mem_caps.h"
+
+#if !CONFIG_DIAG_ENABLE_METRICS
+#error "CONFIG_MDNS_STATS_DIAG_METRICS needs the metrics of esp_diagnostics (CONFIG_DIAG_ENABLE_METRICS)"
+#endif
+
+#define METRICS_TAG     "mdns"
+#define METRICS_PATH    "mDNS"
+
+static const char *TAG = "mdns_stats";
+
+typedef enum {
+    METRIC_RX_PACKETS,
+    METRIC_TX_PACKETS,
+    METRIC_TX_BYTES,
+    METRIC_ANSWERS,
+    METRIC_PARSE_AVG_US,
+    METRIC_PARSE_MAX_US,
+    METRIC_ACTION_DROPS,
+    METRIC_MALLOC_FAILURES,
+    METRIC_QUERIES,
+    METRIC_CACHE_RECORDS,
+    METRIC_MAX
+} mdns_metric_t;
+
+static const struct {
+    const char *key;
+    const char *label;
+} s_metrics[METRIC_MAX] = {
+    [METRIC_RX_PACKETS] = { "rx_pkts", "Packets received" },
+    [METRIC_TX_PACKETS] = { "tx_pkts", "Packets sent" },
+    [METRIC_TX_BYTES] = { "tx_bytes", "Bytes sent" },
+    [METRIC_ANSWERS] = { "answers", "Answers generated" },
+    [METRIC_PARSE_AVG_US] = { "parse_avg_us", "Average parse time (us)" },
+    [METRIC_PARSE_MAX_US] = { "parse_max_us", "Longest parse time (us)" },
+    [METRIC_ACTION_DROPS] = { "action_drops", "Actions dropped" },
+    [METRIC_MALLOC_FAILURES] = { "malloc_fail", "Failed allocations" },
+    [METRIC_QUERIES] = { "queries", "Questions sent" },
+    [METRIC_CACHE_RECORDS] = { "cache_records", "Records in the cache" },
+};
+
+static esp_timer_handle_t s_report_timer;
+
+static void _mdns_stats_diag_report(mdns_metric_t metric, uint32_t value)
+{
+#ifndef CONFIG_ESP_INSIGHTS_META_VERSION_10
+    esp_diag_metrics_report_uint(METRICS_TAG, s_metrics[metric].key, value);
+#else
+    esp_diag_metrics_add_uint(s_metrics[metric].key, value);
+#endif
+}
+
+/**
+ * @brief  reports the totals since mdns_init(), called by the esp_timer task
+ */
+static void _mdns_stats_diag_report_all(void *arg)
+{
+    mdns_stats_t *stats = mdns_mem_malloc(sizeof(mdns_stats_t));
+    if (!stats) {
+        HOOK_MALLOC_FAILED;
+        return;
+    }
+    if (mdns_get_stats(stats) != ESP_OK) {
+        mdns_mem_free(stats);
+        return;
+    }
+    uint32_t rx_packets = 0;
+    uint32_t tx_packets = 0;
+    uint32_t tx_bytes = 0;
+    for (int i = 0; i < CONFIG_MDNS_MAX_INTERFACES; i++) {
+        for (int j = 0; j < MDNS_IP_PROTOCOL_MAX; j++) {
+            rx_packets += stats->netif[i][j].rx_packets;
+            tx_packets += stats->netif[i][j].tx_packets;
+            tx_bytes += stats->netif[i][j].tx_bytes;
+        }
+    }
+    uint32_t parsed = 0;
+    for (int i = 0; i < MDNS_STATS_LATENCY_BUCKETS; i++) {
+        parsed += stats->parse.buckets[i];
+    }
+    _mdns_stats_diag_report(METRIC_RX_PACKETS, rx_packets);
+    _mdns_stats_diag_report(METRIC_TX_PACKETS, tx_packets);
+    _mdns_stats_diag_report(METRIC_TX_BYTES, tx_bytes);
+    _mdns_stats_diag_report(METRIC_ANSWERS, stats->answers);
+    _mdns_stats_diag_report(METRIC_PARSE_AVG_US, parsed ? stats->parse.total_us / parsed : 0);
+    _mdns_stats_diag_report(METRIC_PARSE_MAX_US, stats->parse.max_us);
+    _mdns_stats_diag_report(METRIC_ACTION_DROPS, stats->action_queue_drops);
+    _mdns_stats_diag_report(METRIC_MALLOC_FAILURES, stats->malloc_failures);
+    _mdns_stats_diag_report(METRIC_QUERIES, stats->queries_sent);
+    _mdns_stats_diag_report(METRIC_CACHE_RECORDS, stats->cache_records);
+    mdns_mem_free(stats);
+}
+
+static void _mdns_stats_diag_unregister(void)
+{
+    for (int i = 0; i < METRIC_MAX; i++) {
+#ifndef CONFIG_ESP_INSIGHTS_META_VERSION_10
+        esp_diag_metrics_unregister(METRICS_TAG, s_metrics[i].key);
+#else
+        esp_diag_metrics_unregister(s_metrics[i].key);
+#endif
+    }
+}
+
+esp_err_t _mdns_stats_diag_init(void)
+{
+    esp_err_t err;
+    if (s_report_timer) {
+        return ESP_OK;
+    }
+    for (int i = 0; i < METRIC_MAX; i++) {
+        err = esp_diag_metrics_register(METRICS_TAG, s_metrics[i].key, s_metrics[i].label, METRICS_PATH,
+                                        ESP_DIAG_DATA_TYPE_UINT);
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "Cannot register metric %s: %s", s_metrics[i].key, esp_err_to_name(err));
+            _mdns_stats_diag_unregister();
+            return err;
+        }
+    }
+    const esp_timer_create_args_t timer_conf = {
+        .callback = _mdns_stats_diag_report_all,
+        .name = "mdns_stats"
+    };
+    err = esp_timer_create(&timer_conf, &s_report_timer);
+    if (err != ESP_OK) {
+        s_report_timer = NULL;
+        _mdns_stats_diag_unregister();
+        return err;
+    }
+    err = esp_timer_start_periodic(s_report_timer, CONFIG_MDNS_STATS_DIAG_PERIOD_S * 1000000ULL);
+    if (err != ESP_OK) {
+        _mdns_stats_diag_deinit();
+    }
+    return err;
+}
+
+void _mdns_stats_diag_deinit(void)
+{
+    if (!s_report_timer) {
+        return;
+    }
+    esp_timer_stop(s_report_timer);
+    esp_timer_delete(s_report_timer);
+    s_report_timer = NULL;
+    _mdns_stats_diag_unregister();
+}
@@ -19,6 +19,14 @@
  */
 esp_err_t _mdns_send_rx_action(mdns_rx_packet_t *packet);
 
+/**
+ * @brief  Queue RX packet action stored in the networking layer's packet pool
+ *
+ * Nothing is allocated: the engine does not free the action, it is released
+ * together with the packet by _mdns_packet_free()
+ */
+esp_err_t _mdns_send_pooled_rx_action(mdns_action_t *action, mdns_rx_packet_t *packet);
+
 bool mdns_is_netif_ready(mdns_if_t tcpip_if, mdns_ip_protocol_t ip_protocol);
 
 /**
@@ -42,6 +50,19 @@ esp_err_t _mdns_pcb_deinit(mdns_if_t tcpip_if, mdns_ip_protocol_t ip_protocol);
  */
 size_t _mdns_udp_pcb_write(mdns_if_t tcpip_if, mdns_ip_protocol_t ip_protocol, const esp_ip_addr_t *ip, uint16_t port, uint8_t *data, size_t len);
 
+/**
+ * @brief  Start a burst of packets
+ *
+ * Until _mdns_udp_pcb_batch_flush() the backend may keep the packets
+ * written with _mdns_udp_pcb_write() and send them together
+ */
+void _mdns_udp_pcb_batch_begin(void);
+
+/**
+ * @brief  Send the packets kept since _mdns_udp_pcb_batch_begin()
+ */
+void _mdns_udp_pcb_batch_flush(void);
+
 /**
  * @brief  Gets data pointer to the mDNS packet
  */
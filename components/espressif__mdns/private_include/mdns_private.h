@@ -0,0 +1,745 @@
+/*
+ * SPDX-FileCopyrightText: 2015-2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef MDNS_PRIVATE_H_
+#define MDNS_PRIVATE_H_
+
+#include "sdkconfig.h"
+#include "mdns.h"
+#include "esp_task.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "esp_timer.h"
+#include "esp_system.h"
+
+#ifdef CONFIG_MDNS_ENABLE_DEBUG_PRINTS
+#define MDNS_ENABLE_DEBUG
+#define _mdns_dbg_printf(...) printf(__VA_ARGS__)
+#endif
+
+/** Number of predefined interfaces */
+#ifndef CONFIG_MDNS_PREDEF_NETIF_STA
+#define CONFIG_MDNS_PREDEF_NETIF_STA 0
+#endif
+#ifndef CONFIG_MDNS_PREDEF_NETIF_AP
+#define CONFIG_MDNS_PREDEF_NETIF_AP 0
+#endif
+#ifndef CONFIG_MDNS_PREDEF_NETIF_ETH
+#define CONFIG_MDNS_PREDEF_NETIF_ETH 0
+#endif
+#define MDNS_MAX_PREDEF_INTERFACES (CONFIG_MDNS_PREDEF_NETIF_STA + CONFIG_MDNS_PREDEF_NETIF_AP + CONFIG_MDNS_PREDEF_NETIF_ETH)
+
+#ifdef CONFIG_LWIP_IPV6_NUM_ADDRESSES
+#define NETIF_IPV6_MAX_NUMS CONFIG_LWIP_IPV6_NUM_ADDRESSES
+#else
+#define NETIF_IPV6_MAX_NUMS 3
+#endif
+
+#if ESP_IDF_VERSION < ESP_IDF_VERSION_VAL(5, 1, 0)
+/* CONFIG_LWIP_IPV4 was introduced in IDF v5.1 */
+/* For IDF v5.0, set CONFIG_LWIP_IPV4 to 1 by default */
+#ifndef CONFIG_LWIP_IPV4
+#define CONFIG_LWIP_IPV4 1
+#endif // CONFIG_LWIP_IPV4
+#endif // ESP_IDF_VERSION < ESP_IDF_VERSION_VAL(5, 1, 0)
+
+/** Number of configured interfaces */
+#if MDNS_MAX_PREDEF_INTERFACES > CONFIG_MDNS_MAX_INTERFACES
+#warning Number of configured interfaces is less then number of predefined interfaces. Please update CONFIG_MDNS_MAX_INTERFACES.
+#define MDNS_MAX_INTERFACES (MDNS_MAX_PREDEF_INTERFACES)
+#else
+#define MDNS_MAX_INTERFACES (CONFIG_MDNS_MAX_INTERFACES)
+#endif
+
+/** The maximum number of services */
+#define MDNS_MAX_SERVICES           CONFIG_MDNS_MAX_SERVICES
+#define MDNS_SERVICE_INDEX_SIZE     (MDNS_MAX_SERVICES / 2 + 1) // Buckets of each service index
+#define MDNS_HOST_INDEX_SIZE        16                      // Buckets of the delegated hostname index
+
+#define MDNS_ANSWER_PTR_TTL         4500
+#define MDNS_ANSWER_TXT_TTL         4500
+#define MDNS_ANSWER_SRV_TTL         120
+#define MDNS_ANSWER_A_TTL           120
+#define MDNS_ANSWER_AAAA_TTL        120
+
+#define MDNS_FLAGS_QUERY_REPSONSE   0x8000
+#define MDNS_FLAGS_AUTHORITATIVE    0x0400
+#define MDNS_FLAGS_QR_AUTHORITATIVE (MDNS_FLAGS_QUERY_REPSONSE | MDNS_FLAGS_AUTHORITATIVE)
+#define MDNS_FLAGS_DISTRIBUTED      0x0200                  // TC bit: the known answers of the query continue in the next packet
+
+#define MDNS_NAME_REF               0xC000
+
+//custom type! only used by this implementation
+//to help manage service discovery handling
+#define MDNS_TYPE_SDPTR             0x0032
+
+#define MDNS_CLASS_IN               0x0001
+#define MDNS_CLASS_ANY              0x00FF
+#define MDNS_CLASS_IN_FLUSH_CACHE   0x8001
+
+#define MDNS_ANSWER_ALL             0x3F
+#define MDNS_ANSWER_PTR             0x08
+#define MDNS_ANSWER_TXT             0x04
+#define MDNS_ANSWER_SRV             0x02
+#define MDNS_ANSWER_A               0x01
+#define MDNS_ANSWER_AAAA            0x10
+#define MDNS_ANSWER_NSEC            0x20
+#define MDNS_ANSWER_SDPTR           0x80
+#define MDNS_ANSWER_AAAA_SIZE       16
+
+#define MDNS_SERVICE_PORT           5353                    // UDP port that the server runs on
+#define MDNS_SERVICE_STACK_DEPTH    CONFIG_MDNS_TASK_STACK_SIZE
+#define MDNS_TASK_PRIORITY          CONFIG_MDNS_TASK_PRIORITY
+#if (MDNS_TASK_PRIORITY > ESP_TASK_PRIO_MAX)
+#error "mDNS task priority is higher than ESP_TASK_PRIO_MAX"
+#elif (MDNS_TASK_PRIORITY > ESP_TASKD_EVENT_PRIO)
+#warning "mDNS task priority is higher than ESP_TASKD_EVENT_PRIO, mDNS library might not work correctly"
+#endif
+#define MDNS_TASK_AFFINITY          CONFIG_MDNS_TASK_AFFINITY
+#define MDNS_SERVICE_ADD_TIMEOUT_MS CONFIG_MDNS_SERVICE_ADD_TIMEOUT_MS
+
+#define MDNS_PACKET_QUEUE_LEN       16                      // Maximum packets that can be queued for parsing
+#define MDNS_ACTION_QUEUE_LEN       CONFIG_MDNS_ACTION_QUEUE_LEN  // Maximum actions pending to the server
+#define MDNS_ACTION_POOL_LEN        (MDNS_ACTION_QUEUE_LEN + 2)   // Queued actions, the one executing and one being posted
+#define MDNS_TXT_MAX_LEN            1024                    // Maximum string length of text data in TXT record
+#define MDNS_MAX_PACKET_SIZE        1460                    // Maximum size of mDNS  outgoing packet
+#define MDNS_TX_QUEUE_INIT_LEN      16                      // Initial capacity of the scheduled packets heap, doubled when full
+
+#ifndef CONFIG_MDNS_CACHE_SIZE
+#define CONFIG_MDNS_CACHE_SIZE 0
+#endif
+#define MDNS_CACHE_SIZE             CONFIG_MDNS_CACHE_SIZE  // Bytes of remote records kept in the cache, 0 disables it
+#define MDNS_CACHE_MAX_TTL          86400                   // Longer TTLs are cut to keep the expiry in 32-bit ms
+#define MDNS_CACHE_FLUSH_GRACE_MS   1000                    // Records younger than this survive a cache-flush (RFC 6762 10.2)
+
+#define MDNS_NAME_DICT_SIZE         128                     // Name compression dictionary slots per TX packet (power of 2)
+#define MDNS_NAME_DICT_MAX_PARTS    8                       // Longest FQDN (in labels) indexed by the dictionary
+#define MDNS_NAME_TABLE_NAMES       64                      // Names indexed per RX packet, the next ones are read in place
+#define MDNS_NAME_TABLE_LABELS      256                     // Labels of the names indexed per RX packet
+
+#define MDNS_HEAD_LEN               12
+#define MDNS_HEAD_ID_OFFSET         0
+#define MDNS_HEAD_FLAGS_OFFSET      2
+#define MDNS_HEAD_QUESTIONS_OFFSET  4
+#define MDNS_HEAD_ANSWERS_OFFSET    6
+#define MDNS_HEAD_SERVERS_OFFSET    8
+#define MDNS_HEAD_ADDITIONAL_OFFSET 10
+
+#define MDNS_TYPE_OFFSET            0
+#define MDNS_CLASS_OFFSET           2
+#define MDNS_TTL_OFFSET             4
+#define MDNS_LEN_OFFSET             8
+#define MDNS_DATA_OFFSET            10
+
+#define MDNS_SRV_PRIORITY_OFFSET    0
+#define MDNS_SRV_WEIGHT_OFFSET      2
+#define MDNS_SRV_PORT_OFFSET        4
+#define MDNS_SRV_FQDN_OFFSET        6
+
+#define MDNS_TIMER_RETRY_MS         CONFIG_MDNS_TIMER_PERIOD_MS    // Retry delay of a deadline the timer could not serve
+#define MDNS_AGGREGATE_MIN_DELAY_MS 20                      // Delay range of a shared answer (RFC 6762 6), a scheduled answer
+#define MDNS_AGGREGATE_MAX_DELAY_MS 120                     // leaving within it takes in the answers to a later query
+#define MDNS_TRUNCATED_DELAY_MS     400                     // Delay of the answer to a truncated query, for the continuation
+                                                            // packets of its known answers (RFC 6762 7.2: 400-500 ms)
+#define MDNS_QUERY_INTERVAL_MIN_MS  1000                    // First wait between two queries of a question, doubled after
+#define MDNS_QUERY_INTERVAL_MAX_MS  (60 * 60 * 1000)        // every query up to one hour (RFC 6762 5.2)
+#define MDNS_BROWSE_DELTA_BATCH     16                      // Record changes passed at once to a delta browse notifier
+#define MDNS_QUERY_REFRESH_STEPS    4                       // Refresh queries of a cached answer, at 80, 85, 90 and 95% of
+                                                            // its TTL, plus 0-2% (RFC 6762 5.2)
+#define MDNS_TX_SECTIONS            3                       // Answer, authority and additional records of a TX packet
+
+#define MDNS_SERVICE_LOCK()     xSemaphoreTake(_mdns_service_semaphore, portMAX_DELAY)
+#define MDNS_SERVICE_UNLOCK()   xSemaphoreGive(_mdns_service_semaphore)
+
+#define queueToEnd(type, queue, item)       \
+    if (!queue) {                           \
+        queue = item;                       \
+    } else {                                \
+        type * _q = queue;                  \
+        while (_q->next) { _q = _q->next; } \
+        _q->next = item;                    \
+    }
+
+#define queueDetach(type, queue, item)              \
+    if (queue) {                                    \
+        if (queue == item) {                        \
+            queue = queue->next;                    \
+        } else {                                    \
+            type * _q = queue;                      \
+            while (_q->next && _q->next != item) {  \
+                _q = _q->next;                      \
+            }                                       \
+            if (_q->next == item) {                 \
+                _q->next = item->next;              \
+                item->next = NULL;                  \
+            }                                       \
+        }                                           \
+    }
+
+#define queueFree(type, queue)  while (queue) { type * _q = queue; queue = queue->next; mdns_mem_free(_q); }
+
+#define PCB_STATE_IS_PROBING(s) (s->state > PCB_OFF && s->state < PCB_ANNOUNCE_1)
+#define PCB_STATE_IS_ANNOUNCING(s) (s->state > PCB_PROBE_3 && s->state < PCB_RUNNING)
+#define PCB_STATE_IS_RUNNING(s) (s->state == PCB_RUNNING)
+
+#ifndef HOOK_MALLOC_FAILED
+#if CONFIG_MDNS_ENABLE_STATS
+#define HOOK_MALLOC_FAILED  ESP_LOGE(TAG, "Cannot allocate memory (line: %d, free heap: %" PRIu32 " bytes)", __LINE__, esp_get_free_heap_size()); \
+                            _mdns_stats_malloc_failed();
+#else
+#define HOOK_MALLOC_FAILED  ESP_LOGE(TAG, "Cannot allocate memory (line: %d, free heap: %" PRIu32 " bytes)", __LINE__, esp_get_free_heap_size());
+#endif
+#endif
+
+#if CONFIG_MDNS_ENABLE_STATS
+#define MDNS_STATS_INC(field)   __atomic_add_fetch(&_mdns_server->stats.field, 1, __ATOMIC_RELAXED)
+#define MDNS_STATS_DEC(field)   __atomic_sub_fetch(&_mdns_server->stats.field, 1, __ATOMIC_RELAXED)
+#else
+#define MDNS_STATS_INC(field)
+#define MDNS_STATS_DEC(field)
+#endif
+
+typedef size_t mdns_if_t;
+
+typedef enum {
+    PCB_OFF, PCB_DUP, PCB_INIT,
+    PCB_PROBE_1, PCB_PROBE_2, PCB_PROBE_3,
+    PCB_ANNOUNCE_1, PCB_ANNOUNCE_2, PCB_ANNOUNCE_3,
+    PCB_RUNNING
+} mdns_pcb_state_t;
+
+typedef enum {
+    MDNS_ANSWER, MDNS_NS, MDNS_EXTRA
+} mdns_parsed_record_type_t;
+
+typedef enum {
+    ACTION_SYSTEM_EVENT,
+    ACTION_HOSTNAME_SET,
+    ACTION_INSTANCE_SET,
+    ACTION_SEARCH_ADD,
+    ACTION_SEARCH_SEND,
+    ACTION_SEARCH_END,
+    ACTION_BROWSE_ADD,
+    ACTION_BROWSE_SYNC,
+    ACTION_BROWSE_END,
+    ACTION_BROWSE_EXPIRE,
+    ACTION_TX_HANDLE,
+    ACTION_RX_HANDLE,
+    ACTION_RX_HANDLE_POOLED,
+    ACTION_TASK_STOP,
+    ACTION_DELEGATE_HOSTNAME_ADD,
+    ACTION_DELEGATE_HOSTNAME_REMOVE,
+    ACTION_DELEGATE_HOSTNAME_SET_ADDR,
+    ACTION_MAX
+} mdns_action_type_t;
+
+
+typedef struct {
+    uint16_t id;
+    uint16_t flags;
+    uint16_t questions; //QDCOUNT
+    uint16_t answers;   //ANCOUNT
+    uint16_t servers;   //NSCOUNT
+    uint16_t additional;//ARCOUNT
+} mdns_header_t;
+
+typedef struct {
+    char host[MDNS_NAME_BUF_LEN]; // hostname for A/AAAA records, instance name for SRV records
+    char service[MDNS_NAME_BUF_LEN];
+    char proto[MDNS_NAME_BUF_LEN];
+    char domain[MDNS_NAME_BUF_LEN];
+    uint8_t parts;
+    uint8_t sub;
+    bool    invalid;
+} mdns_name_t;
+
+/**
+ * @brief  Name of a received packet, validated when it is first read
+ */
+typedef struct {
+    uint16_t offset;                            // Where the name starts in the packet
+    uint16_t end;                               // Offset after the name, its pointer or its terminating zero
+    uint16_t first;                             // Index of its first label in mdns_name_table_t.labels
+    uint8_t count;                              // Number of labels
+} mdns_name_entry_t;
+
+/**
+ * @brief  Label offsets of the names of a received packet
+ *
+ * Filled by _mdns_parse_name() while the packet is parsed. The compression pointers of a
+ * name are followed once, when it is first read: names read again take their labels from
+ * the table. Names missing from the table (malformed, or past the table size) are read
+ * in place.
+ */
+typedef struct {
+    mdns_name_entry_t names[MDNS_NAME_TABLE_NAMES];   // Sorted by offset
+    uint16_t labels[MDNS_NAME_TABLE_LABELS];    // Offsets of the label length bytes
+    uint8_t count;
+    uint16_t label_count;
+} mdns_name_table_t;
+
+/**
+ * @brief  Scratch state of the packet parser
+ *
+ * Each thread parsing packets uses its own context, the mDNS task has a static one.
+ */
+typedef struct {
+    mdns_name_t name;                           // Name being parsed
+    mdns_name_t target;                         // Name in the data of the record being cached
+    mdns_name_table_t names;                    // Names of the packet being parsed
+    uint16_t name_labels;                       // Offset of the first label read into name (0 if not from the table)
+    uint16_t target_labels;                     // Offset of the first label read into target (0 if not from the table)
+} mdns_parse_ctx_t;
+
+typedef struct mdns_parsed_question_s {
+    struct mdns_parsed_question_s *next;
+    uint16_t type;
+    bool sub;
+    bool unicast;
+    char *host;
+    char *service;
+    char *proto;
+    char *domain;
+} mdns_parsed_question_t;
+
+typedef struct {
+    mdns_if_t tcpip_if;
+    mdns_ip_protocol_t ip_protocol;
+    esp_ip_addr_t src;
+    uint16_t src_port;
+    uint8_t multicast;
+    uint8_t authoritative;
+    uint8_t probe;
+    uint8_t discovery;
+    uint8_t distributed;
+    mdns_parsed_question_t *questions;
+    struct mdns_known_answer_s *known_answers;  // Records of ours the sender already has, see mdns_known_answer_t
+    uint16_t id;
+} mdns_parsed_packet_t;
+
+typedef struct {
+    mdns_if_t tcpip_if;
+    mdns_ip_protocol_t ip_protocol;
+    struct pbuf *pb;
+    esp_ip_addr_t src;
+    esp_ip_addr_t dest;
+    uint16_t src_port;
+    uint8_t multicast;
+} mdns_rx_packet_t;
+
+typedef struct mdns_subtype_s {
+    const char *subtype;                    /*!< subtype */
+    struct mdns_subtype_s *next;            /*!< next result, or NULL for the last result in the list */
+    struct mdns_subtype_s *index_next;      /*!< next subtype in the same subtype_index bucket */
+    struct mdns_srv_item_s *item;           /*!< service the subtype belongs to, set while it is indexed */
+} mdns_subtype_t;
+
+typedef struct {
+    const char *instance;
+    const char *service;
+    const char *proto;
+    const char *hostname;
+    uint16_t priority;
+    uint16_t weight;
+    uint16_t port;
+    uint8_t *txt;                           // TXT rdata as sent: one length prefixed "key=value" or "key" string
+    uint16_t txt_len;                       // per item, NULL when there are no items
+    mdns_subtype_t *subtype;
+} mdns_service_t;
+
+typedef struct mdns_srv_item_s {
+    struct mdns_srv_item_s *next;
+    struct mdns_srv_item_s *index_next;     // Next item in the same service_index bucket
+    struct mdns_srv_item_s *instance_next;  // Next item in the same instance_index bucket
+    struct mdns_srv_item_s *host_next;      // Next item in the same host_service_index bucket
+    mdns_service_t *service;
+} mdns_srv_item_t;
+
+typedef struct mdns_out_question_s {
+    struct mdns_out_question_s *next;
+    uint16_t type;
+    bool unicast;
+    const char *host;
+    const char *service;
+    const char *proto;
+    const char *domain;
+    bool own_dynamic_memory;
+} mdns_out_question_t;
+
+typedef struct mdns_host_item_t {
+    const char *hostname;
+    mdns_ip_addr_t *address_list;
+    struct mdns_host_item_t *next;
+    struct mdns_host_item_t *index_next;    // Next host in the same hostname index bucket
+} mdns_host_item_t;
+
+typedef struct mdns_out_answer_s {
+    struct mdns_out_answer_s *next;
+    uint16_t type;
+    uint8_t bye;
+    uint8_t flush;
+    mdns_service_t *service;
+    mdns_host_item_t *host;
+    const char *custom_instance;
+    const char *custom_service;
+    const char *custom_proto;
+} mdns_out_answer_t;
+
+/**
+ * @brief  Record of ours found in another host's packet, with the same data as ours
+ *
+ * In a query it is a known answer: the querier has it cached (RFC 6762 7.1). In a response
+ * another responder has just sent it, so our scheduled answer is a duplicate (RFC 6762 7.4).
+ */
+typedef struct mdns_known_answer_s {
+    struct mdns_known_answer_s *next;
+    uint16_t type;
+    mdns_service_t *service;                    // Service of PTR, SDPTR, SRV and TXT records
+    mdns_host_item_t *host;                     // Host of A and AAAA records
+    esp_ip_addr_t addr;                         // Address of A and AAAA records
+} mdns_known_answer_t;
+
+/**
+ * @brief  Record of another host kept in the cache, see CONFIG_MDNS_CACHE_SIZE
+ *
+ * One allocation holds the record and its strings, `size` bytes charged to the cache.
+ */
+typedef struct mdns_cache_record_s {
+    struct mdns_cache_record_s *next;
+    uint32_t received_at;                       // Last reception (ms)
+    uint32_t expires_at;                        // Last reception + TTL (ms)
+    uint32_t ttl;                               // TTL of the last reception (s)
+    uint16_t type;
+    uint16_t size;
+    mdns_if_t tcpip_if;
+    mdns_ip_protocol_t ip_protocol;
+    const char *name;                           // Instance of SRV and TXT records, hostname of A and AAAA, empty for PTR
+    const char *service;
+    const char *proto;
+    const char *target;                         // Instance of PTR records, hostname of SRV records
+    uint16_t port;                              // Port of SRV records
+    uint16_t txt_len;                           // Raw data of TXT records
+    uint8_t refreshed;                          // Refresh queries sent since the last reception
+    uint8_t refresh_jitter;                     // Percent of the TTL added to every refresh point, 0-2
+    const uint8_t *txt;
+    esp_ip_addr_t addr;                         // Address of A and AAAA records
+} mdns_cache_record_t;
+
+/**
+ * @brief  Name compression dictionary of the TX packet being built
+ *
+ * Maps the hash of every label suffix written to the packet to the offset of its first label,
+ * so that _mdns_append_fqdn() finds compression targets without rescanning the packet.
+ */
+typedef struct {
+    uint16_t used;                              // Number of occupied slots
+    uint16_t hash[MDNS_NAME_DICT_SIZE];         // Suffix hash (only used to skip most mismatching slots)
+    uint16_t offset[MDNS_NAME_DICT_SIZE];       // Offset of the suffix in the packet, 0 = empty slot
+} mdns_name_dict_t;
+
+/**
+ * @brief  Scratch state of one TX packet being built: the wire buffer and its compression dictionary
+ *
+ * Each thread building packets uses its own context, the mDNS task has a static one.
+ */
+typedef struct {
+    uint8_t packet[MDNS_MAX_PACKET_SIZE];
+    mdns_name_dict_t names;
+    bool overflow;                              // The record being appended did not fit the packet
+    uint8_t next_section;                       // Where the next packet of a split packet starts, MDNS_TX_SECTIONS
+    mdns_out_answer_t *next_answer;             // when complete (see _mdns_build_tx_next())
+} mdns_tx_ctx_t;
+
+typedef struct mdns_tx_packet_s {
+    struct mdns_tx_packet_s *next;              // Next packet scheduled on the same PCB
+    struct mdns_tx_packet_s *prev;              // Previous one, NULL for the head of the PCB list
+    uint32_t send_at;
+    uint32_t seq;                               // Scheduling order, keeps packets due at the same time FIFO
+    uint16_t heap_index;                        // Position in the scheduled packets heap
+    mdns_if_t tcpip_if;
+    mdns_ip_protocol_t ip_protocol;
+    esp_ip_addr_t dst;
+    uint16_t port;
+    uint16_t flags;
+    uint8_t distributed;                        // Answer to a truncated query, delayed for its known answers
+    uint8_t shared_answer;                      // Delayed answer to a query, known answers and duplicates may drop records
+    mdns_out_question_t *questions;
+    mdns_out_answer_t *answers;
+    mdns_out_answer_t *servers;
+    mdns_out_answer_t *additional;
+    esp_ip_addr_t query_src;                    // Sender of the truncated query, its continuation packets prune the answers
+    uint16_t id;
+} mdns_tx_packet_t;
+
+typedef struct {
+    mdns_pcb_state_t state;
+    mdns_srv_item_t **probe_services;
+    uint8_t probe_services_len;
+    uint8_t probe_ip;
+    uint8_t probe_running;
+    uint16_t failed_probes;
+    mdns_tx_packet_t *tx_packets;               // Packets scheduled on this PCB, last scheduled first (the heap keeps the sending order)
+} mdns_pcb_t;
+
+typedef enum {
+    SEARCH_OFF,
+    SEARCH_INIT,
+    SEARCH_RUNNING,
+    SEARCH_MAX
+} mdns_search_once_state_t;
+
+typedef enum {
+    BROWSE_OFF,
+    BROWSE_INIT,
+    BROWSE_RUNNING,
+    BROWSE_MAX
+} mdns_browse_state_t;
+
+/**
+ * @brief  Continuous querying of a search or browse question (RFC 6762 5.2)
+ *
+ * The question is sent again interval ms after sent_at, the interval doubling every time, and when a cached
+ * answer reaches a refresh point of its TTL.
+ */
+typedef struct {
+    uint32_t sent_at;                           // Last query (ms)
+    uint32_t interval;                          // From MDNS_QUERY_INTERVAL_MIN_MS to MDNS_QUERY_INTERVAL_MAX_MS
+    uint32_t refresh_at;                        // Earliest refresh point of a cached answer (ms), valid if refresh
+    bool refresh;
+} mdns_query_sched_t;
+
+typedef struct mdns_search_once_s {
+    struct mdns_search_once_s *next;
+
+    mdns_search_once_state_t state;
+    uint32_t started_at;
+    mdns_query_sched_t query;
+    uint32_t timeout;
+    mdns_query_notify_t notifier;
+    SemaphoreHandle_t done_semaphore;
+    uint16_t type;
+    bool unicast;
+    bool send_pending;                          // Due, packed into the next queries with the other due questions
+    uint8_t max_results;
+    uint8_t num_results;
+    char *instance;
+    char *service;
+    char *proto;
+    mdns_result_t *result;
+} mdns_search_once_t;
+
+/**
+ * @brief  Record tracked by a browse created with mdns_browse_delta_new()
+ */
+typedef struct {
+    uint16_t type;                              // 0 for a free slot
+    uint16_t next;                              // Index + 1 of the next slot of the bucket or of the free list, 0 ends it
+    uint8_t tcpip_if;
+    uint8_t ip_protocol;
+    bool removed;                               // Notified as removed, released once the notifier returned
+    uint16_t port;                              // Port of SRV records
+    uint16_t txt_len;                           // TXT data is not kept, a change of its length or hash is an update
+    uint32_t received_at;                       // Last reception (ms)
+    uint32_t ttl;                               // TTL of the last reception (s)
+    uint32_t hash;                              // Of the name, selects the bucket
+    uint32_t data_hash;                         // Of the target of SRV records (finds the hosts to track), of TXT data
+    char name[MDNS_NAME_BUF_LEN];               // Instance of PTR, SRV and TXT records, host of A and AAAA records
+    union {
+        char target[MDNS_NAME_BUF_LEN];         // Host of SRV records
+        esp_ip_addr_t addr;                     // Address of A and AAAA records
+    };
+} mdns_browse_record_t;
+
+/**
+ * @brief  Records of a delta browse, allocated in one block with the browse
+ *
+ * Slots are hashed by name into power of two buckets. Changes are queued in deltas and passed to the notifier
+ * at the end of every packet, or once MDNS_BROWSE_DELTA_BATCH are queued.
+ */
+typedef struct {
+    mdns_browse_delta_notify_t notifier;
+    void *arg;
+    mdns_browse_record_t *slots;
+    uint16_t *buckets;                          // Index + 1 of the first slot of each bucket, 0 if empty
+    uint16_t size;                              // Slots, max_records of mdns_browse_delta_new()
+    uint16_t mask;                              // Buckets - 1
+    uint16_t len;                               // Slots in use
+    uint16_t free;                              // Index + 1 of the first free slot, 0 if none
+    uint32_t next_expiry;                       // No record expires before (ms), valid if len
+    bool expire_pending;                        // Expiry action posted by the timer and not executed yet
+    uint16_t pending;                           // Changes queued for the notifier
+    uint16_t pending_slot[MDNS_BROWSE_DELTA_BATCH];
+    mdns_browse_delta_t deltas[MDNS_BROWSE_DELTA_BATCH];
+    uint32_t dropped;                           // Records not tracked, every slot was taken
+} mdns_browse_records_t;
+
+typedef struct mdns_browse_s {
+    struct mdns_browse_s *next;
+
+    mdns_browse_state_t state;
+    bool send_pending;                          // Due, packed into the next queries with the other due questions
+    mdns_browse_notify_t notifier;
+    mdns_query_sched_t query;
+    mdns_browse_records_t *records;             // Set for a browse created with mdns_browse_delta_new()
+
+    char *service;
+    char *proto;
+    mdns_result_t *result;
+} mdns_browse_t;
+
+typedef struct mdns_browse_result_sync_t {
+    mdns_result_t *result;
+    struct mdns_browse_result_sync_t *next;
+} mdns_browse_result_sync_t;
+
+typedef struct mdns_browse_sync {
+    mdns_browse_t *browse;
+    mdns_browse_result_sync_t *sync_result;
+} mdns_browse_sync_t;
+
+typedef struct {
+    mdns_action_type_t type;
+    union {
+        struct {
+            char *hostname;
+        } hostname_set;
+        char *instance;
+        struct {
+            mdns_if_t interface;
+            mdns_event_actions_t event_action;
+        } sys_event;
+        struct {
+            mdns_search_once_t *search;
+        } search_add;
+        struct {
+            mdns_rx_packet_t *packet;
+        } rx_handle;
+        struct {
+            const char *hostname;
+            mdns_ip_addr_t *address_list;
+        } delegate_hostname;
+        struct {
+            mdns_browse_t *browse;
+        } browse_add;
+        struct {
+            mdns_browse_sync_t *browse_sync;
+        } browse_sync;
+    } data;
+} mdns_action_t;
+
+typedef struct mdns_service_batch_s {
+    mdns_srv_item_t *services;          // Created services, last added first, not registered yet
+    size_t len;
+} mdns_service_batch_t;
+
+typedef struct mdns_server_s {
+    struct {
+        mdns_pcb_t pcbs[MDNS_IP_PROTOCOL_MAX];
+    } interfaces[MDNS_MAX_INTERFACES];
+    const char *hostname;
+    const char *instance;
+    mdns_srv_item_t *services;
+    mdns_srv_item_t *service_index[MDNS_SERVICE_INDEX_SIZE];   // Services hashed by (service, proto), in list order
+    mdns_srv_item_t *instance_index[MDNS_SERVICE_INDEX_SIZE];  // Services hashed by (instance, service, proto)
+    mdns_srv_item_t *host_service_index[MDNS_SERVICE_INDEX_SIZE];  // Services hashed by (hostname, service, proto)
+    mdns_subtype_t *subtype_index[MDNS_SERVICE_INDEX_SIZE];    // Subtypes hashed by (subtype, service, proto)
+    QueueHandle_t action_queue;
+    SemaphoreHandle_t action_sema;
+    struct {
+        mdns_tx_packet_t **heap;                // Scheduled packets, min-heap on (send_at, seq)
+        uint16_t len;
+        uint16_t size;
+        uint32_t seq;
+        bool handle_pending;                    // TX action posted to the service task and not executed yet
+    } tx_queue;
+    mdns_search_once_t *search_once;
+    esp_timer_handle_t timer_handle;
+    uint32_t timer_fires_at;                    // Expiry of the one-shot timer (ms), valid while timer_armed
+    bool timer_armed;
+    mdns_browse_t *browse;
+    mdns_browse_t *browse_pending;              // Browses posted with ACTION_BROWSE_ADD, not in the browse chain yet
+    uint16_t delta_browses;                     // Running browses created with mdns_browse_delta_new()
+    struct {
+        uint32_t known_answer;                  // Records left out of our answers, the querier listed them
+        uint32_t duplicate_answer;              // Records dropped from our scheduled answers, another responder sent them
+    } suppressed;
+    struct {
+        uint32_t packets;                       // Answers merged into an answer already scheduled on the PCB
+        uint32_t records;                       // Records of the merged answers the scheduled one already held
+    } aggregated;
+    struct {
+        mdns_cache_record_t *records;           // Most recently added first
+        uint32_t bytes;
+        uint16_t len;
+        uint32_t hits;                          // Searches and browses that got results from the cache
+        uint32_t misses;                        // Searches and browses that got none
+        uint32_t inserts;
+        uint32_t evictions;                     // Records dropped to make room before their TTL ran out
+        uint32_t expirations;
+    } cache;
+    struct {
+        uint32_t sent;                          // Search and browse queries, as scheduled by the timer
+        uint32_t refreshes;                     // Of which sent for a cached answer reaching a refresh point
+        uint32_t packets;                       // Packets they were packed into, per PCB
+        bool send_pending;                      // Query action posted to the service task and not executed yet
+    } queries;
+    struct {
+        mdns_action_t actions[MDNS_ACTION_POOL_LEN];
+        uint8_t next[MDNS_ACTION_POOL_LEN];     // Freelist links, index + 1 of the next free action, 0 ends the list
+        uint32_t free;                          // Freelist head: ABA tag << 16 | index + 1 of the first free action
+        uint32_t in_use;
+        uint32_t peak;                          // Most actions taken at once
+        uint32_t exhausted;                     // Actions not posted, the pool was empty
+    } action_pool;
+#if CONFIG_MDNS_ENABLE_STATS
+    struct {
+        mdns_stats_netif_t netif[MDNS_MAX_INTERFACES][MDNS_IP_PROTOCOL_MAX];
+        mdns_stats_latency_t parse;             // Received packet parsed, with the answer it triggers
+        mdns_stats_latency_t tx;                // Packet serialized and sent
+        uint32_t answers;
+        uint32_t action_depth;                  // Actions posted and not executed yet
+        uint32_t action_peak;
+        uint32_t action_drops;                  // Actions not posted, the queue was full
+        uint32_t malloc_failures;
+        uint32_t searches;
+        uint32_t browses;
+    } stats;
+#endif
+} mdns_server_t;
+
+/*
+ * @brief  Convert mnds if to esp-netif handle
+ *
+ * @param  tcpip_if     mdns supported interface as internal enum
+ *
+ * @return
+ *     - ptr to esp-netif on success
+ *     - NULL if no available netif for current interface index
+ */
+esp_netif_t *_mdns_get_esp_netif(mdns_if_t tcpip_if);
+
+#if CONFIG_MDNS_ENABLE_STATS
+/*
+ * @brief  Count a failed allocation, called by HOOK_MALLOC_FAILED
+ */
+void _mdns_stats_malloc_failed(void);
+#endif
+
+#if CONFIG_MDNS_STATS_DIAG_METRICS
+/*
+ * @brief  Register the mDNS metrics with esp_diagnostics and start reporting them, called by mdns_init()
+ */
+esp_err_t _mdns_stats_diag_init(void);
+
+/*
+ * @brief  Stop reporting the mDNS metrics, called by mdns_free()
+ */
+void _mdns_stats_diag_deinit(void);
+#endif
+
+
+#endif /* MDNS_PRIVATE_H_ */
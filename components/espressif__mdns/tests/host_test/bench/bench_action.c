@@ -0,0 +1,171 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+/*
+ * Action pool of the mDNS task queue
+ *
+ * - post:    posts an RX action per received packet with _mdns_send_rx_action() and releases it as the mDNS
+ *            task does, reporting the heap allocations of mdns (counted by wrapping mdns_mem_malloc() and
+ *            mdns_mem_calloc() at link time) and the time per action
+ * - threads: 1, 2 and 4 threads take and return actions concurrently, each one checking that no other
+ *            thread got the action it holds
+ * - exhaust: takes 4 more actions than the pool holds, the extra ones must be refused and counted
+ *
+ * Usage: bench_action [iterations]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "esp32_mock.h"
+#include "mdns.h"
+#include "mdns_private.h"
+#include "bench_util.h"
+
+void mdns_bench_init_di(void);
+mdns_action_t *mdns_bench_action_alloc(void);
+void mdns_bench_action_free(mdns_action_t *action);
+void mdns_bench_free_action(mdns_action_t *action);
+esp_err_t _mdns_send_rx_action(mdns_rx_packet_t *packet);
+extern mdns_server_t *_mdns_server;
+
+#define BENCH_MAX_THREADS   4
+#define BENCH_EXTRA         4
+
+typedef struct {
+    int iterations;
+    int errors;
+} worker_t;
+
+static unsigned long s_allocs;
+
+void *__real_mdns_mem_malloc(size_t size);
+void *__real_mdns_mem_calloc(size_t num, size_t size);
+
+void *__wrap_mdns_mem_malloc(size_t size)
+{
+    __atomic_add_fetch(&s_allocs, 1, __ATOMIC_RELAXED);
+    return __real_mdns_mem_malloc(size);
+}
+
+void *__wrap_mdns_mem_calloc(size_t num, size_t size)
+{
+    __atomic_add_fetch(&s_allocs, 1, __ATOMIC_RELAXED);
+    return __real_mdns_mem_calloc(num, size);
+}
+
+// A packet as the networking layer hands it over, allocated outside of mdns
+static mdns_rx_packet_t *new_packet(void)
+{
+    mdns_rx_packet_t *packet = calloc(1, sizeof(mdns_rx_packet_t));
+    struct pbuf *pb = calloc(1, sizeof(struct pbuf));
+    if (!packet || !pb) {
+        abort();
+    }
+    packet->pb = pb;
+    return packet;
+}
+
+static void *worker(void *arg)
+{
+    worker_t *w = (worker_t *)arg;
+    for (int i = 0; i < w->iterations; i++) {
+        mdns_action_t *action = mdns_bench_action_alloc();
+        if (!action) {
+            w->errors++;
+            continue;
+        }
+        action->data.instance = (char *)w;
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        if (action->data.instance != (char *)w) {
+            w->errors++;
+        }
+        mdns_bench_action_free(action);
+    }
+    return NULL;
+}
+
+int main(int argc, char **argv)
+{
+    int iterations = argc > 1 ? atoi(argv[1]) : 1000000;
+    int ret = 0;
+
+    mdns_bench_init_di();
+    if (mdns_init()) {
+        abort();
+    }
+
+    // post: one RX action per packet, released after it is handled
+    unsigned long allocs = s_allocs;
+    int failed = 0;
+    double start = now_us();
+    for (int i = 0; i < iterations; i++) {
+        if (_mdns_send_rx_action(new_packet()) != ESP_OK) {
+            failed++;
+            continue;
+        }
+        mdns_action_t *a = NULL;
+        GetLastItem(&a);
+        mdns_bench_free_action(a);
+    }
+    double elapsed = now_us() - start;
+    allocs = s_allocs - allocs;
+    printf("%-8s %-10s %-8s %-14s %-10s\n", "run", "actions", "failed", "allocs/action", "[ns/action]");
+    printf("%-8s %-10d %-8d %-14.2f %-10.1f\n", "post", iterations, failed, (double)allocs / iterations,
+           elapsed * 1e3 / iterations);
+    ret |= failed != 0;
+
+    // threads: the freelist under contention
+    printf("\n%-8s %-10s %-8s %-14s\n", "threads", "actions", "errors", "[Mactions/s]");
+    for (int threads = 1; threads <= BENCH_MAX_THREADS; threads *= 2) {
+        pthread_t tid[BENCH_MAX_THREADS];
+        worker_t workers[BENCH_MAX_THREADS];
+        int errors = 0;
+        start = now_us();
+        for (int t = 0; t < threads; t++) {
+            workers[t] = (worker_t) {
+                .iterations = iterations
+            };
+            pthread_create(&tid[t], NULL, worker, &workers[t]);
+        }
+        for (int t = 0; t < threads; t++) {
+            pthread_join(tid[t], NULL);
+            errors += workers[t].errors;
+        }
+        elapsed = now_us() - start;
+        printf("%-8d %-10d %-8d %-14.1f\n", threads, threads * iterations, errors, threads * iterations / elapsed);
+        if (errors || _mdns_server->action_pool.in_use) {
+            printf("FAIL: %d actions shared or refused, %u not returned\n", errors, _mdns_server->action_pool.in_use);
+            ret = 1;
+        }
+    }
+
+    // exhaust: more actions than the pool holds, without touching the heap
+    mdns_action_t *taken[MDNS_ACTION_POOL_LEN + BENCH_EXTRA];
+    int count = 0;
+    uint32_t exhausted = _mdns_server->action_pool.exhausted;
+    allocs = s_allocs;
+    for (int i = 0; i < MDNS_ACTION_POOL_LEN + BENCH_EXTRA; i++) {
+        if ((taken[count] = mdns_bench_action_alloc()) != NULL) {
+            count++;
+        }
+    }
+    exhausted = _mdns_server->action_pool.exhausted - exhausted;
+    printf("\n%-8s %-10s %-8s %-10s %-6s %-6s\n", "run", "pool", "taken", "exhausted", "peak", "allocs");
+    printf("%-8s %-10d %-8d %-10u %-6u %-6lu\n", "exhaust", MDNS_ACTION_POOL_LEN, count, exhausted,
+           _mdns_server->action_pool.peak, s_allocs - allocs);
+    if (count != MDNS_ACTION_POOL_LEN || exhausted != BENCH_EXTRA || s_allocs != allocs) {
+        printf("FAIL: pool of %d gave %d actions\n", MDNS_ACTION_POOL_LEN, count);
+        ret = 1;
+    }
+    while (count) {
+        mdns_bench_action_free(taken[--count]);
+    }
+
+    ForceTaskDelete();
+    mdns_free();
+    return ret;
+}
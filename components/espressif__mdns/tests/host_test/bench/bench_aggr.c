@@ -0,0 +1,305 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+/*
+ * Aggregation of the answers to concurrent queries
+ *
+ * 1, 2, 4 and 8 controllers query the responder (4 operational instances of _matter._tcp) one after
+ * the other: even ones browse _matter._tcp, odd ones resolve one instance. The burst sends the queries
+ * 5 ms apart, within the delay of the shared answers, the spaced run 250 ms apart. Every answer record
+ * of a query must leave after it, and no packet may hold a record twice. Reports the packets and bytes
+ * sent and the aggregation counters.
+ *
+ * Usage: bench_aggr
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp32_mock.h"
+#include "mdns.h"
+#include "mdns_private.h"
+#include "bench_util.h"
+
+void mdns_bench_init_di(void);
+int mdns_bench_clear_tx_queue(void);
+void mdns_parse_packet(mdns_rx_packet_t *packet);
+extern mdns_server_t *_mdns_server;
+
+#define BENCH_INSTANCES     4
+#define BENCH_MAX_QUERIES   8
+#define BENCH_MAX_RECORDS   64
+#define BURST_GAP_MS        5
+#define SPACED_GAP_MS       250
+
+typedef struct {
+    uint16_t type;
+    char name[128];
+} record_t;
+
+typedef struct {
+    uint32_t packets;
+    uint64_t bytes;
+    uint32_t merged;
+    uint32_t deduplicated;
+    int errors;
+} result_t;
+
+static record_t s_sent[BENCH_MAX_RECORDS * 4];
+static int s_sent_count;
+
+static uint16_t read_u16(const uint8_t *p)
+{
+    return (p[0] << 8) | p[1];
+}
+
+// Decodes a possibly compressed name to dotted form, returns the position after it or NULL
+static const uint8_t *read_name(const uint8_t *packet, size_t len, const uint8_t *p, char *out, size_t out_len)
+{
+    const uint8_t *next = NULL;
+    size_t pos = 0;
+    int jumps = 0;
+    while (p < packet + len && *p) {
+        if ((*p & 0xC0) == 0xC0) {
+            if (p + 1 >= packet + len || ++jumps > 16) {
+                return NULL;
+            }
+            if (!next) {
+                next = p + 2;
+            }
+            p = packet + (((p[0] & 0x3F) << 8) | p[1]);
+            continue;
+        }
+        size_t label = *p++;
+        if (p + label > packet + len || pos + label + 2 > out_len) {
+            return NULL;
+        }
+        memcpy(out + pos, p, label);
+        pos += label;
+        out[pos++] = '.';
+        p += label;
+    }
+    if (p >= packet + len) {
+        return NULL;
+    }
+    out[pos] = 0;
+    return next ? next : p + 1;
+}
+
+// Collects the records of the packet just sent, fails if one of them appears twice
+static int collect_sent(void)
+{
+    const uint8_t *packet = g_tx_packet;
+    size_t len = g_tx_packet_len;
+    int records = read_u16(packet + MDNS_HEAD_ANSWERS_OFFSET) + read_u16(packet + MDNS_HEAD_SERVERS_OFFSET)
+                  + read_u16(packet + MDNS_HEAD_ADDITIONAL_OFFSET);
+    const uint8_t *p = packet + MDNS_HEAD_LEN;
+    int first = s_sent_count;
+    for (int i = 0; i < records; i++) {
+        record_t *r = &s_sent[s_sent_count];
+        p = read_name(packet, len, p, r->name, sizeof(r->name));
+        if (!p || p + MDNS_DATA_OFFSET > packet + len) {
+            return 1;
+        }
+        r->type = read_u16(p + MDNS_TYPE_OFFSET);
+        if (r->type == MDNS_TYPE_PTR) {
+            // instances share the owner name of their PTR record, tell them by the target
+            size_t owner = strlen(r->name);
+            r->name[owner++] = '>';
+            if (!read_name(packet, len, p + MDNS_DATA_OFFSET, r->name + owner, sizeof(r->name) - owner)) {
+                return 1;
+            }
+        }
+        p += MDNS_DATA_OFFSET + read_u16(p + MDNS_LEN_OFFSET);
+        for (int j = first; j < s_sent_count; j++) {
+            if (s_sent[j].type == r->type && !strcmp(s_sent[j].name, r->name)) {
+                return 1;
+            }
+        }
+        if (s_sent_count < (int)(sizeof(s_sent) / sizeof(s_sent[0])) - 1) {
+            s_sent_count++;
+        }
+    }
+    return 0;
+}
+
+static bool was_sent(uint16_t type, const char *name, int from)
+{
+    for (int i = from; i < s_sent_count; i++) {
+        if (s_sent[i].type == type && !strcmp(s_sent[i].name, name)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static int s_collect_errors;
+
+// Runs the actions of a timer firing, collecting what they send
+static void run_and_collect(void)
+{
+    uint32_t sent = g_tx_packet_count;
+    run_actions();
+    if (g_tx_packet_count != sent) {
+        s_collect_errors += collect_sent();
+    }
+}
+
+// Fires the timer until the clock reaches until_ms, collecting what is sent
+static int fire_and_collect(uint32_t until_ms)
+{
+    s_collect_errors = 0;
+    fire_timer_until(until_ms, run_and_collect);
+    return s_collect_errors;
+}
+
+static void put_question(uint8_t *packet, uint16_t *len, const char *instance, uint16_t type)
+{
+    if (instance) {
+        put_label(packet, len, instance);
+    }
+    put_label(packet, len, "_matter");
+    put_label(packet, len, "_tcp");
+    put_label(packet, len, "local");
+    packet[(*len)++] = 0;
+    packet[(*len)++] = type >> 8;
+    packet[(*len)++] = type & 0xFF;
+    packet[(*len)++] = 0x00;
+    packet[(*len)++] = 0x01;
+}
+
+static void instance_name(int i, char *out, size_t len)
+{
+    snprintf(out, len, "2906C908D115D362-8FC77724%08X", i);
+}
+
+static void send_query(int controller)
+{
+    uint8_t data[256] = { 0 };
+    uint16_t len = MDNS_HEAD_LEN;
+    char instance[40];
+    if (controller % 2 == 0) {
+        put_question(data, &len, NULL, MDNS_TYPE_PTR);
+        data[MDNS_HEAD_QUESTIONS_OFFSET + 1] = 1;
+    } else {
+        instance_name(controller / 2 % BENCH_INSTANCES, instance, sizeof(instance));
+        put_question(data, &len, instance, MDNS_TYPE_SRV);
+        put_question(data, &len, instance, MDNS_TYPE_TXT);
+        data[MDNS_HEAD_QUESTIONS_OFFSET + 1] = 2;
+    }
+    struct pbuf pb = { .payload = data, .tot_len = len, .len = len };
+    mdns_rx_packet_t packet = {
+        .pb = &pb,
+        .ip_protocol = MDNS_IP_PROTOCOL_V4,
+        .src_port = MDNS_SERVICE_PORT,
+        .multicast = 1,
+    };
+    packet.src.type = ESP_IPADDR_TYPE_V4;
+    packet.src.u_addr.ip4.addr = 0x0A01A8C0 + (controller << 24);   // 192.168.1.10 + controller
+    mdns_parse_packet(&packet);
+    run_actions();
+}
+
+// Checks that the answers to the query of the controller were sent after it
+static int check_answered(int controller, int from)
+{
+    char name[128];
+    if (controller % 2 == 0) {
+        for (int i = 0; i < BENCH_INSTANCES; i++) {
+            strcpy(name, "_matter._tcp.local.>");
+            instance_name(i, name + strlen(name), sizeof(name) - strlen(name));
+            strcat(name, "._matter._tcp.local.");
+            if (!was_sent(MDNS_TYPE_PTR, name, from)) {
+                return 1;
+            }
+        }
+        return 0;
+    }
+    instance_name(controller / 2 % BENCH_INSTANCES, name, sizeof(name));
+    strcat(name, "._matter._tcp.local.");
+    return !was_sent(MDNS_TYPE_SRV, name, from) || !was_sent(MDNS_TYPE_TXT, name, from);
+}
+
+static result_t run(int controllers, uint32_t gap_ms, uint32_t start_ms)
+{
+    result_t res = { 0 };
+    int sent_from[BENCH_MAX_QUERIES];
+    uint32_t packets = g_tx_packet_count;
+    uint64_t bytes = g_tx_bytes;
+    _mdns_server->aggregated.packets = 0;
+    _mdns_server->aggregated.records = 0;
+    s_sent_count = 0;
+
+    for (int c = 0; c < controllers; c++) {
+        res.errors += fire_and_collect(start_ms + c * gap_ms);
+        sent_from[c] = s_sent_count;
+        send_query(c);
+    }
+    res.errors += fire_and_collect(start_ms + controllers * gap_ms + 1000);
+    for (int c = 0; c < controllers; c++) {
+        res.errors += check_answered(c, sent_from[c]);
+    }
+    res.packets = g_tx_packet_count - packets;
+    res.bytes = g_tx_bytes - bytes;
+    res.merged = _mdns_server->aggregated.packets;
+    res.deduplicated = _mdns_server->aggregated.records;
+    return res;
+}
+
+int main(int argc, char **argv)
+{
+    const int steps[] = { 1, 2, 4, 8 };
+    mdns_txt_item_t txt[] = { {"SII", "5000"}, {"SAI", "300"}, {"T", "1"} };
+    uint32_t start_ms = 1000;
+    int ret = 0;
+
+    mdns_bench_init_di();
+    if (mdns_init() || mdns_hostname_set("bench-host")) {
+        abort();
+    }
+    run_actions();
+    for (int i = 0; i < BENCH_INSTANCES; i++) {
+        char instance[40];
+        instance_name(i, instance, sizeof(instance));
+        if (mdns_service_add(instance, "_matter", "_tcp", 5540, txt, 3)) {
+            abort();
+        }
+        run_actions();
+    }
+    for (int i = 0; i < MDNS_MAX_INTERFACES; i++) {
+        for (int j = 0; j < MDNS_IP_PROTOCOL_MAX; j++) {
+            mdns_pcb_t *pcb = &_mdns_server->interfaces[i].pcbs[j];
+            free(pcb->probe_services);
+            pcb->probe_services = NULL;
+            pcb->probe_services_len = 0;
+            pcb->probe_running = false;
+            pcb->state = PCB_RUNNING;
+        }
+    }
+    mdns_bench_clear_tx_queue();
+    g_tick_step = 0;
+
+    printf("%-12s %-8s %-8s %-8s %-9s %-8s %-8s\n", "controllers", "run", "queries", "packets", "bytes", "merged", "dedup");
+    for (size_t s = 0; s < sizeof(steps) / sizeof(steps[0]); s++) {
+        int n = steps[s];
+        result_t spaced = run(n, SPACED_GAP_MS, start_ms);
+        start_ms += n * SPACED_GAP_MS + 2000;
+        result_t burst = run(n, BURST_GAP_MS, start_ms);
+        start_ms += n * BURST_GAP_MS + 2000;
+        printf("%-12d %-8s %-8d %-8u %-9llu %-8u %-8u\n", n, "spaced", n, spaced.packets,
+               (unsigned long long)spaced.bytes, spaced.merged, spaced.deduplicated);
+        printf("%-12d %-8s %-8d %-8u %-9llu %-8u %-8u\n", n, "burst", n, burst.packets,
+               (unsigned long long)burst.bytes, burst.merged, burst.deduplicated);
+        if (spaced.errors || burst.errors) {
+            printf("FAIL: %d answers missing or records repeated with %d controllers\n", spaced.errors + burst.errors, n);
+            ret = 1;
+        }
+        if (spaced.merged || (n > 1 && !burst.merged)) {
+            printf("FAIL: %u spaced and %u burst answers merged with %d controllers\n", spaced.merged, burst.merged, n);
+            ret = 1;
+        }
+    }
+    return ret;
+}
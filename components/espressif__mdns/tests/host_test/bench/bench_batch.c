@@ -0,0 +1,233 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+/*
+ * Bulk service registration
+ *
+ * Registers 64 services on running PCBs, one by one with 0, 50 and 200 ms between the calls (the application
+ * doing its own work in between), and through one mdns_service_batch_begin/add/commit. The one-shot timer is
+ * fired on a simulated clock until every PCB is running again. It reports:
+ * - register:  CPU time of the registration calls
+ * - announced: from the first call to the first announce on every PCB holding the last service
+ * - running:   from the first call to the end of the third announce on every PCB
+ * - the probe and announce packets and bytes sent, and the services whose SRV record was announced
+ *
+ * Then it checks that services added to a batch for our host take the hostname set before the commit.
+ *
+ * Usage: bench_batch
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp32_mock.h"
+#include "mdns.h"
+#include "mdns_private.h"
+#include "bench_util.h"
+
+void mdns_bench_init_di(void);
+int mdns_bench_clear_tx_queue(void);
+extern mdns_server_t *_mdns_server;
+
+#define BENCH_SERVICES  64
+#define BENCH_LIMIT_MS  60000
+
+static int s_probes;
+static int s_announces;
+static size_t s_bytes;
+static bool s_announced[BENCH_SERVICES];
+
+static uint16_t read_u16(const uint8_t *p)
+{
+    return (p[0] << 8) | p[1];
+}
+
+// Skips a possibly compressed name, returns the position after it or NULL
+static const uint8_t *skip_name(const uint8_t *packet, size_t len, const uint8_t *p)
+{
+    while (p < packet + len && *p) {
+        if ((*p & 0xC0) == 0xC0) {
+            return p + 2 <= packet + len ? p + 2 : NULL;
+        }
+        p += *p + 1;
+    }
+    return p < packet + len ? p + 1 : NULL;
+}
+
+// Marks the services whose SRV record is an answer of the response, the instance label is "Bench Node NN"
+static void capture(const uint8_t *data, size_t len)
+{
+    s_bytes += len;
+    if (len < MDNS_HEAD_LEN) {
+        return;
+    }
+    if (!(read_u16(data + MDNS_HEAD_FLAGS_OFFSET) & MDNS_FLAGS_QUERY_REPSONSE)) {
+        s_probes++;
+        return;
+    }
+    s_announces++;
+    const uint8_t *p = data + MDNS_HEAD_LEN;
+    int questions = read_u16(data + MDNS_HEAD_QUESTIONS_OFFSET);
+    int answers = read_u16(data + MDNS_HEAD_ANSWERS_OFFSET);
+    for (int i = 0; i < questions && p; i++) {
+        p = skip_name(data, len, p);
+        p = p ? p + 4 : NULL;
+    }
+    for (int i = 0; i < answers && p; i++) {
+        const uint8_t *name = p;
+        p = skip_name(data, len, p);
+        if (!p || p + MDNS_DATA_OFFSET > data + len) {
+            return;
+        }
+        while ((*name & 0xC0) == 0xC0) {
+            name = data + (((name[0] & 0x3F) << 8) | name[1]);
+        }
+        int service = -1;
+        if (read_u16(p) == MDNS_TYPE_SRV && *name == 13 && !memcmp(name + 1, "Bench Node ", 11)) {
+            service = (name[12] - '0') * 10 + name[13] - '0';
+        }
+        if (service >= 0 && service < BENCH_SERVICES) {
+            s_announced[service] = true;
+        }
+        p += MDNS_DATA_OFFSET + read_u16(p + MDNS_LEN_OFFSET);
+    }
+}
+
+static bool all_pcbs(bool announced)
+{
+    for (int i = 0; i < MDNS_MAX_INTERFACES; i++) {
+        for (int j = 0; j < MDNS_IP_PROTOCOL_MAX; j++) {
+            mdns_pcb_state_t state = _mdns_server->interfaces[i].pcbs[j].state;
+            if (announced ? state < PCB_ANNOUNCE_2 : state != PCB_RUNNING) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static void service_args(int i, char *instance, size_t instance_len, char *service, size_t service_len)
+{
+    snprintf(instance, instance_len, "Bench Node %02d", i);
+    snprintf(service, service_len, "_bench%02d", i);
+}
+
+static int run(const char *scenario, int gap_ms)
+{
+    mdns_txt_item_t txt[] = { {"board", "esp32c6"}, {"path", "/"} };
+    char instance[32];
+    char service[16];
+    int ret = 0;
+
+    for (int i = 0; i < MDNS_MAX_INTERFACES; i++) {
+        for (int j = 0; j < MDNS_IP_PROTOCOL_MAX; j++) {
+            _mdns_server->interfaces[i].pcbs[j].state = PCB_RUNNING;
+        }
+    }
+    mdns_bench_clear_tx_queue();
+    s_probes = s_announces = 0;
+    s_bytes = 0;
+    memset(s_announced, 0, sizeof(s_announced));
+    uint32_t start = g_tick_count;
+    double cpu = 0;
+
+    if (gap_ms < 0) {
+        double t0 = now_us();
+        mdns_service_batch_t *batch = mdns_service_batch_begin();
+        for (int i = 0; batch && i < BENCH_SERVICES; i++) {
+            service_args(i, instance, sizeof(instance), service, sizeof(service));
+            if (mdns_service_batch_add(batch, instance, service, i % 2 ? "_udp" : "_tcp", NULL, 1000 + i, txt, 2)) {
+                abort();
+            }
+        }
+        if (!batch || mdns_service_batch_commit(batch)) {
+            abort();
+        }
+        cpu = now_us() - t0;
+    } else {
+        for (int i = 0; i < BENCH_SERVICES; i++) {
+            service_args(i, instance, sizeof(instance), service, sizeof(service));
+            double t0 = now_us();
+            if (mdns_service_add(instance, service, i % 2 ? "_udp" : "_tcp", 1000 + i, txt, 2)) {
+                abort();
+            }
+            cpu += now_us() - t0;
+            fire_until(g_tick_count + gap_ms);
+        }
+    }
+
+    uint32_t announced = 0;
+    while (!all_pcbs(false) && g_tick_count - start < BENCH_LIMIT_MS) {
+        fire_until(g_tick_count + 1);
+        if (!announced && all_pcbs(true)) {
+            announced = g_tick_count - start;
+        }
+    }
+    int services = 0;
+    for (int i = 0; i < BENCH_SERVICES; i++) {
+        services += s_announced[i];
+    }
+    printf("%-14s %-13.1f %-13u %-11u %-7d %-10d %-7zu %-9d\n", scenario, cpu, announced, g_tick_count - start, s_probes,
+           s_announces, s_bytes, services);
+    if (!all_pcbs(false) || services != BENCH_SERVICES) {
+        printf("FAIL: %d of %d services announced\n", services, BENCH_SERVICES);
+        ret = 1;
+    }
+    mdns_service_remove_all();
+    mdns_bench_clear_tx_queue();
+    return ret;
+}
+
+// A hostname set between the add and the commit must be the one the batch registers
+static int check_hostname_change(void)
+{
+    int ret = 0;
+    mdns_service_batch_t *batch = mdns_service_batch_begin();
+    if (!batch || mdns_service_batch_add(batch, "Renamed Host", "_late", "_tcp", NULL, 80, NULL, 0)
+            || mdns_service_batch_add(batch, "Explicit Host", "_late", "_udp", "bench-host", 80, NULL, 0)
+            || mdns_service_batch_add(batch, "Upper Case Host", "_case", "_tcp", "BENCH-HOST", 80, NULL, 0)) {
+        abort();
+    }
+    if (mdns_hostname_set("bench-host-2")) {
+        abort();
+    }
+    run_actions();
+    if (mdns_service_batch_commit(batch) || !mdns_service_exists("_late", "_tcp", "bench-host-2")
+            || !mdns_service_exists("_late", "_udp", "bench-host-2") || !mdns_service_exists("_case", "_tcp", "bench-host-2")
+            || mdns_service_exists("_late", "_tcp", "bench-host")) {
+        printf("FAIL: batch services not registered on the new hostname\n");
+        ret = 1;
+    }
+    mdns_service_remove_all();
+    mdns_bench_clear_tx_queue();
+    return ret;
+}
+
+int main(int argc, char **argv)
+{
+    int ret = 0;
+
+    mdns_bench_init_di();
+    if (mdns_init() || mdns_hostname_set("bench-host")) {
+        abort();
+    }
+    run_actions();
+    g_tick_step = 0;
+    g_tick_count = 1000;
+    g_tx_hook = capture;
+
+    printf("%-14s %-13s %-13s %-11s %-7s %-10s %-7s %-9s\n", "registration", "register[us]", "announced[ms]", "running[ms]",
+           "probes", "announces", "bytes", "services");
+    ret |= run("one by one", 0);
+    ret |= run("every 50 ms", 50);
+    ret |= run("every 200 ms", 200);
+    ret |= run("batch", -1);
+    ret |= check_hostname_change();
+
+    g_tx_hook = NULL;
+    ForceTaskDelete();
+    mdns_free();
+    return ret;
+}
@@ -0,0 +1,458 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+/*
+ * Browse notifications with 200 churning Matter nodes
+ *
+ * 200 nodes announce their operational instance (PTR, SRV, TXT and A). Then every 10 s for 20 rounds, all
+ * present nodes announce again, 10% of them with one TXT byte changed, 5% leave with a goodbye and the nodes
+ * that left the round before come back. At the end the nodes go silent and the SRV and A records expire.
+ *
+ * The same traffic is browsed with mdns_browse_new() (mdns_result_t lists) and with mdns_browse_delta_new()
+ * (record deltas). It reports per received packet the time spent in mdns (parse and notification), the heap
+ * allocations of mdns (counted by wrapping mdns_mem_malloc() and mdns_mem_calloc() at link time, the cache
+ * included), the notifier calls and the results or deltas they got. The delta notifier rebuilds the state of
+ * every node, the bench fails if it differs from what the nodes announced.
+ *
+ * Then it checks that mdns_browse_delta_new() returns NULL for a service type browsed already, or posted to be,
+ * and that records expiring one after the other are removed on time with no other traffic.
+ *
+ * Usage: bench_browse
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp32_mock.h"
+#include "mdns.h"
+#include "mdns_private.h"
+#include "bench_util.h"
+
+void mdns_bench_init_di(void);
+int mdns_bench_clear_tx_queue(void);
+void mdns_bench_cache_clear(void);
+void mdns_parse_packet(mdns_rx_packet_t *packet);
+extern mdns_server_t *_mdns_server;
+
+#define NODES               200
+#define ROUNDS              20
+#define ROUND_MS            10000
+#define SRV_TTL             120
+#define PTR_TTL             4500
+#define MAX_RECORDS         1024
+
+typedef struct {
+    bool present;
+    int txt_version;
+} node_t;
+
+// State of a node as rebuilt from the deltas
+typedef struct {
+    bool ptr;
+    bool srv;
+    bool txt;
+    bool a;
+    uint16_t port;
+    char txt_data[64];
+    uint16_t txt_len;
+} seen_t;
+
+static node_t s_nodes[NODES];
+static seen_t s_seen[NODES];
+static unsigned long s_allocs;
+static unsigned long s_calls;
+static unsigned long s_items;
+static int s_errors;
+
+void *__real_mdns_mem_malloc(size_t size);
+void *__real_mdns_mem_calloc(size_t num, size_t size);
+
+void *__wrap_mdns_mem_malloc(size_t size)
+{
+    s_allocs++;
+    return __real_mdns_mem_malloc(size);
+}
+
+void *__wrap_mdns_mem_calloc(size_t num, size_t size)
+{
+    s_allocs++;
+    return __real_mdns_mem_calloc(num, size);
+}
+
+static void instance_name(int node, char *out, size_t len)
+{
+    snprintf(out, len, "2906C908D115D362-8FC77724%08X", node);
+}
+
+static void host_name(int node, char *out, size_t len)
+{
+    snprintf(out, len, "DCA632%010X", node);
+}
+
+static int txt_data(int node, char *out)
+{
+    char txt[3][16];
+    int len = 0;
+    snprintf(txt[0], sizeof(txt[0]), "SII=5000");
+    snprintf(txt[1], sizeof(txt[1]), "SAI=300");
+    snprintf(txt[2], sizeof(txt[2]), "T=%d", s_nodes[node].txt_version % 10);
+    for (int i = 0; i < 3; i++) {
+        out[len++] = strlen(txt[i]);
+        memcpy(out + len, txt[i], strlen(txt[i]));
+        len += strlen(txt[i]);
+    }
+    return len;
+}
+
+static void put_u16(uint8_t *packet, uint16_t *len, uint16_t v)
+{
+    packet[(*len)++] = v >> 8;
+    packet[(*len)++] = v & 0xFF;
+}
+
+static void put_name(uint8_t *packet, uint16_t *len, const char *l1, const char *l2, const char *l3)
+{
+    const char *labels[] = { l1, l2, l3, "local" };
+    for (int i = 0; i < 4; i++) {
+        if (labels[i]) {
+            size_t l = strlen(labels[i]);
+            packet[(*len)++] = l;
+            memcpy(packet + *len, labels[i], l);
+            *len += l;
+        }
+    }
+    packet[(*len)++] = 0;
+}
+
+static void put_head(uint8_t *packet, uint16_t *len, uint16_t type, uint16_t class, uint32_t ttl)
+{
+    put_u16(packet, len, type);
+    put_u16(packet, len, class);
+    put_u16(packet, len, ttl >> 16);
+    put_u16(packet, len, ttl & 0xFFFF);
+}
+
+static void end_data(uint8_t *packet, uint16_t len, uint16_t at)
+{
+    packet[at] = (len - at - 2) >> 8;
+    packet[at + 1] = (len - at - 2) & 0xFF;
+}
+
+// Announces the node, or sends its goodbye, returns the time spent in mdns
+static double announce(int node, bool bye)
+{
+    uint8_t data[512] = { 0 };
+    uint16_t len = MDNS_HEAD_LEN;
+    char instance[40], host[24], txt[64];
+    instance_name(node, instance, sizeof(instance));
+    host_name(node, host, sizeof(host));
+    data[MDNS_HEAD_FLAGS_OFFSET] = MDNS_FLAGS_QR_AUTHORITATIVE >> 8;
+    data[MDNS_HEAD_ANSWERS_OFFSET + 1] = 4;
+
+    put_name(data, &len, "_matter", "_tcp", NULL);
+    put_head(data, &len, MDNS_TYPE_PTR, MDNS_CLASS_IN, bye ? 0 : PTR_TTL);
+    uint16_t at = len;
+    len += 2;
+    put_name(data, &len, instance, "_matter", "_tcp");
+    end_data(data, len, at);
+
+    put_name(data, &len, instance, "_matter", "_tcp");
+    put_head(data, &len, MDNS_TYPE_SRV, MDNS_CLASS_IN_FLUSH_CACHE, bye ? 0 : SRV_TTL);
+    at = len;
+    len += 2;
+    put_u16(data, &len, 0);
+    put_u16(data, &len, 0);
+    put_u16(data, &len, 5540);
+    put_name(data, &len, host, NULL, NULL);
+    end_data(data, len, at);
+
+    put_name(data, &len, instance, "_matter", "_tcp");
+    put_head(data, &len, MDNS_TYPE_TXT, MDNS_CLASS_IN_FLUSH_CACHE, bye ? 0 : PTR_TTL);
+    int txt_len = txt_data(node, txt);
+    put_u16(data, &len, txt_len);
+    memcpy(data + len, txt, txt_len);
+    len += txt_len;
+
+    put_name(data, &len, host, NULL, NULL);
+    put_head(data, &len, MDNS_TYPE_A, MDNS_CLASS_IN_FLUSH_CACHE, bye ? 0 : SRV_TTL);
+    put_u16(data, &len, 4);
+    const uint8_t addr[] = { 10, 0, node / 256, node % 256 };
+    memcpy(data + len, addr, sizeof(addr));
+    len += sizeof(addr);
+
+    struct pbuf pb = { .payload = data, .tot_len = len, .len = len };
+    mdns_rx_packet_t packet = {
+        .pb = &pb,
+        .ip_protocol = MDNS_IP_PROTOCOL_V4,
+        .src_port = MDNS_SERVICE_PORT,
+        .multicast = 1,
+    };
+    packet.src.type = ESP_IPADDR_TYPE_V4;
+    memcpy(&packet.src.u_addr.ip4.addr, addr, sizeof(addr));
+    double t0 = now_us();
+    mdns_parse_packet(&packet);
+    run_actions();
+    return now_us() - t0;
+}
+
+static void result_notifier(mdns_result_t *result)
+{
+    s_calls++;
+    s_items++;
+}
+
+static int node_of(const char *name, bool host)
+{
+    char expected[40];
+    int node = (int)strtol(name + strlen(name) - 8, NULL, 16);
+    if (node < 0 || node >= NODES) {
+        return -1;
+    }
+    if (host) {
+        host_name(node, expected, sizeof(expected));
+    } else {
+        instance_name(node, expected, sizeof(expected));
+    }
+    return strcasecmp(name, expected) ? -1 : node;
+}
+
+static void delta_notifier(const mdns_browse_delta_t *deltas, size_t count, void *arg)
+{
+    s_calls++;
+    s_items += count;
+    for (size_t i = 0; i < count; i++) {
+        const mdns_browse_delta_t *d = &deltas[i];
+        bool host = d->type == MDNS_TYPE_A;
+        int node = node_of(host ? d->hostname : d->instance, host);
+        if (node < 0) {
+            s_errors++;
+            continue;
+        }
+        seen_t *seen = &s_seen[node];
+        bool add = d->op != MDNS_BROWSE_RECORD_REMOVE;
+        switch (d->type) {
+        case MDNS_TYPE_PTR:
+            s_errors += seen->ptr == add;
+            seen->ptr = add;
+            break;
+        case MDNS_TYPE_SRV:
+            s_errors += d->op == MDNS_BROWSE_RECORD_UPDATE ? !seen->srv : seen->srv == add;
+            seen->srv = add;
+            seen->port = d->port;
+            break;
+        case MDNS_TYPE_TXT:
+            s_errors += d->op == MDNS_BROWSE_RECORD_UPDATE ? !seen->txt : seen->txt == add;
+            seen->txt = add;
+            if (add && d->txt_len <= sizeof(seen->txt_data)) {
+                memcpy(seen->txt_data, d->txt, d->txt_len);
+                seen->txt_len = d->txt_len;
+            }
+            break;
+        case MDNS_TYPE_A:
+            s_errors += seen->a == add;
+            seen->a = add;
+            break;
+        default:
+            s_errors++;
+        }
+    }
+}
+
+// Checks the state rebuilt from the deltas, SRV and A records expired when expired is set
+static int check_seen(bool expired)
+{
+    int errors = 0;
+    char txt[64];
+    for (int n = 0; n < NODES; n++) {
+        seen_t *seen = &s_seen[n];
+        bool present = s_nodes[n].present;
+        int txt_len = txt_data(n, txt);
+        errors += seen->ptr != present || seen->txt != present || seen->srv != (present && !expired)
+                  || seen->a != (present && !expired);
+        errors += present && (seen->txt_len != txt_len || memcmp(seen->txt_data, txt, txt_len));
+        errors += present && !expired && seen->port != 5540;
+    }
+    return errors;
+}
+
+static int run(bool delta, uint32_t start_ms)
+{
+    unsigned long packets = 0;
+    double busy = 0;
+    int ret = 0;
+
+    memset(s_nodes, 0, sizeof(s_nodes));
+    memset(s_seen, 0, sizeof(s_seen));
+    mdns_bench_cache_clear();
+    s_calls = s_items = 0;
+    s_errors = 0;
+    fire_until(start_ms);
+    mdns_browse_t *browse = delta ? mdns_browse_delta_new("_matter", "_tcp", MAX_RECORDS, delta_notifier, NULL)
+                            : mdns_browse_new("_matter", "_tcp", result_notifier);
+    if (!browse) {
+        abort();
+    }
+    run_actions();
+    unsigned long allocs = s_allocs;
+
+    for (int n = 0; n < NODES; n++) {
+        s_nodes[n].present = true;
+        busy += announce(n, false);
+        packets++;
+    }
+    srand(1);
+    for (int round = 1; round <= ROUNDS; round++) {
+        fire_until(start_ms + round * ROUND_MS);
+        for (int n = 0; n < NODES; n++) {
+            if (!s_nodes[n].present) {
+                s_nodes[n].present = true;
+                busy += announce(n, false);
+                packets++;
+                continue;
+            }
+            int r = rand() % 100;
+            if (r < 5) {
+                s_nodes[n].present = false;
+                busy += announce(n, true);
+                packets++;
+                continue;
+            }
+            if (r < 15) {
+                s_nodes[n].txt_version++;
+            }
+            busy += announce(n, false);
+            packets++;
+        }
+        if (delta && check_seen(false)) {
+            printf("FAIL: round %d, %d nodes differ\n", round, check_seen(false));
+            ret = 1;
+        }
+    }
+    allocs = s_allocs - allocs;
+    unsigned long calls = s_calls, items = s_items;
+
+    // the nodes go silent, SRV and A records expire
+    fire_until(g_tick_count + (SRV_TTL + 2) * 1000);
+    if (delta && check_seen(true)) {
+        printf("FAIL: %d nodes differ after expiry\n", check_seen(true));
+        ret = 1;
+    }
+    printf("%-8s %-8lu %-12.2f %-14.2f %-10lu %-12lu", delta ? "delta" : "results", packets, busy / packets,
+           (double)allocs / packets, calls, items);
+    if (delta) {
+        printf(" %-10zu %-8u\n", sizeof(mdns_browse_records_t) + MAX_RECORDS * sizeof(mdns_browse_record_t)
+               + MAX_RECORDS * sizeof(uint16_t), browse->records->dropped);
+    } else {
+        printf(" %-10s %-8s\n", "-", "-");
+    }
+    if (s_errors) {
+        printf("FAIL: %d deltas inconsistent with the state\n", s_errors);
+        ret = 1;
+    }
+    mdns_browse_delete("_matter", "_tcp");
+    run_actions();
+    return ret;
+}
+
+// A delta browse of a browsed service type would be freed by the mDNS task, it must be refused at once
+static int check_duplicates(void)
+{
+    int ret = 0;
+    if (!mdns_browse_new("_matter", "_tcp", result_notifier)
+            || mdns_browse_delta_new("_matter", "_tcp", MAX_RECORDS, delta_notifier, NULL)) {
+        printf("FAIL: delta browse of a posted browse\n");
+        ret = 1;
+    }
+    run_actions();
+    if (mdns_browse_delta_new("_matter", "_tcp", MAX_RECORDS, delta_notifier, NULL)) {
+        printf("FAIL: delta browse of a running browse\n");
+        ret = 1;
+    }
+    mdns_browse_delete("_matter", "_tcp");
+    run_actions();
+    mdns_browse_t *browse = mdns_browse_delta_new("_matter", "_tcp", MAX_RECORDS, delta_notifier, NULL);
+    if (!browse || mdns_browse_delta_new("_matter", "_tcp", MAX_RECORDS, delta_notifier, NULL)) {
+        printf("FAIL: second delta browse\n");
+        ret = 1;
+    }
+    run_actions();
+    if (browse && _mdns_server->browse != browse) {
+        printf("FAIL: delta browse not running\n");
+        ret = 1;
+    }
+    mdns_browse_delete("_matter", "_tcp");
+    run_actions();
+    return ret;
+}
+
+// Each expiry of a delta browse must schedule the next one: no query of the browse is due to wake the timer
+static int check_expiry(void)
+{
+    int ret = 0;
+    memset(s_nodes, 0, sizeof(s_nodes));
+    memset(s_seen, 0, sizeof(s_seen));
+    mdns_bench_cache_clear();
+    uint32_t start = g_tick_count;
+    if (!mdns_browse_delta_new("_matter", "_tcp", MAX_RECORDS, delta_notifier, NULL)) {
+        abort();
+    }
+    run_actions();
+    // between the queries of the browse at 127 s and 255 s, the SRV and A records expire at 250 s and 252 s
+    fire_until(start + 130000);
+    s_nodes[0].present = true;
+    announce(0, false);
+    fire_until(start + 132000);
+    s_nodes[1].present = true;
+    announce(1, false);
+    fire_until(start + 251000);
+    if (s_seen[0].srv || s_seen[0].a || !s_seen[1].srv || !s_seen[1].a) {
+        printf("FAIL: first expiry\n");
+        ret = 1;
+    }
+    fire_until(start + 253000);
+    if (s_seen[1].srv || s_seen[1].a || !s_seen[1].ptr) {
+        printf("FAIL: second expiry not scheduled\n");
+        ret = 1;
+    }
+    mdns_browse_delete("_matter", "_tcp");
+    run_actions();
+    return ret;
+}
+
+int main(int argc, char **argv)
+{
+    int ret = 0;
+
+    mdns_bench_init_di();
+    if (mdns_init() || mdns_hostname_set("bench-host")) {
+        abort();
+    }
+    run_actions();
+    for (int i = 0; i < MDNS_MAX_INTERFACES; i++) {
+        for (int j = 0; j < MDNS_IP_PROTOCOL_MAX; j++) {
+            mdns_pcb_t *pcb = &_mdns_server->interfaces[i].pcbs[j];
+            free(pcb->probe_services);
+            pcb->probe_services = NULL;
+            pcb->probe_services_len = 0;
+            pcb->probe_running = false;
+            pcb->state = PCB_RUNNING;
+        }
+    }
+    mdns_bench_clear_tx_queue();
+    g_tick_step = 0;
+    g_tick_count = 1000;
+
+    printf("record slot: %zu bytes\n", sizeof(mdns_browse_record_t));
+    printf("%-8s %-8s %-12s %-14s %-10s %-12s %-10s %-8s\n", "browse", "packets", "[us/packet]", "allocs/packet",
+           "notifies", "items", "storage[B]", "dropped");
+    ret |= run(false, 2000);
+    ret |= run(true, g_tick_count + 10000);
+    ret |= check_duplicates();
+    ret |= check_expiry();
+
+    ForceTaskDelete();
+    mdns_free();
+    return ret;
+}
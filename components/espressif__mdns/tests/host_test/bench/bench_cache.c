@@ -0,0 +1,351 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+/*
+ * Cache of remote records fed by unsolicited announcements
+ *
+ * 4, 8 and 16 Matter nodes announce their operational instance (PTR, SRV, TXT and A) every 100 s for
+ * 20 minutes; node 0 goes silent after 10 minutes. The application resolves one node every 5 s (SRV
+ * query, one result), browses the service type with a PTR query every 60 s and opens one mdns_browse_new()
+ * after 50 s. Nothing answers the queries: only the announcements fill the cache.
+ *
+ * Reports the resolves answered from the cache at once, the PTR query results available at once and
+ * the known answers their packets list, the browse notifications, and the cache counters. Fails if the
+ * cache outgrows CONFIG_MDNS_CACHE_SIZE, if a cached result is wrong, if the silent node is still served
+ * after its SRV TTL, or if a live node misses while all nodes fit the cache.
+ *
+ * Usage: bench_cache
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp32_mock.h"
+#include "mdns.h"
+#include "mdns_private.h"
+#include "bench_util.h"
+
+void mdns_bench_init_di(void);
+int mdns_bench_clear_tx_queue(void);
+int mdns_bench_search_known_answers(mdns_search_once_t *search, mdns_if_t tcpip_if, mdns_ip_protocol_t ip_protocol);
+void mdns_bench_cache_clear(void);
+void mdns_parse_packet(mdns_rx_packet_t *packet);
+extern mdns_server_t *_mdns_server;
+
+#define RUN_MS              (20 * 60 * 1000)
+#define STEP_MS             250
+#define ANNOUNCE_MS         100000
+#define SILENT_AFTER_MS     (10 * 60 * 1000)
+#define RESOLVE_MS          5000
+#define RESOLVE_FROM_MS     30000
+#define BROWSE_MS           60000
+#define BROWSE_FROM_MS      45000
+#define BROWSE_NEW_MS       50000
+#define SRV_TTL             120
+#define PTR_TTL             4500
+#define MAX_PENDING         64
+
+typedef struct {
+    uint32_t resolves;
+    uint32_t resolve_hits;
+    uint32_t browses;
+    uint32_t browse_results;
+    uint32_t known_answers;
+    uint32_t notified;
+    uint32_t peak_bytes;
+    int errors;
+} result_t;
+
+static mdns_search_once_t *s_pending[MAX_PENDING];
+static int s_pending_count;
+static uint32_t s_notified;
+
+// Deletes the searches that have finished
+static void reap_searches(void)
+{
+    for (int i = 0; i < s_pending_count;) {
+        if (s_pending[i]->state == SEARCH_OFF) {
+            mdns_query_results_free(s_pending[i]->result);
+            mdns_query_async_delete(s_pending[i]);
+            s_pending[i] = s_pending[--s_pending_count];
+        } else {
+            i++;
+        }
+    }
+}
+
+static void instance_name(int node, char *out, size_t len)
+{
+    snprintf(out, len, "2906C908D115D362-8FC77724%08X", node);
+}
+
+static void host_name(int node, char *out, size_t len)
+{
+    snprintf(out, len, "DCA632%010X", node);
+}
+
+static void put_u16(uint8_t *packet, uint16_t *len, uint16_t v)
+{
+    packet[(*len)++] = v >> 8;
+    packet[(*len)++] = v & 0xFF;
+}
+
+static void put_u32(uint8_t *packet, uint16_t *len, uint32_t v)
+{
+    put_u16(packet, len, v >> 16);
+    put_u16(packet, len, v & 0xFFFF);
+}
+
+// Writes the name, made of up to 3 labels before "local"
+static void put_name(uint8_t *packet, uint16_t *len, const char *l1, const char *l2, const char *l3)
+{
+    const char *labels[] = { l1, l2, l3, "local" };
+    for (int i = 0; i < 4; i++) {
+        if (labels[i]) {
+            size_t l = strlen(labels[i]);
+            packet[(*len)++] = l;
+            memcpy(packet + *len, labels[i], l);
+            *len += l;
+        }
+    }
+    packet[(*len)++] = 0;
+}
+
+static void put_head(uint8_t *packet, uint16_t *len, uint16_t type, uint16_t class, uint32_t ttl)
+{
+    put_u16(packet, len, type);
+    put_u16(packet, len, class);
+    put_u32(packet, len, ttl);
+}
+
+// Fills the 16-bit length of the data started at *len + 2
+static uint16_t begin_data(uint16_t *len)
+{
+    uint16_t at = *len;
+    *len += 2;
+    return at;
+}
+
+static void end_data(uint8_t *packet, uint16_t len, uint16_t at)
+{
+    uint16_t data_len = len - at - 2;
+    packet[at] = data_len >> 8;
+    packet[at + 1] = data_len & 0xFF;
+}
+
+static void announce(int node)
+{
+    uint8_t data[512] = { 0 };
+    uint16_t len = MDNS_HEAD_LEN;
+    char instance[40], host[24];
+    instance_name(node, instance, sizeof(instance));
+    host_name(node, host, sizeof(host));
+    data[MDNS_HEAD_FLAGS_OFFSET] = (MDNS_FLAGS_QR_AUTHORITATIVE) >> 8;
+    data[MDNS_HEAD_ANSWERS_OFFSET + 1] = 4;
+
+    put_name(data, &len, "_matter", "_tcp", NULL);
+    put_head(data, &len, MDNS_TYPE_PTR, MDNS_CLASS_IN, PTR_TTL);
+    uint16_t at = begin_data(&len);
+    put_name(data, &len, instance, "_matter", "_tcp");
+    end_data(data, len, at);
+
+    put_name(data, &len, instance, "_matter", "_tcp");
+    put_head(data, &len, MDNS_TYPE_SRV, MDNS_CLASS_IN_FLUSH_CACHE, SRV_TTL);
+    at = begin_data(&len);
+    put_u16(data, &len, 0);
+    put_u16(data, &len, 0);
+    put_u16(data, &len, 5540);
+    put_name(data, &len, host, NULL, NULL);
+    end_data(data, len, at);
+
+    put_name(data, &len, instance, "_matter", "_tcp");
+    put_head(data, &len, MDNS_TYPE_TXT, MDNS_CLASS_IN_FLUSH_CACHE, PTR_TTL);
+    at = begin_data(&len);
+    const char *txt[] = { "SII=5000", "SAI=300", "T=1" };
+    for (int i = 0; i < 3; i++) {
+        data[len++] = strlen(txt[i]);
+        memcpy(data + len, txt[i], strlen(txt[i]));
+        len += strlen(txt[i]);
+    }
+    end_data(data, len, at);
+
+    put_name(data, &len, host, NULL, NULL);
+    put_head(data, &len, MDNS_TYPE_A, MDNS_CLASS_IN_FLUSH_CACHE, SRV_TTL);
+    put_u16(data, &len, 4);
+    const uint8_t addr[] = { 10, 0, 0, node + 1 };
+    memcpy(data + len, addr, sizeof(addr));
+    len += sizeof(addr);
+
+    struct pbuf pb = { .payload = data, .tot_len = len, .len = len };
+    mdns_rx_packet_t packet = {
+        .pb = &pb,
+        .ip_protocol = MDNS_IP_PROTOCOL_V4,
+        .src_port = MDNS_SERVICE_PORT,
+        .multicast = 1,
+    };
+    packet.src.type = ESP_IPADDR_TYPE_V4;
+    memcpy(&packet.src.u_addr.ip4.addr, addr, sizeof(addr));
+    mdns_parse_packet(&packet);
+    run_actions();
+}
+
+// Checks the cache accounting, returns the bytes in use
+static int check_cache(uint32_t *bytes)
+{
+    uint32_t sum = 0;
+    uint16_t len = 0;
+    for (mdns_cache_record_t *r = _mdns_server->cache.records; r; r = r->next) {
+        sum += r->size;
+        len++;
+    }
+    *bytes = sum;
+    return sum != _mdns_server->cache.bytes || len != _mdns_server->cache.len || sum > MDNS_CACHE_SIZE;
+}
+
+static bool result_is_node(mdns_result_t *r, int node)
+{
+    char host[24];
+    host_name(node, host, sizeof(host));
+    const uint8_t addr[] = { 10, 0, 0, node + 1 };
+    return r->hostname && !strcmp(r->hostname, host) && r->port == 5540
+           && r->addr && !memcmp(&r->addr->addr.u_addr.ip4.addr, addr, sizeof(addr));
+}
+
+static bool node_is_live(int node, uint32_t t)
+{
+    if (node) {
+        return true;
+    }
+    uint32_t last = (SILENT_AFTER_MS - 1) / ANNOUNCE_MS * ANNOUNCE_MS;
+    return t < last + SRV_TTL * 1000;
+}
+
+// all_fit: nothing was evicted so far, a live node must be in the cache
+static void resolve(int node, uint32_t t, bool all_fit, result_t *res)
+{
+    char instance[40];
+    instance_name(node, instance, sizeof(instance));
+    mdns_search_once_t *s = mdns_query_async_new(instance, "_matter", "_tcp", MDNS_TYPE_SRV, 2000, 1, NULL);
+    if (!s) {
+        abort();
+    }
+    run_actions();
+    res->resolves++;
+    bool hit = s->state == SEARCH_OFF && s->result;
+    if (hit) {
+        res->resolve_hits++;
+        res->errors += !result_is_node(s->result, node) || !node_is_live(node, t);
+    } else if (all_fit && node_is_live(node, t)) {
+        res->errors++;
+    }
+    if (s_pending_count == MAX_PENDING) {
+        abort();
+    }
+    s_pending[s_pending_count++] = s;
+}
+
+static void browse_query(result_t *res)
+{
+    mdns_search_once_t *s = mdns_query_async_new(NULL, "_matter", "_tcp", MDNS_TYPE_PTR, 1000, 0, NULL);
+    if (!s) {
+        abort();
+    }
+    run_actions();
+    res->browses++;
+    for (mdns_result_t *r = s->result; r; r = r->next) {
+        res->browse_results++;
+    }
+    res->known_answers += mdns_bench_search_known_answers(s, 0, MDNS_IP_PROTOCOL_V4);
+    s_pending[s_pending_count++] = s;
+}
+
+static void notifier(mdns_result_t *result)
+{
+    s_notified++;
+}
+
+static result_t run(int nodes, uint32_t start_ms)
+{
+    result_t res = { 0 };
+    mdns_browse_t *browse = NULL;
+    mdns_bench_cache_clear();
+    memset(&_mdns_server->cache, 0, sizeof(_mdns_server->cache));
+
+    for (uint32_t t = 0; t <= RUN_MS; t += STEP_MS) {
+        fire_until(start_ms + t);
+        reap_searches();
+        for (int n = 0; n < nodes; n++) {
+            if (t % ANNOUNCE_MS == n * STEP_MS && (n || t < SILENT_AFTER_MS)) {
+                announce(n);
+            }
+        }
+        if (t >= RESOLVE_FROM_MS && t % RESOLVE_MS == 0) {
+            resolve((t - RESOLVE_FROM_MS) / RESOLVE_MS % nodes, t, !_mdns_server->cache.evictions, &res);
+        }
+        if (t >= BROWSE_FROM_MS && (t - BROWSE_FROM_MS) % BROWSE_MS == 0) {
+            browse_query(&res);
+        }
+        if (t == BROWSE_NEW_MS) {
+            s_notified = 0;
+            browse = mdns_browse_new("_matter", "_tcp", notifier);
+            run_actions();
+            res.notified = s_notified;
+        }
+        uint32_t bytes;
+        res.errors += check_cache(&bytes);
+        if (bytes > res.peak_bytes) {
+            res.peak_bytes = bytes;
+        }
+    }
+    mdns_browse_delete("_matter", "_tcp");
+    run_actions();
+    (void)browse;
+    fire_until(start_ms + RUN_MS + 5000);
+    reap_searches();
+    return res;
+}
+
+int main(int argc, char **argv)
+{
+    const int steps[] = { 4, 8, 16 };
+    uint32_t start_ms = 1000;
+    int ret = 0;
+
+    mdns_bench_init_di();
+    if (mdns_init() || mdns_hostname_set("bench-host")) {
+        abort();
+    }
+    run_actions();
+    for (int i = 0; i < MDNS_MAX_INTERFACES; i++) {
+        for (int j = 0; j < MDNS_IP_PROTOCOL_MAX; j++) {
+            mdns_pcb_t *pcb = &_mdns_server->interfaces[i].pcbs[j];
+            free(pcb->probe_services);
+            pcb->probe_services = NULL;
+            pcb->probe_services_len = 0;
+            pcb->probe_running = false;
+            pcb->state = PCB_RUNNING;
+        }
+    }
+    mdns_bench_clear_tx_queue();
+    g_tick_step = 0;
+
+    printf("cache size: %d bytes\n", MDNS_CACHE_SIZE);
+    printf("%-6s %-9s %-9s %-9s %-12s %-10s %-9s %-8s %-8s %-9s %-9s\n", "nodes", "resolves", "hits", "hit[%]",
+           "ptr results", "known-ans", "notified", "peak[B]", "inserts", "evictions", "expired");
+    for (size_t s = 0; s < sizeof(steps) / sizeof(steps[0]); s++) {
+        int n = steps[s];
+        result_t r = run(n, start_ms);
+        start_ms += RUN_MS + 10000;
+        printf("%-6d %-9u %-9u %-9.1f %-12.1f %-10.1f %-9u %-8u %-8u %-9u %-9u\n", n, r.resolves, r.resolve_hits,
+               100.0 * r.resolve_hits / r.resolves, (double)r.browse_results / r.browses,
+               (double)r.known_answers / r.browses, r.notified, r.peak_bytes, _mdns_server->cache.inserts,
+               _mdns_server->cache.evictions, _mdns_server->cache.expirations);
+        if (r.errors) {
+            printf("FAIL: %d wrong or missing cache answers with %d nodes\n", r.errors, n);
+            ret = 1;
+        }
+    }
+    return ret;
+}
@@ -0,0 +1,230 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+/*
+ * MDNS benchmark dependency injection -- preincluded into mdns.c (on top of the fuzzer's mdns_di.h)
+ * to expose the static packet builders to the benchmarks
+ */
+#pragma once
+#include "mdns_di.h"
+
+mdns_tx_packet_t *(*mdns_bench_static_create_announce_packet)(mdns_if_t tcpip_if, mdns_ip_protocol_t ip_protocol,
+                                                              mdns_srv_item_t *services[], size_t len, bool include_ip) = NULL;
+void (*mdns_bench_static_dispatch_tx_packet)(mdns_tx_packet_t *p) = NULL;
+void (*mdns_bench_static_free_tx_packet)(mdns_tx_packet_t *packet) = NULL;
+void (*mdns_bench_static_clear_tx_queue)(void) = NULL;
+mdns_tx_packet_t *(*mdns_bench_static_alloc_packet_default)(mdns_if_t tcpip_if, mdns_ip_protocol_t ip_protocol) = NULL;
+bool (*mdns_bench_static_alloc_answer)(mdns_out_answer_t **destination, uint16_t type, mdns_service_t *service,
+                                       mdns_host_item_t *host, bool flush, bool bye) = NULL;
+void (*mdns_bench_static_schedule_tx_packet)(mdns_tx_packet_t *packet, uint32_t ms_after) = NULL;
+void (*mdns_bench_static_scheduler_run)(void) = NULL;
+void (*mdns_bench_static_remove_scheduled_known_answers)(mdns_parsed_packet_t *parsed_packet) = NULL;
+void (*mdns_bench_static_remove_scheduled_service_packets)(mdns_service_t *service) = NULL;
+uint16_t (*mdns_bench_static_build_tx_packet)(mdns_tx_ctx_t *ctx, mdns_tx_packet_t *p) = NULL;
+const uint8_t *(*mdns_bench_static_parse_fqdn)(const uint8_t *packet, const uint8_t *start, mdns_name_t *name,
+                                               size_t packet_len) = NULL;
+mdns_tx_packet_t *(*mdns_bench_static_create_search_packet)(mdns_search_once_t *search, mdns_if_t tcpip_if,
+                                                            mdns_ip_protocol_t ip_protocol) = NULL;
+void (*mdns_bench_static_cache_clear)(void) = NULL;
+mdns_action_t *(*mdns_bench_static_action_alloc)(void) = NULL;
+void (*mdns_bench_static_action_free)(mdns_action_t *action) = NULL;
+void (*mdns_bench_static_free_action)(mdns_action_t *action) = NULL;
+
+static mdns_tx_packet_t *_mdns_create_announce_packet(mdns_if_t tcpip_if, mdns_ip_protocol_t ip_protocol,
+                                                      mdns_srv_item_t *services[], size_t len, bool include_ip);
+static void _mdns_dispatch_tx_packet(mdns_tx_packet_t *p);
+static void _mdns_free_tx_packet(mdns_tx_packet_t *packet);
+static void _mdns_clear_tx_queue(void);
+static mdns_tx_packet_t *_mdns_alloc_packet_default(mdns_if_t tcpip_if, mdns_ip_protocol_t ip_protocol);
+static bool _mdns_alloc_answer(mdns_out_answer_t **destination, uint16_t type, mdns_service_t *service,
+                               mdns_host_item_t *host, bool flush, bool bye);
+static void _mdns_schedule_tx_packet(mdns_tx_packet_t *packet, uint32_t ms_after);
+static void _mdns_scheduler_run(void);
+static void _mdns_remove_scheduled_known_answers(mdns_parsed_packet_t *parsed_packet);
+static void _mdns_remove_scheduled_service_packets(mdns_service_t *service);
+static uint16_t _mdns_build_tx_packet(mdns_tx_ctx_t *ctx, mdns_tx_packet_t *p);
+static const uint8_t *_mdns_parse_fqdn(const uint8_t *packet, const uint8_t *start, mdns_name_t *name, size_t packet_len);
+static mdns_tx_packet_t *_mdns_create_search_packet(mdns_search_once_t *search, mdns_if_t tcpip_if, mdns_ip_protocol_t ip_protocol);
+static void _mdns_cache_clear(void);
+static mdns_action_t *_mdns_action_alloc(void);
+static void _mdns_action_free(mdns_action_t *action);
+static void _mdns_free_action(mdns_action_t *action);
+extern mdns_server_t *_mdns_server;
+
+void mdns_bench_init_di(void)
+{
+    mdns_test_init_di();
+    mdns_bench_static_create_announce_packet = _mdns_create_announce_packet;
+    mdns_bench_static_dispatch_tx_packet = _mdns_dispatch_tx_packet;
+    mdns_bench_static_free_tx_packet = _mdns_free_tx_packet;
+    mdns_bench_static_clear_tx_queue = _mdns_clear_tx_queue;
+    mdns_bench_static_alloc_packet_default = _mdns_alloc_packet_default;
+    mdns_bench_static_alloc_answer = _mdns_alloc_answer;
+    mdns_bench_static_schedule_tx_packet = _mdns_schedule_tx_packet;
+    mdns_bench_static_scheduler_run = _mdns_scheduler_run;
+    mdns_bench_static_remove_scheduled_known_answers = _mdns_remove_scheduled_known_answers;
+    mdns_bench_static_remove_scheduled_service_packets = _mdns_remove_scheduled_service_packets;
+    mdns_bench_static_build_tx_packet = _mdns_build_tx_packet;
+    mdns_bench_static_parse_fqdn = _mdns_parse_fqdn;
+    mdns_bench_static_create_search_packet = _mdns_create_search_packet;
+    mdns_bench_static_cache_clear = _mdns_cache_clear;
+    mdns_bench_static_action_alloc = _mdns_action_alloc;
+    mdns_bench_static_action_free = _mdns_action_free;
+    mdns_bench_static_free_action = _mdns_free_action;
+}
+
+mdns_tx_packet_t *mdns_bench_create_announce_packet(mdns_srv_item_t *services[], size_t len)
+{
+    return mdns_bench_static_create_announce_packet(0, MDNS_IP_PROTOCOL_V4, services, len, true);
+}
+
+/**
+ * @brief  creates a response with one answer of the given type per service
+ */
+mdns_tx_packet_t *mdns_bench_create_answer_packet(mdns_srv_item_t *services[], size_t len, uint16_t type)
+{
+    mdns_tx_packet_t *p = mdns_bench_static_alloc_packet_default(0, MDNS_IP_PROTOCOL_V4);
+    if (!p) {
+        abort();
+    }
+    for (size_t i = 0; i < len; i++) {
+        if (!mdns_bench_static_alloc_answer(&p->answers, type, services[i]->service, NULL, false, false)) {
+            abort();
+        }
+    }
+    return p;
+}
+
+void mdns_bench_dispatch_tx_packet(mdns_tx_packet_t *p)
+{
+    mdns_bench_static_dispatch_tx_packet(p);
+}
+
+void mdns_bench_free_tx_packet(mdns_tx_packet_t *p)
+{
+    mdns_bench_static_free_tx_packet(p);
+}
+
+/**
+ * @brief  drops the packets scheduled for sending, returns how many there were
+ */
+int mdns_bench_clear_tx_queue(void)
+{
+    int count = _mdns_server->tx_queue.len;
+    mdns_bench_static_clear_tx_queue();
+    return count;
+}
+
+/**
+ * @brief  schedules a packet with one PTR answer for the service, as the responder does for shared answers
+ */
+mdns_tx_packet_t *mdns_bench_schedule_answer(mdns_if_t tcpip_if, mdns_ip_protocol_t ip_protocol, mdns_service_t *service,
+                                             bool distributed, uint32_t ms_after)
+{
+    mdns_tx_packet_t *p = mdns_bench_static_alloc_packet_default(tcpip_if, ip_protocol);
+    if (!p || !mdns_bench_static_alloc_answer(&p->answers, MDNS_TYPE_PTR, service, NULL, false, false)) {
+        abort();
+    }
+    p->distributed = distributed;
+    mdns_bench_static_schedule_tx_packet(p, ms_after);
+    return p;
+}
+
+void mdns_bench_scheduler_run(void)
+{
+    mdns_bench_static_scheduler_run();
+}
+
+/**
+ * @brief  removes the record from our scheduled answers, as a known answer received on the PCB does
+ */
+void mdns_bench_remove_scheduled_answer(mdns_if_t tcpip_if, mdns_ip_protocol_t ip_protocol, uint16_t type, mdns_srv_item_t *service)
+{
+    mdns_known_answer_t known = { .type = type, .service = service->service };
+    mdns_parsed_packet_t parsed_packet = { .tcpip_if = tcpip_if, .ip_protocol = ip_protocol, .known_answers = &known };
+    mdns_bench_static_remove_scheduled_known_answers(&parsed_packet);
+}
+
+void mdns_bench_remove_scheduled_service_packets(mdns_service_t *service)
+{
+    mdns_bench_static_remove_scheduled_service_packets(service);
+}
+
+/**
+ * @brief  serializes the packet into the caller's build context, returns its length
+ */
+uint16_t mdns_bench_build_tx_packet(mdns_tx_ctx_t *ctx, mdns_tx_packet_t *p)
+{
+    return mdns_bench_static_build_tx_packet(ctx, p);
+}
+
+const uint8_t *mdns_bench_parse_fqdn(const uint8_t *packet, const uint8_t *start, mdns_name_t *name, size_t packet_len)
+{
+    return mdns_bench_static_parse_fqdn(packet, start, name, packet_len);
+}
+
+/**
+ * @brief  builds the query of the search for the PCB, returns how many known answers it lists
+ */
+int mdns_bench_search_known_answers(mdns_search_once_t *search, mdns_if_t tcpip_if, mdns_ip_protocol_t ip_protocol)
+{
+    int count = 0;
+    mdns_tx_packet_t *p = mdns_bench_static_create_search_packet(search, tcpip_if, ip_protocol);
+    if (!p) {
+        abort();
+    }
+    for (mdns_out_answer_t *a = p->answers; a; a = a->next) {
+        count++;
+    }
+    mdns_bench_static_free_tx_packet(p);
+    return count;
+}
+
+void mdns_bench_cache_clear(void)
+{
+    mdns_bench_static_cache_clear();
+}
+
+/**
+ * @brief  allocates a query for the PTR records of the service type, listing those of the services as known answers
+ */
+mdns_tx_packet_t *mdns_bench_create_known_answer_query(const char *service, const char *proto, mdns_srv_item_t *known[],
+                                                       size_t len)
+{
+    mdns_tx_packet_t *p = mdns_bench_static_alloc_packet_default(0, MDNS_IP_PROTOCOL_V4);
+    mdns_out_question_t *q = calloc(1, sizeof(mdns_out_question_t));
+    if (!p || !q) {
+        abort();
+    }
+    q->type = MDNS_TYPE_PTR;
+    q->service = service;
+    q->proto = proto;
+    q->domain = "local";
+    p->questions = q;
+    for (size_t i = 0; i < len; i++) {
+        if (!mdns_bench_static_alloc_answer(&p->answers, MDNS_TYPE_PTR, known[i]->service, NULL, false, false)) {
+            abort();
+        }
+    }
+    return p;
+}
+
+mdns_action_t *mdns_bench_action_alloc(void)
+{
+    return mdns_bench_static_action_alloc();
+}
+
+void mdns_bench_action_free(mdns_action_t *action)
+{
+    mdns_bench_static_action_free(action);
+}
+
+/**
+ * @brief  frees the action and what it holds, as mdns_free() does with the actions left in the queue
+ */
+void mdns_bench_free_action(mdns_action_t *action)
+{
+    mdns_bench_static_free_action(action);
+}
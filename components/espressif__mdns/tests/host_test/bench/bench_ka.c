@@ -0,0 +1,471 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+/*
+ * Known-answer and duplicate-answer suppression over one hour of Matter query traffic
+ *
+ * The responder runs a Matter node (operational and commissionable instances) and a bridged node on a
+ * delegated host. The trace holds the queries of four controllers, two of them coming up later:
+ * periodic operational browses, resolves of both nodes and one commissioning window browsed with the
+ * continuous query backoff. Every other browse is also answered, 10 ms after the query, by a proxy
+ * advertising our own node with full TTLs.
+ *
+ * The trace is replayed twice: stripped of known answers and proxy responses (every query gets a full
+ * answer), then as captured. The known answers are the records a controller heard since it came up
+ * with at least half of their TTL left. Reports the packets and bytes sent, the suppression counters
+ * and the bytes saved, and checks that exactly the queries left with an unknown record got an answer.
+ *
+ * Usage: bench_ka
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp32_mock.h"
+#include "mdns.h"
+#include "mdns_private.h"
+#include "bench_util.h"
+
+void mdns_bench_init_di(void);
+int mdns_bench_clear_tx_queue(void);
+void mdns_parse_packet(mdns_rx_packet_t *packet);
+extern mdns_server_t *_mdns_server;
+
+#define TRACE_SECONDS   3600
+#define MAX_EVENTS      512
+#define PROXY_DELAY_MS  10
+
+#define OP_SELF     "2906C908D115D362-8FC7772401CD0696"
+#define OP_BRIDGED  "2906C908D115D362-8FC7772401CD0697"
+#define COMM_SELF   "DD200C20D25AE5F7"
+#define BRIDGE_HOST "bridge-host"
+
+enum { PTR_OP_SELF, PTR_OP_BRIDGED, SRV_OP_SELF, TXT_OP_SELF, SRV_OP_BRIDGED, TXT_OP_BRIDGED, A_BRIDGE,
+       PTR_COMM, SRV_COMM, TXT_COMM, RECORDS
+     };
+
+typedef struct {
+    uint16_t type;
+    const char *instance;       // owner name is the instance, or the service type for PTR records
+    const char *service;
+    const char *proto;
+    const char *host;           // SRV target, owner name of A records
+    mdns_service_t *srv;        // registered service, for the SRV and TXT data
+} record_t;
+
+static record_t s_records[RECORDS] = {
+    [PTR_OP_SELF]    = { MDNS_TYPE_PTR, OP_SELF, "_matter", "_tcp" },
+    [PTR_OP_BRIDGED] = { MDNS_TYPE_PTR, OP_BRIDGED, "_matter", "_tcp" },
+    [SRV_OP_SELF]    = { MDNS_TYPE_SRV, OP_SELF, "_matter", "_tcp", "bench-host" },
+    [TXT_OP_SELF]    = { MDNS_TYPE_TXT, OP_SELF, "_matter", "_tcp" },
+    [SRV_OP_BRIDGED] = { MDNS_TYPE_SRV, OP_BRIDGED, "_matter", "_tcp", BRIDGE_HOST },
+    [TXT_OP_BRIDGED] = { MDNS_TYPE_TXT, OP_BRIDGED, "_matter", "_tcp" },
+    [A_BRIDGE]       = { MDNS_TYPE_A, NULL, NULL, NULL, BRIDGE_HOST },
+    [PTR_COMM]       = { MDNS_TYPE_PTR, COMM_SELF, "_matterc", "_udp" },
+    [SRV_COMM]       = { MDNS_TYPE_SRV, COMM_SELF, "_matterc", "_udp", "bench-host" },
+    [TXT_COMM]       = { MDNS_TYPE_TXT, COMM_SELF, "_matterc", "_udp" },
+};
+
+#define END -1
+
+typedef struct {
+    const char *name;
+    int questions[4];           // asked as the owner name and type of these records
+    int answers[4];
+    int additional[6];
+} query_kind_t;
+
+enum { Q_BROWSE, Q_RESOLVE_SELF, Q_RESOLVE_BRIDGED, Q_COMMISSION, QUERY_KINDS };
+
+static const query_kind_t s_kinds[QUERY_KINDS] = {
+    [Q_BROWSE]          = { "browse", { PTR_OP_SELF, END }, { PTR_OP_SELF, PTR_OP_BRIDGED, END },
+        { SRV_OP_SELF, TXT_OP_SELF, SRV_OP_BRIDGED, TXT_OP_BRIDGED, A_BRIDGE, END }
+    },
+    [Q_RESOLVE_SELF]    = { "resolve", { SRV_OP_SELF, TXT_OP_SELF, END }, { SRV_OP_SELF, TXT_OP_SELF, END }, { END } },
+    [Q_RESOLVE_BRIDGED] = { "resolve bridged", { SRV_OP_BRIDGED, TXT_OP_BRIDGED, A_BRIDGE, END },
+        { SRV_OP_BRIDGED, TXT_OP_BRIDGED, A_BRIDGE, END }, { END }
+    },
+    [Q_COMMISSION]      = { "commission", { PTR_COMM, END }, { PTR_COMM, END }, { SRV_COMM, TXT_COMM, END } },
+};
+
+// The proxy advertises our own node
+static const int s_proxy_records[] = { PTR_OP_SELF, SRV_OP_SELF, TXT_OP_SELF, END };
+
+typedef struct {
+    uint32_t at_ms;
+    uint8_t kind;
+    uint8_t controller;
+    bool proxy;
+    uint32_t known_ttl[RECORDS];    // remaining TTL of the known answers, 0 = not listed
+    bool answer_expected;
+} event_t;
+
+typedef struct {
+    uint8_t data[1024];
+    uint16_t len;
+} pkt_t;
+
+static event_t s_events[MAX_EVENTS];
+static int s_event_count;
+
+static uint32_t record_ttl(int r)
+{
+    switch (s_records[r].type) {
+    case MDNS_TYPE_SRV:
+        return MDNS_ANSWER_SRV_TTL;
+    case MDNS_TYPE_A:
+        return MDNS_ANSWER_A_TTL;
+    case MDNS_TYPE_TXT:
+        return MDNS_ANSWER_TXT_TTL;
+    default:
+        return MDNS_ANSWER_PTR_TTL;
+    }
+}
+
+static bool in_list(const int *list, int r)
+{
+    for (; *list != END; list++) {
+        if (*list == r) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void put_u16(pkt_t *p, uint16_t v)
+{
+    p->data[p->len++] = v >> 8;
+    p->data[p->len++] = v & 0xFF;
+}
+
+static void put_u32(pkt_t *p, uint32_t v)
+{
+    put_u16(p, v >> 16);
+    put_u16(p, v & 0xFFFF);
+}
+
+// Writes <a>.<b>.<c>.local, skipping NULL parts
+static void put_name(pkt_t *p, const char *a, const char *b, const char *c)
+{
+    const char *parts[] = { a, b, c, "local" };
+    for (size_t i = 0; i < sizeof(parts) / sizeof(parts[0]); i++) {
+        if (parts[i]) {
+            put_label(p->data, &p->len, parts[i]);
+        }
+    }
+    p->data[p->len++] = 0;
+}
+
+static void put_owner(pkt_t *p, int r)
+{
+    const record_t *rec = &s_records[r];
+    if (rec->type == MDNS_TYPE_A) {
+        put_name(p, rec->host, NULL, NULL);
+    } else if (rec->type == MDNS_TYPE_PTR) {
+        put_name(p, rec->service, rec->proto, NULL);
+    } else {
+        put_name(p, rec->instance, rec->service, rec->proto);
+    }
+}
+
+static void put_record(pkt_t *p, int r, uint32_t ttl)
+{
+    const record_t *rec = &s_records[r];
+    put_owner(p, r);
+    put_u16(p, rec->type);
+    put_u16(p, rec->type == MDNS_TYPE_PTR ? 0x0001 : 0x8001);
+    put_u32(p, ttl);
+    uint16_t len_at = p->len;
+    put_u16(p, 0);
+    if (rec->type == MDNS_TYPE_PTR) {
+        put_name(p, rec->instance, rec->service, rec->proto);
+    } else if (rec->type == MDNS_TYPE_SRV) {
+        put_u16(p, rec->srv->priority);
+        put_u16(p, rec->srv->weight);
+        put_u16(p, rec->srv->port);
+        put_name(p, rec->host, NULL, NULL);
+    } else if (rec->type == MDNS_TYPE_TXT) {
+        memcpy(p->data + p->len, rec->srv->txt, rec->srv->txt_len);
+        p->len += rec->srv->txt_len;
+    } else {
+        const uint8_t addr[] = { 192, 168, 1, 60 };
+        memcpy(p->data + p->len, addr, sizeof(addr));
+        p->len += sizeof(addr);
+    }
+    p->data[len_at] = (p->len - len_at - 2) >> 8;
+    p->data[len_at + 1] = (p->len - len_at - 2) & 0xFF;
+}
+
+static void build_query(pkt_t *p, const event_t *e, bool with_known)
+{
+    const query_kind_t *kind = &s_kinds[e->kind];
+    uint16_t questions = 0;
+    uint16_t answers = 0;
+    memset(p->data, 0, MDNS_HEAD_LEN);
+    p->len = MDNS_HEAD_LEN;
+    for (const int *q = kind->questions; *q != END; q++, questions++) {
+        put_owner(p, *q);
+        put_u16(p, s_records[*q].type);
+        put_u16(p, 0x0001);
+    }
+    for (int r = 0; with_known && r < RECORDS; r++) {
+        if (e->known_ttl[r]) {
+            put_record(p, r, e->known_ttl[r]);
+            answers++;
+        }
+    }
+    p->data[MDNS_HEAD_QUESTIONS_OFFSET + 1] = questions;
+    p->data[MDNS_HEAD_ANSWERS_OFFSET + 1] = answers;
+}
+
+static void build_proxy_response(pkt_t *p)
+{
+    uint16_t answers = 0;
+    memset(p->data, 0, MDNS_HEAD_LEN);
+    p->len = MDNS_HEAD_LEN;
+    p->data[MDNS_HEAD_FLAGS_OFFSET] = MDNS_FLAGS_QR_AUTHORITATIVE >> 8;
+    for (const int *r = s_proxy_records; *r != END; r++, answers++) {
+        put_record(p, *r, record_ttl(*r));
+    }
+    p->data[MDNS_HEAD_ANSWERS_OFFSET + 1] = answers;
+}
+
+static void receive(pkt_t *p, uint32_t src_ip)
+{
+    struct pbuf pb = { .payload = p->data, .tot_len = p->len, .len = p->len };
+    mdns_rx_packet_t packet = {
+        .pb = &pb,
+        .ip_protocol = MDNS_IP_PROTOCOL_V4,
+        .src_port = MDNS_SERVICE_PORT,
+        .multicast = 1,
+    };
+    packet.src.type = ESP_IPADDR_TYPE_V4;
+    packet.src.u_addr.ip4.addr = src_ip;
+    mdns_parse_packet(&packet);
+}
+
+// Fires the timer until the scheduled answers are sent
+static void drain(void)
+{
+    while (_mdns_server->tx_queue.len && g_timer_expiry_ms >= 0) {
+        g_tick_count = g_timer_expiry_ms;
+        g_timer_expiry_ms = -1;
+        g_timer_cb(NULL);
+        run_actions();
+    }
+}
+
+static void add_event(bool *busy, uint32_t second, uint8_t kind, uint8_t controller)
+{
+    while (second < TRACE_SECONDS && busy[second]) {
+        second++;
+    }
+    if (second >= TRACE_SECONDS || s_event_count == MAX_EVENTS) {
+        return;
+    }
+    busy[second] = true;
+    s_events[s_event_count++] = (event_t) {
+        .at_ms = second * 1000, .kind = kind, .controller = controller
+    };
+}
+
+static int event_cmp(const void *a, const void *b)
+{
+    const event_t *ea = a, *eb = b;
+    return (ea->at_ms > eb->at_ms) - (ea->at_ms < eb->at_ms);
+}
+
+/**
+ * Builds the trace. The controllers hear every multicast answer sent after they came up: a record is
+ * refreshed when we or the proxy send it. Known answers are the records of the question with at least
+ * half of their TTL left (RFC 6762 7.1)
+ */
+static void build_trace(void)
+{
+    static bool busy[TRACE_SECONDS];
+    const uint32_t up_at[] = { 0, 0, 900, 1800 };
+    const uint32_t browse_period[] = { 60, 90, 120, 300 };
+    const uint32_t commission_at[] = { 600, 601, 603, 607, 615, 631, 663, 727 };
+    uint32_t heard_ms[RECORDS];
+    int browses = 0;
+
+    for (int r = 0; r < RECORDS; r++) {
+        heard_ms[r] = UINT32_MAX;
+    }
+    for (int c = 0; c < 4; c++) {
+        for (uint32_t t = up_at[c] + 3 + c * 7; t < TRACE_SECONDS; t += browse_period[c]) {
+            add_event(busy, t, Q_BROWSE, c);
+        }
+    }
+    for (uint32_t t = 11; t < TRACE_SECONDS; t += 100) {
+        add_event(busy, t, Q_RESOLVE_SELF, 0);
+    }
+    for (uint32_t t = 23; t < TRACE_SECONDS; t += 150) {
+        add_event(busy, t, Q_RESOLVE_SELF, 1);
+    }
+    for (uint32_t t = up_at[2] + 31; t < TRACE_SECONDS; t += 200) {
+        add_event(busy, t, Q_RESOLVE_BRIDGED, 2);
+    }
+    for (size_t i = 0; i < sizeof(commission_at) / sizeof(commission_at[0]); i++) {
+        add_event(busy, commission_at[i], Q_COMMISSION, 1);
+    }
+    qsort(s_events, s_event_count, sizeof(event_t), event_cmp);
+
+    for (int i = 0; i < s_event_count; i++) {
+        event_t *e = &s_events[i];
+        const query_kind_t *kind = &s_kinds[e->kind];
+        bool answered[RECORDS] = { false };
+        e->proxy = e->kind == Q_BROWSE && (browses++ % 2);
+        for (const int *r = kind->answers; *r != END; r++) {
+            bool heard = heard_ms[*r] != UINT32_MAX && heard_ms[*r] >= up_at[e->controller] * 1000;
+            uint32_t age = heard ? (e->at_ms - heard_ms[*r]) / 1000 : UINT32_MAX;
+            uint32_t left = age < record_ttl(*r) ? record_ttl(*r) - age : 0;
+            if (left >= record_ttl(*r) / 2) {
+                e->known_ttl[*r] = left;
+            } else if (!(e->proxy && in_list(s_proxy_records, *r))) {
+                answered[*r] = true;
+                e->answer_expected = true;
+            }
+        }
+        for (int r = 0; e->proxy && r < RECORDS; r++) {
+            if (in_list(s_proxy_records, r)) {
+                heard_ms[r] = e->at_ms + PROXY_DELAY_MS;
+            }
+        }
+        for (int r = 0; e->answer_expected && r < RECORDS; r++) {
+            if (answered[r] || (in_list(kind->additional, r) && !(e->proxy && in_list(s_proxy_records, r)))) {
+                heard_ms[r] = e->at_ms;
+            }
+        }
+    }
+}
+
+typedef struct {
+    uint32_t packets;
+    uint64_t bytes;
+    uint32_t known;
+    uint32_t duplicates;
+    int mismatches;
+    uint64_t query_bytes[QUERY_KINDS];
+} result_t;
+
+static result_t replay(bool as_captured, uint32_t start_ms)
+{
+    result_t res = { 0 };
+    pkt_t p;
+    uint32_t packets = g_tx_packet_count;
+    uint64_t bytes = g_tx_bytes;
+    _mdns_server->suppressed.known_answer = 0;
+    _mdns_server->suppressed.duplicate_answer = 0;
+
+    for (int i = 0; i < s_event_count; i++) {
+        const event_t *e = &s_events[i];
+        uint32_t sent = g_tx_packet_count;
+        uint64_t sent_bytes = g_tx_bytes;
+        g_tick_count = start_ms + e->at_ms;
+        build_query(&p, e, as_captured);
+        receive(&p, 0x0A01A8C0 + (e->controller << 24));   // 192.168.1.10 + controller
+        run_actions();
+        if (as_captured && e->proxy) {
+            g_tick_count += PROXY_DELAY_MS;
+            build_proxy_response(&p);
+            receive(&p, 0x0201A8C0);                        // 192.168.1.2
+            run_actions();
+        }
+        drain();
+        bool answered = g_tx_packet_count != sent;
+        if (answered != (as_captured ? e->answer_expected : true)) {
+            res.mismatches++;
+        }
+        res.query_bytes[e->kind] += g_tx_bytes - sent_bytes;
+    }
+    res.packets = g_tx_packet_count - packets;
+    res.bytes = g_tx_bytes - bytes;
+    res.known = _mdns_server->suppressed.known_answer;
+    res.duplicates = _mdns_server->suppressed.duplicate_answer;
+    return res;
+}
+
+static void add_services(void)
+{
+    mdns_txt_item_t op_txt[] = { {"SII", "5000"}, {"SAI", "300"}, {"T", "1"} };
+    mdns_txt_item_t comm_txt[] = { {"D", "3840"}, {"CM", "1"}, {"VP", "65521+32769"}, {"DT", "257"}, {"DN", "Bench Light"} };
+    mdns_ip_addr_t addr = { 0 };
+    addr.addr.type = ESP_IPADDR_TYPE_V4;
+    addr.addr.u_addr.ip4.addr = 0x3C01A8C0;     // 192.168.1.60
+
+    if (mdns_delegate_hostname_add(BRIDGE_HOST, &addr)) {
+        abort();
+    }
+    run_actions();
+    if (mdns_service_add(OP_SELF, "_matter", "_tcp", 5540, op_txt, 3)
+            || mdns_service_add_for_host(OP_BRIDGED, "_matter", "_tcp", BRIDGE_HOST, 5540, op_txt, 3)
+            || mdns_service_add(COMM_SELF, "_matterc", "_udp", 5540, comm_txt, 5)) {
+        abort();
+    }
+    run_actions();
+    for (mdns_srv_item_t *item = _mdns_server->services; item; item = item->next) {
+        for (int r = 0; r < RECORDS; r++) {
+            if (s_records[r].instance && !strcmp(item->service->instance, s_records[r].instance)) {
+                s_records[r].srv = item->service;
+            }
+        }
+    }
+    for (int i = 0; i < MDNS_MAX_INTERFACES; i++) {
+        for (int j = 0; j < MDNS_IP_PROTOCOL_MAX; j++) {
+            mdns_pcb_t *pcb = &_mdns_server->interfaces[i].pcbs[j];
+            free(pcb->probe_services);
+            pcb->probe_services = NULL;
+            pcb->probe_services_len = 0;
+            pcb->probe_running = false;
+            pcb->state = PCB_RUNNING;
+        }
+    }
+    mdns_bench_clear_tx_queue();
+}
+
+int main(int argc, char **argv)
+{
+    int ret = 0;
+
+    mdns_bench_init_di();
+    if (mdns_init() || mdns_hostname_set("bench-host")) {
+        abort();
+    }
+    run_actions();
+    add_services();
+    g_tick_step = 0;
+    build_trace();
+
+    int queries[QUERY_KINDS] = { 0 };
+    for (int i = 0; i < s_event_count; i++) {
+        queries[s_events[i].kind]++;
+    }
+    result_t base = replay(false, 0);
+    result_t capt = replay(true, (TRACE_SECONDS + 1) * 1000);
+
+    printf("%-12s %-8s %-8s %-9s %-10s %-10s\n", "replay", "queries", "packets", "bytes", "known-ans", "duplicates");
+    printf("%-12s %-8d %-8u %-9llu %-10u %-10u\n", "stripped", s_event_count, base.packets,
+           (unsigned long long)base.bytes, base.known, base.duplicates);
+    printf("%-12s %-8d %-8u %-9llu %-10u %-10u\n", "captured", s_event_count, capt.packets,
+           (unsigned long long)capt.bytes, capt.known, capt.duplicates);
+    printf("saved: %llu bytes (%.1f%%)\n", (unsigned long long)(base.bytes - capt.bytes),
+           base.bytes ? 100.0 * (base.bytes - capt.bytes) / base.bytes : 0.0);
+    printf("%-16s %-8s %-14s %-14s\n", "query", "count", "stripped[B]", "captured[B]");
+    for (int k = 0; k < QUERY_KINDS; k++) {
+        printf("%-16s %-8d %-14llu %-14llu\n", s_kinds[k].name, queries[k], (unsigned long long)base.query_bytes[k],
+               (unsigned long long)capt.query_bytes[k]);
+    }
+    if (base.mismatches || capt.mismatches) {
+        printf("FAIL: %d queries of the stripped and %d of the captured replay answered against expectations\n",
+               base.mismatches, capt.mismatches);
+        ret = 1;
+    }
+    if (!capt.known || !capt.duplicates || capt.bytes >= base.bytes) {
+        printf("FAIL: no suppression\n");
+        ret = 1;
+    }
+    return ret;
+}
@@ -0,0 +1,200 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+/*
+ * Reentrancy stress of the packet builder and the name parser
+ *
+ * Registers 25 services and builds their announce packet once as reference. Then 1, 2 and 4 threads,
+ * each with its own mdns_tx_ctx_t and mdns_parse_ctx_t, rebuild the packet with _mdns_build_tx_packet()
+ * and parse back every name in it with _mdns_parse_fqdn(). Any byte or name that differs from the
+ * reference is a failure. Reports packets (built and parsed) per second over all threads.
+ *
+ * Usage: bench_mt [iterations per thread]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "esp32_mock.h"
+#include "mdns.h"
+#include "mdns_private.h"
+#include "bench_util.h"
+
+void mdns_bench_init_di(void);
+mdns_tx_packet_t *mdns_bench_create_announce_packet(mdns_srv_item_t *services[], size_t len);
+void mdns_bench_free_tx_packet(mdns_tx_packet_t *p);
+uint16_t mdns_bench_build_tx_packet(mdns_tx_ctx_t *ctx, mdns_tx_packet_t *p);
+const uint8_t *mdns_bench_parse_fqdn(const uint8_t *packet, const uint8_t *start, mdns_name_t *name, size_t packet_len);
+extern mdns_server_t *_mdns_server;
+
+#define BENCH_SERVICES      25
+#define BENCH_MAX_THREADS   4
+#define BENCH_MAX_NAMES     128
+
+typedef struct {
+    int iterations;
+    int errors;
+    mdns_tx_ctx_t tx;
+    mdns_parse_ctx_t rx;
+} worker_t;
+
+static mdns_tx_packet_t *s_packet;
+static uint8_t s_ref[MDNS_MAX_PACKET_SIZE];
+static uint16_t s_ref_len;
+static mdns_name_t s_ref_names[BENCH_MAX_NAMES];
+static int s_ref_count;
+
+static uint16_t read_u16(const uint8_t *p)
+{
+    return (p[0] << 8) | p[1];
+}
+
+// Parses the owner name of every record and the target of PTR and SRV records, returns the number of names or -1
+static int parse_names(mdns_parse_ctx_t *ctx, const uint8_t *packet, size_t len, mdns_name_t *out, int max)
+{
+    int records = read_u16(packet + MDNS_HEAD_ANSWERS_OFFSET) + read_u16(packet + MDNS_HEAD_SERVERS_OFFSET)
+                  + read_u16(packet + MDNS_HEAD_ADDITIONAL_OFFSET);
+    const uint8_t *content = packet + MDNS_HEAD_LEN;
+    int count = 0;
+    for (int i = 0; i < records && count + 2 <= max; i++) {
+        content = mdns_bench_parse_fqdn(packet, content, &ctx->name, len);
+        if (!content || content + MDNS_DATA_OFFSET > packet + len) {
+            return -1;
+        }
+        out[count++] = ctx->name;
+        uint16_t type = read_u16(content + MDNS_TYPE_OFFSET);
+        const uint8_t *data = content + MDNS_DATA_OFFSET;
+        content = data + read_u16(content + MDNS_LEN_OFFSET);
+        if (type == MDNS_TYPE_PTR || type == MDNS_TYPE_SRV) {
+            if (!mdns_bench_parse_fqdn(packet, type == MDNS_TYPE_SRV ? data + MDNS_SRV_FQDN_OFFSET : data, &ctx->name, len)) {
+                return -1;
+            }
+            out[count++] = ctx->name;
+        }
+    }
+    return count;
+}
+
+// Bytes past the string terminators are left over from earlier names
+static bool same_name(const mdns_name_t *a, const mdns_name_t *b)
+{
+    return !strcmp(a->host, b->host) && !strcmp(a->service, b->service) && !strcmp(a->proto, b->proto)
+           && !strcmp(a->domain, b->domain) && a->parts == b->parts && a->sub == b->sub && a->invalid == b->invalid;
+}
+
+static void *worker(void *arg)
+{
+    worker_t *w = arg;
+    mdns_name_t names[BENCH_MAX_NAMES];
+    for (int i = 0; i < w->iterations; i++) {
+        uint16_t len = mdns_bench_build_tx_packet(&w->tx, s_packet);
+        if (len != s_ref_len || memcmp(w->tx.packet, s_ref, len) != 0) {
+            w->errors++;
+            continue;
+        }
+        if (parse_names(&w->rx, w->tx.packet, len, names, BENCH_MAX_NAMES) != s_ref_count) {
+            w->errors++;
+            continue;
+        }
+        for (int n = 0; n < s_ref_count; n++) {
+            if (!same_name(&names[n], &s_ref_names[n])) {
+                w->errors++;
+                break;
+            }
+        }
+    }
+    return NULL;
+}
+
+static void add_service(int i)
+{
+    char instance[32];
+    char service[16];
+    mdns_txt_item_t txt[2] = {
+        {"board", "esp32c6"},
+        {"path", "/"},
+    };
+    snprintf(instance, sizeof(instance), "Bench Node %02d", i);
+    snprintf(service, sizeof(service), "_bench%02d", i);
+    if (mdns_service_add(instance, service, i % 2 ? "_udp" : "_tcp", 1000 + i, txt, 2)) {
+        abort();
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int iterations = argc > 1 ? atoi(argv[1]) : 20000;
+    const int steps[] = {1, 2, 4};
+    mdns_srv_item_t *services[BENCH_SERVICES];
+    static worker_t workers[BENCH_MAX_THREADS];
+    static mdns_parse_ctx_t ref_ctx;
+    int ret = 0;
+
+    mdns_bench_init_di();
+    if (mdns_init()) {
+        abort();
+    }
+    for (int i = 0; i < MDNS_MAX_INTERFACES; i++) {
+        _mdns_server->interfaces[i].pcbs[MDNS_IP_PROTOCOL_V4].state = PCB_RUNNING;
+        _mdns_server->interfaces[i].pcbs[MDNS_IP_PROTOCOL_V6].state = PCB_RUNNING;
+    }
+    if (mdns_hostname_set("bench-host")) {
+        abort();
+    }
+    mdns_action_t *a = NULL;
+    GetLastItem(&a);
+    mdns_test_execute_action(a);
+    for (int i = 0; i < BENCH_SERVICES; i++) {
+        add_service(i);
+    }
+    int count = 0;
+    for (mdns_srv_item_t *item = _mdns_server->services; item && count < BENCH_SERVICES; item = item->next) {
+        services[count++] = item;
+    }
+    s_packet = mdns_bench_create_announce_packet(services, count);
+    if (!s_packet) {
+        abort();
+    }
+    s_ref_len = mdns_bench_build_tx_packet(&workers[0].tx, s_packet);
+    memcpy(s_ref, workers[0].tx.packet, s_ref_len);
+    s_ref_count = parse_names(&ref_ctx, s_ref, s_ref_len, s_ref_names, BENCH_MAX_NAMES);
+    if (s_ref_count <= 0) {
+        printf("FAIL: names of the reference packet do not parse\n");
+        return 1;
+    }
+
+    printf("%-8s %-6s %-6s %-12s %-8s\n", "threads", "bytes", "names", "packets/s", "errors");
+    for (size_t s = 0; s < sizeof(steps) / sizeof(steps[0]); s++) {
+        int threads = steps[s];
+        pthread_t tid[BENCH_MAX_THREADS];
+        int errors = 0;
+        double start = now_us();
+        for (int t = 0; t < threads; t++) {
+            workers[t].iterations = iterations;
+            workers[t].errors = 0;
+            if (pthread_create(&tid[t], NULL, worker, &workers[t])) {
+                abort();
+            }
+        }
+        for (int t = 0; t < threads; t++) {
+            pthread_join(tid[t], NULL);
+            errors += workers[t].errors;
+        }
+        double elapsed = now_us() - start;
+        printf("%-8d %-6u %-6d %-12.0f %-8d\n", threads, s_ref_len, s_ref_count,
+               threads * iterations / (elapsed / 1e6), errors);
+        if (errors) {
+            printf("FAIL: %d of %d packets differ from the reference with %d threads\n", errors, threads * iterations, threads);
+            ret = 1;
+        }
+    }
+
+    mdns_bench_free_tx_packet(s_packet);
+    mdns_service_remove_all();
+    ForceTaskDelete();
+    mdns_free();
+    return ret;
+}
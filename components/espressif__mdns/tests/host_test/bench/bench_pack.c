@@ -0,0 +1,298 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+/*
+ * Questions of concurrent searches packed into shared query packets
+ *
+ * - resolve: 50 async SRV searches resolve 50 Matter operational instances at once. The responder misses the first
+ *            round of queries and answers every question of the next one.
+ * - shared:  8 async PTR searches of _matter._tcp run for 3 s with 20 instances of the service in the cache, each
+ *            one is a known answer of every search.
+ * It reports:
+ * - questions: questions scheduled by the timer, one query packet each before packing
+ * - packets:   query packets sent
+ * - qd/an:     questions and known answers in these packets
+ * - max[B]:    largest packet
+ * - resolved:  searches that got their answer
+ *
+ * Fails if a search is not resolved, a question scheduled for a round is missing from its packets or a packet
+ * is over MDNS_MAX_PACKET_SIZE.
+ *
+ * Usage: bench_pack
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp32_mock.h"
+#include "mdns.h"
+#include "mdns_private.h"
+#include "bench_util.h"
+
+void mdns_bench_init_di(void);
+int mdns_bench_clear_tx_queue(void);
+void mdns_bench_cache_clear(void);
+void mdns_parse_packet(mdns_rx_packet_t *packet);
+extern mdns_server_t *_mdns_server;
+
+#define NAMES               50
+#define SHARED_SEARCHES     8
+#define SHARED_INSTANCES    20
+#define INSTANCE_FMT        "2906C908D115D362-%016X"
+
+static struct {
+    int packets;
+    int questions;
+    int answers;
+    int max_len;
+    bool answer;                // Whether the responder answers the questions
+    bool asked[NAMES];
+} s_tx;
+
+static uint16_t read_u16(const uint8_t *p)
+{
+    return (p[0] << 8) | p[1];
+}
+
+// Counts the query packets and marks the instances asked for, by the first label of each question
+static void capture(const uint8_t *data, size_t len)
+{
+    if (len < MDNS_HEAD_LEN || (read_u16(data + MDNS_HEAD_FLAGS_OFFSET) & MDNS_FLAGS_QUERY_REPSONSE)) {
+        return;
+    }
+    uint16_t questions = read_u16(data + MDNS_HEAD_QUESTIONS_OFFSET);
+    s_tx.packets++;
+    s_tx.questions += questions;
+    s_tx.answers += read_u16(data + MDNS_HEAD_ANSWERS_OFFSET);
+    s_tx.max_len = len > s_tx.max_len ? len : s_tx.max_len;
+
+    size_t offset = MDNS_HEAD_LEN;
+    for (int i = 0; i < questions && offset < len; i++) {
+        unsigned node;
+        char label[64];
+        uint8_t l = data[offset];
+        if (l < 64 && offset + 1 + l <= len) {
+            memcpy(label, data + offset + 1, l);
+            label[l] = 0;
+            if (sscanf(label, INSTANCE_FMT, &node) == 1 && node < NAMES) {
+                s_tx.asked[node] = true;
+            }
+        }
+        while (offset < len && data[offset] && (data[offset] & 0xC0) != 0xC0) {
+            offset += data[offset] + 1;
+        }
+        offset += (offset < len && data[offset]) ? 2 : 1;
+        offset += 4;
+    }
+}
+
+static void put_service(uint8_t *data, uint16_t *len)
+{
+    put_label(data, len, "_matter");
+    put_label(data, len, "_tcp");
+    put_label(data, len, "local");
+    data[(*len)++] = 0;
+}
+
+static void put_record_head(uint8_t *data, uint16_t *len, uint16_t type, uint16_t data_len)
+{
+    const uint8_t head[] = { type >> 8, type, 0, MDNS_CLASS_IN, 0, 0, 0x11, 0x94, data_len >> 8, data_len };
+    memcpy(data + *len, head, sizeof(head));
+    *len += sizeof(head);
+}
+
+static void inject(uint8_t *data, uint16_t len, uint16_t answers)
+{
+    data[MDNS_HEAD_FLAGS_OFFSET] = MDNS_FLAGS_QR_AUTHORITATIVE >> 8;
+    data[MDNS_HEAD_ANSWERS_OFFSET] = answers >> 8;
+    data[MDNS_HEAD_ANSWERS_OFFSET + 1] = answers;
+    struct pbuf pb = { .payload = data, .tot_len = len, .len = len };
+    mdns_rx_packet_t packet = {
+        .pb = &pb,
+        .ip_protocol = MDNS_IP_PROTOCOL_V4,
+        .src_port = MDNS_SERVICE_PORT,
+        .multicast = 1,
+    };
+    packet.src.type = ESP_IPADDR_TYPE_V4;
+    packet.src.u_addr.ip4.addr = 0x0A000001;
+    mdns_parse_packet(&packet);
+}
+
+// SRV record of an instance, on port 5540 of node-NN.local
+static void respond(int node)
+{
+    uint8_t data[256] = { 0 };
+    uint16_t len = MDNS_HEAD_LEN;
+    char label[64];
+    snprintf(label, sizeof(label), INSTANCE_FMT, node);
+    put_label(data, &len, label);
+    put_service(data, &len);
+    snprintf(label, sizeof(label), "node-%02d", node);
+    put_record_head(data, &len, MDNS_TYPE_SRV, 6 + strlen(label) + 1 + 7);
+    const uint8_t srv[] = { 0, 0, 0, 0, 5540 >> 8, 5540 & 0xFF };
+    memcpy(data + len, srv, sizeof(srv));
+    len += sizeof(srv);
+    put_label(data, &len, label);
+    put_label(data, &len, "local");
+    data[len++] = 0;
+    inject(data, len, 1);
+}
+
+// PTR records of the instances of _matter._tcp, with a TTL of 4500 s
+static void announce_instances(int count)
+{
+    uint8_t data[MDNS_MAX_PACKET_SIZE] = { 0 };
+    uint16_t len = MDNS_HEAD_LEN;
+    char label[64];
+    for (int i = 0; i < count; i++) {
+        snprintf(label, sizeof(label), INSTANCE_FMT, 0x100 + i);
+        if (i) {
+            data[len++] = 0xC0;
+            data[len++] = MDNS_HEAD_LEN;
+        } else {
+            put_service(data, &len);
+        }
+        put_record_head(data, &len, MDNS_TYPE_PTR, strlen(label) + 3);
+        put_label(data, &len, label);
+        data[len++] = 0xC0;
+        data[len++] = MDNS_HEAD_LEN;
+    }
+    inject(data, len, count);
+}
+
+// Runs the service task, then answers the queries it sent
+static void run_and_respond(void)
+{
+    run_actions();
+    for (int i = 0; i < NAMES; i++) {
+        if (s_tx.answer && s_tx.asked[i]) {
+            respond(i);
+        }
+    }
+}
+
+static void report(const char *run, uint32_t questions, int resolved, int searches)
+{
+    printf("%-8s %-10u %-8d %-5d %-5d %-7d %-8.1f %d/%d\n", run, questions, s_tx.packets, s_tx.questions,
+           s_tx.answers, s_tx.max_len, 100.0 * (questions - s_tx.packets) / questions, resolved, searches);
+}
+
+static int run_resolve(void)
+{
+    mdns_search_once_t *searches[NAMES];
+    char instance[64];
+    int ret = 0;
+
+    mdns_bench_cache_clear();
+    memset(&s_tx, 0, sizeof(s_tx));
+    uint32_t sent = _mdns_server->queries.sent;
+    for (int i = 0; i < NAMES; i++) {
+        snprintf(instance, sizeof(instance), INSTANCE_FMT, i);
+        if (!(searches[i] = mdns_query_async_new(instance, "_matter", "_tcp", MDNS_TYPE_SRV, 3000, 1, NULL))) {
+            abort();
+        }
+        // the mDNS task takes the searches as they come, the timer sends their questions later
+        run_and_respond();
+    }
+    // first round lost
+    fire_timer_until(g_tick_count + 1, run_and_respond);
+    for (int i = 0; i < NAMES; i++) {
+        if (!s_tx.asked[i]) {
+            printf("FAIL: question %d missing from the first round\n", i);
+            ret = 1;
+        }
+    }
+    memset(s_tx.asked, 0, sizeof(s_tx.asked));
+    s_tx.answer = true;
+    fire_timer_until(g_tick_count + 5000, run_and_respond);
+    s_tx.answer = false;
+
+    int resolved = 0;
+    for (int i = 0; i < NAMES; i++) {
+        resolved += searches[i]->result && searches[i]->result->port == 5540;
+        mdns_query_results_free(searches[i]->result);
+        mdns_query_async_delete(searches[i]);
+    }
+    report("resolve", _mdns_server->queries.sent - sent, resolved, NAMES);
+    if (resolved != NAMES || s_tx.max_len > MDNS_MAX_PACKET_SIZE) {
+        ret = 1;
+    }
+    return ret;
+}
+
+static int run_shared(void)
+{
+    mdns_search_once_t *searches[SHARED_SEARCHES];
+    int ret = 0;
+
+    mdns_bench_cache_clear();
+    announce_instances(SHARED_INSTANCES);
+    memset(&s_tx, 0, sizeof(s_tx));
+    uint32_t sent = _mdns_server->queries.sent;
+    for (int i = 0; i < SHARED_SEARCHES; i++) {
+        if (!(searches[i] = mdns_query_async_new(NULL, "_matter", "_tcp", MDNS_TYPE_PTR, 3000, 0, NULL))) {
+            abort();
+        }
+        // the mDNS task takes the searches as they come, the timer sends their questions later
+        run_and_respond();
+    }
+    fire_timer_until(g_tick_count + 5000, run_and_respond);
+
+    int resolved = 0;
+    for (int i = 0; i < SHARED_SEARCHES; i++) {
+        int count = 0;
+        for (mdns_result_t *r = searches[i]->result; r; r = r->next) {
+            count++;
+        }
+        resolved += count == SHARED_INSTANCES;
+        mdns_query_results_free(searches[i]->result);
+        mdns_query_async_delete(searches[i]);
+    }
+    uint32_t questions = _mdns_server->queries.sent - sent;
+    report("shared", questions, resolved, SHARED_SEARCHES);
+    // one question per round, listing every instance once
+    if (resolved != SHARED_SEARCHES || s_tx.questions != s_tx.packets
+            || s_tx.answers != s_tx.packets * SHARED_INSTANCES || s_tx.max_len > MDNS_MAX_PACKET_SIZE) {
+        printf("FAIL: %d questions and %d answers in %d packets\n", s_tx.questions, s_tx.answers, s_tx.packets);
+        ret = 1;
+    }
+    return ret;
+}
+
+int main(int argc, char **argv)
+{
+    int ret = 0;
+
+    mdns_bench_init_di();
+    if (mdns_init() || mdns_hostname_set("bench-host")) {
+        abort();
+    }
+    run_and_respond();
+    // one PCB, every query is one packet
+    for (int i = 0; i < MDNS_MAX_INTERFACES; i++) {
+        for (int j = 0; j < MDNS_IP_PROTOCOL_MAX; j++) {
+            mdns_pcb_t *pcb = &_mdns_server->interfaces[i].pcbs[j];
+            free(pcb->probe_services);
+            pcb->probe_services = NULL;
+            pcb->probe_services_len = 0;
+            pcb->probe_running = false;
+            pcb->state = i == 0 && j == MDNS_IP_PROTOCOL_V4 ? PCB_RUNNING : PCB_OFF;
+        }
+    }
+    mdns_bench_clear_tx_queue();
+    g_tick_step = 0;
+    g_tick_count = 1000;
+    g_tx_hook = capture;
+
+    printf("%-8s %-10s %-8s %-5s %-5s %-7s %-8s %s\n", "run", "questions", "packets", "qd", "an", "max[B]", "saved%",
+           "resolved");
+    ret |= run_resolve();
+    ret |= run_shared();
+
+    g_tx_hook = NULL;
+    ForceTaskDelete();
+    mdns_free();
+    return ret;
+}
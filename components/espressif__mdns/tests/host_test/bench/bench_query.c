@@ -0,0 +1,249 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+/*
+ * Continuous querying over one hour
+ *
+ * 4 PTR questions (_bench00._tcp to _bench03._tcp) stay open for one simulated hour, as async searches with a
+ * one-hour timeout and as browses. One responder per service type answers every query that does not list its
+ * instance as a known answer, with a PTR record of 120 s or 4500 s TTL. It reports:
+ * - queries:  query packets sent
+ * - refresh:  of which sent for a cached answer reaching 80-95% of its TTL
+ * - fixed 1s: packets of the former scheduler, one query per question every second
+ * - avoided:  fixed 1s - queries
+ * - fresh:    seconds the answer of every question was in the cache, out of the hour
+ *
+ * Fails if an answer expired while its question was open or if more queries than at a fixed 1 s were sent.
+ *
+ * Usage: bench_query
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp32_mock.h"
+#include "mdns.h"
+#include "mdns_private.h"
+#include "bench_util.h"
+
+void mdns_bench_init_di(void);
+int mdns_bench_clear_tx_queue(void);
+void mdns_bench_cache_clear(void);
+void mdns_parse_packet(mdns_rx_packet_t *packet);
+extern mdns_server_t *_mdns_server;
+
+#define RUN_MS              (60 * 60 * 1000)
+#define QUESTIONS           4
+
+static int s_queries;
+static bool s_answer[QUESTIONS];
+static uint32_t s_ttl;
+
+static uint16_t read_u16(const uint8_t *p)
+{
+    return (p[0] << 8) | p[1];
+}
+
+static size_t skip_name(const uint8_t *data, size_t len, size_t offset)
+{
+    while (offset < len && data[offset] && (data[offset] & 0xC0) != 0xC0) {
+        offset += data[offset] + 1;
+    }
+    return offset + ((offset < len && data[offset]) ? 2 : 1);
+}
+
+// Counts the queries and marks the questions to answer, the first label of a question is "_benchNN"
+static void capture(const uint8_t *data, size_t len)
+{
+    if (len < MDNS_HEAD_LEN || (read_u16(data + MDNS_HEAD_FLAGS_OFFSET) & MDNS_FLAGS_QUERY_REPSONSE)) {
+        return;
+    }
+    s_queries++;
+    bool asked[QUESTIONS] = { 0 };
+    bool known[QUESTIONS] = { 0 };
+    size_t offset = MDNS_HEAD_LEN;
+    for (int i = read_u16(data + MDNS_HEAD_QUESTIONS_OFFSET); i > 0 && offset + 9 < len; i--) {
+        const uint8_t *name = data + offset;
+        int question = (name[7] - '0') * 10 + name[8] - '0';
+        if (name[0] == 8 && !memcmp(name + 1, "_bench", 6) && question >= 0 && question < QUESTIONS) {
+            asked[question] = true;
+        }
+        offset = skip_name(data, len, offset) + 4;
+    }
+    // known answer suppression, the only instance of a service is "Bench Node NN"
+    for (int i = read_u16(data + MDNS_HEAD_ANSWERS_OFFSET); i > 0 && offset < len; i--) {
+        offset = skip_name(data, len, offset);
+        if (offset + 10 + 14 > len) {
+            break;
+        }
+        const uint8_t *instance = data + offset + 10;
+        int question = (instance[12] - '0') * 10 + instance[13] - '0';
+        if (instance[0] == 13 && !memcmp(instance + 1, "Bench Node ", 11) && question >= 0 && question < QUESTIONS) {
+            known[question] = true;
+        }
+        offset += 10 + read_u16(data + offset + 8);
+    }
+    for (int i = 0; i < QUESTIONS; i++) {
+        s_answer[i] |= asked[i] && !known[i];
+    }
+}
+
+static void respond(int question)
+{
+    uint8_t data[128] = { 0 };
+    uint16_t len = MDNS_HEAD_LEN;
+    char service[16], instance[16];
+    snprintf(service, sizeof(service), "_bench%02d", question);
+    snprintf(instance, sizeof(instance), "Bench Node %02d", question);
+    data[MDNS_HEAD_FLAGS_OFFSET] = MDNS_FLAGS_QR_AUTHORITATIVE >> 8;
+    data[MDNS_HEAD_ANSWERS_OFFSET + 1] = 1;
+
+    put_label(data, &len, service);
+    put_label(data, &len, "_tcp");
+    put_label(data, &len, "local");
+    data[len++] = 0;
+    const uint8_t head[] = { 0, MDNS_TYPE_PTR, 0, MDNS_CLASS_IN, s_ttl >> 24, s_ttl >> 16, s_ttl >> 8, s_ttl, 0,
+                             strlen(instance) + 3
+                           };
+    memcpy(data + len, head, sizeof(head));
+    len += sizeof(head);
+    put_label(data, &len, instance);
+    data[len++] = 0xC0;
+    data[len++] = MDNS_HEAD_LEN;
+
+    struct pbuf pb = { .payload = data, .tot_len = len, .len = len };
+    mdns_rx_packet_t packet = {
+        .pb = &pb,
+        .ip_protocol = MDNS_IP_PROTOCOL_V4,
+        .src_port = MDNS_SERVICE_PORT,
+        .multicast = 1,
+    };
+    packet.src.type = ESP_IPADDR_TYPE_V4;
+    packet.src.u_addr.ip4.addr = 0x0A000001 + question;
+    mdns_parse_packet(&packet);
+}
+
+// Runs the service task, then answers the queries it sent
+static void run_and_respond(void)
+{
+    run_actions();
+    for (int i = 0; i < QUESTIONS; i++) {
+        if (s_answer[i]) {
+            s_answer[i] = false;
+            respond(i);
+        }
+    }
+}
+
+static bool all_fresh(void)
+{
+    int fresh = 0;
+    for (mdns_cache_record_t *r = _mdns_server->cache.records; r; r = r->next) {
+        fresh += r->type == MDNS_TYPE_PTR && (int32_t)(r->expires_at - g_tick_count) > 0;
+    }
+    return fresh == QUESTIONS;
+}
+
+static void browse_notifier(mdns_result_t *result)
+{
+}
+
+static int run(bool browse, uint32_t ttl)
+{
+    mdns_search_once_t *searches[QUESTIONS] = { 0 };
+    char service[16];
+    int ret = 0;
+
+    mdns_bench_cache_clear();
+    s_ttl = ttl;
+    s_queries = 0;
+    uint32_t refreshes = _mdns_server->queries.refreshes;
+    uint32_t start = g_tick_count;
+    for (int i = 0; i < QUESTIONS; i++) {
+        snprintf(service, sizeof(service), "_bench%02d", i);
+        if (browse) {
+            if (!mdns_browse_new(service, "_tcp", browse_notifier)) {
+                abort();
+            }
+        } else if (!(searches[i] = mdns_query_async_new(NULL, service, "_tcp", MDNS_TYPE_PTR, RUN_MS, 0, NULL))) {
+            abort();
+        }
+    }
+    run_and_respond();
+    fire_timer_until(start + 1, run_and_respond);
+
+    int fresh = 0;
+    for (uint32_t t = 1000; t <= RUN_MS; t += 1000) {
+        fire_timer_until(start + t, run_and_respond);
+        fresh += all_fresh();
+    }
+    int queries = s_queries;
+    int fixed = QUESTIONS * (RUN_MS / MDNS_QUERY_INTERVAL_MIN_MS);
+    refreshes = _mdns_server->queries.refreshes - refreshes;
+
+    for (int i = 0; i < QUESTIONS; i++) {
+        snprintf(service, sizeof(service), "_bench%02d", i);
+        if (browse) {
+            mdns_browse_delete(service, "_tcp");
+        }
+    }
+    run_and_respond();
+    fire_timer_until(g_tick_count + 2000, run_and_respond);
+    for (int i = 0; i < QUESTIONS; i++) {
+        if (searches[i]) {
+            if (searches[i]->state != SEARCH_OFF) {
+                ret = 1;
+            }
+            mdns_query_results_free(searches[i]->result);
+            mdns_query_async_delete(searches[i]);
+        }
+    }
+
+    printf("%-8s %-6u %-9d %-9u %-9d %-9d %-9.1f %d/%d\n", browse ? "browse" : "search", ttl, queries, refreshes,
+           fixed, fixed - queries, 100.0 * (fixed - queries) / fixed, fresh, RUN_MS / 1000);
+    if (fresh != RUN_MS / 1000 || queries >= fixed || ret) {
+        printf("FAIL: answers expired %d s of %d, %d queries\n", RUN_MS / 1000 - fresh, RUN_MS / 1000, queries);
+        ret = 1;
+    }
+    return ret;
+}
+
+int main(int argc, char **argv)
+{
+    int ret = 0;
+
+    mdns_bench_init_di();
+    if (mdns_init() || mdns_hostname_set("bench-host")) {
+        abort();
+    }
+    run_and_respond();
+    // one PCB, every query is one packet
+    for (int i = 0; i < MDNS_MAX_INTERFACES; i++) {
+        for (int j = 0; j < MDNS_IP_PROTOCOL_MAX; j++) {
+            mdns_pcb_t *pcb = &_mdns_server->interfaces[i].pcbs[j];
+            free(pcb->probe_services);
+            pcb->probe_services = NULL;
+            pcb->probe_services_len = 0;
+            pcb->probe_running = false;
+            pcb->state = i == 0 && j == MDNS_IP_PROTOCOL_V4 ? PCB_RUNNING : PCB_OFF;
+        }
+    }
+    mdns_bench_clear_tx_queue();
+    g_tick_step = 0;
+    g_tick_count = 1000;
+    g_tx_hook = capture;
+
+    printf("%-8s %-6s %-9s %-9s %-9s %-9s %-9s %s\n", "question", "ttl", "queries", "refresh", "fixed 1s", "avoided",
+           "avoided%", "fresh[s]");
+    ret |= run(false, 120);
+    ret |= run(false, 4500);
+    ret |= run(true, 120);
+    ret |= run(true, 4500);
+
+    g_tx_hook = NULL;
+    ForceTaskDelete();
+    mdns_free();
+    return ret;
+}
@@ -0,0 +1,394 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+/*
+ * Corpus replay: parse throughput of the responder on recorded traffic
+ *
+ * Replays mDNS packets through mdns_parse_packet() and the answer builder of a responder with a Matter operational
+ * instance, a commissionable instance and a HomeKit bridge. After each packet the timer runs until the answers it
+ * triggered are sent, 1 s of simulated time per packet, so the cache and the scheduler age as on a busy network.
+ * A corpus is a list of files or directories:
+ * - *.pcap: classic libpcap captures (Ethernet, Linux cooked or raw IP), the UDP payloads to or from port 5353
+ * - other files: one mDNS payload each, as the corpus of test_afl_fuzz_host
+ * Packets are grouped by the file name up to its first '_' or '-'. The first round warms the cache up and is not
+ * counted. It reports per group:
+ * - packets:     packets replayed per round
+ * - answers:     packets sent per round
+ * - pkt/s:       packets handled per second of CPU, parse, answer build and send
+ * - ns/pkt:      the same per packet
+ * - allocs/pkt:  mdns_mem_* allocations per packet
+ *
+ * Fails if the corpus is empty or if the allocations outstanding grow from one round to the next (a leak).
+ *
+ * Usage: bench_replay [-r rounds] [file|dir ...]
+ *        (default: 200 rounds of corpus/ and ../../test_afl_fuzz_host/in)
+ */
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp32_mock.h"
+#include "mdns.h"
+#include "mdns_private.h"
+#include "bench_util.h"
+
+void mdns_bench_init_di(void);
+int mdns_bench_clear_tx_queue(void);
+void mdns_parse_packet(mdns_rx_packet_t *packet);
+extern mdns_server_t *_mdns_server;
+
+#define MAX_PACKETS         4096
+#define MAX_GROUPS          32
+#define PACKET_GAP_MS       1000
+#define DEFAULT_ROUNDS      200
+
+typedef struct {
+    char name[32];
+    int packets;
+    uint32_t answers;
+    double us;
+    unsigned long allocs;
+} group_t;
+
+typedef struct {
+    uint8_t *data;
+    uint16_t len;
+    mdns_ip_protocol_t ip_protocol;
+    int group;
+} packet_t;
+
+static packet_t s_packets[MAX_PACKETS];
+static int s_packet_count;
+static group_t s_groups[MAX_GROUPS];
+static int s_group_count;
+
+static unsigned long s_allocs;
+static long s_outstanding;
+
+void *__real_mdns_mem_malloc(size_t size);
+void *__real_mdns_mem_calloc(size_t num, size_t size);
+char *__real_mdns_mem_strdup(const char *s);
+char *__real_mdns_mem_strndup(const char *s, size_t n);
+void __real_mdns_mem_free(void *ptr);
+
+static void *counted(void *ptr)
+{
+    if (ptr) {
+        s_allocs++;
+        s_outstanding++;
+    }
+    return ptr;
+}
+
+void *__wrap_mdns_mem_malloc(size_t size)
+{
+    return counted(__real_mdns_mem_malloc(size));
+}
+
+void *__wrap_mdns_mem_calloc(size_t num, size_t size)
+{
+    return counted(__real_mdns_mem_calloc(num, size));
+}
+
+char *__wrap_mdns_mem_strdup(const char *s)
+{
+    return counted(__real_mdns_mem_strdup(s));
+}
+
+char *__wrap_mdns_mem_strndup(const char *s, size_t n)
+{
+    return counted(__real_mdns_mem_strndup(s, n));
+}
+
+void __wrap_mdns_mem_free(void *ptr)
+{
+    if (ptr) {
+        s_outstanding--;
+    }
+    __real_mdns_mem_free(ptr);
+}
+
+static int group_of(const char *path)
+{
+    const char *base = strrchr(path, '/') ? strrchr(path, '/') + 1 : path;
+    size_t len = strcspn(base, "_-.");
+    for (int i = 0; i < s_group_count; i++) {
+        if (strlen(s_groups[i].name) == len && !strncmp(s_groups[i].name, base, len)) {
+            return i;
+        }
+    }
+    if (s_group_count == MAX_GROUPS || len >= sizeof(s_groups[0].name)) {
+        return MAX_GROUPS - 1;
+    }
+    memcpy(s_groups[s_group_count].name, base, len);
+    return s_group_count++;
+}
+
+static void add_packet(const uint8_t *data, size_t len, mdns_ip_protocol_t ip_protocol, int group)
+{
+    if (s_packet_count == MAX_PACKETS || len < MDNS_HEAD_LEN || len > MDNS_MAX_PACKET_SIZE) {
+        return;
+    }
+    packet_t *p = &s_packets[s_packet_count++];
+    p->data = malloc(len);
+    memcpy(p->data, data, len);
+    p->len = len;
+    p->ip_protocol = ip_protocol;
+    p->group = group;
+    s_groups[group].packets++;
+}
+
+static uint16_t read_u16(const uint8_t *p)
+{
+    return (p[0] << 8) | p[1];
+}
+
+static uint32_t read_u32(const uint8_t *p, bool swapped)
+{
+    return swapped ? ((uint32_t)p[3] << 24 | p[2] << 16 | p[1] << 8 | p[0])
+           : ((uint32_t)p[0] << 24 | p[1] << 16 | p[2] << 8 | p[3]);
+}
+
+// UDP payload of an IP packet to or from port 5353
+static void add_ip_packet(const uint8_t *ip, size_t len, int group)
+{
+    const uint8_t *udp;
+    mdns_ip_protocol_t ip_protocol;
+    if (len >= 20 && (ip[0] >> 4) == 4 && ip[9] == 17 && !(read_u16(ip + 6) & 0x3FFF)) {
+        size_t header = (ip[0] & 0x0F) * 4;
+        udp = ip + header;
+        len = len < read_u16(ip + 2) ? len : read_u16(ip + 2);
+        len = len > header ? len - header : 0;
+        ip_protocol = MDNS_IP_PROTOCOL_V4;
+    } else if (len >= 40 && (ip[0] >> 4) == 6 && ip[6] == 17) {
+        udp = ip + 40;
+        len -= 40;
+        ip_protocol = MDNS_IP_PROTOCOL_V6;
+    } else {
+        return;
+    }
+    if (len < 8 || (read_u16(udp) != MDNS_SERVICE_PORT && read_u16(udp + 2) != MDNS_SERVICE_PORT)) {
+        return;
+    }
+    len = len < read_u16(udp + 4) ? len : read_u16(udp + 4);
+    if (len > 8) {
+        add_packet(udp + 8, len - 8, ip_protocol, group);
+    }
+}
+
+static void load_pcap(const uint8_t *data, size_t len, int group)
+{
+    uint32_t magic = read_u32(data, false);
+    bool swapped = magic == 0xD4C3B2A1 || magic == 0x4D3CB2A1;
+    uint32_t link = read_u32(data + 20, swapped);
+    size_t offset = 24;
+    while (offset + 16 <= len) {
+        size_t caplen = read_u32(data + offset + 8, swapped);
+        const uint8_t *frame = data + offset + 16;
+        offset += 16 + caplen;
+        if (offset > len) {
+            break;
+        }
+        size_t skip = 0;
+        uint16_t ethertype = 0;
+        if (link == 1 && caplen >= 14) {           // Ethernet, one VLAN tag at most
+            skip = 14;
+            ethertype = read_u16(frame + 12);
+            if (ethertype == 0x8100 && caplen >= 18) {
+                skip = 18;
+                ethertype = read_u16(frame + 16);
+            }
+        } else if (link == 113 && caplen >= 16) {  // Linux cooked
+            skip = 16;
+            ethertype = read_u16(frame + 14);
+        } else if (link == 101 || link == 12) {     // Raw IP
+            ethertype = caplen && (frame[0] >> 4) == 6 ? 0x86DD : 0x0800;
+        }
+        if (ethertype == 0x0800 || ethertype == 0x86DD) {
+            add_ip_packet(frame + skip, caplen - skip, group);
+        }
+    }
+}
+
+static int load_file(const char *path)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        return 1;
+    }
+    uint8_t *data = malloc(1 << 24);
+    size_t len = fread(data, 1, 1 << 24, f);
+    fclose(f);
+    int group = group_of(path);
+    uint32_t magic = len >= 24 ? read_u32(data, false) : 0;
+    if (magic == 0xA1B2C3D4 || magic == 0xD4C3B2A1 || magic == 0xA1B23C4D || magic == 0x4D3CB2A1) {
+        load_pcap(data, len, group);
+    } else {
+        add_packet(data, len, MDNS_IP_PROTOCOL_V4, group);
+    }
+    free(data);
+    return 0;
+}
+
+static int load(const char *path)
+{
+    struct dirent **entries;
+    int count = scandir(path, &entries, NULL, alphasort);
+    if (count < 0) {
+        return load_file(path);
+    }
+    char file[512];
+    for (int i = 0; i < count; i++) {
+        const char *name = entries[i]->d_name;
+        size_t len = strlen(name);
+        if (name[0] != '.' && !(len > 3 && !strcmp(name + len - 3, ".py"))) {
+            snprintf(file, sizeof(file), "%s/%s", path, name);
+            load_file(file);
+        }
+        free(entries[i]);
+    }
+    free(entries);
+    return 0;
+}
+
+static void replay(packet_t *p, bool counted)
+{
+    struct pbuf pb = { .payload = p->data, .tot_len = p->len, .len = p->len };
+    mdns_rx_packet_t packet = {
+        .pb = &pb,
+        .tcpip_if = 0,
+        .ip_protocol = p->ip_protocol,
+        .src_port = MDNS_SERVICE_PORT,
+        .multicast = 1,
+    };
+    if (p->ip_protocol == MDNS_IP_PROTOCOL_V6) {
+        packet.src.type = ESP_IPADDR_TYPE_V6;
+        packet.src.u_addr.ip6.addr[0] = 0x000080FE;     // fe80::10
+        packet.src.u_addr.ip6.addr[3] = 0x10000000;
+    } else {
+        packet.src.type = ESP_IPADDR_TYPE_V4;
+        packet.src.u_addr.ip4.addr = 0x0A01A8C0;        // 192.168.1.10
+    }
+    group_t *g = &s_groups[p->group];
+    uint32_t sent = g_tx_packet_count;
+    unsigned long allocs = s_allocs;
+    double start = now_us();
+    mdns_parse_packet(&packet);
+    run_actions();
+    fire_until(g_tick_count + PACKET_GAP_MS);
+    if (counted) {
+        g->us += now_us() - start;
+        g->answers += g_tx_packet_count - sent;
+        g->allocs += s_allocs - allocs;
+    }
+}
+
+static void setup_responder(void)
+{
+    mdns_txt_item_t matter_txt[] = { {"SII", "5000"}, {"SAI", "300"}, {"T", "1"} };
+    mdns_txt_item_t commissionable_txt[] = { {"D", "3840"}, {"CM", "2"}, {"VP", "65521+32769"}, {"DT", "257"},
+        {"SII", "5000"}, {"SAI", "300"}, {"T", "1"}
+    };
+    mdns_txt_item_t hap_txt[] = { {"c#", "2"}, {"ff", "0"}, {"id", "A2:7C:31:0F:9E:44"}, {"md", "Bench Bridge"},
+        {"pv", "1.1"}, {"s#", "1"}, {"sf", "1"}, {"ci", "2"}, {"sh", "Wc1b6g=="}
+    };
+    if (mdns_init() || mdns_hostname_set("bench-host")) {
+        abort();
+    }
+    run_actions();
+    if (mdns_service_add("2906C908D115D362-8FC7772401CD0696", "_matter", "_tcp", 5540, matter_txt, 3)
+            || mdns_service_subtype_add_for_host(NULL, "_matter", "_tcp", NULL, "_I2906C908D115D362")
+            || mdns_service_add("DD200C20D25AE5F7", "_matterc", "_udp", 5540, commissionable_txt, 7)
+            || mdns_service_subtype_add_for_host(NULL, "_matterc", "_udp", NULL, "_L3840")
+            || mdns_service_subtype_add_for_host(NULL, "_matterc", "_udp", NULL, "_S15")
+            || mdns_service_subtype_add_for_host(NULL, "_matterc", "_udp", NULL, "_CM")
+            || mdns_service_add("Bench Bridge", "_hap", "_tcp", 8080, hap_txt, 9)) {
+        abort();
+    }
+    run_actions();
+    // interface 0 running on both protocols, without probing
+    for (int i = 0; i < MDNS_MAX_INTERFACES; i++) {
+        for (int j = 0; j < MDNS_IP_PROTOCOL_MAX; j++) {
+            mdns_pcb_t *pcb = &_mdns_server->interfaces[i].pcbs[j];
+            free(pcb->probe_services);
+            pcb->probe_services = NULL;
+            pcb->probe_services_len = 0;
+            pcb->probe_running = false;
+            pcb->state = i == 0 ? PCB_RUNNING : PCB_OFF;
+        }
+    }
+    mdns_bench_clear_tx_queue();
+}
+
+int main(int argc, char **argv)
+{
+    int rounds = DEFAULT_ROUNDS;
+    int arg = 1;
+    int ret = 0;
+
+    if (argc > 2 && !strcmp(argv[1], "-r")) {
+        rounds = atoi(argv[2]) > 1 ? atoi(argv[2]) : 2;
+        arg = 3;
+    }
+    if (arg == argc) {
+        load("corpus");
+        load("../../test_afl_fuzz_host/in");
+    }
+    for (; arg < argc; arg++) {
+        if (load(argv[arg])) {
+            printf("FAIL: cannot read %s\n", argv[arg]);
+            return 1;
+        }
+    }
+    if (!s_packet_count) {
+        printf("FAIL: no mDNS packet in the corpus\n");
+        return 1;
+    }
+
+    mdns_bench_init_di();
+    setup_responder();
+    g_tick_step = 0;
+    g_tick_count = 1000;
+
+    long outstanding = 0;
+    for (int r = 0; r < rounds; r++) {
+        for (int i = 0; i < s_packet_count; i++) {
+            replay(&s_packets[i], r > 0);
+        }
+        // the cache settles in the first rounds, after that every round must end with what it started with
+        if (r == rounds / 2) {
+            outstanding = s_outstanding;
+        }
+    }
+    if (s_outstanding > outstanding) {
+        printf("FAIL: %ld allocations outstanding after %d rounds, %ld after %d\n", s_outstanding, rounds, outstanding,
+               rounds / 2 + 1);
+        ret = 1;
+    }
+
+    int counted = rounds - 1;
+    group_t total = { .name = "total" };
+    printf("%-12s %-8s %-8s %-10s %-8s %s\n", "group", "packets", "answers", "pkt/s", "ns/pkt", "allocs/pkt");
+    for (int i = 0; i <= s_group_count; i++) {
+        group_t *g = i < s_group_count ? &s_groups[i] : &total;
+        if (i < s_group_count) {
+            total.packets += g->packets;
+            total.answers += g->answers;
+            total.us += g->us;
+            total.allocs += g->allocs;
+        }
+        double handled = (double)g->packets * counted;
+        printf("%-12s %-8d %-8.1f %-10.0f %-8.0f %.2f\n", g->name, g->packets, g->answers / (double)counted,
+               handled / g->us * 1e6, g->us * 1e3 / handled, g->allocs / handled);
+    }
+
+    for (int i = 0; i < s_packet_count; i++) {
+        free(s_packets[i].data);
+    }
+    ForceTaskDelete();
+    mdns_free();
+    return ret;
+}
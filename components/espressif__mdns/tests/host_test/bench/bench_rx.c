@@ -0,0 +1,338 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+/*
+ * Query handling load test
+ *
+ * Registers 10, 100 and 500 services (every 10th one on a delegated host) and feeds single-question
+ * queries through mdns_parse_packet(), including the answer build. Reports the CPU time per query
+ * packet for each kind of question and checks that only questions for our names get answered.
+ *
+ * The second table registers the same numbers of instances of one type, _matter._tcp, each with its
+ * own subtype, as a Matter bridge does. It reports SRV, TXT and subtype PTR queries and
+ * mdns_service_exists() on a delegated host, then checks that lookups still find the services after
+ * an instance rename and a hostname change.
+ *
+ * Usage: bench_rx [iterations]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp32_mock.h"
+#include "mdns.h"
+#include "mdns_private.h"
+#include "bench_util.h"
+
+void mdns_bench_init_di(void);
+int mdns_bench_clear_tx_queue(void);
+void mdns_parse_packet(mdns_rx_packet_t *packet);
+extern mdns_server_t *_mdns_server;
+
+#define BENCH_QUERIES 64
+
+typedef enum {
+    QUERY_PTR,
+    QUERY_SRV,
+    QUERY_TXT,
+    QUERY_HOST,
+    QUERY_OTHER_PTR,
+    QUERY_OTHER_HOST,
+    QUERY_KINDS,
+    QUERY_SUBTYPE = QUERY_KINDS,
+    QUERY_EXISTS,
+    QUERY_ALL_KINDS
+} query_kind_t;
+
+static const char *s_kind_names[QUERY_ALL_KINDS] = {
+    "PTR service", "SRV instance", "TXT instance", "A delegated", "PTR foreign", "A foreign", "PTR subtype", "exists host"
+};
+
+static const query_kind_t s_shared_kinds[] = {QUERY_SRV, QUERY_TXT, QUERY_SUBTYPE, QUERY_EXISTS};
+
+// All the services are instances of _matter._tcp
+static bool s_shared;
+
+typedef struct {
+    uint8_t data[256];
+    uint16_t len;
+} query_t;
+
+static void build_query(query_t *q, const char *labels[], int count, uint16_t type)
+{
+    memset(q, 0, sizeof(query_t));
+    q->len = MDNS_HEAD_LEN;
+    q->data[MDNS_HEAD_QUESTIONS_OFFSET + 1] = 1;
+    for (int i = 0; i < count; i++) {
+        put_label(q->data, &q->len, labels[i]);
+    }
+    put_label(q->data, &q->len, "local");
+    q->data[q->len++] = 0;
+    q->data[q->len++] = type >> 8;
+    q->data[q->len++] = type & 0xFF;
+    q->data[q->len++] = 0x00;
+    q->data[q->len++] = 0x01;
+}
+
+// Completes probing and announcing on all PCBs, as if the probes went unanswered
+static void set_pcbs_running(void)
+{
+    for (int i = 0; i < MDNS_MAX_INTERFACES; i++) {
+        for (int j = 0; j < MDNS_IP_PROTOCOL_MAX; j++) {
+            mdns_pcb_t *pcb = &_mdns_server->interfaces[i].pcbs[j];
+            free(pcb->probe_services);
+            pcb->probe_services = NULL;
+            pcb->probe_services_len = 0;
+            pcb->probe_running = false;
+            pcb->state = PCB_RUNNING;
+        }
+    }
+    mdns_bench_clear_tx_queue();
+}
+
+static void service_names(int i, char *instance, char *service, char *host)
+{
+    sprintf(instance, "Bench Node %03d", i);
+    if (s_shared) {
+        strcpy(service, "_matter");
+        sprintf(host, "shared-peer-%02d", i / 10);
+    } else {
+        sprintf(service, "_bench%03d", i);
+        sprintf(host, "bench-peer-%02d", i / 10);
+    }
+}
+
+static const char *service_proto(int i)
+{
+    return s_shared || i % 2 == 0 ? "_tcp" : "_udp";
+}
+
+static void add_service(int i)
+{
+    char instance[32], service[16], host[32];
+    mdns_txt_item_t txt[2] = {
+        {"board", "esp32c6"},
+        {"path", "/"},
+    };
+    service_names(i, instance, service, host);
+    if (i % 10 == 0) {
+        mdns_ip_addr_t addr = { .addr = { .type = ESP_IPADDR_TYPE_V4 } };
+        addr.addr.u_addr.ip4.addr = 0x0A000000 + i;
+        if (mdns_delegate_hostname_add(host, &addr)) {
+            abort();
+        }
+        mdns_action_t *a = NULL;
+        GetLastItem(&a);
+        mdns_test_execute_action(a);
+    }
+    if (mdns_service_add_for_host(instance, service, service_proto(i), i % 10 == 0 ? host : NULL,
+                                  1000 + i, txt, 2)) {
+        abort();
+    }
+    if (s_shared) {
+        char subtype[16];
+        sprintf(subtype, "_L%d", i);
+        if (mdns_service_subtype_add_for_host(instance, service, "_tcp", i % 10 == 0 ? host : NULL, subtype)) {
+            abort();
+        }
+    }
+}
+
+static void build_queries(query_t *queries, query_kind_t kind, int services)
+{
+    char instance[32], service[16], host[32], subtype[16];
+    for (int i = 0; i < BENCH_QUERIES; i++) {
+        int target = rand() % services;
+        service_names(target, instance, service, host);
+        sprintf(subtype, "_L%d", target);
+        const char *proto = service_proto(target);
+        const char *ptr[] = {service, proto};
+        const char *srv[] = {instance, service, proto};
+        const char *sub[] = {subtype, "_sub", service, proto};
+        const char *peer[] = {host};
+        const char *other_ptr[] = {"_googlecast", "_tcp"};
+        const char *other_host[] = {"Living-Room-TV"};
+        switch (kind) {
+        case QUERY_PTR:
+            build_query(&queries[i], ptr, 2, MDNS_TYPE_PTR);
+            break;
+        case QUERY_SRV:
+            build_query(&queries[i], srv, 3, MDNS_TYPE_SRV);
+            break;
+        case QUERY_TXT:
+            build_query(&queries[i], srv, 3, MDNS_TYPE_TXT);
+            break;
+        case QUERY_HOST:
+            // Delegated hosts exist for every 10th service
+            sprintf(host, "bench-peer-%02d", target / 10);
+            build_query(&queries[i], peer, 1, MDNS_TYPE_A);
+            break;
+        case QUERY_OTHER_PTR:
+            build_query(&queries[i], other_ptr, 2, MDNS_TYPE_PTR);
+            break;
+        case QUERY_SUBTYPE:
+            build_query(&queries[i], sub, 4, MDNS_TYPE_PTR);
+            break;
+        case QUERY_EXISTS:
+            // mdns_service_exists() on the delegated host of the target, kept in the query name
+            sprintf((char *)queries[i].data, "%s-peer-%02d", s_shared ? "shared" : "bench", target / 10);
+            break;
+        default:
+            build_query(&queries[i], other_host, 1, MDNS_TYPE_A);
+            break;
+        }
+    }
+}
+
+static mdns_rx_packet_t s_packet;
+static struct pbuf s_pb;
+
+// Runs the queries of one kind, returns the time per query or -1 if they were not answered as expected
+static double run_queries(query_kind_t kind, int services, int iterations)
+{
+    static query_t queries[BENCH_QUERIES];
+    bool ours = kind != QUERY_OTHER_PTR && kind != QUERY_OTHER_HOST;
+    int answered = 0;
+    build_queries(queries, kind, services);
+    double start = now_us();
+    for (int i = 0; i < iterations; i++) {
+        query_t *q = &queries[i % BENCH_QUERIES];
+        if (kind == QUERY_EXISTS) {
+            answered += mdns_service_exists("_matter", "_tcp", (const char *)q->data);
+            continue;
+        }
+        uint32_t sent = g_tx_packet_count;
+        s_pb.payload = q->data;
+        s_pb.len = q->len;
+        mdns_parse_packet(&s_packet);
+        answered += (g_tx_packet_count != sent) + mdns_bench_clear_tx_queue() > 0;
+    }
+    double elapsed = now_us() - start;
+    if (answered != (ours ? iterations : 0)) {
+        printf("\nFAIL: %s answered %d of %d queries\n", s_kind_names[kind], answered, iterations);
+        return -1;
+    }
+    return elapsed / iterations;
+}
+
+static void execute_last_action(void)
+{
+    mdns_action_t *a = NULL;
+    GetLastItem(&a);
+    mdns_test_execute_action(a);
+}
+
+// The services must still be found through the indexes after their names changed
+static int check_renames(int services)
+{
+    char instance[32], service[16], host[32];
+    int ret = 0;
+    service_names(1, instance, service, host);
+    if (mdns_service_instance_name_set_for_host(instance, service, "_tcp", NULL, "Renamed Node") ||
+            !mdns_service_exists_with_instance("Renamed Node", service, "_tcp", NULL) ||
+            mdns_service_exists_with_instance(instance, service, "_tcp", NULL)) {
+        printf("FAIL: instance rename\n");
+        ret = 1;
+    }
+    set_pcbs_running();
+    if (mdns_hostname_set("bench-host-2")) {
+        abort();
+    }
+    execute_last_action();
+    set_pcbs_running();
+    service_names(services - 1, instance, service, host);
+    if (!mdns_service_exists(service, "_tcp", "bench-host-2") || mdns_service_exists(service, "_tcp", "bench-host") ||
+            run_queries(QUERY_SUBTYPE, services, BENCH_QUERIES) < 0) {
+        printf("FAIL: lookups after the hostname change\n");
+        ret = 1;
+    }
+    // the rebuilt indexes must hold every service
+    int missing = 0;
+    for (int i = 0; i < services; i++) {
+        service_names(i, instance, service, host);
+        missing += !mdns_service_exists_with_instance(i == 1 ? "Renamed Node" : instance, service, "_tcp",
+                                                      i % 10 == 0 ? host : "bench-host-2");
+    }
+    if (missing) {
+        printf("FAIL: %d services missing from the indexes after the hostname change\n", missing);
+        ret = 1;
+    }
+    return ret;
+}
+
+int main(int argc, char **argv)
+{
+    int iterations = argc > 1 ? atoi(argv[1]) : 20000;
+    const int steps[] = {10, 100, 500};
+    int registered = 0;
+    int ret = 0;
+
+    srand(1);
+    mdns_bench_init_di();
+    if (mdns_init()) {
+        abort();
+    }
+    set_pcbs_running();
+    if (mdns_hostname_set("bench-host")) {
+        abort();
+    }
+    execute_last_action();
+
+    s_packet.pb = &s_pb;
+    s_packet.ip_protocol = MDNS_IP_PROTOCOL_V4;
+    s_packet.src.type = ESP_IPADDR_TYPE_V4;
+    s_packet.src.u_addr.ip4.addr = 0x3201A8C0;   // 192.168.1.50, not our address
+    s_packet.src_port = MDNS_SERVICE_PORT;
+    s_packet.multicast = 1;
+
+    printf("%-9s", "services");
+    for (int k = 0; k < QUERY_KINDS; k++) {
+        printf(" %-13s", s_kind_names[k]);
+    }
+    printf("  [us/query]\n");
+    for (size_t s = 0; s < sizeof(steps) / sizeof(steps[0]); s++) {
+        int n = steps[s];
+        while (registered < n) {
+            add_service(registered++);
+            set_pcbs_running();
+        }
+        printf("%-9d", n);
+        for (query_kind_t kind = 0; kind < QUERY_KINDS; kind++) {
+            double us = run_queries(kind, n, iterations);
+            ret |= us < 0;
+            printf(" %-13.2f", us);
+        }
+        printf("\n");
+    }
+    mdns_service_remove_all();
+
+    s_shared = true;
+    registered = 0;
+    printf("\n%-9s", "_matter");
+    for (size_t k = 0; k < sizeof(s_shared_kinds) / sizeof(s_shared_kinds[0]); k++) {
+        printf(" %-13s", s_kind_names[s_shared_kinds[k]]);
+    }
+    printf("  [us/query]\n");
+    for (size_t s = 0; s < sizeof(steps) / sizeof(steps[0]); s++) {
+        int n = steps[s];
+        while (registered < n) {
+            add_service(registered++);
+            set_pcbs_running();
+        }
+        printf("%-9d", n);
+        for (size_t k = 0; k < sizeof(s_shared_kinds) / sizeof(s_shared_kinds[0]); k++) {
+            double us = run_queries(s_shared_kinds[k], n, iterations);
+            ret |= us < 0;
+            printf(" %-13.2f", us);
+        }
+        printf("\n");
+    }
+    ret |= check_renames(registered);
+
+    mdns_service_remove_all();
+    ForceTaskDelete();
+    mdns_free();
+    return ret;
+}
@@ -0,0 +1,307 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+/*
+ * Socket networking backend, local UDP flood (Linux only)
+ *
+ * Links mdns_networking_socket.c alone, without the engine: the RX actions it posts go to a ring served by
+ * a consumer thread standing in for the mDNS task, which reads the packet and hands it back with
+ * _mdns_packet_free(). A sender thread floods the backend's socket on the loopback interface with
+ * query-sized datagrams. Reports the packets delivered per second, the socket calls of the receive task
+ * (counted by wrapping them at link time) and the heap allocations per packet. Then times bursts of
+ * _mdns_udp_pcb_write() with and without _mdns_udp_pcb_batch_begin()/_mdns_udp_pcb_batch_flush(), and the
+ * time _mdns_pcb_deinit() takes to stop the receive task.
+ *
+ * Usage: bench_rx_socket [seconds]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <sys/epoll.h>
+#include <sys/select.h>
+
+#include "mdns.h"
+#include "mdns_private.h"
+#include "mdns_networking.h"
+#include "mdns_mem_caps.h"
+
+#define RING_LEN        CONFIG_MDNS_ACTION_QUEUE_LEN
+#define DATAGRAM_LEN    64
+#define TX_BURST        16
+#define TX_ROUNDS       20000
+#define TX_SINK_PORT    5354
+
+// Action queue of the mDNS task
+
+static struct {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    mdns_action_t *items[RING_LEN];
+    unsigned head, tail;
+} s_ring = { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER };
+
+static bool s_running = true;
+static unsigned long s_allocs;
+static unsigned long s_received;
+static unsigned long s_rx_calls;
+static unsigned long s_tx_calls;
+
+// Socket calls of the backend, see the --wrap options of the Makefile
+#define WRAP_COUNT(counter, ret, name, params, args)    \
+    ret __real_##name params;                           \
+    ret __wrap_##name params                            \
+    {                                                   \
+        __atomic_add_fetch(&counter, 1, __ATOMIC_RELAXED); \
+        return __real_##name args;                      \
+    }
+
+WRAP_COUNT(s_rx_calls, int, select, (int n, fd_set *r, fd_set *w, fd_set *e, struct timeval *tv), (n, r, w, e, tv))
+WRAP_COUNT(s_rx_calls, int, epoll_wait, (int fd, struct epoll_event *ev, int max, int timeout), (fd, ev, max, timeout))
+WRAP_COUNT(s_rx_calls, ssize_t, recv, (int fd, void *buf, size_t len, int flags), (fd, buf, len, flags))
+WRAP_COUNT(s_rx_calls, ssize_t, recvfrom, (int fd, void *buf, size_t len, int flags, struct sockaddr *addr, socklen_t *alen),
+           (fd, buf, len, flags, addr, alen))
+WRAP_COUNT(s_rx_calls, int, recvmmsg, (int fd, struct mmsghdr *msgs, unsigned int n, int flags, struct timespec *t),
+           (fd, msgs, n, flags, t))
+WRAP_COUNT(s_tx_calls, ssize_t, sendto, (int fd, const void *buf, size_t len, int flags, const struct sockaddr *addr,
+                                         socklen_t alen), (fd, buf, len, flags, addr, alen))
+WRAP_COUNT(s_tx_calls, int, sendmmsg, (int fd, struct mmsghdr *msgs, unsigned int n, int flags), (fd, msgs, n, flags))
+
+void *mdns_mem_malloc(size_t size)
+{
+    __atomic_add_fetch(&s_allocs, 1, __ATOMIC_RELAXED);
+    return malloc(size);
+}
+
+void *mdns_mem_calloc(size_t num, size_t size)
+{
+    __atomic_add_fetch(&s_allocs, 1, __ATOMIC_RELAXED);
+    return calloc(num, size);
+}
+
+void mdns_mem_free(void *ptr)
+{
+    free(ptr);
+}
+
+static bool ring_push(mdns_action_t *action)
+{
+    bool ok = false;
+    pthread_mutex_lock(&s_ring.lock);
+    if (s_ring.head - s_ring.tail < RING_LEN) {
+        s_ring.items[s_ring.head++ % RING_LEN] = action;
+        pthread_cond_signal(&s_ring.cond);
+        ok = true;
+    }
+    pthread_mutex_unlock(&s_ring.lock);
+    return ok;
+}
+
+// Same contract as the engine's: an action that the mDNS task releases after the packet
+esp_err_t _mdns_send_rx_action(mdns_rx_packet_t *packet)
+{
+    mdns_action_t *action = mdns_mem_malloc(sizeof(mdns_action_t));
+    if (!action) {
+        return ESP_ERR_NO_MEM;
+    }
+    action->type = ACTION_RX_HANDLE;
+    action->data.rx_handle.packet = packet;
+    if (!ring_push(action)) {
+        mdns_mem_free(action);
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+
+esp_err_t _mdns_send_pooled_rx_action(mdns_action_t *action, mdns_rx_packet_t *packet)
+{
+    action->type = ACTION_RX_HANDLE_POOLED;
+    action->data.rx_handle.packet = packet;
+    return ring_push(action) ? ESP_OK : ESP_ERR_NO_MEM;
+}
+
+static void *mdns_task(void *arg)
+{
+    while (true) {
+        pthread_mutex_lock(&s_ring.lock);
+        while (__atomic_load_n(&s_running, __ATOMIC_RELAXED) && s_ring.head == s_ring.tail) {
+            pthread_cond_wait(&s_ring.cond, &s_ring.lock);
+        }
+        if (s_ring.head == s_ring.tail) {
+            pthread_mutex_unlock(&s_ring.lock);
+            return NULL;
+        }
+        mdns_action_t *action = s_ring.items[s_ring.tail++ % RING_LEN];
+        pthread_mutex_unlock(&s_ring.lock);
+
+        // A pooled action goes back with its packet, it must not be touched after _mdns_packet_free()
+        mdns_rx_packet_t *packet = action->data.rx_handle.packet;
+        bool pooled = action->type == ACTION_RX_HANDLE_POOLED;
+        const uint8_t *data = _mdns_get_packet_data(packet);
+        size_t len = _mdns_get_packet_len(packet);
+        if (len != DATAGRAM_LEN || data[MDNS_HEAD_QUESTIONS_OFFSET + 1] != 1 || packet->src_port == 0) {
+            printf("FAIL: corrupted packet (len=%zu)\n", len);
+            exit(1);
+        }
+        __atomic_add_fetch(&s_received, 1, __ATOMIC_RELAXED);
+        _mdns_packet_free(packet);
+        if (!pooled) {
+            mdns_mem_free(action);
+        }
+    }
+}
+
+static void *sender_task(void *arg)
+{
+    uint8_t datagram[DATAGRAM_LEN] = {0};
+    struct sockaddr_in to = { .sin_family = AF_INET, .sin_port = htons(MDNS_SERVICE_PORT) };
+    int sock = socket(AF_INET, SOCK_DGRAM, 0);
+    to.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    datagram[MDNS_HEAD_QUESTIONS_OFFSET + 1] = 1;
+    while (__atomic_load_n(&s_running, __ATOMIC_RELAXED)) {
+        sendto(sock, datagram, sizeof(datagram), 0, (struct sockaddr *)&to, sizeof(to));
+    }
+    close(sock);
+    return NULL;
+}
+
+// Tasks of the networking backend
+BaseType_t xTaskCreate(void (*task)(void *), const char *name, uint32_t stack_size, void *arg, uint32_t priority,
+                       TaskHandle_t *handle)
+{
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, (void *(*)(void *))task, arg)) {
+        return pdFALSE;
+    }
+    pthread_detach(thread);
+    return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t task)
+{
+    pthread_exit(NULL);
+}
+
+// The loopback interface stands in for the netif
+esp_netif_t *_mdns_get_esp_netif(mdns_if_t tcpip_if)
+{
+    return (esp_netif_t *)1;
+}
+
+esp_err_t esp_netif_get_netif_impl_name(esp_netif_t *esp_netif, char *name)
+{
+    strcpy(name, "lo");
+    return ESP_OK;
+}
+
+int esp_netif_get_netif_impl_index(esp_netif_t *esp_netif)
+{
+    return 1;
+}
+
+const char *esp_netif_get_desc(esp_netif_t *esp_netif)
+{
+    return "lo";
+}
+
+esp_err_t esp_netif_get_ip_info(esp_netif_t *esp_netif, esp_netif_ip_info_t *ip_info)
+{
+    ip_info->ip.addr = htonl(INADDR_LOOPBACK);
+    return ESP_OK;
+}
+
+static double clock_s(clockid_t clock)
+{
+    struct timespec ts;
+    clock_gettime(clock, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Time and socket calls per packet of bursts sent to a local sink that nobody reads, the kernel drops
+// what overflows
+static double tx_burst_ns(bool batched, double *calls)
+{
+    static uint8_t data[200];
+    esp_ip_addr_t dst = { .type = ESP_IPADDR_TYPE_V4 };
+    struct sockaddr_in sink_addr = { .sin_family = AF_INET, .sin_port = htons(TX_SINK_PORT) };
+    int sink = socket(AF_INET, SOCK_DGRAM, 0);
+    sink_addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    bind(sink, (struct sockaddr *)&sink_addr, sizeof(sink_addr));
+    dst.u_addr.ip4.addr = htonl(INADDR_LOOPBACK);
+
+    unsigned long tx_calls = s_tx_calls;
+    double start = clock_s(CLOCK_MONOTONIC);
+    for (int r = 0; r < TX_ROUNDS; r++) {
+        if (batched) {
+            _mdns_udp_pcb_batch_begin();
+        }
+        for (int i = 0; i < TX_BURST; i++) {
+            if (_mdns_udp_pcb_write(0, MDNS_IP_PROTOCOL_V4, &dst, TX_SINK_PORT, data, sizeof(data)) != sizeof(data)) {
+                printf("FAIL: _mdns_udp_pcb_write()\n");
+                exit(1);
+            }
+        }
+        if (batched) {
+            _mdns_udp_pcb_batch_flush();
+        }
+    }
+    double elapsed = clock_s(CLOCK_MONOTONIC) - start;
+    close(sink);
+    *calls = (double)(s_tx_calls - tx_calls) / (TX_ROUNDS * TX_BURST);
+    return elapsed * 1e9 / (TX_ROUNDS * TX_BURST);
+}
+
+int main(int argc, char **argv)
+{
+    int seconds = argc > 1 ? atoi(argv[1]) : 3;
+    pthread_t consumer, sender;
+
+    if (_mdns_pcb_init(0, MDNS_IP_PROTOCOL_V4) != ESP_OK) {
+        printf("SKIP: cannot bind UDP port %d on the loopback interface\n", MDNS_SERVICE_PORT);
+        return 0;
+    }
+    pthread_create(&consumer, NULL, mdns_task, NULL);
+    pthread_create(&sender, NULL, sender_task, NULL);
+
+    // Let the receive task get going before counting
+    usleep(200 * 1000);
+    unsigned long received = __atomic_load_n(&s_received, __ATOMIC_RELAXED);
+    unsigned long allocs = __atomic_load_n(&s_allocs, __ATOMIC_RELAXED);
+    unsigned long rx_calls = __atomic_load_n(&s_rx_calls, __ATOMIC_RELAXED);
+    double start = clock_s(CLOCK_MONOTONIC);
+    sleep(seconds);
+    double elapsed = clock_s(CLOCK_MONOTONIC) - start;
+    rx_calls = __atomic_load_n(&s_rx_calls, __ATOMIC_RELAXED) - rx_calls;
+    received = __atomic_load_n(&s_received, __ATOMIC_RELAXED) - received;
+    allocs = __atomic_load_n(&s_allocs, __ATOMIC_RELAXED) - allocs;
+
+    __atomic_store_n(&s_running, false, __ATOMIC_RELAXED);
+    pthread_join(sender, NULL);
+    pthread_mutex_lock(&s_ring.lock);
+    pthread_cond_signal(&s_ring.cond);
+    pthread_mutex_unlock(&s_ring.lock);
+    pthread_join(consumer, NULL);
+    double tx_single_calls, tx_batch_calls;
+    double tx_single = tx_burst_ns(false, &tx_single_calls);
+    double tx_batch = tx_burst_ns(true, &tx_batch_calls);
+    start = clock_s(CLOCK_MONOTONIC);
+    _mdns_pcb_deinit(0, MDNS_IP_PROTOCOL_V4);
+    double stop_ms = (clock_s(CLOCK_MONOTONIC) - start) * 1e3;
+
+    printf("%-11s %-14s %-11s %-18s %-18s %-8s\n", "packets/s", "rx calls/pkt", "allocs/pkt", "tx single[ns|calls]",
+           "tx batch[ns|calls]", "stop[ms]");
+    printf("%-11.0f %-14.2f %-11.2f %-6.0f %-11.3f %-6.0f %-11.3f %-8.1f\n", received / elapsed,
+           received ? (double)rx_calls / received : 0.0, received ? (double)allocs / received : 0.0,
+           tx_single, tx_single_calls, tx_batch, tx_batch_calls, stop_ms);
+    if (received == 0) {
+        printf("FAIL: no packet received\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,227 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+/*
+ * TX scheduler under a probe/announce storm
+ *
+ * Fills the TX queue with 16 to 1024 packets spread over all PCBs, using the delays of probes (120-247 ms),
+ * probe/announce repeats (250 ms, 1000 ms) and delayed shared answers (25-100 ms). Then measures known-answer
+ * removal, service removal and the timer tick + TX action loop that drains the queue through the mocked socket.
+ * Every phase checks that the heap and the per-PCB lists agree and that packets leave in send_at order.
+ * The second table schedules all the packets on one PCB.
+ *
+ * Usage: bench_sched [rounds]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp32_mock.h"
+#include "mdns.h"
+#include "mdns_private.h"
+#include "bench_util.h"
+
+void mdns_bench_init_di(void);
+int mdns_bench_clear_tx_queue(void);
+mdns_tx_packet_t *mdns_bench_schedule_answer(mdns_if_t tcpip_if, mdns_ip_protocol_t ip_protocol, mdns_service_t *service,
+                                             bool distributed, uint32_t ms_after);
+void mdns_bench_scheduler_run(void);
+void mdns_bench_remove_scheduled_answer(mdns_if_t tcpip_if, mdns_ip_protocol_t ip_protocol, uint16_t type, mdns_srv_item_t *service);
+void mdns_bench_remove_scheduled_service_packets(mdns_service_t *service);
+extern mdns_server_t *_mdns_server;
+
+#define BENCH_SERVICES  16
+#define BENCH_PCBS      (MDNS_MAX_INTERFACES * MDNS_IP_PROTOCOL_MAX)
+
+static mdns_srv_item_t *s_services[BENCH_SERVICES];
+static int s_pcbs = BENCH_PCBS;     // PCBs the storm is spread over
+
+static uint32_t storm_delay(int i)
+{
+    switch (i % 4) {
+    case 0:
+        return 120 + (rand() & 0x7F);
+    case 1:
+        return 250;
+    case 2:
+        return 1000;
+    default:
+        return 25 + (rand() % 4) * 25;
+    }
+}
+
+static void schedule_storm(int depth)
+{
+    for (int i = 0; i < depth; i++) {
+        int pcb = rand() % s_pcbs;
+        mdns_bench_schedule_answer(pcb / MDNS_IP_PROTOCOL_MAX, pcb % MDNS_IP_PROTOCOL_MAX,
+                                   s_services[rand() % BENCH_SERVICES]->service, i % 4 == 3, storm_delay(i));
+    }
+}
+
+static bool send_at_before(const mdns_tx_packet_t *a, const mdns_tx_packet_t *b)
+{
+    int32_t diff = (int32_t)(a->send_at - b->send_at);
+    return diff < 0 || (diff == 0 && (int32_t)(a->seq - b->seq) < 0);
+}
+
+// Heap order, heap indexes and per-PCB lists must describe the same set of packets
+static bool check_queue(void)
+{
+    size_t len = _mdns_server->tx_queue.len;
+    mdns_tx_packet_t **heap = _mdns_server->tx_queue.heap;
+    size_t listed = 0;
+    for (size_t i = 0; i < len; i++) {
+        if (heap[i]->heap_index != i || (i > 0 && send_at_before(heap[i], heap[(i - 1) / 2]))) {
+            return false;
+        }
+    }
+    for (int i = 0; i < MDNS_MAX_INTERFACES; i++) {
+        for (int j = 0; j < MDNS_IP_PROTOCOL_MAX; j++) {
+            mdns_tx_packet_t *prev = NULL;
+            for (mdns_tx_packet_t *p = _mdns_server->interfaces[i].pcbs[j].tx_packets; p; prev = p, p = p->next) {
+                if (p->tcpip_if != i || p->ip_protocol != j || p->heap_index >= len || heap[p->heap_index] != p
+                        || p->prev != prev) {
+                    return false;
+                }
+                listed++;
+            }
+        }
+    }
+    return listed == len;
+}
+
+static void set_pcbs_running(void)
+{
+    for (int i = 0; i < MDNS_MAX_INTERFACES; i++) {
+        for (int j = 0; j < MDNS_IP_PROTOCOL_MAX; j++) {
+            mdns_pcb_t *pcb = &_mdns_server->interfaces[i].pcbs[j];
+            free(pcb->probe_services);
+            pcb->probe_services = NULL;
+            pcb->probe_services_len = 0;
+            pcb->probe_running = false;
+            pcb->state = PCB_RUNNING;
+        }
+    }
+    mdns_bench_clear_tx_queue();
+}
+
+// Timer ticks until the queue is empty, returns the number of ticks or -1 if a packet left out of order
+static int drain(double *tick_us, double *tx_us)
+{
+    int ticks = 0;
+    uint32_t last_sent = 0;
+    bool first = true;
+    while (_mdns_server->tx_queue.len) {
+        double t0 = now_us();
+        mdns_bench_scheduler_run();
+        double t1 = now_us();
+        *tick_us += t1 - t0;
+        ticks++;
+        if (!_mdns_server->tx_queue.handle_pending) {
+            continue;
+        }
+        uint32_t head = _mdns_server->tx_queue.heap[0]->send_at;
+        if (!first && (int32_t)(head - last_sent) < 0) {
+            return -1;
+        }
+        first = false;
+        last_sent = head;
+        mdns_action_t *a = NULL;
+        GetLastItem(&a);
+        t0 = now_us();
+        mdns_test_execute_action(a);
+        *tx_us += now_us() - t0;
+        if (!check_queue()) {
+            return -1;
+        }
+    }
+    return ticks;
+}
+
+static int run(int rounds)
+{
+    const int depths[] = {16, 64, 256, 1024};
+    int ret = 0;
+
+    printf("%-7s %-12s %-12s %-13s %-9s %-12s %-10s\n", "depth", "schedule[ns]", "known-ans[ns]",
+           "srv-remove[us]", "ticks", "tick[ns]", "tx[us/pkt]");
+    for (size_t d = 0; d < sizeof(depths) / sizeof(depths[0]); d++) {
+        int depth = depths[d];
+        double schedule_us = 0, known_us = 0, remove_us = 0, tick_us = 0, tx_us = 0;
+        long ticks = 0, sent = 0;
+        for (int r = 0; r < rounds; r++) {
+            double t0 = now_us();
+            schedule_storm(depth);
+            schedule_us += now_us() - t0;
+            if (!check_queue()) {
+                printf("FAIL: queue inconsistent after scheduling %d packets\n", depth);
+                return 1;
+            }
+
+            // Known answers from a querier on one PCB remove our shared answers there
+            t0 = now_us();
+            for (int i = 0; i < BENCH_SERVICES; i++) {
+                mdns_bench_remove_scheduled_answer(i % MDNS_MAX_INTERFACES, MDNS_IP_PROTOCOL_V4, MDNS_TYPE_PTR, s_services[i]);
+            }
+            known_us += now_us() - t0;
+
+            t0 = now_us();
+            mdns_bench_remove_scheduled_service_packets(s_services[r % BENCH_SERVICES]->service);
+            remove_us += now_us() - t0;
+            if (!check_queue()) {
+                printf("FAIL: queue inconsistent after removals at depth %d\n", depth);
+                return 1;
+            }
+
+            uint32_t before = g_tx_packet_count;
+            int queued = _mdns_server->tx_queue.len;
+            int n = drain(&tick_us, &tx_us);
+            if (n < 0 || (int)(g_tx_packet_count - before) != queued) {
+                printf("FAIL: drain at depth %d (ticks=%d, sent %u of %d)\n", depth, n, (unsigned)(g_tx_packet_count - before), queued);
+                ret = 1;
+                break;
+            }
+            ticks += n;
+            sent += queued;
+        }
+        printf("%-7d %-12.1f %-13.1f %-14.2f %-9ld %-12.1f %-10.2f\n", depth,
+               schedule_us * 1000 / (depth * rounds), known_us * 1000 / (BENCH_SERVICES * rounds),
+               remove_us / rounds, ticks / rounds, tick_us * 1000 / ticks, tx_us / sent);
+    }
+    return ret;
+}
+
+int main(int argc, char **argv)
+{
+    int rounds = argc > 1 ? atoi(argv[1]) : 50;
+    int ret;
+
+    srand(1);
+    mdns_bench_init_di();
+    if (mdns_init() || mdns_hostname_set("bench-host")) {
+        abort();
+    }
+    mdns_action_t *a = NULL;
+    GetLastItem(&a);
+    mdns_test_execute_action(a);
+    for (int i = 0; i < BENCH_SERVICES; i++) {
+        char instance[32], service[16];
+        sprintf(instance, "Storm Node %02d", i);
+        sprintf(service, "_storm%02d", i);
+        if (mdns_service_add(instance, service, "_tcp", 1000 + i, NULL, 0)) {
+            abort();
+        }
+        s_services[i] = _mdns_server->services;
+    }
+    set_pcbs_running();
+
+    ret = run(rounds);
+    printf("\nall packets on one PCB\n");
+    s_pcbs = 1;
+    ret |= run(rounds);
+    mdns_bench_clear_tx_queue();
+    return ret;
+}
@@ -0,0 +1,411 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+/*
+ * Records split over several packets
+ *
+ * 100 instances of _matter._tcp are registered, so their records take several packets of MDNS_MAX_PACKET_SIZE:
+ * - announce:  the announce packet of all the instances
+ * - browse:    the answer to a PTR query for _matter._tcp, answers before additional records
+ * - query:     a PTR query listing 60 of the instances as known answers, TC bit on all but its last packet
+ * - truncated: the packets of that query received by the responder, whose answer waits for the continuation
+ * Every packet is walked, every record must be sent and no record may be sent twice.
+ *
+ * Usage: bench_split
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp32_mock.h"
+#include "mdns.h"
+#include "mdns_private.h"
+#include "bench_util.h"
+
+void mdns_bench_init_di(void);
+int mdns_bench_clear_tx_queue(void);
+mdns_tx_packet_t *mdns_bench_create_announce_packet(mdns_srv_item_t *services[], size_t len);
+mdns_tx_packet_t *mdns_bench_create_known_answer_query(const char *service, const char *proto, mdns_srv_item_t *known[],
+                                                       size_t len);
+void mdns_bench_dispatch_tx_packet(mdns_tx_packet_t *p);
+void mdns_bench_free_tx_packet(mdns_tx_packet_t *p);
+void mdns_parse_packet(mdns_rx_packet_t *packet);
+extern mdns_server_t *_mdns_server;
+
+#define BENCH_INSTANCES     100
+#define BENCH_KNOWN         60
+#define BENCH_MAX_PACKETS   32
+#define BENCH_MAX_RECORDS   512
+
+typedef struct {
+    uint8_t section;                // 0 answers, 1 authority, 2 additional
+    uint16_t type;
+    char name[160];
+} record_t;
+
+typedef struct {
+    int packets;
+    int first;                      // records of the first packet, all that left before the split
+    int records;
+    int bytes;
+    int max_len;
+    int truncated;                  // packets with the TC bit
+    int errors;
+} result_t;
+
+static uint8_t s_packets[BENCH_MAX_PACKETS][MDNS_MAX_PACKET_SIZE];
+static size_t s_packet_len[BENCH_MAX_PACKETS];
+static uint32_t s_packet_at[BENCH_MAX_PACKETS];
+static int s_packet_count;
+static bool s_packet_lost;
+static record_t s_records[BENCH_MAX_RECORDS];
+static int s_record_count;
+static char s_instances[BENCH_INSTANCES][40];
+
+static void capture(const uint8_t *data, size_t len)
+{
+    if (s_packet_count == BENCH_MAX_PACKETS || len > MDNS_MAX_PACKET_SIZE) {
+        s_packet_lost = true;
+        return;
+    }
+    memcpy(s_packets[s_packet_count], data, len);
+    s_packet_len[s_packet_count] = len;
+    s_packet_at[s_packet_count++] = g_tick_count;
+}
+
+static void capture_reset(void)
+{
+    s_packet_count = 0;
+    s_packet_lost = false;
+    s_record_count = 0;
+}
+
+static uint16_t read_u16(const uint8_t *p)
+{
+    return (p[0] << 8) | p[1];
+}
+
+// Decodes a possibly compressed name to dotted form, returns the position after it or NULL
+static const uint8_t *read_name(const uint8_t *packet, size_t len, const uint8_t *p, char *out, size_t out_len)
+{
+    const uint8_t *next = NULL;
+    size_t pos = 0;
+    int jumps = 0;
+    while (p < packet + len && *p) {
+        if ((*p & 0xC0) == 0xC0) {
+            if (p + 1 >= packet + len || ++jumps > 16) {
+                return NULL;
+            }
+            if (!next) {
+                next = p + 2;
+            }
+            p = packet + (((p[0] & 0x3F) << 8) | p[1]);
+            continue;
+        }
+        size_t label = *p++;
+        if (p + label > packet + len || pos + label + 2 > out_len) {
+            return NULL;
+        }
+        memcpy(out + pos, p, label);
+        pos += label;
+        out[pos++] = '.';
+        p += label;
+    }
+    if (p >= packet + len) {
+        return NULL;
+    }
+    out[pos] = 0;
+    return next ? next : p + 1;
+}
+
+// Walks the captured packet, appending its records to s_records, returns its record count or -1 if malformed
+static int walk_packet(int n, int *questions, uint16_t *flags)
+{
+    const uint8_t *packet = s_packets[n];
+    size_t len = s_packet_len[n];
+    char name[160];
+    if (len < MDNS_HEAD_LEN) {
+        return -1;
+    }
+    *flags = read_u16(packet + MDNS_HEAD_FLAGS_OFFSET);
+    *questions = read_u16(packet + MDNS_HEAD_QUESTIONS_OFFSET);
+    int counts[3] = { read_u16(packet + MDNS_HEAD_ANSWERS_OFFSET), read_u16(packet + MDNS_HEAD_SERVERS_OFFSET),
+                      read_u16(packet + MDNS_HEAD_ADDITIONAL_OFFSET)
+                    };
+    const uint8_t *p = packet + MDNS_HEAD_LEN;
+    for (int i = 0; i < *questions; i++) {
+        p = read_name(packet, len, p, name, sizeof(name));
+        if (!p || p + 4 > packet + len) {
+            return -1;
+        }
+        p += 4;
+    }
+    int records = 0;
+    for (int section = 0; section < 3; section++) {
+        for (int i = 0; i < counts[section]; i++) {
+            if (s_record_count == BENCH_MAX_RECORDS) {
+                return -1;
+            }
+            record_t *r = &s_records[s_record_count];
+            p = read_name(packet, len, p, r->name, sizeof(r->name));
+            if (!p || p + MDNS_DATA_OFFSET > packet + len) {
+                return -1;
+            }
+            r->section = section;
+            r->type = read_u16(p + MDNS_TYPE_OFFSET);
+            const uint8_t *data = p + MDNS_DATA_OFFSET;
+            const uint8_t *end = data + read_u16(p + MDNS_LEN_OFFSET);
+            if (end > packet + len) {
+                return -1;
+            }
+            if (r->type == MDNS_TYPE_PTR) {
+                // instances share the owner name of their PTR record, tell them by the target
+                size_t owner = strlen(r->name);
+                r->name[owner++] = '>';
+                if (read_name(packet, len, data, r->name + owner, sizeof(r->name) - owner) != end) {
+                    return -1;
+                }
+            } else if (r->type == MDNS_TYPE_SRV
+                       && read_name(packet, len, data + MDNS_SRV_FQDN_OFFSET, name, sizeof(name)) != end) {
+                return -1;
+            }
+            p = end;
+            s_record_count++;
+            records++;
+        }
+    }
+    return p == packet + len ? records : -1;
+}
+
+static int find_record(uint16_t type, const char *name)
+{
+    int found = -1;
+    for (int i = 0; i < s_record_count; i++) {
+        if (s_records[i].type == type && !strcmp(s_records[i].name, name)) {
+            if (found >= 0) {
+                return -2;
+            }
+            found = i;
+        }
+    }
+    return found;
+}
+
+static void ptr_name(int i, char *out, size_t len)
+{
+    snprintf(out, len, "_matter._tcp.local.>%s._matter._tcp.local.", s_instances[i]);
+}
+
+static void instance_name(int i, char *out, size_t len)
+{
+    snprintf(out, len, "%s._matter._tcp.local.", s_instances[i]);
+}
+
+// Walks all captured packets. Only query packets may have the TC bit, on all but their last packet
+static result_t check_packets(bool query)
+{
+    result_t res = { .packets = s_packet_count, .errors = s_packet_lost };
+    for (int n = 0; n < s_packet_count; n++) {
+        int questions;
+        uint16_t flags;
+        int records = walk_packet(n, &questions, &flags);
+        if (records < 0 || (n > 0 && questions)) {
+            printf("FAIL: packet %d malformed or repeating the questions\n", n);
+            res.errors++;
+            continue;
+        }
+        bool tc = flags & MDNS_FLAGS_DISTRIBUTED;
+        res.truncated += tc;
+        if (tc != (query && n < s_packet_count - 1)) {
+            printf("FAIL: TC bit %s on packet %d of %d\n", tc ? "set" : "clear", n + 1, s_packet_count);
+            res.errors++;
+        }
+        if (n == 0) {
+            res.first = records;
+        }
+        res.records += records;
+        res.bytes += s_packet_len[n];
+        if ((int)s_packet_len[n] > res.max_len) {
+            res.max_len = s_packet_len[n];
+        }
+    }
+    // records leave in the order of the packet, answers first
+    for (int i = 1; i < s_record_count; i++) {
+        if (s_records[i].section < s_records[i - 1].section && s_records[i].section == 0) {
+            printf("FAIL: answer %s after a %s record\n", s_records[i].name, s_records[i - 1].section == 2 ? "additional" : "authority");
+            res.errors++;
+            break;
+        }
+    }
+    return res;
+}
+
+// Checks that the PTR records of instances [from, to) were sent once, and those of the others not
+static int check_ptr(int from, int to, bool with_srv_txt)
+{
+    char name[160];
+    int errors = 0;
+    for (int i = 0; i < BENCH_INSTANCES; i++) {
+        bool expected = i >= from && i < to;
+        ptr_name(i, name, sizeof(name));
+        int at = find_record(MDNS_TYPE_PTR, name);
+        if ((at >= 0) != expected) {
+            errors++;
+        }
+        if (with_srv_txt && expected) {
+            instance_name(i, name, sizeof(name));
+            errors += find_record(MDNS_TYPE_SRV, name) < 0;
+            errors += find_record(MDNS_TYPE_TXT, name) < 0;
+        }
+    }
+    if (errors) {
+        printf("FAIL: %d records of instances %d..%d missing, repeated or unexpected\n", errors, from, to - 1);
+    }
+    return errors;
+}
+
+static void receive(const uint8_t *data, size_t len, uint8_t controller)
+{
+    struct pbuf pb = { .payload = (void *)data, .tot_len = len, .len = len };
+    mdns_rx_packet_t packet = {
+        .pb = &pb,
+        .ip_protocol = MDNS_IP_PROTOCOL_V4,
+        .src_port = MDNS_SERVICE_PORT,
+        .multicast = 1,
+    };
+    packet.src.type = ESP_IPADDR_TYPE_V4;
+    packet.src.u_addr.ip4.addr = 0x0A01A8C0 + (controller << 24);   // 192.168.1.10 + controller
+    mdns_parse_packet(&packet);
+    run_actions();
+}
+
+static void send_browse(uint8_t controller)
+{
+    static const uint8_t query[] = {
+        0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0,
+        7, '_', 'm', 'a', 't', 't', 'e', 'r', 4, '_', 't', 'c', 'p', 5, 'l', 'o', 'c', 'a', 'l', 0,
+        0, MDNS_TYPE_PTR, 0, 1
+    };
+    receive(query, sizeof(query), controller);
+}
+
+static void print_result(const char *scenario, result_t *res, int answered)
+{
+    printf("%-10s %-8d %-8d %-8d %-8d %-8d %-4d %-8d\n", scenario, res->packets, res->first, res->records, res->bytes,
+           res->max_len, res->truncated, answered);
+}
+
+int main(int argc, char **argv)
+{
+    mdns_srv_item_t *services[BENCH_INSTANCES];
+    mdns_txt_item_t txt[] = { {"SII", "5000"}, {"SAI", "300"}, {"T", "1"} };
+    uint8_t query[BENCH_MAX_PACKETS][MDNS_MAX_PACKET_SIZE];
+    size_t query_len[BENCH_MAX_PACKETS];
+    int query_packets;
+    int ret = 0;
+
+    mdns_bench_init_di();
+    if (mdns_init() || mdns_hostname_set("bench-host")) {
+        abort();
+    }
+    run_actions();
+    for (int i = 0; i < BENCH_INSTANCES; i++) {
+        snprintf(s_instances[i], sizeof(s_instances[i]), "2906C908D115D362-8FC77724%08X", i);
+        if (mdns_service_add(s_instances[i], "_matter", "_tcp", 5540, txt, 3)) {
+            abort();
+        }
+        run_actions();
+    }
+    // services[] in instance order
+    int count = 0;
+    for (mdns_srv_item_t *item = _mdns_server->services; item; item = item->next, count++) {
+        for (int i = 0; i < BENCH_INSTANCES; i++) {
+            if (!strcmp(item->service->instance, s_instances[i])) {
+                services[i] = item;
+            }
+        }
+    }
+    for (int i = 0; i < MDNS_MAX_INTERFACES; i++) {
+        for (int j = 0; j < MDNS_IP_PROTOCOL_MAX; j++) {
+            mdns_pcb_t *pcb = &_mdns_server->interfaces[i].pcbs[j];
+            free(pcb->probe_services);
+            pcb->probe_services = NULL;
+            pcb->probe_services_len = 0;
+            pcb->probe_running = false;
+            pcb->state = PCB_RUNNING;
+        }
+    }
+    mdns_bench_clear_tx_queue();
+    g_tick_step = 0;
+    g_tick_count = 1000;
+    g_tx_hook = capture;
+
+    printf("%-10s %-8s %-8s %-8s %-8s %-8s %-4s %-8s\n", "scenario", "packets", "first", "records", "bytes", "max[B]", "TC",
+           "answered");
+
+    // the announce of all instances
+    capture_reset();
+    mdns_tx_packet_t *announce = mdns_bench_create_announce_packet(services, count);
+    if (!announce) {
+        abort();
+    }
+    mdns_bench_dispatch_tx_packet(announce);
+    mdns_bench_free_tx_packet(announce);
+    result_t res = check_packets(false);
+    res.errors += check_ptr(0, BENCH_INSTANCES, true);
+    print_result("announce", &res, BENCH_INSTANCES);
+    ret |= res.errors != 0;
+
+    // the answer to a browse, delayed as a shared answer
+    capture_reset();
+    send_browse(1);
+    fire_until(g_tick_count + 1000);
+    res = check_packets(false);
+    res.errors += check_ptr(0, BENCH_INSTANCES, true);
+    print_result("browse", &res, BENCH_INSTANCES);
+    ret |= res.errors != 0;
+
+    // our query, listing the first instances as known answers
+    capture_reset();
+    mdns_tx_packet_t *ka_query = mdns_bench_create_known_answer_query("_matter", "_tcp", services, BENCH_KNOWN);
+    mdns_bench_dispatch_tx_packet(ka_query);
+    mdns_bench_free_tx_packet(ka_query);
+    res = check_packets(true);
+    res.errors += check_ptr(0, BENCH_KNOWN, false);
+    print_result("query", &res, 0);
+    ret |= res.errors != 0 || res.packets < 2;
+    query_packets = s_packet_count;
+    for (int n = 0; n < query_packets; n++) {
+        memcpy(query[n], s_packets[n], s_packet_len[n]);
+        query_len[n] = s_packet_len[n];
+    }
+
+    // that query received, first without then with its continuation
+    for (int full = 0; full < 2; full++) {
+        capture_reset();
+        uint32_t received_at = g_tick_count;
+        for (int n = 0; n < (full ? query_packets : 1); n++) {
+            receive(query[n], query_len[n], 2 + full);
+        }
+        fire_until(g_tick_count + 1000);
+        res = check_packets(false);
+        int answered = 0;
+        for (int i = 0; i < s_record_count; i++) {
+            answered += s_records[i].section == 0 && s_records[i].type == MDNS_TYPE_PTR;
+        }
+        if (full) {
+            res.errors += check_ptr(BENCH_KNOWN, BENCH_INSTANCES, false);
+        }
+        if (!s_packet_count || s_packet_at[0] - received_at < MDNS_TRUNCATED_DELAY_MS) {
+            printf("FAIL: answer to the truncated query not delayed for its continuation\n");
+            res.errors++;
+        }
+        print_result(full ? "truncated" : "first-only", &res, answered);
+        ret |= res.errors != 0;
+    }
+
+    g_tx_hook = NULL;
+    return ret;
+}
@@ -0,0 +1,237 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+/*
+ * Engine statistics against the traffic they count
+ *
+ * The responder (4 operational instances of _matter._tcp) answers 10000 queries 250 ms apart, browses of
+ * _matter._tcp and resolves of an instance in turn, then 4 searches and 2 browses are started. bench_stats is
+ * built with CONFIG_MDNS_ENABLE_STATS, bench_stats_off from the same source without it. It reports:
+ * - rx/tx:    packets counted by mdns_get_stats() on the interface, against the ones injected and sent
+ * - answers:  answers generated
+ * - parse:    average and longest parsing time, with the answer it triggers
+ * - us/query: wall time of the run per query, parsing and sending the answer
+ *
+ * bench_stats fails if a counter differs from the traffic injected and captured, or if the depth of the action
+ * queue is not 0 once the actions are run.
+ *
+ * Usage: bench_stats
+ *        bench_stats_off
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp32_mock.h"
+#include "mdns.h"
+#include "mdns_private.h"
+#include "bench_util.h"
+
+#ifndef CONFIG_MDNS_ENABLE_STATS
+#define CONFIG_MDNS_ENABLE_STATS 0
+#endif
+
+void mdns_bench_init_di(void);
+int mdns_bench_clear_tx_queue(void);
+void mdns_parse_packet(mdns_rx_packet_t *packet);
+extern mdns_server_t *_mdns_server;
+
+#define BENCH_INSTANCES     4
+#define BENCH_QUERIES       10000
+#define QUERY_GAP_MS        250
+#define BENCH_SEARCHES      4
+#define BENCH_BROWSES       2
+
+static void put_question(uint8_t *packet, uint16_t *len, const char *instance, uint16_t type)
+{
+    if (instance) {
+        put_label(packet, len, instance);
+    }
+    put_label(packet, len, "_matter");
+    put_label(packet, len, "_tcp");
+    put_label(packet, len, "local");
+    packet[(*len)++] = 0;
+    packet[(*len)++] = type >> 8;
+    packet[(*len)++] = type & 0xFF;
+    packet[(*len)++] = 0x00;
+    packet[(*len)++] = 0x01;
+}
+
+static void instance_name(int i, char *out, size_t len)
+{
+    snprintf(out, len, "2906C908D115D362-8FC77724%08X", i);
+}
+
+// Browse of _matter._tcp for even queries, resolve of an instance for odd ones, returns the packet length
+static uint16_t send_query(int query)
+{
+    uint8_t data[256] = { 0 };
+    uint16_t len = MDNS_HEAD_LEN;
+    char instance[40];
+    if (query % 2 == 0) {
+        put_question(data, &len, NULL, MDNS_TYPE_PTR);
+        data[MDNS_HEAD_QUESTIONS_OFFSET + 1] = 1;
+    } else {
+        instance_name(query / 2 % BENCH_INSTANCES, instance, sizeof(instance));
+        put_question(data, &len, instance, MDNS_TYPE_SRV);
+        put_question(data, &len, instance, MDNS_TYPE_TXT);
+        data[MDNS_HEAD_QUESTIONS_OFFSET + 1] = 2;
+    }
+    struct pbuf pb = { .payload = data, .tot_len = len, .len = len };
+    mdns_rx_packet_t packet = {
+        .pb = &pb,
+        .tcpip_if = 0,
+        .ip_protocol = MDNS_IP_PROTOCOL_V4,
+        .src_port = MDNS_SERVICE_PORT,
+        .multicast = 1,
+    };
+    packet.src.type = ESP_IPADDR_TYPE_V4;
+    packet.src.u_addr.ip4.addr = 0x0A01A8C0 + ((query % 8) << 24);   // 192.168.1.10 + query % 8
+    mdns_parse_packet(&packet);
+    run_actions();
+    return len;
+}
+
+static void browse_notifier(mdns_result_t *result)
+{
+}
+
+static uint32_t latency_count(const mdns_stats_latency_t *latency)
+{
+    uint32_t count = 0;
+    for (int i = 0; i < MDNS_STATS_LATENCY_BUCKETS; i++) {
+        count += latency->buckets[i];
+    }
+    return count;
+}
+
+int main(int argc, char **argv)
+{
+    mdns_txt_item_t txt[] = { {"SII", "5000"}, {"SAI", "300"}, {"T", "1"} };
+    mdns_stats_t before, traffic, after;
+    int ret = 0;
+
+    mdns_bench_init_di();
+    if (mdns_init() || mdns_hostname_set("bench-host")) {
+        abort();
+    }
+    run_actions();
+    for (int i = 0; i < BENCH_INSTANCES; i++) {
+        char instance[40];
+        instance_name(i, instance, sizeof(instance));
+        if (mdns_service_add(instance, "_matter", "_tcp", 5540, txt, 3)) {
+            abort();
+        }
+        run_actions();
+    }
+    // one PCB, every packet is counted on interface 0, IPv4
+    for (int i = 0; i < MDNS_MAX_INTERFACES; i++) {
+        for (int j = 0; j < MDNS_IP_PROTOCOL_MAX; j++) {
+            mdns_pcb_t *pcb = &_mdns_server->interfaces[i].pcbs[j];
+            free(pcb->probe_services);
+            pcb->probe_services = NULL;
+            pcb->probe_services_len = 0;
+            pcb->probe_running = false;
+            pcb->state = i == 0 && j == MDNS_IP_PROTOCOL_V4 ? PCB_RUNNING : PCB_OFF;
+        }
+    }
+    mdns_bench_clear_tx_queue();
+    g_tick_step = 0;
+    g_tick_count = 1000;
+
+    if (mdns_get_stats(&before) || mdns_get_stats(NULL) != ESP_ERR_INVALID_ARG) {
+        abort();
+    }
+    uint32_t tx_packets = g_tx_packet_count;
+    uint64_t tx_bytes = g_tx_bytes;
+    uint64_t rx_bytes = 0;
+    double start = now_us();
+    for (int q = 0; q < BENCH_QUERIES; q++) {
+        fire_until(g_tick_count + QUERY_GAP_MS);
+        rx_bytes += send_query(q);
+    }
+    fire_until(g_tick_count + 1000);
+    double elapsed = now_us() - start;
+    tx_packets = g_tx_packet_count - tx_packets;
+    tx_bytes = g_tx_bytes - tx_bytes;
+    if (mdns_get_stats(&traffic)) {
+        abort();
+    }
+
+    mdns_search_once_t *searches[BENCH_SEARCHES];
+    for (int i = 0; i < BENCH_SEARCHES; i++) {
+        if (!(searches[i] = mdns_query_async_new(NULL, "_bench", "_tcp", MDNS_TYPE_PTR, 1000, 1, NULL))) {
+            abort();
+        }
+        run_actions();
+    }
+    char service[16];
+    for (int i = 0; i < BENCH_BROWSES; i++) {
+        snprintf(service, sizeof(service), "_bench%02d", i);
+        if (!mdns_browse_new(service, "_tcp", browse_notifier)) {
+            abort();
+        }
+        run_actions();
+    }
+    if (mdns_get_stats(&after)) {
+        abort();
+    }
+
+    const mdns_stats_netif_t *n = &traffic.netif[0][MDNS_IP_PROTOCOL_V4];
+    const mdns_stats_netif_t *n0 = &before.netif[0][MDNS_IP_PROTOCOL_V4];
+    uint32_t parsed = latency_count(&traffic.parse) - latency_count(&before.parse);
+    printf("%-5s %-8s %-8s %-8s %-10s %-8s %-12s %-13s %s\n", "stats", "rx", "tx", "tx[B]", "answers", "parsed",
+           "parse avg/max", "searches/act", "us/query");
+    printf("%-5s %-8u %-8u %-8u %-10u %-8u %5.1f/%-6u %u/%-11u %.2f\n", CONFIG_MDNS_ENABLE_STATS ? "on" : "off",
+           n->rx_packets - n0->rx_packets, n->tx_packets - n0->tx_packets, n->tx_bytes - n0->tx_bytes,
+           traffic.answers - before.answers, parsed,
+           parsed ? (double)(traffic.parse.total_us - before.parse.total_us) / parsed : 0.0, traffic.parse.max_us,
+           after.searches_started - before.searches_started, after.searches_active, elapsed / BENCH_QUERIES);
+
+#if CONFIG_MDNS_ENABLE_STATS
+    if (n->rx_packets - n0->rx_packets != BENCH_QUERIES || n->rx_bytes - n0->rx_bytes != rx_bytes
+            || parsed != BENCH_QUERIES) {
+        printf("FAIL: %u packets and %u bytes received, %u parsed, %d and %llu injected\n",
+               n->rx_packets - n0->rx_packets, n->rx_bytes - n0->rx_bytes, parsed, BENCH_QUERIES,
+               (unsigned long long)rx_bytes);
+        ret = 1;
+    }
+    if (n->tx_packets - n0->tx_packets != tx_packets || n->tx_bytes - n0->tx_bytes != tx_bytes
+            || latency_count(&traffic.tx) - latency_count(&before.tx) != tx_packets) {
+        printf("FAIL: %u packets and %u bytes sent, %u and %llu captured\n", n->tx_packets - n0->tx_packets,
+               n->tx_bytes - n0->tx_bytes, tx_packets, (unsigned long long)tx_bytes);
+        ret = 1;
+    }
+    if (traffic.answers - before.answers != BENCH_QUERIES) {
+        printf("FAIL: %u answers to %d queries\n", traffic.answers - before.answers, BENCH_QUERIES);
+        ret = 1;
+    }
+    if (after.searches_started - before.searches_started != BENCH_SEARCHES || after.searches_active != BENCH_SEARCHES
+            || after.browses_started - before.browses_started != BENCH_BROWSES || after.browses_active != BENCH_BROWSES) {
+        printf("FAIL: %u/%u searches and %u/%u browses started/active\n", after.searches_started - before.searches_started,
+               after.searches_active, after.browses_started - before.browses_started, after.browses_active);
+        ret = 1;
+    }
+    if (after.action_queue_depth || !after.action_queue_peak || after.action_queue_drops) {
+        printf("FAIL: action queue depth %u, peak %u, drops %u\n", after.action_queue_depth, after.action_queue_peak,
+               after.action_queue_drops);
+        ret = 1;
+    }
+#endif
+
+    for (int i = 0; i < BENCH_BROWSES; i++) {
+        snprintf(service, sizeof(service), "_bench%02d", i);
+        mdns_browse_delete(service, "_tcp");
+    }
+    run_actions();
+    fire_until(g_tick_count + 2000);
+    for (int i = 0; i < BENCH_SEARCHES; i++) {
+        mdns_query_results_free(searches[i]->result);
+        mdns_query_async_delete(searches[i]);
+    }
+    ForceTaskDelete();
+    mdns_free();
+    return ret;
+}
@@ -0,0 +1,200 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+/*
+ * Timer wakeups of the responder over one simulated hour
+ *
+ * Runs the same traffic with the timer callback fired every CONFIG_MDNS_TIMER_PERIOD_MS (the former periodic
+ * timer) and fired only when the one-shot timer armed by mdns expires. Scenarios: idle responder, a PTR query
+ * for our service every 10 s (answered after the 25-100 ms shared answer delay), and the same plus a 3 s
+ * browse query every 5 minutes. Reports wakeups per hour, answer latency and how late searches end.
+ *
+ * Usage: bench_timer
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp32_mock.h"
+#include "mdns.h"
+#include "mdns_private.h"
+#include "bench_util.h"
+
+void mdns_bench_init_di(void);
+int mdns_bench_clear_tx_queue(void);
+void mdns_parse_packet(mdns_rx_packet_t *packet);
+extern mdns_server_t *_mdns_server;
+
+#define HOUR_MS         (3600 * 1000)
+#define SEARCH_TIMEOUT  3000
+
+typedef struct {
+    const char *name;
+    uint32_t query_period_ms;
+    uint32_t search_period_ms;
+} scenario_t;
+
+typedef struct {
+    long wakeups;
+    long answers;
+    double answer_latency_ms;
+    long searches;
+    double search_overrun_ms;
+} result_t;
+
+static uint8_t s_query[64];
+static uint16_t s_query_len;
+
+static void build_query(void)
+{
+    memset(s_query, 0, sizeof(s_query));
+    s_query_len = MDNS_HEAD_LEN;
+    s_query[MDNS_HEAD_QUESTIONS_OFFSET + 1] = 1;
+    put_label(s_query, &s_query_len, "_bench");
+    put_label(s_query, &s_query_len, "_tcp");
+    put_label(s_query, &s_query_len, "local");
+    s_query[s_query_len++] = 0;
+    s_query[s_query_len++] = MDNS_TYPE_PTR >> 8;
+    s_query[s_query_len++] = MDNS_TYPE_PTR & 0xFF;
+    s_query[s_query_len++] = 0x00;
+    s_query[s_query_len++] = 0x01;
+}
+
+static void receive_query(void)
+{
+    struct pbuf pb = { .payload = s_query, .tot_len = s_query_len, .len = s_query_len };
+    mdns_rx_packet_t packet = {
+        .pb = &pb,
+        .ip_protocol = MDNS_IP_PROTOCOL_V4,
+        .src_port = MDNS_SERVICE_PORT,
+        .multicast = 1,
+    };
+    packet.src.type = ESP_IPADDR_TYPE_V4;
+    packet.src.u_addr.ip4.addr = 0x3201A8C0;   // 192.168.1.50
+    mdns_parse_packet(&packet);
+}
+
+static int64_t earliest(int64_t a, int64_t b)
+{
+    if (a < 0) {
+        return b;
+    }
+    return (b < 0 || a < b) ? a : b;
+}
+
+static result_t run(const scenario_t *sc, bool periodic)
+{
+    result_t res = {0};
+    int64_t start = g_tick_count;
+    int64_t end = start + HOUR_MS;
+    int64_t next_tick = start + CONFIG_MDNS_TIMER_PERIOD_MS;
+    int64_t next_query = sc->query_period_ms ? start + sc->query_period_ms : -1;
+    int64_t next_search = sc->search_period_ms ? start + sc->search_period_ms : -1;
+    int64_t query_at = -1;
+    int64_t search_at = 0;
+    mdns_search_once_t *search = NULL;
+
+    while (true) {
+        int64_t t_timer = periodic ? next_tick : g_timer_expiry_ms;
+        int64_t t = earliest(earliest(t_timer, next_query), next_search);
+        if (t < 0 || t >= end) {
+            break;
+        }
+        g_tick_count = t;
+        if (t == t_timer) {
+            if (periodic) {
+                next_tick += CONFIG_MDNS_TIMER_PERIOD_MS;
+            } else {
+                g_timer_expiry_ms = -1;
+            }
+            res.wakeups++;
+            g_timer_cb(NULL);
+            run_actions();
+            if (query_at >= 0 && _mdns_server->tx_queue.len == 0) {
+                res.answers++;
+                res.answer_latency_ms += t - query_at;
+                query_at = -1;
+            }
+            if (search && search->state == SEARCH_OFF) {
+                res.searches++;
+                res.search_overrun_ms += t - (search_at + SEARCH_TIMEOUT);
+                mdns_query_async_delete(search);
+                search = NULL;
+            }
+        }
+        if (t == next_query) {
+            receive_query();
+            run_actions();
+            if (_mdns_server->tx_queue.len) {
+                query_at = t;
+            }
+            next_query += sc->query_period_ms;
+        }
+        if (t == next_search) {
+            search = mdns_query_async_new(NULL, "_printer", "_tcp", MDNS_TYPE_PTR, SEARCH_TIMEOUT, 20, NULL);
+            if (!search) {
+                abort();
+            }
+            search_at = t;
+            run_actions();
+            next_search += sc->search_period_ms;
+        }
+    }
+    g_tick_count = end;
+    return res;
+}
+
+int main(int argc, char **argv)
+{
+    const scenario_t scenarios[] = {
+        {"idle", 0, 0},
+        {"query/10s", 10000, 0},
+        {"query/10s+search/5min", 10000, 300000},
+    };
+    int ret = 0;
+
+    mdns_bench_init_di();
+    if (mdns_init() || mdns_hostname_set("bench-host")) {
+        abort();
+    }
+    run_actions();
+    if (mdns_service_add("Bench Node", "_bench", "_tcp", 80, NULL, 0)) {
+        abort();
+    }
+    for (int i = 0; i < MDNS_MAX_INTERFACES; i++) {
+        for (int j = 0; j < MDNS_IP_PROTOCOL_MAX; j++) {
+            mdns_pcb_t *pcb = &_mdns_server->interfaces[i].pcbs[j];
+            free(pcb->probe_services);
+            pcb->probe_services = NULL;
+            pcb->probe_services_len = 0;
+            pcb->probe_running = false;
+            pcb->state = PCB_RUNNING;
+        }
+    }
+    run_actions();
+    mdns_bench_clear_tx_queue();
+    build_query();
+    g_tick_step = 0;
+
+    printf("%-24s %-10s %-13s %-12s %-16s %-16s %-13s\n", "scenario", "timer", "wakeups/h", "answers",
+           "answer lat[ms]", "search late[ms]", "searches");
+    for (size_t s = 0; s < sizeof(scenarios) / sizeof(scenarios[0]); s++) {
+        for (int periodic = 1; periodic >= 0; periodic--) {
+            result_t res = run(&scenarios[s], periodic);
+            printf("%-24s %-10s %-13ld %-12ld %-16.1f %-16.1f %-13ld\n", scenarios[s].name,
+                   periodic ? "periodic" : "one-shot", res.wakeups, res.answers,
+                   res.answers ? res.answer_latency_ms / res.answers : 0.0,
+                   res.searches ? res.search_overrun_ms / res.searches : 0.0, res.searches);
+            long queries = scenarios[s].query_period_ms ? HOUR_MS / scenarios[s].query_period_ms - 1 : 0;
+            long searches = scenarios[s].search_period_ms ? HOUR_MS / scenarios[s].search_period_ms - 1 : 0;
+            if (res.answers < queries || res.searches < searches) {
+                printf("FAIL: %s/%s answered %ld of %ld queries, finished %ld of %ld searches\n", scenarios[s].name,
+                       periodic ? "periodic" : "one-shot", res.answers, queries, res.searches, searches);
+                ret = 1;
+            }
+        }
+    }
+    return ret;
+}
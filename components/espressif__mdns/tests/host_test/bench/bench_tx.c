@@ -0,0 +1,276 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+/*
+ * TX packet build benchmark
+ *
+ * Registers a growing number of services and measures how long _mdns_dispatch_tx_packet() takes to
+ * serialize one announce packet (SDPTR + PTR + SRV + TXT per service, A/AAAA of the host), which is
+ * dominated by name compression. The announce leaves in as many packets as its records take, every
+ * packet is walked to check that all names decode.
+ * Then every service gets the TXT record of a Matter commissionable node and a response with only
+ * the TXT answers of 8 services is built, to time the TXT rdata on its own.
+ *
+ * Usage: bench_tx [iterations]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp32_mock.h"
+#include "mdns.h"
+#include "mdns_private.h"
+#include "bench_util.h"
+
+void mdns_bench_init_di(void);
+mdns_tx_packet_t *mdns_bench_create_announce_packet(mdns_srv_item_t *services[], size_t len);
+void mdns_bench_dispatch_tx_packet(mdns_tx_packet_t *p);
+void mdns_bench_free_tx_packet(mdns_tx_packet_t *p);
+mdns_tx_packet_t *mdns_bench_create_answer_packet(mdns_srv_item_t *services[], size_t len, uint16_t type);
+int mdns_bench_clear_tx_queue(void);
+extern mdns_server_t *_mdns_server;
+
+#define BENCH_MAX_SERVICES 64
+#define BENCH_TXT_ANSWERS  8
+
+// Records and bytes of the packets written by the last dispatch, -1 records if one was malformed
+static int s_records;
+static size_t s_bytes;
+static int s_packets;
+
+static int check_packet(const uint8_t *packet, size_t len);
+
+static void count_packet(const uint8_t *data, size_t len)
+{
+    int records = check_packet(data, len);
+    s_records = (records < 0 || s_records < 0) ? -1 : s_records + records;
+    s_bytes += len;
+    s_packets++;
+}
+
+static void dispatch(mdns_tx_packet_t *packet)
+{
+    s_records = 0;
+    s_bytes = 0;
+    s_packets = 0;
+    mdns_bench_dispatch_tx_packet(packet);
+}
+
+static uint16_t read_u16(const uint8_t *p)
+{
+    return (p[0] << 8) | p[1];
+}
+
+// Skips (and validates) the name at *pos, compression pointers may only point backwards
+static bool skip_name(const uint8_t *packet, size_t len, size_t *pos)
+{
+    size_t cur = *pos;
+    bool jumped = false;
+    int name_len = 0;
+    while (cur < len) {
+        uint8_t label = packet[cur];
+        if ((label & 0xC0) == 0xC0) {
+            if (cur + 1 >= len) {
+                return false;
+            }
+            size_t target = ((label & 0x3F) << 8) | packet[cur + 1];
+            if (target >= cur || target < MDNS_HEAD_LEN) {
+                return false;
+            }
+            if (!jumped) {
+                *pos = cur + 2;
+                jumped = true;
+            }
+            cur = target;
+            continue;
+        }
+        if (label > 63) {
+            return false;
+        }
+        if (label == 0) {
+            if (!jumped) {
+                *pos = cur + 1;
+            }
+            return true;
+        }
+        name_len += label + 1;
+        if (name_len > 255) {
+            return false;
+        }
+        cur += label + 1;
+    }
+    return false;
+}
+
+// Walks the whole packet, returns the number of records or -1 if malformed
+static int check_packet(const uint8_t *packet, size_t len)
+{
+    if (len < MDNS_HEAD_LEN) {
+        return -1;
+    }
+    size_t pos = MDNS_HEAD_LEN;
+    int questions = read_u16(packet + MDNS_HEAD_QUESTIONS_OFFSET);
+    int records = read_u16(packet + MDNS_HEAD_ANSWERS_OFFSET) + read_u16(packet + MDNS_HEAD_SERVERS_OFFSET)
+                  + read_u16(packet + MDNS_HEAD_ADDITIONAL_OFFSET);
+    for (int i = 0; i < questions; i++) {
+        if (!skip_name(packet, len, &pos) || pos + 4 > len) {
+            return -1;
+        }
+        pos += 4;
+    }
+    for (int i = 0; i < records; i++) {
+        if (!skip_name(packet, len, &pos) || pos + MDNS_DATA_OFFSET > len) {
+            return -1;
+        }
+        uint16_t type = read_u16(packet + pos + MDNS_TYPE_OFFSET);
+        uint16_t data_len = read_u16(packet + pos + MDNS_LEN_OFFSET);
+        pos += MDNS_DATA_OFFSET;
+        if (pos + data_len > len) {
+            return -1;
+        }
+        size_t data = pos;
+        if (type == MDNS_TYPE_PTR && (!skip_name(packet, len, &data) || data != pos + data_len)) {
+            return -1;
+        }
+        data = pos + MDNS_SRV_FQDN_OFFSET;
+        if (type == MDNS_TYPE_SRV && (!skip_name(packet, len, &data) || data != pos + data_len)) {
+            return -1;
+        }
+        pos += data_len;
+    }
+    return pos == len ? records : -1;
+}
+
+static void add_service(int i)
+{
+    char instance[32];
+    char service[16];
+    mdns_txt_item_t txt[2] = {
+        {"board", "esp32c6"},
+        {"path", "/"},
+    };
+    snprintf(instance, sizeof(instance), "Bench Node %02d", i);
+    snprintf(service, sizeof(service), "_bench%02d", i);
+    if (mdns_service_add(instance, service, i % 2 ? "_udp" : "_tcp", 1000 + i, txt, 2)) {
+        abort();
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int iterations = argc > 1 ? atoi(argv[1]) : 2000;
+    const int steps[] = {10, 25, 50, 64};
+    mdns_srv_item_t *services[BENCH_MAX_SERVICES];
+    int registered = 0;
+    int ret = 0;
+
+    mdns_bench_init_di();
+    if (mdns_init()) {
+        abort();
+    }
+    for (int i = 0; i < MDNS_MAX_INTERFACES; i++) {
+        _mdns_server->interfaces[i].pcbs[MDNS_IP_PROTOCOL_V4].state = PCB_RUNNING;
+        _mdns_server->interfaces[i].pcbs[MDNS_IP_PROTOCOL_V6].state = PCB_RUNNING;
+    }
+    if (mdns_hostname_set("bench-host")) {
+        abort();
+    }
+    mdns_action_t *a = NULL;
+    GetLastItem(&a);
+    mdns_test_execute_action(a);
+
+    g_tx_hook = count_packet;
+    printf("%-9s %-8s %-8s %-6s %-12s\n", "services", "packets", "records", "bytes", "build[us]");
+    for (size_t s = 0; s < sizeof(steps) / sizeof(steps[0]); s++) {
+        int n = steps[s];
+        while (registered < n) {
+            add_service(registered++);
+        }
+        int count = 0;
+        for (mdns_srv_item_t *item = _mdns_server->services; item && count < n; item = item->next) {
+            services[count++] = item;
+        }
+
+        mdns_tx_packet_t *packet = mdns_bench_create_announce_packet(services, count);
+        if (!packet) {
+            abort();
+        }
+        dispatch(packet);
+        size_t len = s_bytes;
+        int records = s_records;
+        int packets = s_packets;
+        if (records != 4 * n) {
+            printf("FAIL: malformed packet or %d of %d records with %d services\n", records, 4 * n, n);
+            ret = 1;
+        }
+
+        double start = now_us();
+        for (int i = 0; i < iterations; i++) {
+            dispatch(packet);
+        }
+        double elapsed = now_us() - start;
+        if (s_bytes != len) {
+            printf("FAIL: packet size changed between builds (%zu -> %zu)\n", len, s_bytes);
+            ret = 1;
+        }
+        printf("%-9d %-8d %-8d %-6zu %-12.2f\n", n, packets, records, len, elapsed / iterations);
+        mdns_bench_free_tx_packet(packet);
+    }
+
+    mdns_txt_item_t matter_txt[] = {
+        {"VP", "65521+32768"},
+        {"DT", "257"},
+        {"DN", "Bench Light"},
+        {"SII", "5000"},
+        {"SAI", "300"},
+        {"T", "0"},
+        {"D", "3840"},
+        {"CM", "1"},
+    };
+    int count = 0;
+    for (mdns_srv_item_t *item = _mdns_server->services; item; item = item->next) {
+        if (mdns_service_txt_set_for_host(item->service->instance, item->service->service, item->service->proto, NULL,
+                                          matter_txt, sizeof(matter_txt) / sizeof(matter_txt[0]))) {
+            abort();
+        }
+        if (count < BENCH_TXT_ANSWERS) {
+            services[count++] = item;
+        }
+    }
+    // the TXT changes restarted the pcbs, drop their probes and announces as bench_rx does
+    for (int i = 0; i < MDNS_MAX_INTERFACES; i++) {
+        for (int j = 0; j < MDNS_IP_PROTOCOL_MAX; j++) {
+            mdns_pcb_t *pcb = &_mdns_server->interfaces[i].pcbs[j];
+            free(pcb->probe_services);
+            pcb->probe_services = NULL;
+            pcb->probe_services_len = 0;
+            pcb->probe_running = false;
+            pcb->state = PCB_RUNNING;
+        }
+    }
+    mdns_bench_clear_tx_queue();
+    mdns_tx_packet_t *packet = mdns_bench_create_answer_packet(services, count, MDNS_TYPE_TXT);
+    dispatch(packet);
+    size_t len = s_bytes;
+    if (s_records != count || s_packets != 1) {
+        printf("FAIL: malformed packet or %d of %d TXT answers\n", s_records, count);
+        ret = 1;
+    }
+    double start = now_us();
+    for (int i = 0; i < iterations; i++) {
+        dispatch(packet);
+    }
+    double elapsed = now_us() - start;
+    printf("\n%-9s %-8s %-6s %-14s\n", "answers", "items", "bytes", "TXT[ns/answer]");
+    printf("%-9d %-8zu %-6zu %-14.1f\n", count, sizeof(matter_txt) / sizeof(matter_txt[0]), len,
+           elapsed * 1e3 / iterations / count);
+    mdns_bench_free_tx_packet(packet);
+
+    g_tx_hook = NULL;
+    mdns_service_remove_all();
+    ForceTaskDelete();
+    mdns_free();
+    return ret;
+}
@@ -0,0 +1,60 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+/*
+ * Helpers shared by the benchmarks: the wall clock, the service task and the one-shot timer of the mocks
+ * run by hand, and the labels of the packets fed to mdns
+ */
+#pragma once
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "esp32_mock.h"
+#include "mdns_private.h"
+
+void mdns_test_execute_action(void *action);
+
+static inline double now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+// Runs the service task: executes every action posted since the last call
+static inline void run_actions(void)
+{
+    mdns_action_t *a = NULL;
+    while (GetNextItem(&a)) {
+        mdns_test_execute_action(a);
+    }
+}
+
+// Fires the timer until the clock reaches until_ms, run executes the actions of each firing
+static inline void fire_timer_until(uint32_t until_ms, void (*run)(void))
+{
+    while (g_timer_expiry_ms >= 0 && g_timer_expiry_ms <= until_ms) {
+        g_tick_count = g_timer_expiry_ms;
+        g_timer_expiry_ms = -1;
+        g_timer_cb(NULL);
+        run();
+    }
+    g_tick_count = until_ms;
+}
+
+// Fires the timer until the clock reaches until_ms
+static inline void fire_until(uint32_t until_ms)
+{
+    fire_timer_until(until_ms, run_actions);
+}
+
+static inline void put_label(uint8_t *packet, uint16_t *len, const char *label)
+{
+    size_t l = strlen(label);
+    packet[(*len)++] = l;
+    memcpy(packet + *len, label, l);
+    *len += l;
+}
@@ -0,0 +1,275 @@
+#!/usr/bin/env python
+# SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+# SPDX-License-Identifier: Unlicense OR CC0-1.0
+#
+# Writes the replay corpus of bench_replay: the mDNS packets of Matter commissioning and operational discovery,
+# HomeKit and Chromecast, with the record sets, TTLs, flags and name compression these stacks send.
+#
+# Usage: python gen_corpus.py [output dir]
+import os
+import socket
+import struct
+import sys
+
+TYPE = {'A': 1, 'PTR': 12, 'TXT': 16, 'AAAA': 28, 'SRV': 33, 'NSEC': 47, 'ANY': 255}
+FLUSH = 0x8000
+QU = 0x8000
+
+# The responder of bench_replay
+MATTER_OPERATIONAL = '2906C908D115D362-8FC7772401CD0696'
+MATTER_COMPRESSED_FABRIC = '2906C908D115D362'
+MATTER_COMMISSIONABLE = 'DD200C20D25AE5F7'
+HAP_INSTANCE = 'Bench Bridge'
+HOSTNAME = 'bench-host'
+
+
+class Packet:
+    def __init__(self, flags):
+        self.flags = flags
+        self.data = bytearray(12)
+        self.names = {}
+        self.counts = [0, 0, 0, 0]
+
+    def name(self, name):
+        labels = name.rstrip('.').split('.')
+        for i in range(len(labels)):
+            suffix = '.'.join(labels[i:]).lower()
+            if suffix in self.names:
+                self.data += struct.pack('>H', 0xC000 | self.names[suffix])
+                return
+            if len(self.data) < 0x3FFF:
+                self.names[suffix] = len(self.data)
+            label = labels[i].encode()
+            self.data += bytes([len(label)]) + label
+        self.data += b'\0'
+
+    def question(self, name, rtype, unicast=False):
+        self.name(name)
+        self.data += struct.pack('>HH', TYPE[rtype], 1 | (QU if unicast else 0))
+        self.counts[0] += 1
+
+    def record(self, section, name, rtype, ttl, rdata, flush=False):
+        self.name(name)
+        self.data += struct.pack('>HHI', TYPE[rtype], 1 | (FLUSH if flush else 0), ttl)
+        length = len(self.data)
+        self.data += b'\0\0'
+        rdata(self)
+        struct.pack_into('>H', self.data, length, len(self.data) - length - 2)
+        self.counts[section] += 1
+
+    def unique(self):
+        # cache flush on the unique records of responses, never in the proposed records of a probe
+        return bool(self.flags & 0x8000)
+
+    def ptr(self, section, name, target, ttl=4500):
+        self.record(section, name, 'PTR', ttl, lambda p: p.name(target))
+
+    def srv(self, section, name, port, target, ttl=120):
+        def rdata(p):
+            p.data += struct.pack('>HHH', 0, 0, port)
+            p.name(target)
+        self.record(section, name, 'SRV', ttl, rdata, flush=self.unique())
+
+    def txt(self, section, name, items, ttl=4500):
+        def rdata(p):
+            for item in items:
+                p.data += bytes([len(item)]) + item.encode()
+        self.record(section, name, 'TXT', ttl, rdata, flush=self.unique())
+
+    def a(self, section, name, address, ttl=120):
+        self.record(section, name, 'A', ttl, lambda p: p.data.__iadd__(socket.inet_pton(socket.AF_INET, address)),
+                    flush=self.unique())
+
+    def aaaa(self, section, name, address, ttl=120):
+        self.record(section, name, 'AAAA', ttl,
+                    lambda p: p.data.__iadd__(socket.inet_pton(socket.AF_INET6, address)), flush=self.unique())
+
+    def nsec(self, section, name, types, ttl=120):
+        def rdata(p):
+            p.name(name)
+            bitmap = bytearray(32)
+            for t in types:
+                bitmap[TYPE[t] // 8] |= 0x80 >> (TYPE[t] % 8)
+            used = max(TYPE[t] // 8 for t in types) + 1
+            p.data += bytes([0, used]) + bitmap[:used]
+        self.record(section, name, 'NSEC', ttl, rdata, flush=self.unique())
+
+    def bytes(self):
+        struct.pack_into('>HHHHHH', self.data, 0, 0, self.flags, *self.counts)
+        return bytes(self.data)
+
+
+def query():
+    return Packet(0)
+
+
+def response():
+    return Packet(0x8400)
+
+
+def matter_commissioner_browse():
+    # commissioner looking for commissionable nodes, all of them and the ones with discriminator 3840
+    p = query()
+    p.question('_matterc._udp.local', 'PTR', unicast=True)
+    p.question('_L3840._sub._matterc._udp.local', 'PTR', unicast=True)
+    return p
+
+
+def matter_commissionable_response():
+    # another commissionable node answering, long and short discriminator and commissioning mode subtypes
+    instance = '9B0A3C42D8E71F06._matterc._udp.local'
+    host = 'C4D3A2B1E0F00001.local'
+    p = response()
+    p.ptr(1, '_matterc._udp.local', instance)
+    p.ptr(1, '_L3840._sub._matterc._udp.local', instance)
+    p.ptr(1, '_S15._sub._matterc._udp.local', instance)
+    p.ptr(1, '_CM._sub._matterc._udp.local', instance)
+    p.ptr(1, '_V65521._sub._matterc._udp.local', instance)
+    p.srv(1, instance, 5540, host)
+    p.txt(1, instance, ['D=3840', 'CM=1', 'VP=65521+32769', 'DT=257', 'DN=Test Bulb', 'SII=5000', 'SAI=300', 'T=1',
+                        'PH=33', 'PI='])
+    p.aaaa(3, host, 'fe80::c6d3:a2ff:feb1:e0f0')
+    p.aaaa(3, host, 'fd11:22::c6d3:a2ff:feb1:e0f0')
+    p.a(3, host, '192.168.1.61')
+    return p
+
+
+def matter_operational_resolve():
+    # controller resolving our operational instance: SRV, TXT and the addresses of the host
+    instance = MATTER_OPERATIONAL + '._matter._tcp.local'
+    p = query()
+    p.question(instance, 'SRV')
+    p.question(instance, 'TXT')
+    p.question(HOSTNAME + '.local', 'AAAA')
+    p.question(HOSTNAME + '.local', 'A')
+    return p
+
+
+def matter_operational_browse():
+    # controller browsing the nodes of its fabric, with one of them as a known answer
+    p = query()
+    p.question('_I' + MATTER_COMPRESSED_FABRIC + '._sub._matter._tcp.local', 'PTR')
+    p.ptr(1, '_I' + MATTER_COMPRESSED_FABRIC + '._sub._matter._tcp.local',
+          MATTER_COMPRESSED_FABRIC + '-0000000000000011._matter._tcp.local')
+    return p
+
+
+def matter_operational_response():
+    # another node of the fabric answering a resolve
+    instance = MATTER_COMPRESSED_FABRIC + '-0000000000000011._matter._tcp.local'
+    host = 'A1B2C3D4E5F60011.local'
+    p = response()
+    p.srv(1, instance, 5540, host)
+    p.txt(1, instance, ['SII=800', 'SAI=800', 'SAT=4000', 'T=0'])
+    p.aaaa(3, host, 'fd11:22::a1b2:c3d4:e5f6:11')
+    p.aaaa(3, host, 'fe80::a3b2:c3ff:fed4:e5f6')
+    p.nsec(3, host, ['AAAA'])
+    return p
+
+
+def matter_probe():
+    # node of another fabric probing its operational instance, the proposed records in the authority section
+    instance = '5E3F0C8A9B7D2E14-0000000000000042._matter._tcp.local'
+    host = 'B7C6D5E4F3A20042.local'
+    p = query()
+    p.question(instance, 'ANY', unicast=True)
+    p.question(host, 'ANY', unicast=True)
+    p.srv(2, instance, 5540, host)
+    p.aaaa(2, host, 'fd11:22::b7c6:d5e4:f3a2:42')
+    return p
+
+
+def homekit_browse():
+    # iOS browsing HomeKit accessories, with the accessories it already knows as known answers
+    p = query()
+    p.question('_hap._tcp.local', 'PTR')
+    p.question('_hap._udp.local', 'PTR')
+    p.question('_airplay._tcp.local', 'PTR')
+    p.ptr(1, '_hap._tcp.local', 'Hue Bridge - 4F2A1C._hap._tcp.local', ttl=4400)
+    p.ptr(1, '_hap._tcp.local', 'Eve Energy 0C3D._hap._tcp.local', ttl=3200)
+    p.ptr(1, '_hap._udp.local', 'Nanoleaf Shapes 8A1B._hap._udp.local', ttl=4100)
+    return p
+
+
+def homekit_resolve():
+    # iOS resolving our bridge
+    instance = HAP_INSTANCE + '._hap._tcp.local'
+    p = query()
+    p.question(instance, 'SRV', unicast=True)
+    p.question(instance, 'TXT', unicast=True)
+    return p
+
+
+def homekit_response():
+    # accessory answering a browse, with its records in the additional section
+    instance = 'Hue Bridge - 4F2A1C._hap._tcp.local'
+    host = 'Philips-hue.local'
+    p = response()
+    p.ptr(1, '_hap._tcp.local', instance)
+    p.txt(3, instance, ['c#=52', 'ff=0', 'id=5B:14:9A:0E:C2:7F', 'md=BSB002', 'pv=1.1', 's#=1', 'sf=0', 'ci=2',
+                        'sh=q5XuDw=='])
+    p.srv(3, instance, 8080, host)
+    p.a(3, host, '192.168.1.20')
+    p.aaaa(3, host, 'fe80::217:88ff:fe4f:2a1c')
+    p.nsec(3, instance, ['TXT', 'SRV'])
+    p.nsec(3, host, ['A', 'AAAA'])
+    return p
+
+
+def chromecast_browse():
+    # Chrome browsing Cast devices, the unicast response bit set on the first query
+    p = query()
+    p.question('_googlecast._tcp.local', 'PTR', unicast=True)
+    p.question('_CC1AD845._sub._googlecast._tcp.local', 'PTR', unicast=True)
+    return p
+
+
+def chromecast_response():
+    # Cast device answering, TXT with the device id, model and friendly name
+    instance = 'Chromecast-4b5e8f0a3c2d1e9f7a6b5c4d3e2f1a0b._googlecast._tcp.local'
+    host = '4b5e8f0a-3c2d-1e9f-7a6b-5c4d3e2f1a0b.local'
+    p = response()
+    p.ptr(1, '_googlecast._tcp.local', instance, ttl=120)
+    p.ptr(1, '_CC1AD845._sub._googlecast._tcp.local', instance, ttl=120)
+    p.txt(3, instance, ['id=4b5e8f0a3c2d1e9f7a6b5c4d3e2f1a0b', 'cd=9F1C0E2B7A5D4C3B2A1F0E9D8C7B6A59', 'rm=',
+                        've=05', 'md=Chromecast', 'ic=/setup/icon.png', 'fn=Living Room TV', 'ca=201221', 'st=0',
+                        'bs=FA8FCA7E2B10', 'nf=1', 'rs='])
+    p.srv(3, instance, 8009, host)
+    p.a(3, host, '192.168.1.42')
+    return p
+
+
+def chromecast_announce():
+    # Cast device announcing itself after joining the network, cache flush on its unique records
+    instance = 'Google-Nest-Mini-7c1a2b3c4d5e6f708192a3b4c5d6e7f8._googlecast._tcp.local'
+    host = '7c1a2b3c-4d5e-6f70-8192-a3b4c5d6e7f8.local'
+    p = response()
+    p.ptr(1, '_googlecast._tcp.local', instance, ttl=120)
+    p.srv(1, instance, 8009, host)
+    p.txt(1, instance, ['id=7c1a2b3c4d5e6f708192a3b4c5d6e7f8', 'cd=1A2B3C4D5E6F708192A3B4C5D6E7F809', 'rm=',
+                        've=05', 'md=Google Nest Mini', 'ic=/setup/icon.png', 'fn=Kitchen speaker', 'ca=199172',
+                        'st=0', 'bs=FA8FCA3D1E42', 'nf=1', 'rs='])
+    p.a(1, host, '192.168.1.43')
+    return p
+
+
+CORPUS = {
+    'matter_commissioner_browse': matter_commissioner_browse,
+    'matter_commissionable_response': matter_commissionable_response,
+    'matter_operational_resolve': matter_operational_resolve,
+    'matter_operational_browse': matter_operational_browse,
+    'matter_operational_response': matter_operational_response,
+    'matter_probe': matter_probe,
+    'homekit_browse': homekit_browse,
+    'homekit_resolve': homekit_resolve,
+    'homekit_response': homekit_response,
+    'chromecast_browse': chromecast_browse,
+    'chromecast_response': chromecast_response,
+    'chromecast_announce': chromecast_announce,
+}
+
+if __name__ == '__main__':
+    out = sys.argv[1] if len(sys.argv) > 1 else os.path.dirname(os.path.abspath(__file__))
+    for name, build in CORPUS.items():
+        with open(os.path.join(out, name + '.bin'), 'wb') as f:
+            f.write(build().bytes())
@@ -0,0 +1,15 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+/*
+ * Fuzzer test configuration with the limits raised for the benchmarks
+ */
+#pragma once
+#include "../../test_afl_fuzz_host/sdkconfig.h"
+
+#undef CONFIG_MDNS_MAX_SERVICES
+#define CONFIG_MDNS_MAX_SERVICES 512
+
+#define CONFIG_MDNS_CACHE_SIZE 4096
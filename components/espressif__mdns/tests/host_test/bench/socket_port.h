@@ -0,0 +1,42 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+/*
+ * Host port of the FreeRTOS API used by mdns_networking_socket.c -- preincluded into it and into
+ * bench_rx_socket.c, tasks run as pthreads
+ */
+#pragma once
+
+// Skip these include files
+#define INC_FREERTOS_H
+#define INC_TASK_H
+#define QUEUE_H
+#define SEMAPHORE_H
+#define _ESP_TASK_H_
+
+#include <stdint.h>
+#include <unistd.h>
+
+#define ESP_TASK_PRIO_MAX           25
+#define ESP_TASKD_EVENT_PRIO        5
+#define pdTRUE                      1
+#define pdFALSE                     0
+#define pdPASS                      pdTRUE
+#define portMAX_DELAY               0xFFFFFFFF
+#define portTICK_PERIOD_MS          1
+#define pdMS_TO_TICKS(ms)           (ms)
+
+typedef void *SemaphoreHandle_t;
+typedef void *QueueHandle_t;
+typedef void *TaskHandle_t;
+typedef int BaseType_t;
+typedef uint32_t TickType_t;
+typedef void *StackType_t;
+typedef void *StaticTask_t;
+
+BaseType_t xTaskCreate(void (*task)(void *), const char *name, uint32_t stack_size, void *arg, uint32_t priority,
+                       TaskHandle_t *handle);
+void vTaskDelete(TaskHandle_t task);
+#define vTaskDelay(ticks)           usleep((ticks) * 1000)
@@ -7,6 +7,7 @@
 #include <string.h>
 #include <pthread.h>
 #include <stdlib.h>
+#include <time.h>
 #include <unistd.h>
 #include "esp32_mock.h"
 #include "esp_log.h"
@@ -14,6 +15,25 @@
 void     *g_queue;
 int       g_queue_send_shall_fail = 0;
 int       g_size = 0;
+const uint8_t *g_tx_packet = NULL;
+size_t    g_tx_packet_len = 0;
+uint32_t  g_tx_packet_count = 0;
+uint64_t  g_tx_bytes = 0;
+void (*g_tx_hook)(const uint8_t *data, size_t len) = NULL;
+uint32_t  g_tick_count = 0;
+uint32_t  g_tick_step = 1;
+esp_timer_cb_t g_timer_cb = NULL;
+int64_t   g_timer_expiry_ms = -1;
+
+struct esp_timer {
+    int unused;
+};
+static struct esp_timer s_timer;
+
+#define QUEUE_LOG_LEN 32
+static uint8_t *s_queue_log;
+static uint32_t s_queue_log_head;
+static uint32_t s_queue_log_tail;
 
 const char *WIFI_EVENT = "wifi_event";
 const char *ETH_EVENT = "eth_event";
@@ -38,24 +58,58 @@ esp_err_t esp_timer_delete(esp_timer_handle_t timer)
 
 esp_err_t esp_timer_stop(esp_timer_handle_t timer)
 {
+    if (g_timer_expiry_ms < 0) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    g_timer_expiry_ms = -1;
     return ESP_OK;
 }
 
 esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t period)
 {
+    g_timer_expiry_ms = g_tick_count + (period + 999) / 1000;
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeout_us)
+{
+    g_timer_expiry_ms = g_tick_count + (timeout_us + 999) / 1000;
     return ESP_OK;
 }
 
+// Real time, for the durations measured by the mdns statistics
+int64_t esp_timer_get_time(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
 esp_err_t esp_timer_create(const esp_timer_create_args_t *create_args,
                            esp_timer_handle_t *out_handle)
 {
+    g_timer_cb = create_args->callback;
+    *out_handle = &s_timer;
     return ESP_OK;
 }
 
+size_t mock_udp_pcb_write(const uint8_t *data, size_t len)
+{
+    g_tx_packet = data;
+    g_tx_packet_len = len;
+    g_tx_packet_count++;
+    g_tx_bytes += len;
+    if (g_tx_hook) {
+        g_tx_hook(data, len);
+    }
+    return len;
+}
+
 uint32_t xTaskGetTickCount(void)
 {
-    static uint32_t tick = 0;
-    return tick++;
+    uint32_t tick = g_tick_count;
+    g_tick_count += g_tick_step;
+    return tick;
 }
 
 /// Queue mock
@@ -63,6 +117,8 @@ QueueHandle_t xQueueCreate(uint32_t uxQueueLength, uint32_t uxItemSize)
 {
     g_size = uxItemSize;
     g_queue = malloc((uxQueueLength) * (uxItemSize));
+    s_queue_log = malloc(QUEUE_LOG_LEN * uxItemSize);
+    s_queue_log_head = s_queue_log_tail = 0;
     return g_queue;
 }
 
@@ -70,6 +126,8 @@ QueueHandle_t xQueueCreate(uint32_t uxQueueLength, uint32_t uxItemSize)
 void vQueueDelete(QueueHandle_t xQueue)
 {
     free(xQueue);
+    free(s_queue_log);
+    s_queue_log = NULL;
 }
 
 uint32_t xQueueSend(QueueHandle_t xQueue, const void *pvItemToQueue, TickType_t xTicksToWait)
@@ -78,6 +136,7 @@ uint32_t xQueueSend(QueueHandle_t xQueue, const void *pvItemToQueue, TickType_t
         return pdFALSE;
     } else {
         memcpy(xQueue, pvItemToQueue, g_size);
+        memcpy(s_queue_log + (s_queue_log_tail++ % QUEUE_LOG_LEN) * g_size, pvItemToQueue, g_size);
         return pdPASS;
     }
 }
@@ -93,6 +152,15 @@ void GetLastItem(void *pvBuffer)
     memcpy(pvBuffer, g_queue, g_size);
 }
 
+bool GetNextItem(void *pvBuffer)
+{
+    if (s_queue_log_head == s_queue_log_tail) {
+        return false;
+    }
+    memcpy(pvBuffer, s_queue_log + (s_queue_log_head++ % QUEUE_LOG_LEN) * g_size, g_size);
+    return true;
+}
+
 void ForceTaskDelete(void)
 {
     g_queue_send_shall_fail = 1;
@@ -72,7 +72,7 @@
 
 #define ESP_TASK_PRIO_MAX 25
 #define ESP_TASKD_EVENT_PRIO 5
-#define _mdns_udp_pcb_write(tcpip_if, ip_protocol, ip, port, data, len) len
+#define _mdns_udp_pcb_write(tcpip_if, ip_protocol, ip, port, data, len) mock_udp_pcb_write(data, len)
 #define TaskHandle_t TaskHandle_t
 
 
@@ -113,8 +113,25 @@ struct pbuf {
 };
 
 uint32_t xTaskGetTickCount(void);
+
+// TX mock: keeps a reference to the last packet written by mdns, counts packets and bytes. The optional
+// hook sees every packet, before the next write reuses the buffer
+extern const uint8_t *g_tx_packet;
+extern size_t g_tx_packet_len;
+extern uint32_t g_tx_packet_count;
+extern uint64_t g_tx_bytes;
+extern void (*g_tx_hook)(const uint8_t *data, size_t len);
+size_t mock_udp_pcb_write(const uint8_t *data, size_t len);
+
 typedef void (*esp_timer_cb_t)(void *arg);
 
+// Clock and timer mock: 1 ms ticks, the count advances by g_tick_step on every read. The expiry tick of the
+// armed timer is kept for the test to fire g_timer_cb itself (-1 when stopped)
+extern uint32_t g_tick_count;
+extern uint32_t g_tick_step;
+extern esp_timer_cb_t g_timer_cb;
+extern int64_t g_timer_expiry_ms;
+
 // Queue mock
 QueueHandle_t xQueueCreate(uint32_t uxQueueLength,
                            uint32_t uxItemSize);
@@ -127,6 +144,9 @@ uint32_t xQueueReceive(QueueHandle_t xQueue, void *pvBuffer, TickType_t xTicksTo
 
 void GetLastItem(void *pvBuffer);
 
+// Items sent to the queue in FIFO order (last 32 kept), independent of GetLastItem()
+bool GetNextItem(void *pvBuffer);
+
 void ForceTaskDelete(void);
 
 esp_err_t esp_event_handler_register(const char *event_base, int32_t event_id, void *event_handler, void *event_handler_arg);
@@ -29,3 +29,11 @@ static inline bool mdns_is_netif_ready(mdns_if_t tcpip_if, mdns_ip_protocol_t ip
 {
     return true;
 }
+
+static inline void _mdns_udp_pcb_batch_begin(void)
+{
+}
+
+static inline void _mdns_udp_pcb_batch_flush(void)
+{
+}
@@ -59,20 +59,14 @@ static int mdns_test_add_delegated_host(const char *mdns_hostname)
 
 static int mdns_test_service_instance_name_set(const char *service, const char *proto, const char *instance)
 {
-    int ret = mdns_service_instance_name_set(service, proto, instance);
-    mdns_action_t *a = NULL;
-    GetLastItem(&a);
-    mdns_test_execute_action(a);
-    return ret;
+    // runs under the service lock, no action to execute
+    return mdns_service_instance_name_set(service, proto, instance);
 }
 
 static int mdns_test_service_txt_set(const char *service, const char *proto,  uint8_t num_items, mdns_txt_item_t txt[])
 {
-    int ret = mdns_service_txt_set(service, proto, txt, num_items);
-    mdns_action_t *a = NULL;
-    GetLastItem(&a);
-    mdns_test_execute_action(a);
-    return ret;
+    // runs under the service lock, no action to execute
+    return mdns_service_txt_set(service, proto, txt, num_items);
 }
 
 static int mdns_test_sub_service_add(const char *sub_name, const char *service_name, const char *proto, uint32_t port)
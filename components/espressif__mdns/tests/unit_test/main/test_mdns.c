@@ -61,6 +61,40 @@ TEST(mdns, init_deinit)
     esp_event_loop_delete_default();
 }
 
+TEST(mdns, txt_item_over_255_bytes_left_out)
+{
+    mdns_result_t *results = NULL;
+    char long_value[300];
+    memset(long_value, 'a', sizeof(long_value) - 1);
+    long_value[sizeof(long_value) - 1] = '\0';
+    test_case_uses_tcpip();
+    TEST_ASSERT_EQUAL(ESP_OK, esp_event_loop_create_default());
+    TEST_ASSERT_EQUAL(ESP_OK, mdns_init());
+    TEST_ASSERT_EQUAL(ESP_OK, mdns_hostname_set(MDNS_HOSTNAME));
+
+    TEST_ASSERT_EQUAL(ESP_OK, mdns_service_add(MDNS_INSTANCE, MDNS_SERVICE_NAME, MDNS_SERVICE_PROTO, MDNS_SERVICE_PORT, NULL, 0));
+
+    // 299 bytes of value do not fit a TXT string, the item must be left out rather than truncated
+    mdns_txt_item_t txt_data[] = {
+        {"long", long_value},
+        {"key", "value"},
+    };
+    TEST_ASSERT_EQUAL(ESP_OK, mdns_service_txt_set(MDNS_SERVICE_NAME, MDNS_SERVICE_PROTO, txt_data, 2));
+    yield_to_all_priorities();
+
+    TEST_ASSERT_EQUAL(ESP_OK, mdns_lookup_selfhosted_service(NULL, MDNS_SERVICE_NAME, MDNS_SERVICE_PROTO, 1, &results));
+    TEST_ASSERT_NOT_EQUAL(NULL, results);
+    TEST_ASSERT_EQUAL(1, results->txt_count);
+    TEST_ASSERT_EQUAL_STRING("key", results->txt[0].key);
+    TEST_ASSERT_EQUAL_STRING("value", results->txt[0].value);
+    mdns_query_results_free(results);
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, mdns_service_txt_item_set(MDNS_SERVICE_NAME, MDNS_SERVICE_PROTO, "long", long_value));
+
+    TEST_ASSERT_EQUAL(ESP_OK, mdns_service_remove(MDNS_SERVICE_NAME, MDNS_SERVICE_PROTO));
+    mdns_free();
+    esp_event_loop_delete_default();
+}
+
 TEST(mdns, boolean_txt_null_value)
 {
     mdns_result_t *results = NULL;
@@ -330,6 +364,7 @@ TEST_GROUP_RUNNER(mdns)
     RUN_TEST_CASE(mdns, add_remove_service)
     RUN_TEST_CASE(mdns, add_remove_deleg_service)
     RUN_TEST_CASE(mdns, boolean_txt_null_value)
+    RUN_TEST_CASE(mdns, txt_item_over_255_bytes_left_out)
 
 }
 
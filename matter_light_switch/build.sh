@@ -54,8 +54,9 @@ show_menu() {
     echo "7) Menuconfig"
     echo "8) Erase flash (Factory Reset)"
     echo "9) Exit"
+    echo "10) Flash/RAM budget report (diff against size_baseline.json)"
     echo ""
-    read -p "Enter choice [1-9]: " choice
+    read -p "Enter choice [1-10]: " choice
 }
 
 # Main loop
@@ -112,6 +113,12 @@ while true; do
             echo -e "${GREEN}Exiting...${NC}"
             exit 0
             ;;
+        10)
+            echo -e "${GREEN}Building and analysing flash/RAM usage...${NC}"
+            idf.py build
+            cmake --build build --target size-budget
+            echo -e "${YELLOW}Run 'cmake --build build --target size-budget-save' to accept as new baseline${NC}"
+            ;;
         *)
             echo -e "${RED}Invalid option${NC}"
             ;;
@@ -1,7 +0,0 @@
-/*
- * SPDX-FileCopyrightText: 2022-2025 Espressif Systems (Shanghai) CO LTD
- *
- * SPDX-License-Identifier: Unlicense OR CC0-1.0
- */
-#include "../../tinycbor/src/cbor.h"
-#include "../../tinycbor/src/cborjson.h"
@@ -1,2 +0,0 @@
-TEMPLATE = subdirs
-SUBDIRS = simplereader.pro
@@ -1,3 +0,0 @@
-CONFIG -= qt
-SOURCES = simplereader.c
-include(../src/src.pri)
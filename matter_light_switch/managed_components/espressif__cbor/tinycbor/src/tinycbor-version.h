@@ -1,3 +0,0 @@
-#define TINYCBOR_VERSION_MAJOR      0
-#define TINYCBOR_VERSION_MINOR      6
-#define TINYCBOR_VERSION_PATCH      0
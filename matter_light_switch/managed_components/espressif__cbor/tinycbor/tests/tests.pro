@@ -1,3 +0,0 @@
-TEMPLATE = subdirs
-SUBDIRS = parser encoder cpp tojson
-msvc: SUBDIRS -= tojson
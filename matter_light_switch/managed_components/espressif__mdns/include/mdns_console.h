@@ -1,14 +0,0 @@
-/*
- * SPDX-FileCopyrightText: 2015-2022 Espressif Systems (Shanghai) CO LTD
- *
- * SPDX-License-Identifier: Apache-2.0
- */
-#ifndef _MDNS_CONSOLE_H_
-#define _MDNS_CONSOLE_H_
-
-/**
- * @brief  Register MDNS functions with the console component
- */
-void mdns_console_register(void);
-
-#endif /* _MDNS_CONSOLE_H_ */
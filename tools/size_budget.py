@@ -0,0 +1,352 @@
+#!/usr/bin/env python3
+"""
+Flash / IRAM / DRAM budget report for the ESP32-C6 Matter firmwares.
+
+Parses the GNU ld map file (and optionally the ELF section table) produced by
+`idf.py build`, attributes every input section to a component and a symbol,
+and diffs the result against a saved baseline.
+
+    size_budget.py --map build/matter_light_switch.map --elf build/matter_light_switch.elf \
+                   --partitions partitions.csv --baseline size_baseline.json
+    size_budget.py ... --save-baseline          # record the current build as baseline
+
+Exit code is 1 when the image does not fit the app partition or when a growth
+limit (--max-flash-growth / --max-ram-growth) is exceeded.
+"""
+
+import argparse
+import json
+import os
+import re
+import struct
+import sys
+from collections import defaultdict
+
+# Output section -> memory class (ESP32-C6 linker script names)
+SECTION_CLASSES = [
+    ('.flash.text', 'flash_code'),
+    ('.flash.rodata_noload', None),       # Not part of the image
+    ('.flash.rodata', 'flash_data'),
+    ('.flash.appdesc', 'flash_data'),
+    ('.flash.tdata', 'flash_data'),
+    ('.flash.tbss', None),
+    ('.eh_frame', 'flash_data'),
+    ('.iram0.', 'iram'),
+    ('.dram0.bss', 'dram_bss'),
+    ('.dram0.heap_start', None),
+    ('.dram0.', 'dram_data'),
+    ('.noinit', 'dram_bss'),
+    # NOLOAD RTC sections take LP RAM but no bytes of the image
+    ('.rtc_noinit', 'lp_bss'),
+    ('.rtc.bss', 'lp_bss'),
+    ('.rtc_reserved', 'lp_bss'),
+    ('.rtc', 'lp_ram'),
+    ('.lp_', 'lp_ram'),
+    # Host (gcc/ld) names, only used when running the tool on a host build
+    ('.text', 'flash_code'),
+    ('.rodata', 'flash_data'),
+    ('.data', 'dram_data'),
+    ('.bss', 'dram_bss'),
+]
+
+CLASSES = ['flash_code', 'flash_data', 'iram', 'dram_data', 'dram_bss', 'lp_ram', 'lp_bss']
+
+# Bytes stored in the app partition / bytes of static RAM (HP and LP)
+FLASH_CLASSES = ['flash_code', 'flash_data', 'iram', 'dram_data', 'lp_ram']
+RAM_CLASSES = ['iram', 'dram_data', 'dram_bss', 'lp_ram', 'lp_bss']
+
+GENERIC_INPUT_SECTIONS = {'.text', '.data', '.bss', '.rodata', '.sdata', '.sbss', '.srodata', 'COMMON', '.literal'}
+INPUT_PREFIXES = ('.text.', '.rodata.', '.data.', '.bss.', '.sdata.', '.sbss.', '.srodata.', '.literal.',
+                  '.iram1.', '.dram1.', '.rodata.str1.', '.tbss.', '.tdata.')
+
+
+def classify(output_section):
+    for prefix, cls in SECTION_CLASSES:
+        if output_section.startswith(prefix):
+            return cls
+    return None
+
+
+def component_of(path):
+    """esp-idf/<component>/lib<x>.a(obj) -> <component>, toolchain libs -> lib<x>"""
+    m = re.search(r'esp-idf/([^/]+)/', path)
+    if m:
+        return m.group(1)
+    m = re.search(r'(lib[\w+\-]+)\.a\(', path)
+    if m:
+        return m.group(1)
+    base = os.path.basename(path.split('(')[0])
+    return base or '(unknown)'
+
+
+def symbol_of(input_section, path):
+    if input_section not in GENERIC_INPUT_SECTIONS:
+        for prefix in INPUT_PREFIXES:
+            if input_section.startswith(prefix):
+                return input_section[len(prefix):]
+        return input_section
+    m = re.search(r'\(([^)]+)\)', path)
+    obj = m.group(1) if m else os.path.basename(path)
+    return '{}:{}'.format(obj, input_section)
+
+
+HEX = r'0x[0-9a-fA-F]+'
+OUT_RE = re.compile(r'^(\.\S+)(?:\s+(' + HEX + r')\s+(' + HEX + r'))?\s*$')
+IN_RE = re.compile(r'^ (\S+)(?:\s+(' + HEX + r')\s+(' + HEX + r')\s+(.+))?\s*$')
+CONT_RE = re.compile(r'^\s+(' + HEX + r')\s+(' + HEX + r')\s+(.+)$')
+FILL_RE = re.compile(r'^ \*fill\*\s+(' + HEX + r')\s+(' + HEX + r')')
+
+
+def parse_map(path):
+    """Returns {(class, component, symbol): size}"""
+    usage = defaultdict(int)
+    in_memory_map = False
+    out_class = None
+    pending = None          # Input section name waiting for its address line
+
+    with open(path, 'r', errors='replace') as f:
+        for line in f:
+            line = line.rstrip('\n')
+            if not in_memory_map:
+                in_memory_map = line.startswith('Linker script and memory map')
+                continue
+            if line.startswith('OUTPUT(') or line.startswith('/DISCARD/'):
+                out_class = None
+                pending = None
+                continue
+
+            m = OUT_RE.match(line)
+            if m:
+                out_class = classify(m.group(1))
+                pending = None
+                continue
+            if out_class is None:
+                continue
+
+            m = FILL_RE.match(line)
+            if m:
+                usage[(out_class, '(fill)', '*fill*')] += int(m.group(2), 16)
+                continue
+
+            if pending:
+                m = CONT_RE.match(line)
+                if m:
+                    size = int(m.group(2), 16)
+                    if size:
+                        file = m.group(3).strip()
+                        usage[(out_class, component_of(file), symbol_of(pending, file))] += size
+                    pending = None
+                    continue
+                pending = None
+
+            m = IN_RE.match(line)
+            if m and not m.group(1).startswith('*') and not m.group(1).startswith('0x'):
+                if m.group(2) is None:
+                    pending = m.group(1)
+                    continue
+                size = int(m.group(3), 16)
+                if size:
+                    file = m.group(4).strip()
+                    usage[(out_class, component_of(file), symbol_of(m.group(1), file))] += size
+    return usage
+
+
+def parse_elf_sections(path):
+    """Allocated section sizes per memory class, from the ELF section header table"""
+    sizes = defaultdict(int)
+    with open(path, 'rb') as f:
+        data = f.read()
+    if data[:4] != b'\x7fELF':
+        raise ValueError('{} is not an ELF file'.format(path))
+    is64 = data[4] == 2
+    endian = '<' if data[5] == 1 else '>'
+    if is64:
+        shoff, = struct.unpack_from(endian + 'Q', data, 0x28)
+        shentsize, shnum, shstrndx = struct.unpack_from(endian + 'HHH', data, 0x3A)
+    else:
+        shoff, = struct.unpack_from(endian + 'I', data, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from(endian + 'HHH', data, 0x2E)
+
+    def section(i):
+        off = shoff + i * shentsize
+        if is64:
+            name, stype, flags, _addr, offset, size = struct.unpack_from(endian + 'IIQQQQ', data, off)
+        else:
+            name, stype, flags, _addr, offset, size = struct.unpack_from(endian + 'IIIIII', data, off)
+        return name, stype, flags, offset, size
+
+    _, _, _, str_off, _ = section(shstrndx)
+    for i in range(shnum):
+        name_off, _stype, flags, _offset, size = section(i)
+        if not flags & 0x2:     # SHF_ALLOC
+            continue
+        end = data.index(b'\0', str_off + name_off)
+        name = data[str_off + name_off:end].decode()
+        cls = classify(name)
+        if cls:
+            sizes[cls] += size
+    return dict(sizes)
+
+
+def app_partition_size(path):
+    """Largest app partition in partitions.csv"""
+    largest = 0
+    with open(path) as f:
+        for line in f:
+            line = line.split('#')[0].strip()
+            if not line:
+                continue
+            fields = [x.strip() for x in line.split(',')]
+            if len(fields) < 5 or fields[1] != 'app' or not fields[4]:
+                continue
+            size = fields[4].upper()
+            mult = 1
+            if size.endswith('K'):
+                size, mult = size[:-1], 1024
+            elif size.endswith('M'):
+                size, mult = size[:-1], 1024 * 1024
+            largest = max(largest, int(size, 0) * mult)
+    return largest
+
+
+def summarize(usage, top):
+    totals = defaultdict(int)
+    components = defaultdict(lambda: defaultdict(int))
+    symbols = defaultdict(int)
+    for (cls, comp, sym), size in usage.items():
+        totals[cls] += size
+        components[comp][cls] += size
+        symbols['{}/{}'.format(comp, sym)] += size
+    top_symbols = dict(sorted(symbols.items(), key=lambda kv: -kv[1])[:top])
+    return {
+        'totals': {c: totals.get(c, 0) for c in CLASSES},
+        'components': {comp: {c: v.get(c, 0) for c in CLASSES} for comp, v in components.items()},
+        'symbols': top_symbols,
+    }
+
+
+def flash_of(entry):
+    return sum(entry.get(c, 0) for c in FLASH_CLASSES)
+
+
+def ram_of(entry):
+    return sum(entry.get(c, 0) for c in RAM_CLASSES)
+
+
+def print_report(report, partition_size, top):
+    totals = report['totals']
+    print('Memory class totals:')
+    for c in CLASSES:
+        print('  {:<12} {:>10}'.format(c, totals[c]))
+    flash = flash_of(totals)
+    print('  {:<12} {:>10}'.format('image', flash))
+    print('  {:<12} {:>10}'.format('static RAM', ram_of(totals)))
+    if partition_size:
+        print('App partition: {} bytes, used {:.1f}%, headroom {} bytes'.format(
+            partition_size, 100.0 * flash / partition_size, partition_size - flash))
+
+    print('\nTop {} components:'.format(top))
+    print('  {:<32} {:>9} {:>9} {:>8} {:>8} {:>8}'.format('component', 'flash', 'code', 'iram', 'dram', 'bss'))
+    comps = sorted(report['components'].items(), key=lambda kv: -flash_of(kv[1]) - kv[1]['dram_bss'])
+    for comp, v in comps[:top]:
+        print('  {:<32} {:>9} {:>9} {:>8} {:>8} {:>8}'.format(
+            comp[:32], flash_of(v), v['flash_code'], v['iram'], v['dram_data'], v['dram_bss']))
+
+    print('\nTop {} symbols:'.format(top))
+    for sym, size in list(report['symbols'].items())[:top]:
+        print('  {:>8}  {}'.format(size, sym))
+
+
+def print_diff(report, baseline, top):
+    """Returns (flash_delta, ram_delta)"""
+    cur, base = report['totals'], baseline['totals']
+    print('\nDiff against baseline:')
+    for c in CLASSES:
+        d = cur[c] - base.get(c, 0)
+        if d:
+            print('  {:<12} {:>+10}'.format(c, d))
+    flash_delta = flash_of(cur) - flash_of(base)
+    ram_delta = ram_of(cur) - ram_of(base)
+    print('  {:<12} {:>+10}'.format('image', flash_delta))
+    print('  {:<12} {:>+10}'.format('static RAM', ram_delta))
+
+    deltas = []
+    names = set(report['components']) | set(baseline['components'])
+    empty = {c: 0 for c in CLASSES}
+    for comp in names:
+        a = baseline['components'].get(comp, empty)
+        b = report['components'].get(comp, empty)
+        df, dr = flash_of(b) - flash_of(a), ram_of(b) - ram_of(a)
+        if df or dr:
+            deltas.append((comp, df, dr))
+    if deltas:
+        print('\n  {:<32} {:>10} {:>10}'.format('component', 'flash', 'ram'))
+        for comp, df, dr in sorted(deltas, key=lambda x: -abs(x[1]) - abs(x[2]))[:top]:
+            print('  {:<32} {:>+10} {:>+10}'.format(comp[:32], df, dr))
+
+    sym_deltas = []
+    for sym in set(report['symbols']) | set(baseline['symbols']):
+        d = report['symbols'].get(sym, 0) - baseline['symbols'].get(sym, 0)
+        if d:
+            sym_deltas.append((sym, d))
+    if sym_deltas:
+        print('\n  Symbol changes (among the top symbols of either build):')
+        for sym, d in sorted(sym_deltas, key=lambda x: -abs(x[1]))[:top]:
+            print('  {:>+8}  {}'.format(d, sym))
+    return flash_delta, ram_delta
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument('--map', required=True, help='Linker map file')
+    parser.add_argument('--elf', help='ELF file, used to cross-check the map totals')
+    parser.add_argument('--partitions', help='partitions.csv, to check the app partition headroom')
+    parser.add_argument('--baseline', help='Baseline JSON to diff against')
+    parser.add_argument('--save-baseline', action='store_true', help='Write the current report as baseline')
+    parser.add_argument('--top', type=int, default=20, help='Rows per table')
+    parser.add_argument('--max-flash-growth', type=int, default=None, help='Fail if the image grows more (bytes)')
+    parser.add_argument('--max-ram-growth', type=int, default=None, help='Fail if static RAM grows more (bytes)')
+    args = parser.parse_args()
+
+    if not os.path.exists(args.map):
+        print('Map file {} not found, build the project first'.format(args.map))
+        return 1
+
+    report = summarize(parse_map(args.map), top=200)
+    partition_size = app_partition_size(args.partitions) if args.partitions else 0
+    print_report(report, partition_size, args.top)
+
+    failed = False
+    if args.elf and os.path.exists(args.elf):
+        elf = parse_elf_sections(args.elf)
+        report['elf'] = elf
+        for c in CLASSES:
+            if c in elf and abs(elf[c] - report['totals'][c]) > 64:
+                print('Note: {} is {} bytes in the ELF, {} attributed from the map (alignment/linker-generated)'.format(
+                    c, elf[c], report['totals'][c]))
+    if partition_size and flash_of(report['totals']) > partition_size:
+        print('FAIL: image does not fit the {} byte app partition'.format(partition_size))
+        failed = True
+
+    if args.baseline and args.save_baseline:
+        with open(args.baseline, 'w') as f:
+            json.dump(report, f, indent=1, sort_keys=True)
+        print('\nBaseline saved to {}'.format(args.baseline))
+    elif args.baseline and os.path.exists(args.baseline):
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+        flash_delta, ram_delta = print_diff(report, baseline, args.top)
+        if args.max_flash_growth is not None and flash_delta > args.max_flash_growth:
+            print('FAIL: image grew by {} bytes (limit {})'.format(flash_delta, args.max_flash_growth))
+            failed = True
+        if args.max_ram_growth is not None and ram_delta > args.max_ram_growth:
+            print('FAIL: static RAM grew by {} bytes (limit {})'.format(ram_delta, args.max_ram_growth))
+            failed = True
+    elif args.baseline:
+        print('\nNo baseline at {}, run with --save-baseline to create it'.format(args.baseline))
+
+    return 1 if failed else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())